@@ -41,12 +41,25 @@ struct CAT : public ModulePass {
     auto dfa = noelle.getDataFlowAnalyses();
     auto dfr = dfa.runReachableAnalysis(mainF);
     errs() << "Data flow reachable analysis\n";
-    for (auto &inst : instructions(mainF)) {
-      errs() << " Next are the instructions reachable from " << inst << "\n";
-      auto &outSet = dfr->OUT(&inst);
-      for (auto reachInst : outSet) {
-        errs() << "   " << *reachInst << "\n";
-      }
+
+    /*
+     * Walk the sets of every instruction through the dense result.
+     * This replays each basic block once and it does not allocate a set per
+     * instruction.
+     */
+    auto dense = dfr->getDenseResult();
+    for (auto &bb : *mainF) {
+      dense->expand(&bb,
+                    [dense](Instruction *inst,
+                            const DataFlowBitVector &IN,
+                            const DataFlowBitVector &OUT) {
+                      errs() << " Next are the instructions reachable from "
+                             << *inst << "\n";
+                      OUT.forEachSetBit([dense](uint32_t elementID) {
+                        errs() << "   " << *dense->getElement(elementID)
+                               << "\n";
+                      });
+                    });
     }
 
     return false;
@@ -122,9 +122,16 @@ struct CAT : public ModulePass {
      * Generate the code to allocate and initialize the loop environment that
      * will be given to the task as its input. This code will be in the callers
      * of the task. In our example, we'll have a single caller.
+     *
+     * Live-in variables are only read by the task, so we pack them together
+     * (compact layout) rather than giving each of them a cache line.
      */
     auto program = noelle.getProgram();
-    auto envBuilder = new LoopEnvironmentBuilder(program->getContext(), env, 1);
+    auto envBuilder =
+        new LoopEnvironmentBuilder(program->getContext(),
+                                   env,
+                                   1,
+                                   LoopEnvironmentLayout::Compact);
     auto envUser = envBuilder->getUser(0);
 
     /*
@@ -26,17 +26,108 @@
 
 namespace arcana::noelle {
 
+/*
+ * Model of the machine NOELLE runs on.
+ *
+ * The topology (sockets, NUMA nodes, SMT siblings, and caches) is read from
+ * /sys/devices/system the first time it is needed.
+ * If it is not available, the model falls back to the number of logical cores
+ * reported by the C++ runtime.
+ */
 class Architecture {
 public:
+  /*
+   * Cache reachable from a logical core.
+   */
+  struct Cache {
+    uint32_t level;
+    std::string type;
+    uint64_t bytes;
+    uint32_t lineBytes;
+    std::set<uint32_t> sharedWith;
+  };
+
   Architecture();
 
   static uint32_t getNumberOfLogicalCores(void);
 
   static uint32_t getNumberOfPhysicalCores(void);
 
+  static uint32_t getNumberOfSockets(void);
+
+  static uint32_t getNumberOfNUMANodes(void);
+
   static int32_t getCacheLineBytes(void);
 
+  /*
+   * Return the IDs of the logical cores that are online.
+   */
+  static std::vector<uint32_t> getLogicalCores(void);
+
+  static uint32_t getSocket(uint32_t logicalCore);
+
+  static uint32_t getNUMANode(uint32_t logicalCore);
+
+  /*
+   * Return the logical cores that share the physical core of @logicalCore
+   * (including @logicalCore).
+   */
+  static std::set<uint32_t> getSMTSiblings(uint32_t logicalCore);
+
+  static std::vector<Cache> getCaches(uint32_t logicalCore);
+
+  /*
+   * Return the latency (in nanoseconds) to move a cache line from
+   * @fromLogicalCore to @toLogicalCore.
+   * Return 0 if the latency has not been measured (e.g., the two cores could
+   * not run the microbenchmark within its time limit).
+   */
+  static double getCoreToCoreLatency(uint32_t fromLogicalCore,
+                                     uint32_t toLogicalCore);
+
+  /*
+   * Load the latencies between logical cores from @cacheFileName.
+   * If the file does not exist or it was generated for a different set of
+   * logical cores, then measure the latencies with a microbenchmark and store
+   * them in @cacheFileName.
+   *
+   * Return true if the latency of at least a pair of cores is available.
+   */
+  static bool measureCoreToCoreLatencies(const std::string &cacheFileName);
+
 private:
+  struct LogicalCore {
+    uint32_t ID;
+    uint32_t physicalCore;
+    uint32_t socket;
+    uint32_t numaNode;
+    std::set<uint32_t> smtSiblings;
+    std::vector<Cache> caches;
+  };
+
+  struct Topology {
+    std::vector<LogicalCore> cores;
+    std::unordered_map<uint32_t, uint32_t> coreIndexes;
+    uint32_t physicalCores;
+    uint32_t sockets;
+    uint32_t numaNodes;
+    int32_t cacheLineBytes;
+    std::vector<std::vector<double>> latencies;
+  };
+
+  static Topology &getTopology(void);
+
+  static Topology readTopology(void);
+
+  static const LogicalCore &getLogicalCore(uint32_t logicalCore);
+
+  static bool loadLatencies(Topology &topology,
+                            const std::string &cacheFileName);
+
+  static void storeLatencies(const Topology &topology,
+                             const std::string &cacheFileName);
+
+  static double measureLatency(uint32_t logicalCore0, uint32_t logicalCore1);
 };
 
 } // namespace arcana::noelle
@@ -19,24 +19,529 @@
  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
  OR OTHER DEALINGS IN THE SOFTWARE.
  */
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#ifdef __linux__
+#  include <pthread.h>
+#  include <sched.h>
+#endif
+
 #include "arcana/noelle/core/Architecture.hpp"
 
 namespace arcana::noelle {
 
+static const std::string cpuDirectory = "/sys/devices/system/cpu/";
+static const std::string nodeDirectory = "/sys/devices/system/node/";
+static std::mutex latenciesLock;
+
+static bool readFile(const std::string &fileName, std::string &content) {
+  std::ifstream file(fileName);
+  if (!file.good()) {
+    return false;
+  }
+  std::getline(file, content);
+
+  return true;
+}
+
+static bool readNumber(const std::string &fileName, uint64_t &value) {
+  std::string content;
+  if (!readFile(fileName, content) || content.empty()) {
+    return false;
+  }
+  value = std::strtoull(content.c_str(), nullptr, 10);
+
+  return true;
+}
+
+/*
+ * Parse a list of IDs in the sysfs format (e.g., "0-3,8,10-11").
+ */
+static std::set<uint32_t> parseList(const std::string &list) {
+  std::set<uint32_t> IDs;
+  std::stringstream stream{ list };
+  std::string range;
+  while (std::getline(stream, range, ',')) {
+    if (range.empty()) {
+      continue;
+    }
+    auto dash = range.find('-');
+    uint32_t first = std::strtoul(range.c_str(), nullptr, 10);
+    uint32_t last = first;
+    if (dash != std::string::npos) {
+      last = std::strtoul(range.c_str() + dash + 1, nullptr, 10);
+    }
+    for (auto ID = first; ID <= last; ID++) {
+      IDs.insert(ID);
+    }
+  }
+
+  return IDs;
+}
+
+/*
+ * Parse a cache size in the sysfs format (e.g., "32K").
+ */
+static uint64_t parseSize(const std::string &size) {
+  char *unit = nullptr;
+  uint64_t bytes = std::strtoull(size.c_str(), &unit, 10);
+  if (unit != nullptr) {
+    switch (*unit) {
+      case 'K':
+        bytes <<= 10;
+        break;
+      case 'M':
+        bytes <<= 20;
+        break;
+      case 'G':
+        bytes <<= 30;
+        break;
+    }
+  }
+
+  return bytes;
+}
+
 Architecture::Architecture() {
   return;
 }
 
 uint32_t Architecture::getNumberOfLogicalCores(void) {
-  return std::thread::hardware_concurrency();
+  auto &topology = Architecture::getTopology();
+
+  return topology.cores.size();
 }
 
 uint32_t Architecture::getNumberOfPhysicalCores(void) {
-  return getNumberOfLogicalCores() / 2;
+  auto &topology = Architecture::getTopology();
+
+  return topology.physicalCores;
+}
+
+uint32_t Architecture::getNumberOfSockets(void) {
+  auto &topology = Architecture::getTopology();
+
+  return topology.sockets;
+}
+
+uint32_t Architecture::getNumberOfNUMANodes(void) {
+  auto &topology = Architecture::getTopology();
+
+  return topology.numaNodes;
 }
 
 int32_t Architecture::getCacheLineBytes(void) {
-  return 64;
+  auto &topology = Architecture::getTopology();
+
+  return topology.cacheLineBytes;
+}
+
+std::vector<uint32_t> Architecture::getLogicalCores(void) {
+  std::vector<uint32_t> IDs;
+  for (auto &core : Architecture::getTopology().cores) {
+    IDs.push_back(core.ID);
+  }
+
+  return IDs;
+}
+
+uint32_t Architecture::getSocket(uint32_t logicalCore) {
+  return Architecture::getLogicalCore(logicalCore).socket;
+}
+
+uint32_t Architecture::getNUMANode(uint32_t logicalCore) {
+  return Architecture::getLogicalCore(logicalCore).numaNode;
+}
+
+std::set<uint32_t> Architecture::getSMTSiblings(uint32_t logicalCore) {
+  return Architecture::getLogicalCore(logicalCore).smtSiblings;
+}
+
+std::vector<Architecture::Cache> Architecture::getCaches(uint32_t logicalCore) {
+  return Architecture::getLogicalCore(logicalCore).caches;
+}
+
+double Architecture::getCoreToCoreLatency(uint32_t fromLogicalCore,
+                                          uint32_t toLogicalCore) {
+  auto &topology = Architecture::getTopology();
+  std::lock_guard<std::mutex> guard(latenciesLock);
+  if (topology.latencies.empty()) {
+    return 0;
+  }
+  auto from = topology.coreIndexes.at(fromLogicalCore);
+  auto to = topology.coreIndexes.at(toLogicalCore);
+
+  return topology.latencies[from][to];
+}
+
+bool Architecture::measureCoreToCoreLatencies(
+    const std::string &cacheFileName) {
+  auto &topology = Architecture::getTopology();
+  std::lock_guard<std::mutex> guard(latenciesLock);
+
+  /*
+   * Check if the latencies are already available.
+   */
+  if (!topology.latencies.empty()) {
+    return true;
+  }
+  if (Architecture::loadLatencies(topology, cacheFileName)) {
+    return true;
+  }
+
+  /*
+   * Measure the latencies.
+   */
+#ifdef __linux__
+  auto n = topology.cores.size();
+  std::vector<std::vector<double>> latencies(n, std::vector<double>(n, 0));
+  auto measured = false;
+  for (auto i = 0u; i < n; i++) {
+    for (auto j = i + 1; j < n; j++) {
+      auto latency = Architecture::measureLatency(topology.cores[i].ID,
+                                                  topology.cores[j].ID);
+      latencies[i][j] = latency;
+      latencies[j][i] = latency;
+      measured |= (latency > 0);
+    }
+  }
+
+  /*
+   * Check if no pair of cores could run the microbenchmark (e.g., the
+   * process cannot run on the cores listed by sysfs).
+   * In this case, the latencies stay unknown.
+   */
+  if (!measured) {
+    return false;
+  }
+  topology.latencies = std::move(latencies);
+
+  /*
+   * Cache the latencies.
+   */
+  Architecture::storeLatencies(topology, cacheFileName);
+
+  return true;
+#else
+  return false;
+#endif
+}
+
+Architecture::Topology &Architecture::getTopology(void) {
+  static Topology topology = Architecture::readTopology();
+
+  return topology;
+}
+
+const Architecture::LogicalCore &Architecture::getLogicalCore(
+    uint32_t logicalCore) {
+  auto &topology = Architecture::getTopology();
+  assert(topology.coreIndexes.count(logicalCore) > 0);
+
+  return topology.cores[topology.coreIndexes.at(logicalCore)];
+}
+
+Architecture::Topology Architecture::readTopology(void) {
+  Topology topology;
+  topology.physicalCores = 0;
+  topology.sockets = 0;
+  topology.numaNodes = 0;
+  topology.cacheLineBytes = 64;
+
+  /*
+   * Fetch the logical cores that are online.
+   */
+  std::string content;
+  std::set<uint32_t> onlineCores;
+  if (readFile(cpuDirectory + "online", content)) {
+    onlineCores = parseList(content);
+  }
+  if (onlineCores.empty()) {
+
+    /*
+     * The topology is not available.
+     * Assume every physical core has two logical cores.
+     */
+    uint32_t n = std::max(std::thread::hardware_concurrency(), 1u);
+    for (auto ID = 0u; ID < n; ID++) {
+      topology.coreIndexes[ID] = topology.cores.size();
+      topology.cores.push_back({ ID, ID / 2, 0, 0, { ID }, {} });
+    }
+    topology.physicalCores = std::max(n / 2, 1u);
+    topology.sockets = 1;
+    topology.numaNodes = 1;
+
+    return topology;
+  }
+
+  /*
+   * Fetch the NUMA node of every logical core.
+   */
+  std::unordered_map<uint32_t, uint32_t> numaNodeOfCore;
+  std::set<uint32_t> numaNodes;
+  if (readFile(nodeDirectory + "online", content)) {
+    numaNodes = parseList(content);
+  }
+  for (auto node : numaNodes) {
+    auto nodeName = nodeDirectory + "node" + std::to_string(node) + "/cpulist";
+    if (!readFile(nodeName, content)) {
+      continue;
+    }
+    for (auto core : parseList(content)) {
+      numaNodeOfCore[core] = node;
+    }
+  }
+  topology.numaNodes = std::max<uint32_t>(numaNodes.size(), 1);
+
+  /*
+   * Describe every logical core.
+   */
+  std::set<std::pair<uint64_t, uint64_t>> physicalCores;
+  std::set<uint64_t> sockets;
+  for (auto ID : onlineCores) {
+    LogicalCore core;
+    core.ID = ID;
+    auto coreDirectory = cpuDirectory + "cpu" + std::to_string(ID) + "/";
+
+    /*
+     * Fetch the socket and the physical core.
+     */
+    uint64_t socket = 0;
+    uint64_t physicalCore = ID;
+    readNumber(coreDirectory + "topology/physical_package_id", socket);
+    readNumber(coreDirectory + "topology/core_id", physicalCore);
+    core.socket = socket;
+    core.physicalCore = physicalCore;
+    sockets.insert(socket);
+    physicalCores.insert({ socket, physicalCore });
+    core.numaNode = 0;
+    if (numaNodeOfCore.count(ID) > 0) {
+      core.numaNode = numaNodeOfCore.at(ID);
+    }
+
+    /*
+     * Fetch the SMT siblings.
+     */
+    if (readFile(coreDirectory + "topology/thread_siblings_list", content)) {
+      core.smtSiblings = parseList(content);
+    }
+    core.smtSiblings.insert(ID);
+
+    /*
+     * Fetch the caches.
+     */
+    for (auto index = 0u;; index++) {
+      auto cacheDirectory =
+          coreDirectory + "cache/index" + std::to_string(index) + "/";
+      uint64_t level;
+      if (!readNumber(cacheDirectory + "level", level)) {
+        break;
+      }
+      Cache cache;
+      cache.level = level;
+      readFile(cacheDirectory + "type", cache.type);
+      cache.bytes = 0;
+      if (readFile(cacheDirectory + "size", content)) {
+        cache.bytes = parseSize(content);
+      }
+      uint64_t lineBytes = 0;
+      readNumber(cacheDirectory + "coherency_line_size", lineBytes);
+      cache.lineBytes = lineBytes;
+      if (readFile(cacheDirectory + "shared_cpu_list", content)) {
+        cache.sharedWith = parseList(content);
+      }
+      core.caches.push_back(cache);
+    }
+
+    topology.coreIndexes[ID] = topology.cores.size();
+    topology.cores.push_back(core);
+  }
+  topology.physicalCores = physicalCores.size();
+  topology.sockets = sockets.size();
+
+  /*
+   * Fetch the size of the cache line of the first-level data cache.
+   */
+  for (auto &cache : topology.cores.front().caches) {
+    if ((cache.level == 1) && (cache.type != "Instruction")
+        && (cache.lineBytes > 0)) {
+      topology.cacheLineBytes = cache.lineBytes;
+      break;
+    }
+  }
+
+  return topology;
+}
+
+bool Architecture::loadLatencies(Topology &topology,
+                                 const std::string &cacheFileName) {
+  std::ifstream file(cacheFileName);
+  if (!file.good()) {
+    return false;
+  }
+
+  /*
+   * Check that the file describes the current logical cores.
+   */
+  uint64_t n = 0;
+  file >> n;
+  if (!file.good() || (n != topology.cores.size())) {
+    return false;
+  }
+  for (auto &core : topology.cores) {
+    uint32_t ID;
+    file >> ID;
+    if (!file.good() || (ID != core.ID)) {
+      return false;
+    }
+  }
+
+  /*
+   * Read the latencies.
+   */
+  std::vector<std::vector<double>> latencies(n, std::vector<double>(n, 0));
+  for (auto i = 0u; i < n; i++) {
+    for (auto j = 0u; j < n; j++) {
+      file >> latencies[i][j];
+    }
+  }
+  if (file.fail()) {
+    return false;
+  }
+  topology.latencies = std::move(latencies);
+
+  return true;
+}
+
+void Architecture::storeLatencies(const Topology &topology,
+                                  const std::string &cacheFileName) {
+  std::ofstream file(cacheFileName);
+  if (!file.good()) {
+    return;
+  }
+
+  /*
+   * Write the logical cores followed by the matrix of latencies.
+   */
+  file << topology.cores.size() << "\n";
+  for (auto &core : topology.cores) {
+    file << core.ID << " ";
+  }
+  file << "\n";
+  for (auto &row : topology.latencies) {
+    for (auto latency : row) {
+      file << latency << " ";
+    }
+    file << "\n";
+  }
+
+  return;
+}
+
+double Architecture::measureLatency(uint32_t logicalCore0,
+                                    uint32_t logicalCore1) {
+#ifdef __linux__
+  constexpr uint64_t warmUpRoundTrips = 1000;
+  constexpr uint64_t roundTrips = 10000;
+  constexpr uint64_t spinsBetweenChecks = 1024;
+  constexpr auto timeLimit = std::chrono::seconds(1);
+
+  /*
+   * Pin the current thread to @logicalCore.
+   */
+  auto pin = [](uint32_t logicalCore) -> bool {
+    if (logicalCore >= CPU_SETSIZE) {
+      return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(logicalCore, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+  };
+
+  /*
+   * The two threads bounce a cache line between the two cores.
+   * Each write of a thread is awaited by the other one.
+   *
+   * The wait is bounded: if a thread could not be pinned or the time limit
+   * expires (e.g., both threads ended up on the same core), then the
+   * microbenchmark is aborted and the latency is unknown.
+   */
+  alignas(64) std::atomic<uint64_t> line{ 0 };
+  std::atomic<bool> aborted{ false };
+  auto deadline = std::chrono::steady_clock::now() + timeLimit;
+  auto waitFor = [&line, &aborted, deadline](uint64_t value) -> bool {
+    uint64_t spins = 0;
+    while (line.load(std::memory_order_acquire) != value) {
+      if (aborted.load(std::memory_order_relaxed)) {
+        return false;
+      }
+      spins++;
+      if ((spins % spinsBetweenChecks) == 0) {
+        if (std::chrono::steady_clock::now() > deadline) {
+          aborted = true;
+          return false;
+        }
+        std::this_thread::yield();
+      }
+    }
+    return true;
+  };
+  double latency = 0;
+  std::thread ping([&]() {
+    if (!pin(logicalCore0)) {
+      aborted = true;
+      return;
+    }
+    std::chrono::steady_clock::time_point start;
+    for (uint64_t i = 0; i < warmUpRoundTrips + roundTrips; i++) {
+      if (i == warmUpRoundTrips) {
+        start = std::chrono::steady_clock::now();
+      }
+      line.store(2 * i + 1, std::memory_order_release);
+      if (!waitFor(2 * i + 2)) {
+        return;
+      }
+    }
+    auto end = std::chrono::steady_clock::now();
+    auto nanoseconds =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+            .count();
+
+    /*
+     * A round trip includes two transfers of the cache line.
+     */
+    latency = ((double)nanoseconds) / (roundTrips * 2);
+  });
+  std::thread pong([&]() {
+    if (!pin(logicalCore1)) {
+      aborted = true;
+      return;
+    }
+    for (uint64_t i = 0; i < warmUpRoundTrips + roundTrips; i++) {
+      if (!waitFor(2 * i + 1)) {
+        return;
+      }
+      line.store(2 * i + 2, std::memory_order_release);
+    }
+  });
+  ping.join();
+  pong.join();
+
+  /*
+   * The latency is unknown if the microbenchmark has been aborted.
+   */
+  if (aborted) {
+    return 0;
+  }
+
+  return latency;
+#else
+  return 0;
+#endif
 }
 
 } // namespace arcana::noelle
@@ -0,0 +1,128 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Yian Su, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_BASIC_UTILITIES_DAGREACHABILITY_H_
+#define NOELLE_SRC_CORE_BASIC_UTILITIES_DAGREACHABILITY_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Reachability among the nodes of a directed acyclic graph.
+ *
+ * Nodes are identified by the indexes 0..N-1.
+ * The transitive closure is computed once, visiting the nodes in reverse
+ * topological order, and it is represented either as
+ * - one bit vector per node (DENSE): a node's row is the OR, one word at a
+ *   time, of the rows of its successors, or
+ * - a list of intervals of post-order numbers per node (INTERVALS): a node
+ *   reaches the nodes whose post-order number falls in one of its intervals.
+ *   Nodes of a spanning tree have contiguous numbers, so the lists are short
+ *   for the DAGs we generate and the memory needed does not grow as N^2.
+ *
+ * Merging nodes can create cycles.
+ * Both representations answer as if the merged nodes were a single node of
+ * the graph: a node reaches itself if and only if it belongs to a cycle.
+ */
+class DAGReachability {
+public:
+  enum Representation { AUTOMATIC, DENSE, INTERVALS };
+
+  DAGReachability();
+
+  /*
+   * Compute the transitive closure of the DAG with @numberOfNodes nodes where
+   * there is an edge from i to every node of @successors[i].
+   * AUTOMATIC uses DENSE for DAGs with up to maximumNumberOfDenseNodes nodes.
+   */
+  void compute(uint32_t numberOfNodes,
+               const std::vector<std::vector<uint32_t>> &successors,
+               Representation representation = AUTOMATIC);
+
+  /*
+   * Check if there is a path with at least one edge from @from to @to.
+   */
+  bool isReachable(uint32_t from, uint32_t to) const;
+
+  /*
+   * Collapse @nodes into a single node and return its index, which is the
+   * smallest one of @nodes.
+   * The other indexes of @nodes are no longer used.
+   */
+  uint32_t merge(const std::vector<uint32_t> &nodes);
+
+  Representation getRepresentation(void) const;
+
+  static constexpr uint32_t maximumNumberOfDenseNodes = 1 << 13;
+
+private:
+  Representation representation;
+  uint32_t numberOfNodes;
+
+  /*
+   * DENSE: the row of node i is rows[i * wordsPerRow .. (i+1) * wordsPerRow).
+   */
+  uint32_t wordsPerRow;
+  std::vector<uint64_t> rows;
+
+  /*
+   * INTERVALS: the edges of the original DAG are kept, and a merged node is
+   * represented by the node it has been merged into (representatives).
+   * Intervals are computed for the DAG of the strongly connected components
+   * of the graph of the representatives, which is cyclic after some merges.
+   * The intervals of component c are
+   * intervals[firstInterval[c] .. firstInterval[c + 1]).
+   * Merges only record the new representatives: intervals are computed again
+   * by the first query that follows them.
+   */
+  std::vector<std::vector<uint32_t>> successors;
+  std::vector<uint32_t> representatives;
+  mutable bool areIntervalsStale;
+  mutable std::vector<uint32_t> components;
+  mutable std::vector<bool> isComponentCyclic;
+  mutable std::vector<uint32_t> postOrder;
+  mutable std::vector<std::pair<uint32_t, uint32_t>> intervals;
+  mutable std::vector<uint32_t> firstInterval;
+
+  static std::vector<uint32_t> computePostOrder(
+      const std::vector<std::vector<uint32_t>> &successors,
+      std::vector<uint32_t> &firstDescendant);
+
+  void computeDenseRows(const std::vector<std::vector<uint32_t>> &successors);
+
+  void computeComponentIntervals(void) const;
+
+  void computeIntervals(
+      const std::vector<std::vector<uint32_t>> &successors) const;
+
+  uint32_t getRepresentative(uint32_t node) const;
+
+  void mergeDenseRows(const std::vector<uint32_t> &nodes, uint32_t merged);
+
+  bool testBit(uint32_t row, uint32_t column) const;
+
+  void setBit(uint32_t row, uint32_t column);
+};
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_BASIC_UTILITIES_DAGREACHABILITY_H_
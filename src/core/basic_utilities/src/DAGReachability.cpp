@@ -0,0 +1,499 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Yian Su, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <limits>
+
+#include "arcana/noelle/core/DAGReachability.hpp"
+
+namespace arcana::noelle {
+
+DAGReachability::DAGReachability()
+  : representation{ DENSE },
+    numberOfNodes{ 0 },
+    wordsPerRow{ 0 },
+    areIntervalsStale{ false } {
+  return;
+}
+
+DAGReachability::Representation DAGReachability::getRepresentation(
+    void) const {
+  return this->representation;
+}
+
+void DAGReachability::compute(
+    uint32_t numberOfNodes,
+    const std::vector<std::vector<uint32_t>> &successors,
+    Representation representation) {
+  assert(successors.size() == numberOfNodes);
+
+  /*
+   * Pick the representation.
+   */
+  if (representation == AUTOMATIC) {
+    representation = (numberOfNodes <= maximumNumberOfDenseNodes) ? DENSE
+                                                                   : INTERVALS;
+  }
+  this->representation = representation;
+  this->numberOfNodes = numberOfNodes;
+
+  /*
+   * Drop the previous closure.
+   */
+  this->rows.clear();
+  this->successors.clear();
+  this->representatives.clear();
+  this->components.clear();
+  this->isComponentCyclic.clear();
+  this->postOrder.clear();
+  this->intervals.clear();
+  this->firstInterval.clear();
+
+  /*
+   * Compute the closure.
+   */
+  if (representation == DENSE) {
+    this->computeDenseRows(successors);
+  } else {
+    this->successors = successors;
+    this->representatives.resize(numberOfNodes);
+    for (auto node = 0u; node < numberOfNodes; node++) {
+      this->representatives[node] = node;
+    }
+    this->computeComponentIntervals();
+  }
+
+  return;
+}
+
+std::vector<uint32_t> DAGReachability::computePostOrder(
+    const std::vector<std::vector<uint32_t>> &successors,
+    std::vector<uint32_t> &firstDescendant) {
+  uint32_t numberOfNodes = successors.size();
+  std::vector<uint32_t> order;
+  order.reserve(numberOfNodes);
+  firstDescendant.assign(numberOfNodes, 0);
+
+  /*
+   * Depth-first visit all nodes.
+   * Every node is appended to @order after all its successors, so @order is a
+   * reverse topological order.
+   */
+  std::vector<bool> visited(numberOfNodes, false);
+  std::vector<std::pair<uint32_t, uint32_t>> stack;
+  for (auto root = 0u; root < numberOfNodes; root++) {
+    if (visited[root]) {
+      continue;
+    }
+    visited[root] = true;
+    firstDescendant[root] = order.size();
+    stack.push_back({ root, 0 });
+    while (!stack.empty()) {
+      auto &top = stack.back();
+      auto node = top.first;
+      auto &succs = successors[node];
+      if (top.second < succs.size()) {
+        auto succ = succs[top.second];
+        top.second++;
+        if (!visited[succ]) {
+          visited[succ] = true;
+          firstDescendant[succ] = order.size();
+          stack.push_back({ succ, 0 });
+        }
+        continue;
+      }
+      order.push_back(node);
+      stack.pop_back();
+    }
+  }
+
+  return order;
+}
+
+void DAGReachability::computeDenseRows(
+    const std::vector<std::vector<uint32_t>> &successors) {
+  this->wordsPerRow = (this->numberOfNodes + 63) / 64;
+  this->rows.assign(
+      static_cast<uint64_t>(this->numberOfNodes) * this->wordsPerRow,
+      0);
+
+  /*
+   * The row of a node is the union of the rows of its successors and the
+   * successors themselves.
+   * Successors are visited first, so their rows are complete.
+   */
+  std::vector<uint32_t> firstDescendant;
+  auto order = DAGReachability::computePostOrder(successors, firstDescendant);
+  for (auto node : order) {
+    auto row = &this->rows[static_cast<uint64_t>(node) * this->wordsPerRow];
+    for (auto succ : successors[node]) {
+      auto succRow =
+          &this->rows[static_cast<uint64_t>(succ) * this->wordsPerRow];
+      for (auto w = 0u; w < this->wordsPerRow; w++) {
+        row[w] |= succRow[w];
+      }
+      this->setBit(node, succ);
+    }
+  }
+
+  return;
+}
+
+uint32_t DAGReachability::getRepresentative(uint32_t node) const {
+  while (this->representatives[node] != node) {
+    node = this->representatives[node];
+  }
+
+  return node;
+}
+
+void DAGReachability::computeComponentIntervals(void) const {
+
+  /*
+   * Fetch the edges among representatives.
+   * Edges among nodes merged together are not edges of the merged node.
+   */
+  std::vector<uint32_t> representativeOf(this->numberOfNodes);
+  for (auto node = 0u; node < this->numberOfNodes; node++) {
+    representativeOf[node] = this->getRepresentative(node);
+  }
+  std::vector<std::vector<uint32_t>> edges(this->numberOfNodes);
+  for (auto node = 0u; node < this->numberOfNodes; node++) {
+    auto src = representativeOf[node];
+    for (auto succ : this->successors[node]) {
+      auto dst = representativeOf[succ];
+      if (src != dst) {
+        edges[src].push_back(dst);
+      }
+    }
+  }
+
+  /*
+   * Compute the strongly connected components (Tarjan).
+   * Components are identified in reverse topological order.
+   */
+  const uint32_t unvisited = std::numeric_limits<uint32_t>::max();
+  std::vector<uint32_t> index(this->numberOfNodes, unvisited);
+  std::vector<uint32_t> lowLink(this->numberOfNodes, 0);
+  std::vector<bool> isOnStack(this->numberOfNodes, false);
+  std::vector<uint32_t> sccStack;
+  std::vector<std::pair<uint32_t, uint32_t>> dfsStack;
+  uint32_t nextIndex = 0;
+  this->components.assign(this->numberOfNodes, 0);
+  this->isComponentCyclic.clear();
+  for (auto root = 0u; root < this->numberOfNodes; root++) {
+    if ((representativeOf[root] != root) || (index[root] != unvisited)) {
+      continue;
+    }
+    dfsStack.push_back({ root, 0 });
+    index[root] = lowLink[root] = nextIndex++;
+    sccStack.push_back(root);
+    isOnStack[root] = true;
+    while (!dfsStack.empty()) {
+      auto &top = dfsStack.back();
+      auto node = top.first;
+      if (top.second < edges[node].size()) {
+        auto succ = edges[node][top.second];
+        top.second++;
+        if (index[succ] == unvisited) {
+          index[succ] = lowLink[succ] = nextIndex++;
+          sccStack.push_back(succ);
+          isOnStack[succ] = true;
+          dfsStack.push_back({ succ, 0 });
+        } else if (isOnStack[succ]) {
+          lowLink[node] = std::min(lowLink[node], index[succ]);
+        }
+        continue;
+      }
+      dfsStack.pop_back();
+      if (!dfsStack.empty()) {
+        auto parent = dfsStack.back().first;
+        lowLink[parent] = std::min(lowLink[parent], lowLink[node]);
+      }
+      if (lowLink[node] != index[node]) {
+        continue;
+      }
+
+      /*
+       * @node is the root of a component.
+       */
+      uint32_t component = this->isComponentCyclic.size();
+      uint32_t size = 0;
+      uint32_t member;
+      do {
+        member = sccStack.back();
+        sccStack.pop_back();
+        isOnStack[member] = false;
+        this->components[member] = component;
+        size++;
+      } while (member != node);
+      this->isComponentCyclic.push_back(size > 1);
+    }
+  }
+  for (auto node = 0u; node < this->numberOfNodes; node++) {
+    this->components[node] = this->components[representativeOf[node]];
+  }
+
+  /*
+   * Compute the intervals of the DAG of the components.
+   */
+  uint32_t numberOfComponents = this->isComponentCyclic.size();
+  std::vector<std::vector<uint32_t>> componentSuccessors(numberOfComponents);
+  for (auto node = 0u; node < this->numberOfNodes; node++) {
+    if (representativeOf[node] != node) {
+      continue;
+    }
+    auto src = this->components[node];
+    for (auto succ : edges[node]) {
+      auto dst = this->components[succ];
+      if (src != dst) {
+        componentSuccessors[src].push_back(dst);
+      }
+    }
+  }
+  for (auto &succs : componentSuccessors) {
+    std::sort(succs.begin(), succs.end());
+    succs.erase(std::unique(succs.begin(), succs.end()), succs.end());
+  }
+  this->computeIntervals(componentSuccessors);
+  this->areIntervalsStale = false;
+
+  return;
+}
+
+void DAGReachability::computeIntervals(
+    const std::vector<std::vector<uint32_t>> &successors) const {
+  uint32_t numberOfNodes = successors.size();
+
+  /*
+   * Number the nodes in post order.
+   * The nodes of the depth-first subtree of a node n are numbered with
+   * [firstDescendant[n], postOrder[n]].
+   */
+  std::vector<uint32_t> firstDescendant;
+  auto order = DAGReachability::computePostOrder(successors, firstDescendant);
+  this->postOrder.assign(numberOfNodes, 0);
+  for (auto i = 0u; i < order.size(); i++) {
+    this->postOrder[order[i]] = i;
+  }
+
+  /*
+   * The intervals of a node are the one of its subtree and the ones of its
+   * successors, merged when they overlap or are adjacent.
+   */
+  std::vector<std::vector<std::pair<uint32_t, uint32_t>>> nodeIntervals(
+      numberOfNodes);
+  for (auto node : order) {
+    auto &current = nodeIntervals[node];
+    current.push_back({ firstDescendant[node], this->postOrder[node] });
+    for (auto succ : successors[node]) {
+      auto &succIntervals = nodeIntervals[succ];
+      current.insert(current.end(), succIntervals.begin(), succIntervals.end());
+    }
+    std::sort(current.begin(), current.end());
+    auto last = 0u;
+    for (auto i = 1u; i < current.size(); i++) {
+      if (current[i].first <= current[last].second + 1) {
+        current[last].second =
+            std::max(current[last].second, current[i].second);
+        continue;
+      }
+      last++;
+      current[last] = current[i];
+    }
+    current.resize(last + 1);
+    current.shrink_to_fit();
+  }
+
+  /*
+   * Store the intervals contiguously.
+   */
+  this->intervals.clear();
+  this->firstInterval.assign(numberOfNodes + 1, 0);
+  for (auto node = 0u; node < numberOfNodes; node++) {
+    this->firstInterval[node] = this->intervals.size();
+    auto &current = nodeIntervals[node];
+    this->intervals.insert(this->intervals.end(),
+                           current.begin(),
+                           current.end());
+  }
+  this->firstInterval[numberOfNodes] = this->intervals.size();
+
+  return;
+}
+
+bool DAGReachability::isReachable(uint32_t from, uint32_t to) const {
+  assert(from < this->numberOfNodes);
+  assert(to < this->numberOfNodes);
+
+  if (this->representation == DENSE) {
+    return this->testBit(from, to);
+  }
+
+  /*
+   * Label the graph if it has been modified by merges.
+   */
+  if (this->areIntervalsStale) {
+    this->computeComponentIntervals();
+  }
+
+  /*
+   * Nodes of the same component reach each other through a cycle (if any).
+   */
+  auto fromComponent = this->components[from];
+  auto toComponent = this->components[to];
+  if (fromComponent == toComponent) {
+    return this->isComponentCyclic[fromComponent];
+  }
+
+  /*
+   * Look for the interval that could include the post-order number of @to.
+   */
+  auto number = this->postOrder[toComponent];
+  auto begin = this->intervals.begin() + this->firstInterval[fromComponent];
+  auto end = this->intervals.begin() + this->firstInterval[fromComponent + 1];
+  auto it = std::upper_bound(
+      begin,
+      end,
+      number,
+      [](uint32_t n, const std::pair<uint32_t, uint32_t> &interval) {
+        return n < interval.first;
+      });
+  if (it == begin) {
+    return false;
+  }
+  it--;
+
+  return number <= it->second;
+}
+
+uint32_t DAGReachability::merge(const std::vector<uint32_t> &nodes) {
+  assert(!nodes.empty());
+  auto merged = *std::min_element(nodes.begin(), nodes.end());
+
+  if (this->representation == DENSE) {
+    this->mergeDenseRows(nodes, merged);
+    return merged;
+  }
+
+  /*
+   * Represent @nodes with the merged node.
+   * The intervals are computed again by the next query, so consecutive merges
+   * label the graph only once.
+   */
+  for (auto node : nodes) {
+    this->representatives[this->getRepresentative(node)] = merged;
+  }
+  this->representatives[merged] = merged;
+  this->areIntervalsStale = true;
+
+  return merged;
+}
+
+void DAGReachability::mergeDenseRows(const std::vector<uint32_t> &nodes,
+                                     uint32_t merged) {
+
+  /*
+   * Compute the set of nodes merged and the nodes they reach.
+   */
+  std::vector<uint64_t> mask(this->wordsPerRow, 0);
+  for (auto node : nodes) {
+    mask[node / 64] |= (1ULL << (node % 64));
+  }
+  std::vector<uint64_t> mergedRow(this->wordsPerRow, 0);
+  for (auto node : nodes) {
+    auto row = &this->rows[static_cast<uint64_t>(node) * this->wordsPerRow];
+    for (auto w = 0u; w < this->wordsPerRow; w++) {
+      mergedRow[w] |= row[w];
+      row[w] = 0;
+    }
+  }
+  auto reachesMergedNodes = [this, &mask](uint32_t node) -> bool {
+    auto row = &this->rows[static_cast<uint64_t>(node) * this->wordsPerRow];
+    for (auto w = 0u; w < this->wordsPerRow; w++) {
+      if (row[w] & mask[w]) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  /*
+   * The merged node is in a cycle if a node it reaches reaches it back.
+   * This happens when @nodes skip a node of a path between two of them.
+   */
+  auto isInACycle = false;
+  for (auto w = 0u; w < this->wordsPerRow; w++) {
+    mergedRow[w] &= ~mask[w];
+  }
+  for (auto node = 0u; node < this->numberOfNodes; node++) {
+    if ((mergedRow[node / 64] & (1ULL << (node % 64)))
+        && reachesMergedNodes(node)) {
+      isInACycle = true;
+      break;
+    }
+  }
+  if (isInACycle) {
+    mergedRow[merged / 64] |= (1ULL << (merged % 64));
+  }
+
+  /*
+   * Nodes that reach one of @nodes now reach the merged node and what it
+   * reaches.
+   */
+  for (auto node = 0u; node < this->numberOfNodes; node++) {
+    if (mask[node / 64] & (1ULL << (node % 64))) {
+      continue;
+    }
+    if (!reachesMergedNodes(node)) {
+      continue;
+    }
+    auto row = &this->rows[static_cast<uint64_t>(node) * this->wordsPerRow];
+    for (auto w = 0u; w < this->wordsPerRow; w++) {
+      row[w] = (row[w] & ~mask[w]) | mergedRow[w];
+    }
+    this->setBit(node, merged);
+  }
+
+  /*
+   * Set the row of the merged node.
+   */
+  auto row = &this->rows[static_cast<uint64_t>(merged) * this->wordsPerRow];
+  std::copy(mergedRow.begin(), mergedRow.end(), row);
+
+  return;
+}
+
+bool DAGReachability::testBit(uint32_t row, uint32_t column) const {
+  auto word =
+      this->rows[static_cast<uint64_t>(row) * this->wordsPerRow + column / 64];
+
+  return (word >> (column % 64)) & 1;
+}
+
+void DAGReachability::setBit(uint32_t row, uint32_t column) {
+  auto &word =
+      this->rows[static_cast<uint64_t>(row) * this->wordsPerRow + column / 64];
+  word |= (1ULL << (column % 64));
+
+  return;
+}
+
+} // namespace arcana::noelle
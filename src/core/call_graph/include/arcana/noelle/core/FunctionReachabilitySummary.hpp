@@ -0,0 +1,70 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Yian Su, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_CALL_GRAPH_FUNCTIONREACHABILITYSUMMARY_H_
+#define NOELLE_SRC_CORE_CALL_GRAPH_FUNCTIONREACHABILITYSUMMARY_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/CallGraph.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Summary of the target functions that every function of a program can reach
+ * through a chain of calls.
+ *
+ * The summary is computed with a single bottom-up visit of the SCCDAG of the
+ * call graph: every SCC of the call graph gets a bitset of the reachable
+ * targets, which is the union of the targets and bitsets of its callees.
+ */
+class FunctionReachabilitySummary {
+public:
+  FunctionReachabilitySummary(CallGraph *cg,
+                              const std::vector<const Function *> &targets);
+
+  FunctionReachabilitySummary() = delete;
+
+  /*
+   * Return true if @f can reach at least one target function.
+   */
+  bool canReachATarget(const Function *f) const;
+
+  /*
+   * Return true if @from can reach the target function @target.
+   */
+  bool canReach(const Function *from, const Function *target) const;
+
+  std::set<const Function *> getReachableTargets(const Function *f) const;
+
+  const std::vector<const Function *> &getTargets(void) const;
+
+private:
+  std::vector<const Function *> targets;
+  std::unordered_map<const Function *, uint32_t> targetIndexes;
+  std::unordered_map<const Function *, uint32_t> sccOfFunction;
+  std::vector<BitVector> reachableTargetsOfSCC;
+
+  const BitVector *getReachableTargetsOf(const Function *f) const;
+};
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_CALL_GRAPH_FUNCTIONREACHABILITYSUMMARY_H_
@@ -55,6 +55,8 @@ public:
   std::unordered_map<SCCCAGNode *, SCCCAGEdge *> getIncomingEdges(
       SCCCAGNode *n) const;
 
+  ~SCCCAG();
+
 private:
   CallGraph *cg;
   std::unordered_map<CallGraphFunctionNode *, SCCCAGNode *> fromCGNodeToSCC;
@@ -0,0 +1,204 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Yian Su, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/SCCCAG.hpp"
+#include "arcana/noelle/core/FunctionReachabilitySummary.hpp"
+
+namespace arcana::noelle {
+
+FunctionReachabilitySummary::FunctionReachabilitySummary(
+    CallGraph *cg,
+    const std::vector<const Function *> &targets)
+  : targets{ targets },
+    targetIndexes{},
+    sccOfFunction{},
+    reachableTargetsOfSCC{} {
+  assert(cg != nullptr);
+
+  /*
+   * Assign an index to every target.
+   */
+  for (auto i = 0u; i < this->targets.size(); i++) {
+    this->targetIndexes[this->targets[i]] = i;
+  }
+
+  /*
+   * Compute the SCCDAG of the call graph.
+   */
+  SCCCAG sccdag{ cg };
+
+  /*
+   * Assign an index to every SCC and collect the functions it includes.
+   */
+  std::vector<SCCCAGNode *> sccs;
+  std::unordered_map<SCCCAGNode *, uint32_t> sccIndexes;
+  std::vector<std::vector<const Function *>> functionsOfSCC;
+  for (auto node : sccdag.getNodes()) {
+    auto sccIndex = sccs.size();
+    sccIndexes[node] = sccIndex;
+    sccs.push_back(node);
+    functionsOfSCC.push_back({});
+    auto &functions = functionsOfSCC.back();
+    if (node->isAnSCC()) {
+      auto sccNode = static_cast<SCCCAGNode_SCC *>(node);
+      for (auto cgNode : sccNode->getInternalNodes()) {
+        functions.push_back(cgNode->getFunction());
+      }
+    } else {
+      auto functionNode = static_cast<SCCCAGNode_Function *>(node);
+      functions.push_back(functionNode->getNode()->getFunction());
+    }
+    for (auto f : functions) {
+      this->sccOfFunction[f] = sccIndex;
+    }
+  }
+
+  /*
+   * Compute the callees of every SCC.
+   */
+  std::vector<std::vector<uint32_t>> callees(sccs.size());
+  for (auto i = 0u; i < sccs.size(); i++) {
+    for (auto &pair : sccdag.getOutgoingEdges(sccs[i])) {
+      callees[i].push_back(sccIndexes.at(pair.first));
+    }
+  }
+
+  /*
+   * Compute the targets included in every SCC.
+   */
+  std::vector<BitVector> targetsOfSCC(sccs.size(),
+                                      BitVector(this->targets.size(), false));
+  for (auto i = 0u; i < sccs.size(); i++) {
+    for (auto f : functionsOfSCC[i]) {
+      auto it = this->targetIndexes.find(f);
+      if (it != this->targetIndexes.end()) {
+        targetsOfSCC[i].set(it->second);
+      }
+    }
+  }
+
+  /*
+   * Propagate the reachable targets bottom-up.
+   *
+   * SCCs are visited in post-order, so the bitsets of the callees of an SCC
+   * are computed before the bitset of the SCC.
+   * The stack holds the SCCs being visited and the index of the next callee to
+   * visit.
+   */
+  this->reachableTargetsOfSCC.assign(sccs.size(),
+                                     BitVector(this->targets.size(), false));
+  std::vector<bool> visited(sccs.size(), false);
+  std::vector<std::pair<uint32_t, uint32_t>> stack;
+  for (auto root = 0u; root < sccs.size(); root++) {
+    if (visited[root]) {
+      continue;
+    }
+    visited[root] = true;
+    stack.push_back({ root, 0 });
+    while (!stack.empty()) {
+      auto &top = stack.back();
+      auto sccIndex = top.first;
+      if (top.second < callees[sccIndex].size()) {
+        auto callee = callees[sccIndex][top.second];
+        top.second++;
+        if (!visited[callee]) {
+          visited[callee] = true;
+          stack.push_back({ callee, 0 });
+        }
+        continue;
+      }
+      stack.pop_back();
+
+      /*
+       * All callees of the current SCC have been summarized.
+       */
+      auto &reachable = this->reachableTargetsOfSCC[sccIndex];
+      for (auto callee : callees[sccIndex]) {
+        reachable |= this->reachableTargetsOfSCC[callee];
+        reachable |= targetsOfSCC[callee];
+      }
+
+      /*
+       * The functions of a recursive SCC reach each other.
+       */
+      if (sccs[sccIndex]->isAnSCC()) {
+        reachable |= targetsOfSCC[sccIndex];
+      }
+    }
+  }
+
+  return;
+}
+
+bool FunctionReachabilitySummary::canReachATarget(const Function *f) const {
+  auto reachable = this->getReachableTargetsOf(f);
+  if (reachable == nullptr) {
+    return false;
+  }
+
+  return reachable->any();
+}
+
+bool FunctionReachabilitySummary::canReach(const Function *from,
+                                           const Function *target) const {
+  auto it = this->targetIndexes.find(target);
+  if (it == this->targetIndexes.end()) {
+    return false;
+  }
+  auto reachable = this->getReachableTargetsOf(from);
+  if (reachable == nullptr) {
+    return false;
+  }
+
+  return reachable->test(it->second);
+}
+
+std::set<const Function *> FunctionReachabilitySummary::getReachableTargets(
+    const Function *f) const {
+  std::set<const Function *> s;
+
+  auto reachable = this->getReachableTargetsOf(f);
+  if (reachable == nullptr) {
+    return s;
+  }
+  for (auto i : reachable->set_bits()) {
+    s.insert(this->targets[i]);
+  }
+
+  return s;
+}
+
+const std::vector<const Function *> &FunctionReachabilitySummary::getTargets(
+    void) const {
+  return this->targets;
+}
+
+const BitVector *FunctionReachabilitySummary::getReachableTargetsOf(
+    const Function *f) const {
+  auto it = this->sccOfFunction.find(f);
+  if (it == this->sccOfFunction.end()) {
+    return nullptr;
+  }
+
+  return &this->reachableTargetsOfSCC[it->second];
+}
+
+} // namespace arcana::noelle
@@ -316,6 +316,17 @@ SCCCAGEdge *SCCCAG::newEdge(SCCCAGNode *from, SCCCAGNode *to) {
   return newEdge;
 }
 
+SCCCAG::~SCCCAG() {
+  for (auto edge : this->edges) {
+    delete edge;
+  }
+  for (auto node : this->nodes) {
+    delete node;
+  }
+
+  return;
+}
+
 bool SCCCAG::doesItBelongToAnSCC(Function *f) {
 
   /*
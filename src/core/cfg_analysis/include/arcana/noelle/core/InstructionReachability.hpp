@@ -0,0 +1,90 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Yian Su, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_CFG_ANALYSIS_INSTRUCTIONREACHABILITY_H_
+#define NOELLE_SRC_CORE_CFG_ANALYSIS_INSTRUCTIONREACHABILITY_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/LoopStructure.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Reachability between the instructions of a function.
+ *
+ * The reachability is computed once on the condensation of the CFG (i.e., the
+ * DAG of its strongly connected components) with a bitset per component.
+ * Queries are then answered in constant time.
+ *
+ * When it is computed for a loop, the reachability is restricted to a single
+ * iteration of that loop: edges to the loop header are ignored and
+ * instructions outside the loop are never reached.
+ *
+ * Queries about two instructions of the same basic block rely on
+ * Instruction::comesBefore, which caches the order of the instructions within
+ * the block. Hence, concurrent queries are safe only if the order of these
+ * instructions has already been cached.
+ */
+class InstructionReachability {
+public:
+  InstructionReachability(Function &F);
+
+  InstructionReachability(LoopStructure &loop);
+
+  InstructionReachability() = delete;
+
+  /*
+   * Return true if @to can be executed after @from.
+   * This is the case if there is a non-empty path in the CFG from @from to
+   * @to.
+   */
+  bool canReach(Instruction *from, Instruction *to) const;
+
+  /*
+   * Return true if there is a non-empty path in the CFG from @from to @to.
+   */
+  bool canReach(BasicBlock *from, BasicBlock *to) const;
+
+  /*
+   * Return true if @i can be executed again after being executed.
+   */
+  bool isIncludedInACycle(Instruction *i) const;
+
+  Function *getFunction(void) const;
+
+private:
+  Function *function;
+  std::unordered_map<BasicBlock *, uint32_t> blockToSCC;
+
+  /*
+   * The components reachable from a component through at least one edge.
+   * Components are numbered in reverse topological order, so the components
+   * reachable from component C have an ID that is not greater than C.
+   */
+  std::vector<BitVector> reachableSCCs;
+
+  void computeReachability(const std::vector<BasicBlock *> &blocks,
+                           BasicBlock *header);
+};
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_CFG_ANALYSIS_INSTRUCTIONREACHABILITY_H_
@@ -0,0 +1,113 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Yian Su, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_CFG_ANALYSIS_INSTRUCTIONREACHABILITYCACHE_H_
+#define NOELLE_SRC_CORE_CFG_ANALYSIS_INSTRUCTIONREACHABILITYCACHE_H_
+
+#include <list>
+#include <memory>
+#include <mutex>
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/InstructionReachability.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Reachability of the instructions of functions and of loops.
+ *
+ * The reachability is computed the first time it is requested and it is kept
+ * until the code of its function is reported as modified.
+ * The cache keeps the reachability of at most @capacity functions (and of their
+ * loops); the least recently used function is dropped to make room for a new
+ * one.
+ * The cache can be queried by several threads.
+ */
+class InstructionReachabilityCache {
+public:
+  InstructionReachabilityCache(uint64_t capacity);
+
+  InstructionReachabilityCache() = delete;
+
+  InstructionReachabilityCache(const InstructionReachabilityCache &other) =
+      delete;
+
+  /*
+   * Return the reachability of the instructions of @F.
+   */
+  std::shared_ptr<const InstructionReachability> getReachability(Function &F);
+
+  /*
+   * Return the reachability of the instructions of @loop within a single
+   * iteration of @loop.
+   */
+  std::shared_ptr<const InstructionReachability> getReachability(
+      LoopStructure &loop);
+
+  /*
+   * Drop the reachability of @F and of its loops because the code of @F has
+   * been modified.
+   */
+  void invalidate(Function &F);
+
+  /*
+   * Drop everything.
+   */
+  void invalidateAll(void);
+
+  uint64_t getNumberOfHits(void) const;
+
+  uint64_t getNumberOfMisses(void) const;
+
+  uint64_t getNumberOfFunctions(void) const;
+
+  uint64_t getCapacity(void) const;
+
+  static constexpr uint64_t defaultCapacity = 64;
+
+private:
+  mutable std::mutex lock;
+  uint64_t capacity;
+
+  /*
+   * Functions in the cache from the most to the least recently used one.
+   */
+  std::list<Function *> functionsByUse;
+  std::unordered_map<Function *, std::list<Function *>::iterator> uses;
+  std::unordered_map<Function *,
+                     std::shared_ptr<const InstructionReachability>>
+      functions;
+  std::unordered_map<
+      Function *,
+      std::unordered_map<BasicBlock *,
+                         std::shared_ptr<const InstructionReachability>>>
+      loops;
+  uint64_t hits;
+  uint64_t misses;
+
+  void markAsUsed(Function *F);
+
+  void erase(Function *F);
+};
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_CFG_ANALYSIS_INSTRUCTIONREACHABILITYCACHE_H_
@@ -20,7 +20,7 @@
  OR OTHER DEALINGS IN THE SOFTWARE.
  */
 #include "arcana/noelle/core/CFGAnalysis.hpp"
-#include "arcana/noelle/core/DataFlowAnalysis.hpp"
+#include "arcana/noelle/core/InstructionReachability.hpp"
 
 namespace arcana::noelle {
 
@@ -46,28 +46,16 @@ bool CFGAnalysis::isIncludedInACycle(BasicBlock &bb) {
 bool CFGAnalysis::isIncludedInACycle(Instruction &i) {
 
   /*
-   * Compute the reachable analysis.
+   * Compute the reachability of the instructions of the function.
    */
-  DataFlowAnalysis dfa{};
   auto f = i.getFunction();
-  auto filter = [&i](Instruction *inst) -> bool {
-    if (inst == &i) {
-      return true;
-    }
-    return false;
-  };
-  auto dfr = dfa.runReachableAnalysis(f, filter);
+  InstructionReachability reachability(*f);
 
   /*
    * Check if the instruction @i is reachable just after it.
    * If it is, then @i is within a cycle.
    */
-  auto &outSet = dfr->OUT(&i);
-  if (outSet.count(&i) > 0) {
-    return true;
-  }
-
-  return false;
+  return reachability.isIncludedInACycle(&i);
 }
 
 } // namespace arcana::noelle
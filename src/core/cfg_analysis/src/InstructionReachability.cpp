@@ -0,0 +1,258 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Yian Su, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/InstructionReachability.hpp"
+
+namespace arcana::noelle {
+
+InstructionReachability::InstructionReachability(Function &F)
+  : function{ &F } {
+
+  /*
+   * Consider all basic blocks of the function.
+   */
+  std::vector<BasicBlock *> blocks;
+  for (auto &bb : F) {
+    blocks.push_back(&bb);
+  }
+
+  /*
+   * Compute the reachability.
+   */
+  this->computeReachability(blocks, nullptr);
+
+  return;
+}
+
+InstructionReachability::InstructionReachability(LoopStructure &loop)
+  : function{ loop.getFunction() } {
+
+  /*
+   * Consider only the basic blocks of the loop.
+   * They are collected in the order of the function to make the numbering of
+   * the components deterministic.
+   */
+  std::vector<BasicBlock *> blocks;
+  for (auto &bb : *this->function) {
+    if (loop.isIncluded(&bb)) {
+      blocks.push_back(&bb);
+    }
+  }
+
+  /*
+   * Compute the reachability within a single iteration of the loop.
+   */
+  this->computeReachability(blocks, loop.getHeader());
+
+  return;
+}
+
+void InstructionReachability::computeReachability(
+    const std::vector<BasicBlock *> &blocks,
+    BasicBlock *header) {
+
+  /*
+   * Number the basic blocks.
+   */
+  std::unordered_map<BasicBlock *, uint32_t> blockToID;
+  for (auto i = 0u; i < blocks.size(); i++) {
+    blockToID[blocks[i]] = i;
+  }
+
+  /*
+   * Collect the edges between the basic blocks considered.
+   * Edges to @header are skipped.
+   */
+  std::vector<std::vector<uint32_t>> successors(blocks.size());
+  for (auto i = 0u; i < blocks.size(); i++) {
+    for (auto succBB : llvm::successors(blocks[i])) {
+      if (succBB == header) {
+        continue;
+      }
+      auto it = blockToID.find(succBB);
+      if (it == blockToID.end()) {
+        continue;
+      }
+      successors[i].push_back(it->second);
+    }
+  }
+
+  /*
+   * Compute the strongly connected components with the iterative version of
+   * Tarjan's algorithm.
+   * Components are completed in reverse topological order, so the
+   * reachability of a component can be computed as soon as it is completed.
+   */
+  const uint32_t unvisited = std::numeric_limits<uint32_t>::max();
+  std::vector<uint32_t> index(blocks.size(), unvisited);
+  std::vector<uint32_t> lowLink(blocks.size(), 0);
+  std::vector<uint32_t> blockSCC(blocks.size(), unvisited);
+  std::vector<bool> onStack(blocks.size(), false);
+  std::vector<uint32_t> stack;
+  std::vector<std::pair<uint32_t, uint32_t>> work;
+  uint32_t nextIndex = 0;
+  auto visit = [&](uint32_t id) {
+    index[id] = nextIndex;
+    lowLink[id] = nextIndex;
+    nextIndex++;
+    stack.push_back(id);
+    onStack[id] = true;
+    work.push_back(std::make_pair(id, 0));
+  };
+  for (auto root = 0u; root < blocks.size(); root++) {
+    if (index[root] != unvisited) {
+      continue;
+    }
+    visit(root);
+    while (!work.empty()) {
+      auto id = work.back().first;
+
+      /*
+       * Visit the next successor of the current basic block.
+       */
+      auto nextSucc = work.back().second;
+      if (nextSucc < successors[id].size()) {
+        work.back().second++;
+        auto succID = successors[id][nextSucc];
+        if (index[succID] == unvisited) {
+          visit(succID);
+        } else if (onStack[succID]) {
+          lowLink[id] = std::min(lowLink[id], index[succID]);
+        }
+        continue;
+      }
+
+      /*
+       * All successors have been visited.
+       * Check if the current basic block is the root of a component.
+       */
+      work.pop_back();
+      if (!work.empty()) {
+        auto parentID = work.back().first;
+        lowLink[parentID] = std::min(lowLink[parentID], lowLink[id]);
+      }
+      if (lowLink[id] != index[id]) {
+        continue;
+      }
+
+      /*
+       * Pop the component.
+       */
+      uint32_t sccID = this->reachableSCCs.size();
+      std::vector<uint32_t> members;
+      uint32_t member;
+      do {
+        member = stack.back();
+        stack.pop_back();
+        onStack[member] = false;
+        blockSCC[member] = sccID;
+        members.push_back(member);
+      } while (member != id);
+
+      /*
+       * Compute the components reachable from the new one.
+       * The component reaches itself if it includes a cycle.
+       */
+      BitVector reachable(sccID + 1);
+      auto isCyclic = (members.size() > 1);
+      for (auto memberID : members) {
+        for (auto succID : successors[memberID]) {
+          auto succSCC = blockSCC[succID];
+          if (succSCC == sccID) {
+            isCyclic = true;
+            continue;
+          }
+          reachable.set(succSCC);
+          reachable |= this->reachableSCCs[succSCC];
+        }
+      }
+      if (isCyclic) {
+        reachable.set(sccID);
+      }
+      this->reachableSCCs.push_back(std::move(reachable));
+    }
+  }
+
+  /*
+   * Keep the mapping from basic blocks to components.
+   */
+  for (auto i = 0u; i < blocks.size(); i++) {
+    this->blockToSCC[blocks[i]] = blockSCC[i];
+  }
+
+  return;
+}
+
+bool InstructionReachability::canReach(BasicBlock *from, BasicBlock *to) const {
+
+  /*
+   * Fetch the components of the basic blocks.
+   */
+  auto fromIt = this->blockToSCC.find(from);
+  if (fromIt == this->blockToSCC.end()) {
+    return false;
+  }
+  auto toIt = this->blockToSCC.find(to);
+  if (toIt == this->blockToSCC.end()) {
+    return false;
+  }
+
+  /*
+   * Check the reachability between the components.
+   */
+  auto &reachable = this->reachableSCCs[fromIt->second];
+  if (toIt->second >= reachable.size()) {
+    return false;
+  }
+
+  return reachable.test(toIt->second);
+}
+
+bool InstructionReachability::canReach(Instruction *from,
+                                       Instruction *to) const {
+  assert(from != nullptr);
+  assert(to != nullptr);
+
+  /*
+   * Check if @to follows @from within the same basic block.
+   */
+  auto fromBB = from->getParent();
+  auto toBB = to->getParent();
+  if ((fromBB == toBB) && (this->blockToSCC.count(fromBB) > 0)
+      && from->comesBefore(to)) {
+    return true;
+  }
+
+  /*
+   * @to can only be reached by leaving the basic block of @from.
+   */
+  return this->canReach(fromBB, toBB);
+}
+
+bool InstructionReachability::isIncludedInACycle(Instruction *i) const {
+  return this->canReach(i, i);
+}
+
+Function *InstructionReachability::getFunction(void) const {
+  return this->function;
+}
+
+} // namespace arcana::noelle
@@ -0,0 +1,186 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Yian Su, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/InstructionReachabilityCache.hpp"
+
+namespace arcana::noelle {
+
+InstructionReachabilityCache::InstructionReachabilityCache(uint64_t capacity)
+  : capacity{ capacity },
+    hits{ 0 },
+    misses{ 0 } {
+  assert(this->capacity > 0);
+
+  return;
+}
+
+std::shared_ptr<const InstructionReachability> InstructionReachabilityCache::
+    getReachability(Function &F) {
+
+  /*
+   * Check if the reachability has already been computed.
+   */
+  {
+    std::lock_guard<std::mutex> guard(this->lock);
+    auto it = this->functions.find(&F);
+    if (it != this->functions.end()) {
+      this->hits++;
+      this->markAsUsed(&F);
+      return it->second;
+    }
+    this->misses++;
+  }
+
+  /*
+   * Compute the reachability.
+   * The lock is not held while the reachability is computed.
+   */
+  auto reachability = std::make_shared<const InstructionReachability>(F);
+
+  /*
+   * Add the reachability unless another thread has already added it.
+   */
+  std::lock_guard<std::mutex> guard(this->lock);
+  auto result = this->functions.insert(std::make_pair(&F, reachability));
+  auto cachedReachability = result.first->second;
+  this->markAsUsed(&F);
+
+  return cachedReachability;
+}
+
+std::shared_ptr<const InstructionReachability> InstructionReachabilityCache::
+    getReachability(LoopStructure &loop) {
+  auto F = loop.getFunction();
+  auto header = loop.getHeader();
+
+  /*
+   * Check if the reachability has already been computed.
+   */
+  {
+    std::lock_guard<std::mutex> guard(this->lock);
+    auto loopsOfF = this->loops.find(F);
+    if (loopsOfF != this->loops.end()) {
+      auto it = loopsOfF->second.find(header);
+      if (it != loopsOfF->second.end()) {
+        this->hits++;
+        this->markAsUsed(F);
+        return it->second;
+      }
+    }
+    this->misses++;
+  }
+
+  /*
+   * Compute the reachability.
+   * The lock is not held while the reachability is computed.
+   */
+  auto reachability = std::make_shared<const InstructionReachability>(loop);
+
+  /*
+   * Add the reachability unless another thread has already added it.
+   */
+  std::lock_guard<std::mutex> guard(this->lock);
+  auto result = this->loops[F].insert(std::make_pair(header, reachability));
+  auto cachedReachability = result.first->second;
+  this->markAsUsed(F);
+
+  return cachedReachability;
+}
+
+void InstructionReachabilityCache::invalidate(Function &F) {
+  std::lock_guard<std::mutex> guard(this->lock);
+  this->erase(&F);
+
+  return;
+}
+
+void InstructionReachabilityCache::invalidateAll(void) {
+  std::lock_guard<std::mutex> guard(this->lock);
+  this->functions.clear();
+  this->loops.clear();
+  this->functionsByUse.clear();
+  this->uses.clear();
+
+  return;
+}
+
+void InstructionReachabilityCache::markAsUsed(Function *F) {
+
+  /*
+   * Move @F to the front of the list.
+   */
+  auto it = this->uses.find(F);
+  if (it != this->uses.end()) {
+    this->functionsByUse.splice(this->functionsByUse.begin(),
+                                this->functionsByUse,
+                                it->second);
+    return;
+  }
+  this->functionsByUse.push_front(F);
+  this->uses[F] = this->functionsByUse.begin();
+
+  /*
+   * Make room by dropping the least recently used function.
+   * The reachability that has already been returned stays valid because it is
+   * shared with the callers.
+   */
+  if (this->functionsByUse.size() > this->capacity) {
+    this->erase(this->functionsByUse.back());
+  }
+
+  return;
+}
+
+void InstructionReachabilityCache::erase(Function *F) {
+  this->functions.erase(F);
+  this->loops.erase(F);
+  auto it = this->uses.find(F);
+  if (it != this->uses.end()) {
+    this->functionsByUse.erase(it->second);
+    this->uses.erase(it);
+  }
+
+  return;
+}
+
+uint64_t InstructionReachabilityCache::getNumberOfHits(void) const {
+  std::lock_guard<std::mutex> guard(this->lock);
+
+  return this->hits;
+}
+
+uint64_t InstructionReachabilityCache::getNumberOfMisses(void) const {
+  std::lock_guard<std::mutex> guard(this->lock);
+
+  return this->misses;
+}
+
+uint64_t InstructionReachabilityCache::getNumberOfFunctions(void) const {
+  std::lock_guard<std::mutex> guard(this->lock);
+
+  return this->functionsByUse.size();
+}
+
+uint64_t InstructionReachabilityCache::getCapacity(void) const {
+  return this->capacity;
+}
+
+} // namespace arcana::noelle
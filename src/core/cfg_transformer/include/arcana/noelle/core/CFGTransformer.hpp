@@ -30,6 +30,11 @@ class CFGTransformer {
 public:
   CFGTransformer();
 
+  /*
+   * @codeModified is invoked with every function whose code is modified.
+   */
+  CFGTransformer(std::function<void(Function &F)> codeModified);
+
   BasicBlock *branchToANewBasicBlockAndBack(
       Instruction *splitPoint,
       std::string newBasicBlockName,
@@ -45,6 +50,7 @@ public:
           addConditionalBranch);
 
 private:
+  std::function<void(Function &F)> codeModified;
 };
 
 } // namespace arcana::noelle
@@ -23,7 +23,12 @@
 
 namespace arcana::noelle {
 
-CFGTransformer::CFGTransformer() {
+CFGTransformer::CFGTransformer() : codeModified{ [](Function &F) {} } {
+  return;
+}
+
+CFGTransformer::CFGTransformer(std::function<void(Function &F)> codeModified)
+  : codeModified{ codeModified } {
   return;
 }
 
@@ -80,6 +85,11 @@ void CFGTransformer::branchToTargetBasicBlockAndBack(
    */
   addConditionalBranch(&targetBB, newLastBB);
 
+  /*
+   * Notify the change of the code.
+   */
+  this->codeModified(*bb->getParent());
+
   return;
 }
 
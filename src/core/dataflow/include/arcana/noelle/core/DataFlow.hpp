@@ -26,6 +26,7 @@
 
 #include "arcana/noelle/core/DataFlowResult.hpp"
 #include "arcana/noelle/core/DataFlowEngine.hpp"
+#include "arcana/noelle/core/DenseDataFlowEngine.hpp"
 #include "arcana/noelle/core/DataFlowAnalysis.hpp"
 
 #endif // NOELLE_SRC_CORE_DATAFLOW_H_
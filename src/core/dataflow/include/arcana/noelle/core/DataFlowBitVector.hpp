@@ -0,0 +1,221 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_DATAFLOW_DATAFLOWBITVECTOR_H_
+#define NOELLE_SRC_CORE_DATAFLOW_DATAFLOWBITVECTOR_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Set of data-flow elements packed in 64-bit words.
+ *
+ * Set operations work a word at a time without branches, so the compiler can
+ * vectorize them.
+ */
+class DataFlowBitVector {
+public:
+  DataFlowBitVector();
+
+  DataFlowBitVector(uint32_t numberOfBits);
+
+  void resize(uint32_t numberOfBits);
+
+  uint32_t size(void) const;
+
+  uint32_t count(void) const;
+
+  bool empty(void) const;
+
+  bool test(uint32_t bit) const;
+
+  void set(uint32_t bit);
+
+  void reset(uint32_t bit);
+
+  void clear(void);
+
+  /*
+   * this = this U other
+   *
+   * Return true if this set changed.
+   */
+  bool unionWith(const DataFlowBitVector &other);
+
+  /*
+   * this = this - other
+   */
+  void subtract(const DataFlowBitVector &other);
+
+  /*
+   * this = gen U (this - kill)
+   *
+   * Return true if this set changed.
+   */
+  bool transfer(const DataFlowBitVector &gen, const DataFlowBitVector &kill);
+
+  bool operator==(const DataFlowBitVector &other) const;
+
+  bool operator!=(const DataFlowBitVector &other) const;
+
+  /*
+   * Invoke @f for every bit set, in increasing order.
+   */
+  template <class F>
+  void forEachSetBit(F f) const;
+
+private:
+  std::vector<uint64_t> words;
+  uint32_t numberOfBits;
+
+  static uint32_t numberOfWords(uint32_t numberOfBits);
+};
+
+inline DataFlowBitVector::DataFlowBitVector() : numberOfBits{ 0 } {
+  return;
+}
+
+inline DataFlowBitVector::DataFlowBitVector(uint32_t numberOfBits)
+  : words(DataFlowBitVector::numberOfWords(numberOfBits), 0),
+    numberOfBits{ numberOfBits } {
+  return;
+}
+
+inline uint32_t DataFlowBitVector::numberOfWords(uint32_t numberOfBits) {
+  return (numberOfBits + 63) / 64;
+}
+
+inline void DataFlowBitVector::resize(uint32_t numberOfBits) {
+  this->words.resize(DataFlowBitVector::numberOfWords(numberOfBits), 0);
+  this->numberOfBits = numberOfBits;
+}
+
+inline uint32_t DataFlowBitVector::size(void) const {
+  return this->numberOfBits;
+}
+
+inline uint32_t DataFlowBitVector::count(void) const {
+  uint32_t c = 0;
+  for (auto word : this->words) {
+    c += llvm::countPopulation(word);
+  }
+
+  return c;
+}
+
+inline bool DataFlowBitVector::empty(void) const {
+  for (auto word : this->words) {
+    if (word != 0) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+inline bool DataFlowBitVector::test(uint32_t bit) const {
+  assert(bit < this->numberOfBits);
+  return (this->words[bit / 64] >> (bit % 64)) & 1;
+}
+
+inline void DataFlowBitVector::set(uint32_t bit) {
+  assert(bit < this->numberOfBits);
+  this->words[bit / 64] |= (((uint64_t)1) << (bit % 64));
+}
+
+inline void DataFlowBitVector::reset(uint32_t bit) {
+  assert(bit < this->numberOfBits);
+  this->words[bit / 64] &= ~(((uint64_t)1) << (bit % 64));
+}
+
+inline void DataFlowBitVector::clear(void) {
+  std::fill(this->words.begin(), this->words.end(), 0);
+}
+
+inline bool DataFlowBitVector::unionWith(const DataFlowBitVector &other) {
+  assert(this->numberOfBits == other.numberOfBits);
+  uint64_t added = 0;
+  auto w = this->words.data();
+  auto o = other.words.data();
+  auto n = this->words.size();
+  for (auto i = 0u; i < n; i++) {
+    added |= o[i] & ~w[i];
+    w[i] |= o[i];
+  }
+
+  return added != 0;
+}
+
+inline void DataFlowBitVector::subtract(const DataFlowBitVector &other) {
+  assert(this->numberOfBits == other.numberOfBits);
+  auto w = this->words.data();
+  auto o = other.words.data();
+  auto n = this->words.size();
+  for (auto i = 0u; i < n; i++) {
+    w[i] &= ~o[i];
+  }
+}
+
+inline bool DataFlowBitVector::transfer(const DataFlowBitVector &gen,
+                                        const DataFlowBitVector &kill) {
+  assert(this->numberOfBits == gen.numberOfBits);
+  assert(this->numberOfBits == kill.numberOfBits);
+  uint64_t changed = 0;
+  auto w = this->words.data();
+  auto g = gen.words.data();
+  auto k = kill.words.data();
+  auto n = this->words.size();
+  for (auto i = 0u; i < n; i++) {
+    auto newWord = g[i] | (w[i] & ~k[i]);
+    changed |= newWord ^ w[i];
+    w[i] = newWord;
+  }
+
+  return changed != 0;
+}
+
+inline bool DataFlowBitVector::operator==(
+    const DataFlowBitVector &other) const {
+  return (this->numberOfBits == other.numberOfBits)
+         && (this->words == other.words);
+}
+
+inline bool DataFlowBitVector::operator!=(
+    const DataFlowBitVector &other) const {
+  return !(*this == other);
+}
+
+template <class F>
+void DataFlowBitVector::forEachSetBit(F f) const {
+  for (auto i = 0u; i < this->words.size(); i++) {
+    auto word = this->words[i];
+    while (word != 0) {
+      auto bit = llvm::countTrailingZeros(word);
+      f(i * 64 + bit);
+      word &= word - 1;
+    }
+  }
+}
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_DATAFLOW_DATAFLOWBITVECTOR_H_
@@ -34,6 +34,18 @@ public:
    */
   DataFlowEngine();
 
+  /*
+   * If @storeOnlyBlockSummaries is true, only the IN and OUT sets of the first
+   * and the last instructions of every basic block are kept while computing
+   * the fixed point. The sets of the other instructions are computed again,
+   * by replaying their basic block, the first time they are requested from the
+   * result.
+   *
+   * In this mode, computeIN and computeOUT can only access the sets of the
+   * instruction they are invoked on and of the predecessor they are given.
+   */
+  DataFlowEngine(bool storeOnlyBlockSummaries);
+
   DataFlowResult *applyForward(
       Function *f,
       std::function<void(Instruction *, DataFlowResult *)> computeGEN,
@@ -113,8 +125,6 @@ private:
       std::function<void(Instruction *inst,
                          std::set<Value *> &OUT,
                          DataFlowResult *df)> computeOUT,
-      std::function<void(std::list<BasicBlock *> &workingList, BasicBlock *bb)>
-          appendBB,
       std::function<Instruction *(BasicBlock *bb)> getFirstInstruction,
       std::function<Instruction *(BasicBlock *bb)> getLastInstruction,
       std::function<std::set<Value *> &(DataFlowResult *df,
@@ -123,8 +133,9 @@ private:
       std::function<std::set<Value *> &(DataFlowResult *df,
                                         Instruction *instruction)>
           getOutSetOfInst,
-      std::function<BasicBlock::iterator(BasicBlock *)> getEndIterator,
       std::function<void(BasicBlock::iterator &)> incrementIterator);
+
+  bool storeOnlyBlockSummaries;
 };
 
 } // namespace arcana::noelle
@@ -23,6 +23,7 @@
 #define NOELLE_SRC_CORE_DATAFLOW_DATAFLOWRESULT_H_
 
 #include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/DenseDataFlowResult.hpp"
 
 namespace arcana::noelle {
 
@@ -33,16 +34,58 @@ public:
    */
   DataFlowResult();
 
+  /*
+   * Adapter: the IN and OUT sets of the instructions of a basic block are
+   * materialized from @dense, with a single replay of the basic block, the
+   * first time one of them is requested.
+   * Clients that walk the sets of every instruction should use
+   * getDenseResult() instead, which does not materialize any set.
+   */
+  DataFlowResult(std::shared_ptr<DenseDataFlowResult> dense);
+
   std::set<Value *> &GEN(Instruction *inst);
   std::set<Value *> &KILL(Instruction *inst);
   std::set<Value *> &IN(Instruction *inst);
   std::set<Value *> &OUT(Instruction *inst);
 
+  /*
+   * Return the result computed by DenseDataFlowEngine, if this is an adapter.
+   * Return nullptr otherwise.
+   */
+  DenseDataFlowResult *getDenseResult(void) const;
+
+  /*
+   * Number of times a basic block has been processed to compute the fixed
+   * point.
+   */
+  uint64_t getNumberOfBlockIterations(void) const;
+
 private:
   std::map<Instruction *, std::set<Value *>> gens;
   std::map<Instruction *, std::set<Value *>> kills;
   std::map<Instruction *, std::set<Value *>> ins;
   std::map<Instruction *, std::set<Value *>> outs;
+  std::shared_ptr<DenseDataFlowResult> dense;
+  uint64_t blockIterations;
+
+  /*
+   * Recompute the IN and OUT sets of the instructions of a basic block.
+   * It is set by DataFlowEngine when it keeps only the sets at the boundaries
+   * of basic blocks (see DataFlowEngine(bool storeOnlyBlockSummaries)).
+   */
+  std::function<void(BasicBlock *bb, DataFlowResult *df)> replay;
+
+  void replayBasicBlockOf(
+      Instruction *inst,
+      const std::map<Instruction *, std::set<Value *>> &sets);
+
+  void materializeBasicBlockOf(Instruction *inst);
+
+  /*
+   * DataFlowEngine fills the sets, drops the ones within basic blocks, and
+   * sets the replay function.
+   */
+  friend class DataFlowEngine;
 };
 
 } // namespace arcana::noelle
@@ -0,0 +1,80 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Yian Su, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_DATAFLOW_DATAFLOWWORKLIST_H_
+#define NOELLE_SRC_CORE_DATAFLOW_DATAFLOWWORKLIST_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Working list of the basic blocks of a data-flow analysis.
+ *
+ * Basic blocks are identified by their index in @flowsTo, where @flowsTo[b]
+ * lists the basic blocks that the data-flow sets of b flow into (successors for
+ * forward analyses and predecessors for backward ones).
+ *
+ * Basic blocks are popped in reverse post-order of the graph described by
+ * @flowsTo, which is the reverse post-order of the CFG for forward analyses
+ * and the post-order for backward ones. So, a basic block is processed after
+ * the ones that flow into it, except along back edges, and the blocks of an
+ * inner loop are processed again before the ones that follow the loop.
+ * A basic block is never in the list twice.
+ */
+class DataFlowWorkList {
+public:
+  DataFlowWorkList(const std::vector<std::vector<uint32_t>> &flowsTo);
+
+  /*
+   * Add all basic blocks.
+   */
+  void pushAll(void);
+
+  /*
+   * Add @b unless it is already in the list.
+   */
+  void push(uint32_t b);
+
+  /*
+   * Remove and return the basic block that comes first in reverse post-order.
+   */
+  uint32_t pop(void);
+
+  bool empty(void) const;
+
+  /*
+   * Number of basic blocks popped so far.
+   */
+  uint64_t getNumberOfIterations(void) const;
+
+private:
+  std::vector<uint32_t> priorities;
+  std::vector<uint32_t> blocksInOrder;
+  std::vector<bool> isInWorkList;
+  std::priority_queue<uint32_t, std::vector<uint32_t>, std::greater<uint32_t>>
+      workList;
+  uint64_t iterations;
+};
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_DATAFLOW_DATAFLOWWORKLIST_H_
@@ -0,0 +1,213 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_DATAFLOW_DENSEDATAFLOWENGINE_H_
+#define NOELLE_SRC_CORE_DATAFLOW_DENSEDATAFLOWENGINE_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/DataFlowBitVector.hpp"
+#include "arcana/noelle/core/DenseDataFlowResult.hpp"
+#include "arcana/noelle/core/LoopStructure.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Engine for data-flow problems that can be expressed with GEN and KILL sets
+ * and where the meet operator is the set union:
+ *
+ *   forward:  OUT[i] = GEN[i] U (IN[i] - KILL[i]), IN[b] = U OUT[p] for p in
+ *             predecessors(b)
+ *   backward: IN[i] = GEN[i] U (OUT[i] - KILL[i]), OUT[b] = U IN[s] for s in
+ *             successors(b)
+ *
+ * The elements of the sets are given by @domain, which is numbered once.
+ * GEN and KILL of every instruction are requested once through
+ * @computeGENAndKILL, which is inlined in the engine.
+ * The transfer functions of the instructions of a basic block are composed, so
+ * the fixed point is computed at the basic block granularity with bit-vector
+ * operations.
+ */
+class DenseDataFlowEngine {
+public:
+  DenseDataFlowEngine();
+
+  /*
+   * @computeGENAndKILL is invoked as
+   * computeGENAndKILL(Instruction *i, std::vector<Value *> &GEN,
+   *                   std::vector<Value *> &KILL)
+   * Values that do not belong to @domain are ignored.
+   */
+  template <class GENAndKILLFunction>
+  DenseDataFlowResult *applyForward(Function *f,
+                                    const std::vector<Value *> &domain,
+                                    GENAndKILLFunction computeGENAndKILL);
+
+  template <class GENAndKILLFunction>
+  DenseDataFlowResult *applyBackward(Function *f,
+                                     const std::vector<Value *> &domain,
+                                     GENAndKILLFunction computeGENAndKILL);
+
+  /*
+   * Run the analysis only on the basic blocks @blocks of a function.
+   * The work is proportional to the size of @blocks rather than to the one of
+   * the function.
+   *
+   * Edges of the CFG that enter or leave @blocks are ignored.
+   * @boundary flows into the IN of the basic blocks that can be entered from
+   * outside @blocks (forward analyses), or into the OUT of the basic blocks
+   * that can leave @blocks (backward analyses). Basic blocks without
+   * predecessors (forward) or successors (backward) are included.
+   */
+  template <class GENAndKILLFunction>
+  DenseDataFlowResult *applyForward(const std::vector<BasicBlock *> &blocks,
+                                    const std::vector<Value *> &domain,
+                                    const std::vector<Value *> &boundary,
+                                    GENAndKILLFunction computeGENAndKILL);
+
+  template <class GENAndKILLFunction>
+  DenseDataFlowResult *applyBackward(const std::vector<BasicBlock *> &blocks,
+                                     const std::vector<Value *> &domain,
+                                     const std::vector<Value *> &boundary,
+                                     GENAndKILLFunction computeGENAndKILL);
+
+  /*
+   * Run the analysis only on the basic blocks of @loop.
+   * The back edges of @loop are considered.
+   */
+  template <class GENAndKILLFunction>
+  DenseDataFlowResult *applyForward(LoopStructure *loop,
+                                    const std::vector<Value *> &domain,
+                                    const std::vector<Value *> &boundary,
+                                    GENAndKILLFunction computeGENAndKILL);
+
+  template <class GENAndKILLFunction>
+  DenseDataFlowResult *applyBackward(LoopStructure *loop,
+                                     const std::vector<Value *> &domain,
+                                     const std::vector<Value *> &boundary,
+                                     GENAndKILLFunction computeGENAndKILL);
+
+private:
+  template <class GENAndKILLFunction>
+  DenseDataFlowResult *apply(DenseDataFlowResult *r,
+                             GENAndKILLFunction computeGENAndKILL);
+
+  static std::vector<BasicBlock *> getBasicBlocks(LoopStructure *loop);
+
+  void setGENAndKILL(DenseDataFlowResult *r,
+                     Instruction *inst,
+                     const std::vector<Value *> &gen,
+                     const std::vector<Value *> &kill);
+
+  void computeFixedPoint(DenseDataFlowResult *r);
+};
+
+template <class GENAndKILLFunction>
+DenseDataFlowResult *DenseDataFlowEngine::applyForward(
+    Function *f,
+    const std::vector<Value *> &domain,
+    GENAndKILLFunction computeGENAndKILL) {
+  auto r = new DenseDataFlowResult(f, domain, true);
+  return this->apply(r, computeGENAndKILL);
+}
+
+template <class GENAndKILLFunction>
+DenseDataFlowResult *DenseDataFlowEngine::applyBackward(
+    Function *f,
+    const std::vector<Value *> &domain,
+    GENAndKILLFunction computeGENAndKILL) {
+  auto r = new DenseDataFlowResult(f, domain, false);
+  return this->apply(r, computeGENAndKILL);
+}
+
+template <class GENAndKILLFunction>
+DenseDataFlowResult *DenseDataFlowEngine::applyForward(
+    const std::vector<BasicBlock *> &blocks,
+    const std::vector<Value *> &domain,
+    const std::vector<Value *> &boundary,
+    GENAndKILLFunction computeGENAndKILL) {
+  auto r = new DenseDataFlowResult(blocks, domain, boundary, true);
+  return this->apply(r, computeGENAndKILL);
+}
+
+template <class GENAndKILLFunction>
+DenseDataFlowResult *DenseDataFlowEngine::applyBackward(
+    const std::vector<BasicBlock *> &blocks,
+    const std::vector<Value *> &domain,
+    const std::vector<Value *> &boundary,
+    GENAndKILLFunction computeGENAndKILL) {
+  auto r = new DenseDataFlowResult(blocks, domain, boundary, false);
+  return this->apply(r, computeGENAndKILL);
+}
+
+template <class GENAndKILLFunction>
+DenseDataFlowResult *DenseDataFlowEngine::applyForward(
+    LoopStructure *loop,
+    const std::vector<Value *> &domain,
+    const std::vector<Value *> &boundary,
+    GENAndKILLFunction computeGENAndKILL) {
+  return this->applyForward(DenseDataFlowEngine::getBasicBlocks(loop),
+                            domain,
+                            boundary,
+                            computeGENAndKILL);
+}
+
+template <class GENAndKILLFunction>
+DenseDataFlowResult *DenseDataFlowEngine::applyBackward(
+    LoopStructure *loop,
+    const std::vector<Value *> &domain,
+    const std::vector<Value *> &boundary,
+    GENAndKILLFunction computeGENAndKILL) {
+  return this->applyBackward(DenseDataFlowEngine::getBasicBlocks(loop),
+                             domain,
+                             boundary,
+                             computeGENAndKILL);
+}
+
+template <class GENAndKILLFunction>
+DenseDataFlowResult *DenseDataFlowEngine::apply(
+    DenseDataFlowResult *r,
+    GENAndKILLFunction computeGENAndKILL) {
+
+  /*
+   * Compute GEN and KILL of every instruction.
+   */
+  std::vector<Value *> gen;
+  std::vector<Value *> kill;
+  for (auto bb : r->blocks) {
+    for (auto &inst : *bb) {
+      gen.clear();
+      kill.clear();
+      computeGENAndKILL(&inst, gen, kill);
+      this->setGENAndKILL(r, &inst, gen, kill);
+    }
+  }
+
+  /*
+   * Compute IN and OUT of every basic block.
+   */
+  this->computeFixedPoint(r);
+
+  return r;
+}
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_DATAFLOW_DENSEDATAFLOWENGINE_H_
@@ -0,0 +1,140 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_DATAFLOW_DENSEDATAFLOWRESULT_H_
+#define NOELLE_SRC_CORE_DATAFLOW_DENSEDATAFLOWRESULT_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/DataFlowBitVector.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Result of a data-flow analysis computed by DenseDataFlowEngine.
+ *
+ * The elements of the data-flow sets are numbered once and sets are stored as
+ * bit vectors.
+ * Only the IN and OUT sets of basic blocks are stored.
+ * IN and OUT sets of instructions are computed when requested by replaying the
+ * transfer functions of the instructions of their basic block.
+ *
+ * IN is the set at the beginning of an instruction (or basic block) and OUT is
+ * the set at its end following the program order, independently of the
+ * direction of the analysis.
+ */
+class DenseDataFlowResult {
+public:
+  DenseDataFlowResult(Function *f,
+                      const std::vector<Value *> &domain,
+                      bool isForward);
+
+  /*
+   * Result restricted to the basic blocks @blocks of a function, where
+   * @boundary flows into them from the rest of the function.
+   */
+  DenseDataFlowResult(const std::vector<BasicBlock *> &blocks,
+                      const std::vector<Value *> &domain,
+                      const std::vector<Value *> &boundary,
+                      bool isForward);
+
+  Function *getFunction(void) const;
+
+  /*
+   * Return true if the sets of @bb have been computed.
+   */
+  bool isIncluded(BasicBlock *bb) const;
+
+  const DataFlowBitVector &getBoundary(void) const;
+
+  bool isForward(void) const;
+
+  /*
+   * Elements of the data-flow sets.
+   */
+  uint32_t getDomainSize(void) const;
+
+  Value *getElement(uint32_t elementID) const;
+
+  bool isInDomain(Value *v) const;
+
+  uint32_t getElementID(Value *v) const;
+
+  /*
+   * Sets of basic blocks.
+   */
+  const DataFlowBitVector &IN(BasicBlock *bb) const;
+
+  const DataFlowBitVector &OUT(BasicBlock *bb) const;
+
+  /*
+   * Sets of instructions.
+   */
+  DataFlowBitVector GEN(Instruction *inst) const;
+
+  DataFlowBitVector KILL(Instruction *inst) const;
+
+  DataFlowBitVector IN(Instruction *inst) const;
+
+  DataFlowBitVector OUT(Instruction *inst) const;
+
+  /*
+   * Invoke @f with the IN and OUT sets of every instruction of @bb following
+   * the program order.
+   * This costs a single replay of @bb.
+   */
+  void expand(BasicBlock *bb,
+              std::function<void(Instruction *inst,
+                                 const DataFlowBitVector &IN,
+                                 const DataFlowBitVector &OUT)> f) const;
+
+  /*
+   * Conversion to sets of values.
+   */
+  std::set<Value *> toSet(const DataFlowBitVector &bv) const;
+
+  uint64_t getNumberOfBlockIterations(void) const;
+
+private:
+  Function *f;
+  bool forward;
+  std::vector<Value *> domain;
+  std::unordered_map<Value *, uint32_t> elementIDs;
+  std::vector<BasicBlock *> blocks;
+  std::unordered_map<BasicBlock *, uint32_t> blockIDs;
+  DataFlowBitVector boundary;
+  std::vector<DataFlowBitVector> ins;
+  std::vector<DataFlowBitVector> outs;
+  std::unordered_map<Instruction *, uint32_t> instructionIDs;
+  std::vector<std::vector<uint32_t>> gens;
+  std::vector<std::vector<uint32_t>> kills;
+  uint64_t blockIterations;
+
+  void initialize(const std::vector<BasicBlock *> &blocks,
+                  const std::vector<Value *> &boundary);
+
+  void applyTransfer(Instruction *inst, DataFlowBitVector &bv) const;
+
+  friend class DenseDataFlowEngine;
+};
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_DATAFLOW_DENSEDATAFLOWRESULT_H_
@@ -49,56 +49,46 @@ DataFlowResult *DataFlowAnalysis::runReachableAnalysis(
   /*
    * Allocate the engine
    */
-  auto dfa = DataFlowEngine{};
+  auto dfa = DenseDataFlowEngine{};
+
+  /*
+   * Collect the instructions that should be considered.
+   */
+  std::vector<Value *> domain;
+  for (auto &inst : instructions(*f)) {
+    if (filter(&inst)) {
+      domain.push_back(&inst);
+    }
+  }
 
   /*
    * Define the data-flow equations
+   *
+   * IN[i] = GEN[i] U OUT[i]
+   * OUT[i] = U IN[s] for s in successors(i)
    */
-  auto computeGEN = [filter](Instruction *i, DataFlowResult *df) {
-    /*
-     * Check if the instruction should be considered.
-     */
+  auto computeGENAndKILL = [filter](Instruction *i,
+                                    std::vector<Value *> &GEN,
+                                    std::vector<Value *> &KILL) {
     if (!filter(i)) {
       return;
     }
-
-    /*
-     * Add the instruction to the GEN set.
-     */
-    auto &gen = df->GEN(i);
-    gen.insert(i);
+    GEN.push_back(i);
 
     return;
   };
-  auto computeKILL = [](Instruction *, DataFlowResult *) { return; };
-  auto computeOUT = [](Instruction *inst,
-                       Instruction *succ,
-                       std::set<Value *> &OUT,
-                       DataFlowResult *df) {
-    auto &inS = df->IN(succ);
-    OUT.insert(inS.begin(), inS.end());
-    return;
-  };
-  auto computeIN =
-      [](Instruction *inst, std::set<Value *> &IN, DataFlowResult *df) {
-        auto &genI = df->GEN(inst);
-        auto &outI = df->OUT(inst);
-
-        /*
-         * IN[i] = GEN[i] U OUT[i]
-         */
-        IN.insert(genI.begin(), genI.end());
-        IN.insert(outI.begin(), outI.end());
-
-        return;
-      };
 
   /*
    * Run the data flow analysis needed to identify the instructions that could
    * be executed from a given point.
    */
+  auto denseDF = dfa.applyBackward(f, domain, computeGENAndKILL);
+
+  /*
+   * Wrap the dense result to expose the set-based interface.
+   */
   auto df =
-      dfa.applyBackward(f, computeGEN, computeKILL, computeIN, computeOUT);
+      new DataFlowResult(std::shared_ptr<DenseDataFlowResult>(denseDF));
 
   return df;
 }
@@ -20,10 +20,16 @@
  OR OTHER DEALINGS IN THE SOFTWARE.
  */
 #include "arcana/noelle/core/DataFlowEngine.hpp"
+#include "arcana/noelle/core/DataFlowWorkList.hpp"
 
 namespace arcana::noelle {
 
-DataFlowEngine::DataFlowEngine() {
+DataFlowEngine::DataFlowEngine() : DataFlowEngine(false) {
+  return;
+}
+
+DataFlowEngine::DataFlowEngine(bool storeOnlyBlockSummaries)
+  : storeOnlyBlockSummaries{ storeOnlyBlockSummaries } {
   return;
 }
 
@@ -78,10 +84,6 @@ DataFlowResult *DataFlowEngine::applyForward(
   /*
    * Define the customization.
    */
-  auto appendBB = [](std::list<BasicBlock *> &workingList, BasicBlock *bb) {
-    workingList.push_back(bb);
-  };
-
   auto getFirstInst = [](BasicBlock *bb) -> Instruction * {
     return &*bb->begin();
   };
@@ -116,10 +118,6 @@ DataFlowResult *DataFlowEngine::applyForward(
     return df->OUT(inst);
   };
 
-  auto getEndIterator = [](BasicBlock *bb) -> BasicBlock::iterator {
-    return bb->end();
-  };
-
   auto incrementIterator = [](BasicBlock::iterator &iter) { iter++; };
 
   /*
@@ -135,12 +133,10 @@ DataFlowResult *DataFlowEngine::applyForward(
                                                    getSuccessors,
                                                    computeIN,
                                                    computeOUT,
-                                                   appendBB,
                                                    getFirstInst,
                                                    getLastInst,
                                                    inSetOfInst,
                                                    outSetOfInst,
-                                                   getEndIterator,
                                                    incrementIterator);
   return dfa;
 }
@@ -185,10 +181,6 @@ DataFlowResult *DataFlowEngine::applyBackward(
   /*
    * Define the customization
    */
-  auto appendBB = [](std::list<BasicBlock *> &workingList, BasicBlock *bb) {
-    workingList.push_front(bb);
-  };
-
   auto getPredecessors = [](BasicBlock *bb) -> std::list<BasicBlock *> {
     std::list<BasicBlock *> Successors;
     for (auto predecessor : successors(bb)) {
@@ -229,10 +221,6 @@ DataFlowResult *DataFlowEngine::applyBackward(
     return df->IN(inst);
   };
 
-  auto getEndIterator = [](BasicBlock *bb) -> BasicBlock::iterator {
-    return bb->begin();
-  };
-
   auto incrementIterator = [](BasicBlock::iterator &iter) { iter--; };
 
   auto dfr = this->applyGeneralizedForwardAnalysis(f,
@@ -244,12 +232,10 @@ DataFlowResult *DataFlowEngine::applyBackward(
                                                    getSuccessors,
                                                    computeOUT,
                                                    computeIN,
-                                                   appendBB,
                                                    getFirstInst,
                                                    getLastInst,
                                                    inSetOfInst,
                                                    outSetOfInst,
-                                                   getEndIterator,
                                                    incrementIterator);
 
   return dfr;
@@ -290,8 +276,6 @@ DataFlowResult *DataFlowEngine::applyGeneralizedForwardAnalysis(
     std::function<void(Instruction *inst,
                        std::set<Value *> &OUT,
                        DataFlowResult *df)> computeOUT,
-    std::function<void(std::list<BasicBlock *> &workingList, BasicBlock *bb)>
-        appendBB,
     std::function<Instruction *(BasicBlock *bb)> getFirstInstruction,
     std::function<Instruction *(BasicBlock *bb)> getLastInstruction,
     std::function<std::set<Value *> &(DataFlowResult *df,
@@ -299,19 +283,32 @@ DataFlowResult *DataFlowEngine::applyGeneralizedForwardAnalysis(
     std::function<std::set<Value *> &(DataFlowResult *df,
                                       Instruction *instruction)>
         getOutSetOfInst,
-    std::function<BasicBlock::iterator(BasicBlock *)> getEndIterator,
     std::function<void(BasicBlock::iterator &)> incrementIterator) {
 
   /*
    * Initialize IN and OUT sets.
+   * Only the sets at the boundaries of basic blocks are kept when only the
+   * summaries of basic blocks are stored.
    */
   auto df = new DataFlowResult{};
+  auto initializeSets = [df, &initializeIN, &initializeOUT](Instruction *i) {
+    auto &INSet = df->IN(i);
+    auto &OUTSet = df->OUT(i);
+    initializeIN(i, INSet);
+    initializeOUT(i, OUTSet);
+  };
   for (auto &bb : *f) {
+    if (this->storeOnlyBlockSummaries) {
+      auto firstInst = getFirstInstruction(&bb);
+      auto lastInst = getLastInstruction(&bb);
+      initializeSets(firstInst);
+      if (lastInst != firstInst) {
+        initializeSets(lastInst);
+      }
+      continue;
+    }
     for (auto &i : bb) {
-      auto &INSet = df->IN(&i);
-      auto &OUTSet = df->OUT(&i);
-      initializeIN(&i, INSet);
-      initializeOUT(&i, OUTSet);
+      initializeSets(&i);
     }
   }
 
@@ -320,32 +317,107 @@ DataFlowResult *DataFlowEngine::applyGeneralizedForwardAnalysis(
    */
   computeGENAndKILL(f, computeGEN, computeKILL, df);
 
+  /*
+   * Define how the OUT of the first instruction of a basic block is propagated
+   * to the rest of the instructions of the basic block.
+   */
+  auto storeOnlyBlockSummaries = this->storeOnlyBlockSummaries;
+  auto propagateWithinBasicBlock = [storeOnlyBlockSummaries,
+                                    initializeIN,
+                                    initializeOUT,
+                                    computeIN,
+                                    computeOUT,
+                                    getFirstInstruction,
+                                    getLastInstruction,
+                                    getInSetOfInst,
+                                    getOutSetOfInst,
+                                    incrementIterator](BasicBlock *bb,
+                                                       DataFlowResult *df) {
+    auto inst = getFirstInstruction(bb);
+    auto lastInst = getLastInstruction(bb);
+    BasicBlock::iterator iter(inst);
+    auto predI = inst;
+    while (predI != lastInst) {
+
+      /*
+       * Move the iterator.
+       */
+      incrementIterator(iter);
+
+      /*
+       * Fetch the current instruction.
+       */
+      auto i = &*iter;
+
+      /*
+       * The sets of the instructions within the basic block are not kept, so
+       * they start from their initial value.
+       */
+      if (storeOnlyBlockSummaries && (i != lastInst)) {
+        initializeIN(i, df->IN(i));
+        initializeOUT(i, df->OUT(i));
+      }
+
+      /*
+       * Compute IN[i]
+       */
+      auto &inSetOfI = getInSetOfInst(df, i);
+      computeIN(i, predI, inSetOfI, df);
+
+      /*
+       * Compute OUT[i]
+       */
+      auto &outSetOfI = getOutSetOfInst(df, i);
+      computeOUT(i, outSetOfI, df);
+
+      /*
+       * Update the predecessor.
+       */
+      predI = i;
+    }
+  };
+
+  /*
+   * Number the basic blocks and fetch the ones that flow into each of them and
+   * the ones that each of them flows into.
+   */
+  std::vector<BasicBlock *> blocks;
+  std::unordered_map<BasicBlock *, uint32_t> blockIDs;
+  for (auto &bb : *f) {
+    blockIDs[&bb] = blocks.size();
+    blocks.push_back(&bb);
+  }
+  std::vector<std::vector<uint32_t>> flowsFrom(blocks.size());
+  std::vector<std::vector<uint32_t>> flowsTo(blocks.size());
+  for (auto b = 0u; b < blocks.size(); b++) {
+    for (auto predecessorBB : getPredecessors(blocks[b])) {
+      flowsFrom[b].push_back(blockIDs.at(predecessorBB));
+    }
+    for (auto succBB : getSuccessors(blocks[b])) {
+      flowsTo[b].push_back(blockIDs.at(succBB));
+    }
+  }
+
   /*
    * Compute the IN and OUT
    *
    * Create the working list by adding all basic blocks to it.
    */
-  std::list<BasicBlock *> workingList;
-  for (auto &bb : *f) {
-    appendBB(workingList, &bb);
-  }
+  DataFlowWorkList workList(flowsTo);
+  workList.pushAll();
 
   /*
    * Compute the INs and OUTs iteratively until the working list is empty.
    */
-  std::unordered_set<BasicBlock *> computedOnce;
-
-  while (!workingList.empty()) {
-
-    /*
-     * Fetch a basic block that needs to be processed.
-     */
-    auto bb = workingList.front();
+  std::vector<bool> computedOnce(blocks.size(), false);
+  while (!workList.empty()) {
 
     /*
-     * Remove the basic block from the workingList.
+     * Fetch a basic block that needs to be processed and remove it from the
+     * working list.
      */
-    workingList.pop_front();
+    auto b = workList.pop();
+    auto bb = blocks[b];
 
     /*
      * Fetch the first instruction of the basic block.
@@ -361,12 +433,12 @@ DataFlowResult *DataFlowEngine::applyGeneralizedForwardAnalysis(
     /*
      * Compute the IN of the first instruction of the current basic block.
      */
-    for (auto predecessorBB : getPredecessors(bb)) {
+    for (auto predecessor : flowsFrom[b]) {
 
       /*
        * Fetch the current predecessor of "inst".
        */
-      auto predecessorInst = getLastInstruction(predecessorBB);
+      auto predecessorInst = getLastInstruction(blocks[predecessor]);
 
       /*
        * Compute IN[inst]
@@ -382,56 +454,49 @@ DataFlowResult *DataFlowEngine::applyGeneralizedForwardAnalysis(
 
     /* Check if the OUT of the first instruction of the current basic block
      * changed.
+     * Sets can only grow, so a change is detected by their size.
      */
-    if ((computedOnce.find(bb) == computedOnce.end())
-        || (outSetOfInst.size() != oldSizeOut)) {
+    if ((!computedOnce[b]) || (outSetOfInst.size() != oldSizeOut)) {
 
-      computedOnce.insert(bb);
+      computedOnce[b] = true;
 
       /*
        * Propagate the new OUT[inst] to the rest of the instructions of the
        * current basic block.
        */
-      BasicBlock::iterator iter(inst);
-      auto predI = cast<Instruction>(inst);
-      while (iter != getEndIterator(bb)) {
-
-        /*
-         * Move the iterator.
-         */
-        incrementIterator(iter);
-
-        /*
-         * Fetch the current instruction.
-         */
-        auto i = &*iter;
-
-        /*
-         * Compute IN[i]
-         */
-        auto &inSetOfI = getInSetOfInst(df, i);
-        computeIN(i, predI, inSetOfI, df);
-
-        /*
-         * Compute OUT[i]
-         */
-        auto &outSetOfI = getOutSetOfInst(df, i);
-        computeOUT(i, outSetOfI, df);
-
-        /*
-         * Update the predecessor.
-         */
-        predI = i;
+      propagateWithinBasicBlock(bb, df);
+
+      /*
+       * Drop the sets of the instructions within the basic block.
+       */
+      if (this->storeOnlyBlockSummaries) {
+        auto lastInst = getLastInstruction(bb);
+        for (auto &i : *bb) {
+          if ((&i == inst) || (&i == lastInst)) {
+            continue;
+          }
+          df->ins.erase(&i);
+          df->outs.erase(&i);
+        }
       }
 
       /*
        * Add successors of the current basic block to the working list.
        */
-      for (auto succBB : getSuccessors(bb)) {
-        workingList.push_back(succBB);
+      for (auto successor : flowsTo[b]) {
+        workList.push(successor);
       }
     }
   }
+  df->blockIterations = workList.getNumberOfIterations();
+
+  /*
+   * The sets of the instructions within basic blocks are computed when they
+   * are requested.
+   */
+  if (this->storeOnlyBlockSummaries) {
+    df->replay = propagateWithinBasicBlock;
+  }
 
   return df;
 }
@@ -23,32 +23,118 @@
 
 namespace arcana::noelle {
 
-DataFlowResult::DataFlowResult() {
+DataFlowResult::DataFlowResult()
+  : dense{ nullptr },
+    blockIterations{ 0 },
+    replay{ nullptr } {
+  return;
+}
+
+DataFlowResult::DataFlowResult(std::shared_ptr<DenseDataFlowResult> dense)
+  : dense{ dense },
+    blockIterations{ 0 },
+    replay{ nullptr } {
+  return;
+}
+
+DenseDataFlowResult *DataFlowResult::getDenseResult(void) const {
+  return this->dense.get();
+}
+
+uint64_t DataFlowResult::getNumberOfBlockIterations(void) const {
+  if (this->dense != nullptr) {
+    return this->dense->getNumberOfBlockIterations();
+  }
+
+  return this->blockIterations;
+}
+
+void DataFlowResult::materializeBasicBlockOf(Instruction *inst) {
+
+  /*
+   * Check if the sets need to be materialized.
+   */
+  if ((this->dense == nullptr) || (this->ins.find(inst) != this->ins.end())) {
+    return;
+  }
+
+  /*
+   * Materialize the sets of all the instructions of the basic block with a
+   * single replay.
+   */
+  auto bb = inst->getParent();
+  this->dense->expand(bb,
+                      [this](Instruction *i,
+                             const DataFlowBitVector &IN,
+                             const DataFlowBitVector &OUT) {
+                        this->ins[i] = this->dense->toSet(IN);
+                        this->outs[i] = this->dense->toSet(OUT);
+                      });
+
+  return;
+}
+
+void DataFlowResult::replayBasicBlockOf(
+    Instruction *inst,
+    const std::map<Instruction *, std::set<Value *>> &sets) {
+
+  /*
+   * Check if the set needs to be computed.
+   */
+  if ((this->replay == nullptr) || (sets.find(inst) != sets.end())) {
+    return;
+  }
+
+  /*
+   * Compute the sets of the instructions of the basic block.
+   * The sets accessed while replaying the basic block must not be replayed.
+   */
+  auto replay = std::move(this->replay);
+  this->replay = nullptr;
+  replay(inst->getParent(), this);
+  this->replay = std::move(replay);
+
   return;
 }
 
 std::set<Value *> &DataFlowResult::GEN(Instruction *inst) {
+  auto it = this->gens.find(inst);
+  if (it != this->gens.end()) {
+    return it->second;
+  }
   auto &s = this->gens[inst];
+  if (this->dense != nullptr) {
+    s = this->dense->toSet(this->dense->GEN(inst));
+  }
 
   return s;
 }
 
 std::set<Value *> &DataFlowResult::KILL(Instruction *inst) {
+  auto it = this->kills.find(inst);
+  if (it != this->kills.end()) {
+    return it->second;
+  }
   auto &s = this->kills[inst];
+  if (this->dense != nullptr) {
+    s = this->dense->toSet(this->dense->KILL(inst));
+  }
 
   return s;
 }
 
 std::set<Value *> &DataFlowResult::IN(Instruction *inst) {
-  auto &s = this->ins[inst];
+  this->replayBasicBlockOf(inst, this->ins);
+  this->materializeBasicBlockOf(inst);
 
-  return s;
+  return this->ins[inst];
 }
 
 std::set<Value *> &DataFlowResult::OUT(Instruction *inst) {
-  auto &s = this->outs[inst];
+  this->replayBasicBlockOf(inst, this->outs);
+  this->materializeBasicBlockOf(inst);
 
-  return s;
+  return this->outs[inst];
 }
 
 } // namespace arcana::noelle
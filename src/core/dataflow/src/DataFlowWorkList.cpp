@@ -0,0 +1,132 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Yian Su, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/DataFlowWorkList.hpp"
+
+namespace arcana::noelle {
+
+DataFlowWorkList::DataFlowWorkList(
+    const std::vector<std::vector<uint32_t>> &flowsTo)
+  : priorities(flowsTo.size(), 0),
+    isInWorkList(flowsTo.size(), false),
+    iterations{ 0 } {
+  auto numberOfBlocks = flowsTo.size();
+
+  /*
+   * Identify the basic blocks that nothing flows into.
+   * The visit starts from them, and then from any basic block not yet visited
+   * (e.g., unreachable ones).
+   */
+  std::vector<bool> hasIncomingFlows(numberOfBlocks, false);
+  for (auto b = 0u; b < numberOfBlocks; b++) {
+    for (auto other : flowsTo[b]) {
+      hasIncomingFlows[other] = true;
+    }
+  }
+  std::vector<uint32_t> roots;
+  for (auto b = 0u; b < numberOfBlocks; b++) {
+    if (!hasIncomingFlows[b]) {
+      roots.push_back(b);
+    }
+  }
+  for (auto b = 0u; b < numberOfBlocks; b++) {
+    if (hasIncomingFlows[b]) {
+      roots.push_back(b);
+    }
+  }
+
+  /*
+   * Compute the post-order with an iterative depth-first visit.
+   */
+  std::vector<uint32_t> postOrder;
+  postOrder.reserve(numberOfBlocks);
+  std::vector<bool> visited(numberOfBlocks, false);
+  std::vector<std::pair<uint32_t, uint32_t>> stack;
+  for (auto root : roots) {
+    if (visited[root]) {
+      continue;
+    }
+    visited[root] = true;
+    stack.push_back(std::make_pair(root, 0));
+    while (!stack.empty()) {
+      auto &[b, nextFlow] = stack.back();
+      if (nextFlow < flowsTo[b].size()) {
+        auto other = flowsTo[b][nextFlow];
+        nextFlow++;
+        if (!visited[other]) {
+          visited[other] = true;
+          stack.push_back(std::make_pair(other, 0));
+        }
+        continue;
+      }
+      postOrder.push_back(b);
+      stack.pop_back();
+    }
+  }
+
+  /*
+   * Assign the priorities following the reverse post-order.
+   */
+  this->blocksInOrder.assign(postOrder.rbegin(), postOrder.rend());
+  for (auto i = 0u; i < numberOfBlocks; i++) {
+    this->priorities[this->blocksInOrder[i]] = i;
+  }
+
+  return;
+}
+
+void DataFlowWorkList::pushAll(void) {
+  for (auto b = 0u; b < this->priorities.size(); b++) {
+    this->push(b);
+  }
+
+  return;
+}
+
+void DataFlowWorkList::push(uint32_t b) {
+  if (this->isInWorkList[b]) {
+    return;
+  }
+  this->isInWorkList[b] = true;
+  this->workList.push(this->priorities[b]);
+
+  return;
+}
+
+uint32_t DataFlowWorkList::pop(void) {
+  assert(!this->workList.empty());
+  auto b = this->blocksInOrder[this->workList.top()];
+  this->workList.pop();
+  this->isInWorkList[b] = false;
+  this->iterations++;
+
+  return b;
+}
+
+bool DataFlowWorkList::empty(void) const {
+  return this->workList.empty();
+}
+
+uint64_t DataFlowWorkList::getNumberOfIterations(void) const {
+  return this->iterations;
+}
+
+} // namespace arcana::noelle
@@ -0,0 +1,207 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/DenseDataFlowEngine.hpp"
+#include "arcana/noelle/core/DataFlowWorkList.hpp"
+
+namespace arcana::noelle {
+
+DenseDataFlowEngine::DenseDataFlowEngine() {
+  return;
+}
+
+std::vector<BasicBlock *> DenseDataFlowEngine::getBasicBlocks(
+    LoopStructure *loop) {
+  assert(loop != nullptr);
+
+  /*
+   * Collect the basic blocks in the order of the function to make the
+   * numbering deterministic.
+   */
+  std::vector<BasicBlock *> blocks;
+  for (auto &bb : *loop->getFunction()) {
+    if (loop->isIncluded(&bb)) {
+      blocks.push_back(&bb);
+    }
+  }
+
+  return blocks;
+}
+
+void DenseDataFlowEngine::setGENAndKILL(DenseDataFlowResult *r,
+                                        Instruction *inst,
+                                        const std::vector<Value *> &gen,
+                                        const std::vector<Value *> &kill) {
+  auto instID = r->instructionIDs.at(inst);
+
+  /*
+   * Translate the values into the IDs of the elements of the domain.
+   */
+  auto translate = [r](const std::vector<Value *> &values,
+                       std::vector<uint32_t> &elementIDs) {
+    for (auto v : values) {
+      auto it = r->elementIDs.find(v);
+      if (it == r->elementIDs.end()) {
+        continue;
+      }
+      elementIDs.push_back(it->second);
+    }
+  };
+  translate(gen, r->gens[instID]);
+  translate(kill, r->kills[instID]);
+
+  return;
+}
+
+void DenseDataFlowEngine::computeFixedPoint(DenseDataFlowResult *r) {
+  auto numberOfBlocks = r->blocks.size();
+  auto domainSize = r->getDomainSize();
+
+  /*
+   * Compose the transfer functions of the instructions of every basic block.
+   *
+   * GEN[b] = GEN[i] U (GEN[b] - KILL[i])
+   * KILL[b] = KILL[b] U KILL[i]
+   */
+  std::vector<DataFlowBitVector> blockGENs(numberOfBlocks,
+                                           DataFlowBitVector(domainSize));
+  std::vector<DataFlowBitVector> blockKILLs(numberOfBlocks,
+                                            DataFlowBitVector(domainSize));
+  for (auto b = 0u; b < numberOfBlocks; b++) {
+    auto &gen = blockGENs[b];
+    auto &kill = blockKILLs[b];
+    auto compose = [r, &gen, &kill](Instruction &inst) {
+      auto instID = r->instructionIDs.at(&inst);
+      for (auto elementID : r->kills[instID]) {
+        gen.reset(elementID);
+        kill.set(elementID);
+      }
+      for (auto elementID : r->gens[instID]) {
+        gen.set(elementID);
+      }
+    };
+    auto bb = r->blocks[b];
+    if (r->forward) {
+      for (auto &inst : *bb) {
+        compose(inst);
+      }
+    } else {
+      for (auto &inst : reverse(*bb)) {
+        compose(inst);
+      }
+    }
+  }
+
+  /*
+   * Fetch the basic blocks that flow into a basic block (predecessors for
+   * forward analyses and successors for backward ones) and the ones that a
+   * basic block flows into.
+   */
+  std::vector<std::vector<uint32_t>> flowsFrom(numberOfBlocks);
+  std::vector<std::vector<uint32_t>> flowsTo(numberOfBlocks);
+  for (auto b = 0u; b < numberOfBlocks; b++) {
+    for (auto succBB : successors(r->blocks[b])) {
+      auto it = r->blockIDs.find(succBB);
+      if (it == r->blockIDs.end()) {
+        continue;
+      }
+      auto s = it->second;
+      if (r->forward) {
+        flowsFrom[s].push_back(b);
+        flowsTo[b].push_back(s);
+      } else {
+        flowsFrom[b].push_back(s);
+        flowsTo[s].push_back(b);
+      }
+    }
+  }
+
+  /*
+   * The sets that the meet operator computes and the ones that the transfer
+   * functions compute.
+   */
+  auto &meetSets = r->forward ? r->ins : r->outs;
+  auto &transferSets = r->forward ? r->outs : r->ins;
+
+  /*
+   * The boundary flows into the basic blocks that can be entered from outside
+   * the ones analyzed (forward analyses) or that can leave them (backward
+   * analyses).
+   */
+  if (!r->boundary.empty()) {
+    auto isOutside = [r](BasicBlock *other) -> bool {
+      return !r->isIncluded(other);
+    };
+    for (auto b = 0u; b < numberOfBlocks; b++) {
+      auto bb = r->blocks[b];
+      auto isBoundary =
+          r->forward ? (pred_empty(bb) || any_of(predecessors(bb), isOutside))
+                     : (succ_empty(bb) || any_of(successors(bb), isOutside));
+      if (isBoundary) {
+        meetSets[b].unionWith(r->boundary);
+      }
+    }
+  }
+
+  /*
+   * Add all basic blocks to the working list.
+   */
+  DataFlowWorkList workList(flowsTo);
+  workList.pushAll();
+
+  /*
+   * Compute the fixed point.
+   */
+  DataFlowBitVector newSet(domainSize);
+  while (!workList.empty()) {
+    auto b = workList.pop();
+
+    /*
+     * Apply the meet operator.
+     */
+    auto &meetSet = meetSets[b];
+    for (auto other : flowsFrom[b]) {
+      meetSet.unionWith(transferSets[other]);
+    }
+
+    /*
+     * Apply the transfer function of the basic block.
+     * Sets can only grow, so a change is detected by the union.
+     */
+    newSet = meetSet;
+    newSet.transfer(blockGENs[b], blockKILLs[b]);
+    if (!transferSets[b].unionWith(newSet)) {
+      continue;
+    }
+
+    /*
+     * Propagate the change.
+     */
+    for (auto other : flowsTo[b]) {
+      workList.push(other);
+    }
+  }
+  r->blockIterations = workList.getNumberOfIterations();
+
+  return;
+}
+
+} // namespace arcana::noelle
@@ -0,0 +1,291 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/DenseDataFlowResult.hpp"
+
+namespace arcana::noelle {
+
+DenseDataFlowResult::DenseDataFlowResult(Function *f,
+                                         const std::vector<Value *> &domain,
+                                         bool isForward)
+  : f{ f },
+    forward{ isForward },
+    domain{ domain },
+    blockIterations{ 0 } {
+  assert(f != nullptr);
+
+  /*
+   * Consider all basic blocks of the function.
+   */
+  std::vector<BasicBlock *> blocks;
+  for (auto &bb : *f) {
+    blocks.push_back(&bb);
+  }
+  this->initialize(blocks, {});
+
+  return;
+}
+
+DenseDataFlowResult::DenseDataFlowResult(
+    const std::vector<BasicBlock *> &blocks,
+    const std::vector<Value *> &domain,
+    const std::vector<Value *> &boundary,
+    bool isForward)
+  : f{ blocks.empty() ? nullptr : blocks.front()->getParent() },
+    forward{ isForward },
+    domain{ domain },
+    blockIterations{ 0 } {
+  assert(this->f != nullptr);
+
+  this->initialize(blocks, boundary);
+
+  return;
+}
+
+void DenseDataFlowResult::initialize(const std::vector<BasicBlock *> &blocks,
+                                     const std::vector<Value *> &boundary) {
+
+  /*
+   * Number the elements of the domain.
+   */
+  for (auto i = 0u; i < this->domain.size(); i++) {
+    this->elementIDs[this->domain[i]] = i;
+  }
+
+  /*
+   * Number the basic blocks and the instructions.
+   */
+  auto instID = 0u;
+  for (auto bb : blocks) {
+    assert(bb->getParent() == this->f);
+    this->blockIDs[bb] = this->blocks.size();
+    this->blocks.push_back(bb);
+    for (auto &inst : *bb) {
+      this->instructionIDs[&inst] = instID++;
+    }
+  }
+
+  /*
+   * Allocate the sets.
+   */
+  this->ins.resize(this->blocks.size(),
+                   DataFlowBitVector(this->getDomainSize()));
+  this->outs.resize(this->blocks.size(),
+                    DataFlowBitVector(this->getDomainSize()));
+  this->gens.resize(instID);
+  this->kills.resize(instID);
+
+  /*
+   * Set the boundary.
+   */
+  this->boundary.resize(this->getDomainSize());
+  for (auto v : boundary) {
+    auto it = this->elementIDs.find(v);
+    if (it != this->elementIDs.end()) {
+      this->boundary.set(it->second);
+    }
+  }
+
+  return;
+}
+
+Function *DenseDataFlowResult::getFunction(void) const {
+  return this->f;
+}
+
+bool DenseDataFlowResult::isIncluded(BasicBlock *bb) const {
+  return this->blockIDs.find(bb) != this->blockIDs.end();
+}
+
+const DataFlowBitVector &DenseDataFlowResult::getBoundary(void) const {
+  return this->boundary;
+}
+
+bool DenseDataFlowResult::isForward(void) const {
+  return this->forward;
+}
+
+uint32_t DenseDataFlowResult::getDomainSize(void) const {
+  return this->domain.size();
+}
+
+Value *DenseDataFlowResult::getElement(uint32_t elementID) const {
+  assert(elementID < this->domain.size());
+  return this->domain[elementID];
+}
+
+bool DenseDataFlowResult::isInDomain(Value *v) const {
+  return this->elementIDs.find(v) != this->elementIDs.end();
+}
+
+uint32_t DenseDataFlowResult::getElementID(Value *v) const {
+  assert(this->isInDomain(v));
+  return this->elementIDs.at(v);
+}
+
+const DataFlowBitVector &DenseDataFlowResult::IN(BasicBlock *bb) const {
+  return this->ins[this->blockIDs.at(bb)];
+}
+
+const DataFlowBitVector &DenseDataFlowResult::OUT(BasicBlock *bb) const {
+  return this->outs[this->blockIDs.at(bb)];
+}
+
+DataFlowBitVector DenseDataFlowResult::GEN(Instruction *inst) const {
+  DataFlowBitVector bv(this->getDomainSize());
+  for (auto elementID : this->gens[this->instructionIDs.at(inst)]) {
+    bv.set(elementID);
+  }
+
+  return bv;
+}
+
+DataFlowBitVector DenseDataFlowResult::KILL(Instruction *inst) const {
+  DataFlowBitVector bv(this->getDomainSize());
+  for (auto elementID : this->kills[this->instructionIDs.at(inst)]) {
+    bv.set(elementID);
+  }
+
+  return bv;
+}
+
+void DenseDataFlowResult::applyTransfer(Instruction *inst,
+                                        DataFlowBitVector &bv) const {
+  auto instID = this->instructionIDs.at(inst);
+
+  /*
+   * bv = GEN[inst] U (bv - KILL[inst])
+   */
+  for (auto elementID : this->kills[instID]) {
+    bv.reset(elementID);
+  }
+  for (auto elementID : this->gens[instID]) {
+    bv.set(elementID);
+  }
+
+  return;
+}
+
+DataFlowBitVector DenseDataFlowResult::IN(Instruction *inst) const {
+  auto bb = inst->getParent();
+
+  /*
+   * Forward analyses: replay the instructions that precede @inst.
+   */
+  if (this->forward) {
+    auto bv = this->IN(bb);
+    for (auto &i : *bb) {
+      if (&i == inst) {
+        break;
+      }
+      this->applyTransfer(&i, bv);
+    }
+    return bv;
+  }
+
+  /*
+   * Backward analyses: replay the instructions that follow @inst and then
+   * @inst itself.
+   */
+  auto bv = this->OUT(inst);
+  this->applyTransfer(inst, bv);
+
+  return bv;
+}
+
+DataFlowBitVector DenseDataFlowResult::OUT(Instruction *inst) const {
+  auto bb = inst->getParent();
+
+  /*
+   * Forward analyses: replay the instructions up to @inst included.
+   */
+  if (this->forward) {
+    auto bv = this->IN(inst);
+    this->applyTransfer(inst, bv);
+    return bv;
+  }
+
+  /*
+   * Backward analyses: replay the instructions that follow @inst.
+   */
+  auto bv = this->OUT(bb);
+  for (auto &i : reverse(*bb)) {
+    if (&i == inst) {
+      break;
+    }
+    this->applyTransfer(&i, bv);
+  }
+
+  return bv;
+}
+
+void DenseDataFlowResult::expand(
+    BasicBlock *bb,
+    std::function<void(Instruction *inst,
+                       const DataFlowBitVector &IN,
+                       const DataFlowBitVector &OUT)> f) const {
+
+  /*
+   * Forward analyses.
+   */
+  if (this->forward) {
+    auto current = this->IN(bb);
+    for (auto &i : *bb) {
+      auto in = current;
+      this->applyTransfer(&i, current);
+      f(&i, in, current);
+    }
+    return;
+  }
+
+  /*
+   * Backward analyses.
+   * Compute the sets in reverse and report them following the program order.
+   */
+  std::vector<std::pair<Instruction *, DataFlowBitVector>> outSets;
+  auto current = this->OUT(bb);
+  for (auto &i : reverse(*bb)) {
+    outSets.push_back(std::make_pair(&i, current));
+    this->applyTransfer(&i, current);
+  }
+  for (auto it = outSets.rbegin(); it != outSets.rend(); ++it) {
+    auto in = it->second;
+    this->applyTransfer(it->first, in);
+    f(it->first, in, it->second);
+  }
+
+  return;
+}
+
+std::set<Value *> DenseDataFlowResult::toSet(
+    const DataFlowBitVector &bv) const {
+  std::set<Value *> s;
+  bv.forEachSetBit(
+      [this, &s](uint32_t elementID) { s.insert(this->domain[elementID]); });
+
+  return s;
+}
+
+uint64_t DenseDataFlowResult::getNumberOfBlockIterations(void) const {
+  return this->blockIterations;
+}
+
+} // namespace arcana::noelle
@@ -67,6 +67,37 @@ public:
   virtual bool canThisDependenceBeLoopCarried(DGEdge<Value, Value> *dep,
                                               LoopStructure &loop);
 
+  /*
+   * Return false if the analysis cannot remove any dependence of @function
+   * (or of @loop).
+   * In this case, the analysis is not queried about them.
+   */
+  virtual bool canRemoveDependencesOf(Function &function);
+
+  virtual bool canRemoveDependencesOf(LoopStructure &loop);
+
+  /*
+   * Batched versions of the queries above: the answer at position i is about
+   * @pairs[i] (and @types[i]).
+   * They are invoked with all the pairs of a function (or of a loop) that the
+   * analyses queried before this one could not resolve.
+   * The default implementations answer one pair at a time with the queries
+   * above; analyses can override them to amortize their setup across pairs.
+   */
+  virtual std::vector<bool> canThereBeMemoryDataDependences(
+      const std::vector<std::pair<Instruction *, Instruction *>> &pairs,
+      Function &function);
+
+  virtual std::vector<bool> canThereBeMemoryDataDependences(
+      const std::vector<std::pair<Instruction *, Instruction *>> &pairs,
+      LoopStructure &loop);
+
+  virtual std::vector<MemoryDataDependenceStrength>
+  areThereTheseMemoryDataDependenceTypes(
+      const std::vector<DataDependenceType> &types,
+      const std::vector<std::pair<Instruction *, Instruction *>> &pairs,
+      LoopStructure &loop);
+
   virtual ~DependenceAnalysis();
 
 private:
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Yian Su, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_DEPENDENCE_ANALYSIS_DEPENDENCE_ANALYSIS_PIPELINE_H_
+#define NOELLE_SRC_CORE_DEPENDENCE_ANALYSIS_DEPENDENCE_ANALYSIS_PIPELINE_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/DependenceAnalysis.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * The dependence analyses registered by the user.
+ *
+ * The cost and the effectiveness of every analysis are measured while it is
+ * queried. Analyses are then queried starting from the one that removes
+ * dependences at the lowest cost, so the queries about a dependence stop as
+ * soon as possible.
+ * Since the order changes over time, queries can stop early only on answers
+ * that do not depend on it (i.e., the lack of a dependence).
+ */
+class DependenceAnalysisPipeline {
+public:
+  struct Statistics {
+    uint64_t queries;
+    uint64_t removedDependences;
+    uint64_t nanoseconds;
+  };
+
+  DependenceAnalysisPipeline();
+
+  void addAnalysis(DependenceAnalysis *a);
+
+  void removeAnalysis(DependenceAnalysis *a);
+
+  bool empty(void) const;
+
+  /*
+   * Return the analyses in the order they should be queried.
+   * Analyses that have not been measured yet come first, in the order they
+   * have been added; the others follow from the one that spends the least
+   * time per dependence removed.
+   * The order is returned by copy, so the analyses can be accounted while the
+   * caller iterates over it.
+   */
+  std::vector<DependenceAnalysis *> getAnalyses(void) const;
+
+  /*
+   * Account @queries queries answered by @a in @nanoseconds, which removed
+   * @removedDependences dependences.
+   */
+  void account(DependenceAnalysis *a,
+               uint64_t queries,
+               uint64_t removedDependences,
+               uint64_t nanoseconds);
+
+  /*
+   * Iterator: invoke @f on the statistics of every analysis, in the order the
+   * analyses have been added.
+   */
+  void iterateOverStatistics(
+      std::function<void(DependenceAnalysis *a, const Statistics &statistics)>
+          f) const;
+
+  void printStatistics(raw_ostream &stream, const std::string &prefix) const;
+
+private:
+  std::vector<DependenceAnalysis *> analyses;
+  std::unordered_map<DependenceAnalysis *, Statistics> statistics;
+  mutable std::vector<DependenceAnalysis *> order;
+  mutable bool isOrderValid;
+  uint64_t queriesSinceLastOrder;
+
+  /*
+   * Number of queries an analysis must answer before its cost is considered,
+   * and number of queries after which the analyses are sorted again.
+   */
+  static constexpr uint64_t queriesToMeasure = 64;
+  static constexpr uint64_t queriesBetweenOrders = 1024;
+};
+
+} // namespace arcana::noelle
+
+#endif
@@ -0,0 +1,166 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Yian Su, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_DEPENDENCE_ANALYSIS_DEPENDENCE_QUERY_CACHE_H_
+#define NOELLE_SRC_CORE_DEPENDENCE_ANALYSIS_DEPENDENCE_QUERY_CACHE_H_
+
+#include <array>
+#include <mutex>
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Answers of alias and dependence queries shared by the PDG and LDG
+ * generators.
+ *
+ * A query is identified by its kind, the analysis that answers it, the two
+ * values it is about, and its context (the function or the header of the loop
+ * considered by the analysis).
+ * The number of answers kept is bounded: the least recently used one is
+ * dropped when the cache is full.
+ *
+ * Answers become stale when the code changes, so the ones about a function
+ * must be dropped (invalidate) when the function is modified.
+ */
+class DependenceQueryCache {
+public:
+  enum QueryKind : uint8_t {
+    ALIAS,
+    MOD_REF_LOCATION,
+    MOD_REF_CALL,
+    CAN_THERE_BE_A_DEPENDENCE,
+    DEPENDENCE_TYPE,
+    LOOP_DEPENDENCE
+  };
+
+  struct Query {
+    QueryKind kind;
+    uint32_t analysisID;
+    const Value *from;
+    const Value *to;
+    const Value *context;
+    uint8_t parameter;
+
+    bool operator==(const Query &other) const;
+  };
+
+  struct Statistics {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t nanosecondsToAnswerMisses;
+  };
+
+  DependenceQueryCache(uint64_t capacity);
+
+  DependenceQueryCache() = delete;
+
+  DependenceQueryCache(const DependenceQueryCache &other) = delete;
+
+  /*
+   * Return the identifier used in queries answered by @analysis.
+   */
+  uint32_t getAnalysisID(const void *analysis, const std::string &name);
+
+  /*
+   * Return the answer of @query.
+   * @answer is invoked only if the answer is not in the cache.
+   */
+  uint8_t query(const Query &query, std::function<uint8_t(void)> answer);
+
+  /*
+   * Return the answers of @queries, in order.
+   * @answer is invoked, with the position of the query within @queries, only
+   * for the queries whose answer is not in the cache.
+   */
+  std::vector<uint8_t> query(const std::vector<Query> &queries,
+                             std::function<uint8_t(uint64_t queryIndex)> answer);
+
+  /*
+   * Return the answers of @queries, in order.
+   * The answers that are not in the cache are computed by a single invocation
+   * of @answer, which receives the positions of these queries within @queries
+   * and returns their answers in the same order.
+   */
+  std::vector<uint8_t> queryAll(
+      const std::vector<Query> &queries,
+      std::function<std::vector<uint8_t>(
+          const std::vector<uint64_t> &queryIndexes)> answer);
+
+  /*
+   * Drop the answers about the code of @F.
+   * These are the answers of the queries that include a value of @F.
+   */
+  void invalidate(const Function &F);
+
+  /*
+   * Drop the answers given by @analysis.
+   */
+  void invalidate(const void *analysis);
+
+  void clear(void);
+
+  uint64_t getNumberOfAnswers(void) const;
+
+  uint64_t getCapacity(void) const;
+
+  /*
+   * Iterator: invoke @f on the statistics of every analysis.
+   */
+  void iterateOverStatistics(
+      std::function<void(const std::string &analysisName,
+                         const Statistics &statistics)> f) const;
+
+  static constexpr uint64_t defaultCapacity = 1 << 20;
+
+private:
+  struct QueryHash {
+    size_t operator()(const Query &query) const;
+  };
+  struct Answer {
+    Query query;
+    uint8_t answer;
+    std::array<const Function *, 3> functions;
+  };
+
+  uint64_t capacity;
+  std::list<Answer> answers;
+  std::unordered_map<Query, std::list<Answer>::iterator, QueryHash> index;
+  std::unordered_map<const void *, uint32_t> analysisIDs;
+  std::vector<std::string> analysisNames;
+  std::vector<Statistics> statistics;
+  mutable std::mutex lock;
+
+  bool lookup(const Query &query, uint8_t &answer);
+  std::vector<uint64_t> lookup(const std::vector<Query> &queries,
+                               std::vector<uint8_t> &answers);
+
+  void insert(const Query &query, uint8_t answer, uint64_t nanoseconds);
+
+  void erase(std::function<bool(const Answer &answer)> shouldBeErased);
+
+  static const Function *getFunction(const Value *value);
+};
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_DEPENDENCE_ANALYSIS_DEPENDENCE_QUERY_CACHE_H_
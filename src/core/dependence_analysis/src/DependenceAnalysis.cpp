@@ -78,6 +78,59 @@ bool DependenceAnalysis::canThisDependenceBeLoopCarried(
   return true;
 }
 
+bool DependenceAnalysis::canRemoveDependencesOf(Function &function) {
+  return true;
+}
+
+bool DependenceAnalysis::canRemoveDependencesOf(LoopStructure &loop) {
+  return true;
+}
+
+std::vector<bool> DependenceAnalysis::canThereBeMemoryDataDependences(
+    const std::vector<std::pair<Instruction *, Instruction *>> &pairs,
+    Function &function) {
+  std::vector<bool> answers;
+  answers.reserve(pairs.size());
+  for (auto &pair : pairs) {
+    answers.push_back(this->canThereBeAMemoryDataDependence(pair.first,
+                                                            pair.second,
+                                                            function));
+  }
+
+  return answers;
+}
+
+std::vector<bool> DependenceAnalysis::canThereBeMemoryDataDependences(
+    const std::vector<std::pair<Instruction *, Instruction *>> &pairs,
+    LoopStructure &loop) {
+  std::vector<bool> answers;
+  answers.reserve(pairs.size());
+  for (auto &pair : pairs) {
+    answers.push_back(
+        this->canThereBeAMemoryDataDependence(pair.first, pair.second, loop));
+  }
+
+  return answers;
+}
+
+std::vector<MemoryDataDependenceStrength> DependenceAnalysis::
+    areThereTheseMemoryDataDependenceTypes(
+        const std::vector<DataDependenceType> &types,
+        const std::vector<std::pair<Instruction *, Instruction *>> &pairs,
+        LoopStructure &loop) {
+  assert(types.size() == pairs.size());
+  std::vector<MemoryDataDependenceStrength> answers;
+  answers.reserve(pairs.size());
+  for (auto i = 0u; i < pairs.size(); i++) {
+    answers.push_back(this->isThereThisMemoryDataDependenceType(types[i],
+                                                                pairs[i].first,
+                                                                pairs[i].second,
+                                                                loop));
+  }
+
+  return answers;
+}
+
 DependenceAnalysis::~DependenceAnalysis() {}
 
 } // namespace arcana::noelle
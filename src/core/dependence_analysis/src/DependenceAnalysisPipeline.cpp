@@ -0,0 +1,166 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Yian Su, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/DependenceAnalysisPipeline.hpp"
+
+namespace arcana::noelle {
+
+DependenceAnalysisPipeline::DependenceAnalysisPipeline()
+  : isOrderValid{ false },
+    queriesSinceLastOrder{ 0 } {
+  return;
+}
+
+void DependenceAnalysisPipeline::addAnalysis(DependenceAnalysis *a) {
+  assert(a != nullptr);
+
+  /*
+   * Check if the analysis has already been added.
+   */
+  if (this->statistics.find(a) != this->statistics.end()) {
+    return;
+  }
+
+  /*
+   * Add the analysis.
+   */
+  this->analyses.push_back(a);
+  this->statistics[a] = { 0, 0, 0 };
+  this->isOrderValid = false;
+
+  return;
+}
+
+void DependenceAnalysisPipeline::removeAnalysis(DependenceAnalysis *a) {
+  auto it = std::find(this->analyses.begin(), this->analyses.end(), a);
+  if (it == this->analyses.end()) {
+    return;
+  }
+  this->analyses.erase(it);
+  this->statistics.erase(a);
+  this->isOrderValid = false;
+
+  return;
+}
+
+bool DependenceAnalysisPipeline::empty(void) const {
+  return this->analyses.empty();
+}
+
+std::vector<DependenceAnalysis *> DependenceAnalysisPipeline::getAnalyses(
+    void) const {
+
+  /*
+   * Check if the current order can be used.
+   */
+  if (this->isOrderValid) {
+    return this->order;
+  }
+
+  /*
+   * Compute the time spent by every analysis per dependence removed.
+   * Analyses that have not been measured yet cost nothing, so they are queried
+   * first and measured.
+   */
+  std::unordered_map<DependenceAnalysis *, double> costs;
+  for (auto a : this->analyses) {
+    auto &s = this->statistics.at(a);
+    if (s.queries < DependenceAnalysisPipeline::queriesToMeasure) {
+      costs[a] = 0;
+      continue;
+    }
+    costs[a] = static_cast<double>(s.nanoseconds + 1)
+               / static_cast<double>(s.removedDependences + 1);
+  }
+
+  /*
+   * Sort the analyses.
+   * Ties are broken by the order the analyses have been added.
+   */
+  this->order = this->analyses;
+  std::stable_sort(this->order.begin(),
+                   this->order.end(),
+                   [&costs](DependenceAnalysis *a, DependenceAnalysis *b) {
+                     return costs.at(a) < costs.at(b);
+                   });
+  this->isOrderValid = true;
+
+  return this->order;
+}
+
+void DependenceAnalysisPipeline::account(DependenceAnalysis *a,
+                                         uint64_t queries,
+                                         uint64_t removedDependences,
+                                         uint64_t nanoseconds) {
+  auto it = this->statistics.find(a);
+  if (it == this->statistics.end()) {
+    return;
+  }
+
+  /*
+   * Update the statistics of the analysis.
+   */
+  auto &s = it->second;
+  auto queriesToMeasure = DependenceAnalysisPipeline::queriesToMeasure;
+  auto wasMeasured = (s.queries >= queriesToMeasure);
+  s.queries += queries;
+  s.removedDependences += removedDependences;
+  s.nanoseconds += nanoseconds;
+
+  /*
+   * Check if the analyses should be sorted again.
+   */
+  this->queriesSinceLastOrder += queries;
+  auto isMeasured = (s.queries >= queriesToMeasure);
+  if ((wasMeasured != isMeasured)
+      || (this->queriesSinceLastOrder
+          >= DependenceAnalysisPipeline::queriesBetweenOrders)) {
+    this->isOrderValid = false;
+    this->queriesSinceLastOrder = 0;
+  }
+
+  return;
+}
+
+void DependenceAnalysisPipeline::iterateOverStatistics(
+    std::function<void(DependenceAnalysis *a, const Statistics &statistics)> f)
+    const {
+  for (auto a : this->analyses) {
+    f(a, this->statistics.at(a));
+  }
+
+  return;
+}
+
+void DependenceAnalysisPipeline::printStatistics(
+    raw_ostream &stream,
+    const std::string &prefix) const {
+  for (auto a : this->analyses) {
+    auto &s = this->statistics.at(a);
+    stream << prefix << a->getName() << ": " << s.queries << " queries, "
+           << s.removedDependences << " dependences removed, "
+           << (s.nanoseconds / 1000000) << " ms\n";
+  }
+
+  return;
+}
+
+} // namespace arcana::noelle
@@ -0,0 +1,337 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Yian Su, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <chrono>
+
+#include "arcana/noelle/core/DependenceQueryCache.hpp"
+
+namespace arcana::noelle {
+
+bool DependenceQueryCache::Query::operator==(const Query &other) const {
+  return (this->kind == other.kind) && (this->analysisID == other.analysisID)
+         && (this->from == other.from) && (this->to == other.to)
+         && (this->context == other.context)
+         && (this->parameter == other.parameter);
+}
+
+size_t DependenceQueryCache::QueryHash::operator()(const Query &query) const {
+  return hash_combine(query.kind,
+                      query.analysisID,
+                      query.from,
+                      query.to,
+                      query.context,
+                      query.parameter);
+}
+
+DependenceQueryCache::DependenceQueryCache(uint64_t capacity)
+  : capacity{ capacity } {
+  assert(this->capacity > 0);
+
+  return;
+}
+
+uint32_t DependenceQueryCache::getAnalysisID(const void *analysis,
+                                             const std::string &name) {
+  std::lock_guard<std::mutex> guard(this->lock);
+
+  /*
+   * Check if the analysis has already been registered.
+   */
+  auto it = this->analysisIDs.find(analysis);
+  if (it != this->analysisIDs.end()) {
+    return it->second;
+  }
+
+  /*
+   * Register the analysis.
+   */
+  uint32_t id = this->analysisNames.size();
+  this->analysisIDs[analysis] = id;
+  this->analysisNames.push_back(name);
+  this->statistics.push_back({ 0, 0, 0 });
+
+  return id;
+}
+
+uint8_t DependenceQueryCache::query(const Query &query,
+                                    std::function<uint8_t(void)> answer) {
+
+  /*
+   * Check if we already know the answer.
+   */
+  uint8_t result;
+  if (this->lookup(query, result)) {
+    return result;
+  }
+
+  /*
+   * Compute the answer.
+   * The lock is not held while the analysis runs.
+   */
+  auto start = std::chrono::steady_clock::now();
+  result = answer();
+  auto end = std::chrono::steady_clock::now();
+  auto nanoseconds =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+  this->insert(query, result, nanoseconds);
+
+  return result;
+}
+
+std::vector<uint8_t> DependenceQueryCache::query(
+    const std::vector<Query> &queries,
+    std::function<uint8_t(uint64_t queryIndex)> answer) {
+  std::vector<uint8_t> results(queries.size(), 0);
+
+  /*
+   * Fetch the answers we already know.
+   */
+  auto misses = this->lookup(queries, results);
+
+  /*
+   * Compute the other answers.
+   */
+  for (auto i : misses) {
+    auto start = std::chrono::steady_clock::now();
+    results[i] = answer(i);
+    auto end = std::chrono::steady_clock::now();
+    auto nanoseconds =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+            .count();
+    this->insert(queries[i], results[i], nanoseconds);
+  }
+
+  return results;
+}
+
+std::vector<uint8_t> DependenceQueryCache::queryAll(
+    const std::vector<Query> &queries,
+    std::function<std::vector<uint8_t>(
+        const std::vector<uint64_t> &queryIndexes)> answer) {
+  std::vector<uint8_t> results(queries.size(), 0);
+
+  /*
+   * Fetch the answers we already know.
+   */
+  auto misses = this->lookup(queries, results);
+  if (misses.empty()) {
+    return results;
+  }
+
+  /*
+   * Compute the other answers at once.
+   * The time spent is split evenly among them.
+   */
+  auto start = std::chrono::steady_clock::now();
+  auto newResults = answer(misses);
+  auto end = std::chrono::steady_clock::now();
+  assert(newResults.size() == misses.size());
+  auto nanoseconds =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+  for (auto i = 0u; i < misses.size(); i++) {
+    auto queryIndex = misses[i];
+    results[queryIndex] = newResults[i];
+    this->insert(queries[queryIndex],
+                 newResults[i],
+                 nanoseconds / misses.size());
+  }
+
+  return results;
+}
+
+std::vector<uint64_t> DependenceQueryCache::lookup(
+    const std::vector<Query> &queries,
+    std::vector<uint8_t> &answers) {
+  std::lock_guard<std::mutex> guard(this->lock);
+
+  std::vector<uint64_t> misses;
+  for (auto i = 0u; i < queries.size(); i++) {
+    auto it = this->index.find(queries[i]);
+    auto &s = this->statistics[queries[i].analysisID];
+    if (it == this->index.end()) {
+      s.misses++;
+      misses.push_back(i);
+      continue;
+    }
+    s.hits++;
+    this->answers.splice(this->answers.begin(), this->answers, it->second);
+    answers[i] = it->second->answer;
+  }
+
+  return misses;
+}
+
+bool DependenceQueryCache::lookup(const Query &query, uint8_t &answer) {
+  std::lock_guard<std::mutex> guard(this->lock);
+  assert(query.analysisID < this->statistics.size());
+  auto &s = this->statistics[query.analysisID];
+
+  auto it = this->index.find(query);
+  if (it == this->index.end()) {
+    s.misses++;
+    return false;
+  }
+  s.hits++;
+
+  /*
+   * Mark the answer as the most recently used.
+   */
+  this->answers.splice(this->answers.begin(), this->answers, it->second);
+  answer = it->second->answer;
+
+  return true;
+}
+
+void DependenceQueryCache::insert(const Query &query,
+                                  uint8_t answer,
+                                  uint64_t nanoseconds) {
+  std::lock_guard<std::mutex> guard(this->lock);
+  this->statistics[query.analysisID].nanosecondsToAnswerMisses += nanoseconds;
+
+  /*
+   * Check if another thread has already added the answer.
+   */
+  if (this->index.find(query) != this->index.end()) {
+    return;
+  }
+
+  /*
+   * Make room for the new answer.
+   */
+  if (this->answers.size() >= this->capacity) {
+    auto &leastRecentlyUsed = this->answers.back();
+    this->index.erase(leastRecentlyUsed.query);
+    this->answers.pop_back();
+  }
+
+  /*
+   * Add the answer.
+   * The answer is about the code of every function that includes a value of
+   * the query (e.g., the two functions of an inter-procedural alias query).
+   */
+  std::array<const Function *, 3> functions{
+    DependenceQueryCache::getFunction(query.from),
+    DependenceQueryCache::getFunction(query.to),
+    DependenceQueryCache::getFunction(query.context)
+  };
+  this->answers.push_front({ query, answer, functions });
+  this->index[query] = this->answers.begin();
+
+  return;
+}
+
+void DependenceQueryCache::invalidate(const Function &F) {
+  this->erase([&F](const Answer &answer) -> bool {
+    return std::find(answer.functions.begin(), answer.functions.end(), &F)
+           != answer.functions.end();
+  });
+
+  return;
+}
+
+void DependenceQueryCache::invalidate(const void *analysis) {
+  uint32_t id;
+  {
+    std::lock_guard<std::mutex> guard(this->lock);
+    auto it = this->analysisIDs.find(analysis);
+    if (it == this->analysisIDs.end()) {
+      return;
+    }
+    id = it->second;
+
+    /*
+     * A new analysis allocated at the same address must get a new identifier.
+     */
+    this->analysisIDs.erase(it);
+  }
+  this->erase([id](const Answer &answer) -> bool {
+    return answer.query.analysisID == id;
+  });
+
+  return;
+}
+
+void DependenceQueryCache::erase(
+    std::function<bool(const Answer &answer)> shouldBeErased) {
+  std::lock_guard<std::mutex> guard(this->lock);
+
+  for (auto it = this->answers.begin(); it != this->answers.end();) {
+    if (!shouldBeErased(*it)) {
+      it++;
+      continue;
+    }
+    this->index.erase(it->query);
+    it = this->answers.erase(it);
+  }
+
+  return;
+}
+
+void DependenceQueryCache::clear(void) {
+  std::lock_guard<std::mutex> guard(this->lock);
+  this->answers.clear();
+  this->index.clear();
+
+  return;
+}
+
+uint64_t DependenceQueryCache::getNumberOfAnswers(void) const {
+  std::lock_guard<std::mutex> guard(this->lock);
+
+  return this->answers.size();
+}
+
+uint64_t DependenceQueryCache::getCapacity(void) const {
+  return this->capacity;
+}
+
+void DependenceQueryCache::iterateOverStatistics(
+    std::function<void(const std::string &analysisName,
+                       const Statistics &statistics)> f) const {
+  std::lock_guard<std::mutex> guard(this->lock);
+  for (auto i = 0u; i < this->analysisNames.size(); i++) {
+    f(this->analysisNames[i], this->statistics[i]);
+  }
+
+  return;
+}
+
+const Function *DependenceQueryCache::getFunction(const Value *value) {
+  if (value == nullptr) {
+    return nullptr;
+  }
+  if (auto inst = dyn_cast<Instruction>(value)) {
+    return inst->getFunction();
+  }
+  if (auto arg = dyn_cast<Argument>(value)) {
+    return arg->getParent();
+  }
+  if (auto bb = dyn_cast<BasicBlock>(value)) {
+    return bb->getParent();
+  }
+  if (auto f = dyn_cast<Function>(value)) {
+    return f;
+  }
+
+  return nullptr;
+}
+
+} // namespace arcana::noelle
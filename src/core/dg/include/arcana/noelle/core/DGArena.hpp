@@ -0,0 +1,108 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Yian Su, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_DG_DGARENA_H_
+#define NOELLE_SRC_CORE_DG_DGARENA_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "llvm/Support/Allocator.h"
+
+namespace arcana::noelle {
+
+/*
+ * Memory of the nodes and edges of dependence graphs.
+ *
+ * Objects are bump-allocated from slabs that are released all together when
+ * the arena is destroyed.
+ * The memory of destroyed objects can be recycled by the next objects of the
+ * same size (e.g., edges removed and then added to a graph).
+ */
+class DGArena {
+public:
+  DGArena();
+
+  DGArena(const DGArena &other) = delete;
+
+  DGArena &operator=(const DGArena &other) = delete;
+
+  template <class Object, class... Args>
+  Object *create(Args &&...args);
+
+  /*
+   * Invoke the destructor of @object.
+   * If @recycle is true, its memory is reused by the next object of the same
+   * size. Otherwise, its memory is released when the arena is destroyed.
+   */
+  template <class Object>
+  void destroy(Object *object, bool recycle);
+
+  /*
+   * Bytes of the slabs allocated.
+   */
+  uint64_t getNumberOfBytesReserved(void) const;
+
+  /*
+   * Bytes used by objects that have not been destroyed.
+   */
+  uint64_t getNumberOfBytesInUse(void) const;
+
+  /*
+   * Bytes of destroyed objects that can be recycled.
+   */
+  uint64_t getNumberOfBytesToRecycle(void) const;
+
+  /*
+   * Number of objects created by recycling the memory of destroyed ones.
+   */
+  uint64_t getNumberOfRecycledObjects(void) const;
+
+private:
+  BumpPtrAllocator allocator;
+  std::unordered_map<size_t, std::vector<void *>> freeLists;
+  uint64_t bytesInUse;
+  uint64_t bytesToRecycle;
+  uint64_t recycledObjects;
+
+  void *allocate(size_t size, size_t alignment);
+
+  void deallocate(void *memory, size_t size, bool recycle);
+};
+
+template <class Object, class... Args>
+Object *DGArena::create(Args &&...args) {
+  auto memory = this->allocate(sizeof(Object), alignof(Object));
+  auto object = new (memory) Object(std::forward<Args>(args)...);
+
+  return object;
+}
+
+template <class Object>
+void DGArena::destroy(Object *object, bool recycle) {
+  assert(object != nullptr);
+  object->~Object();
+  this->deallocate(object, sizeof(Object), recycle);
+
+  return;
+}
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_DG_DGARENA_H_
@@ -31,6 +31,8 @@
 #include "arcana/noelle/core/VariableDependence.hpp"
 #include "arcana/noelle/core/ControlDependence.hpp"
 #include "arcana/noelle/core/UndefinedDependence.hpp"
+#include "arcana/noelle/core/FrozenDG.hpp"
+#include "arcana/noelle/core/DGArena.hpp"
 
 namespace arcana::noelle {
 
@@ -197,7 +199,41 @@ public:
   static std::vector<DGEdge<T, T> *> sortDependences(
       const std::set<DGEdge<T, T> *> &set);
 
+  /*
+   * Frozen form.
+   *
+   * freeze() builds a read-optimized (CSR) view of the current nodes and
+   * edges that traversals use while the graph does not change.
+   * Any modification of the graph thaws it (i.e., it drops the frozen form).
+   *
+   * The frozen form is kept next to the node and edge sets, which remain the
+   * mutable form of the graph. It takes about 25 bytes per edge and 32 bytes
+   * per node, which adds about 12% to the memory of a graph with four edges
+   * per node. It is released by thaw().
+   *
+   * Traversals must hold the returned pointer while they walk the frozen form:
+   * a modification done during the walk (e.g., by a callback) thaws the graph,
+   * and the frozen form stays alive until its last holder releases it.
+   */
+  void freeze(void);
+  void thaw(void);
+  bool isFrozen(void) const;
+  std::shared_ptr<const FrozenDG<T>> getFrozenForm(void) const;
+
+  /*
+   * Memory of the nodes and edges of the graph.
+   */
+  const DGArena &getArena(void) const;
+
 protected:
+  void destroyEdge(DGEdge<T, T> *edge, bool recycle);
+
+  /*
+   * Destroy all the nodes and edges of the graph.
+   * Their memory is released all together with the arena.
+   */
+  void destroyNodesAndEdges(void);
+
   int32_t nodeIdCounter;
   std::set<DGNode<T> *> allNodes;
   std::set<DGEdge<T, T> *> allEdges;
@@ -205,21 +241,28 @@ protected:
   std::map<T *, DGNode<T> *> internalNodeMap;
   std::map<T *, DGNode<T> *> externalNodeMap;
   std::shared_ptr<DepIdReverseMap_t> depLookupMap;
+  std::shared_ptr<FrozenDG<T>> frozenForm;
+  std::unique_ptr<DGArena> arena;
 };
 
 /*
  * DG<T> class method implementations
  */
 template <class T>
-DG<T>::DG() : nodeIdCounter{ 0 },
-              depLookupMap{ nullptr } {
+DG<T>::DG()
+  : nodeIdCounter{ 0 },
+    depLookupMap{ nullptr },
+    frozenForm{ nullptr },
+    arena{ std::make_unique<DGArena>() } {
 
   return;
 }
 
 template <class T>
 DGNode<T> *DG<T>::addNode(T *theT, bool inclusion) {
-  auto node = new DGNode<T>(nodeIdCounter++, theT);
+  this->thaw();
+
+  auto node = this->arena->template create<DGNode<T>>(nodeIdCounter++, theT);
   allNodes.insert(node);
   auto &map = inclusion ? internalNodeMap : externalNodeMap;
   map[theT] = node;
@@ -277,9 +320,14 @@ template <class T>
 DGEdge<T, T> *DG<T>::addVariableDataDependenceEdge(T *from,
                                                    T *to,
                                                    DataDependenceType t) {
+  this->thaw();
+
   auto fromNode = this->fetchNode(from);
   auto toNode = this->fetchNode(to);
-  auto edge = new VariableDependence<T, T>(fromNode, toNode, t);
+  auto edge =
+      this->arena->template create<VariableDependence<T, T>>(fromNode,
+                                                              toNode,
+                                                              t);
   allEdges.insert(edge);
   fromNode->addOutgoingEdge(edge);
   toNode->addIncomingEdge(edge);
@@ -291,13 +339,19 @@ DGEdge<T, T> *DG<T>::addMemoryDataDependenceEdge(T *from,
                                                  T *to,
                                                  DataDependenceType t,
                                                  bool isMust) {
+  this->thaw();
+
   auto fromNode = this->fetchNode(from);
   auto toNode = this->fetchNode(to);
   DGEdge<T, T> *edge = nullptr;
   if (isMust) {
-    edge = new MustMemoryDependence<T, T>(fromNode, toNode, t);
+    edge = this->arena->template create<MustMemoryDependence<T, T>>(fromNode,
+                                                                    toNode,
+                                                                    t);
   } else {
-    edge = new MayMemoryDependence<T, T>(fromNode, toNode, t);
+    edge = this->arena->template create<MayMemoryDependence<T, T>>(fromNode,
+                                                                   toNode,
+                                                                   t);
   }
   assert(edge != nullptr);
 
@@ -309,9 +363,12 @@ DGEdge<T, T> *DG<T>::addMemoryDataDependenceEdge(T *from,
 
 template <class T>
 DGEdge<T, T> *DG<T>::addControlDependenceEdge(T *from, T *to) {
+  this->thaw();
+
   auto fromNode = this->fetchNode(from);
   auto toNode = this->fetchNode(to);
-  auto edge = new ControlDependence<T, T>(fromNode, toNode);
+  auto edge =
+      this->arena->template create<ControlDependence<T, T>>(fromNode, toNode);
   allEdges.insert(edge);
   fromNode->addOutgoingEdge(edge);
   toNode->addIncomingEdge(edge);
@@ -320,9 +377,12 @@ DGEdge<T, T> *DG<T>::addControlDependenceEdge(T *from, T *to) {
 
 template <class T>
 DGEdge<T, T> *DG<T>::addUndefinedDependenceEdge(T *from, T *to) {
+  this->thaw();
+
   auto fromNode = this->fetchNode(from);
   auto toNode = this->fetchNode(to);
-  auto edge = new UndefinedDependence<T, T>(fromNode, toNode);
+  auto edge =
+      this->arena->template create<UndefinedDependence<T, T>>(fromNode, toNode);
   allEdges.insert(edge);
   fromNode->addOutgoingEdge(edge);
   toNode->addIncomingEdge(edge);
@@ -345,20 +405,26 @@ std::unordered_set<DGEdge<T, T> *> DG<T>::fetchEdges(DGNode<T> *From,
 
 template <class T>
 DGEdge<T, T> *DG<T>::copyAddEdge(DGEdge<T, T> &edgeToCopy) {
+  this->thaw();
+
   DGEdge<T, T> *edge = nullptr;
   if (isa<ControlDependence<T, T>>(&edgeToCopy)) {
     auto edgeToCopyAsCD = cast<ControlDependence<T, T>>(&edgeToCopy);
-    edge = new ControlDependence<T, T>(*edgeToCopyAsCD);
+    edge = this->arena->template create<ControlDependence<T, T>>(
+        *edgeToCopyAsCD);
   } else {
     if (isa<VariableDependence<T, T>>(&edgeToCopy)) {
       auto edgeToCopyAsVD = cast<VariableDependence<T, T>>(&edgeToCopy);
-      edge = new VariableDependence<T, T>(*edgeToCopyAsVD);
+      edge = this->arena->template create<VariableDependence<T, T>>(
+          *edgeToCopyAsVD);
     } else if (isa<MayMemoryDependence<T, T>>(&edgeToCopy)) {
       auto edgeToCopyAsMD = cast<MayMemoryDependence<T, T>>(&edgeToCopy);
-      edge = new MayMemoryDependence<T, T>(*edgeToCopyAsMD);
+      edge = this->arena->template create<MayMemoryDependence<T, T>>(
+          *edgeToCopyAsMD);
     } else {
       auto edgeToCopyAsMD = cast<MustMemoryDependence<T, T>>(&edgeToCopy);
-      edge = new MustMemoryDependence<T, T>(*edgeToCopyAsMD);
+      edge = this->arena->template create<MustMemoryDependence<T, T>>(
+          *edgeToCopyAsMD);
     }
   }
   allEdges.insert(edge);
@@ -520,6 +586,8 @@ std::unordered_set<DGNode<T> *> DG<T>::getPreviousDepthNodes(DGNode<T> *node) {
 
 template <class T>
 void DG<T>::removeNode(DGNode<T> *node) {
+  this->thaw();
+
   auto theT = node->getT();
   auto &map = isInternal(theT) ? internalNodeMap : externalNodeMap;
   map.erase(theT);
@@ -547,18 +615,20 @@ void DG<T>::removeNode(DGNode<T> *node) {
     edge->getDstNode()->removeConnectedNode(node);
   for (auto edge : allToAndFromNode) {
     allEdges.erase(edge);
-    delete edge;
+    this->destroyEdge(edge, true);
   }
 
-  delete node;
+  this->arena->destroy(node, true);
 }
 
 template <class T>
 void DG<T>::removeEdge(DGEdge<T, T> *edge) {
+  this->thaw();
+
   edge->getSrcNode()->removeConnectedEdge(edge);
   edge->getDstNode()->removeConnectedEdge(edge);
   allEdges.erase(edge);
-  delete edge;
+  this->destroyEdge(edge, true);
 }
 
 template <class T>
@@ -588,6 +658,8 @@ void DG<T>::copyNodesIntoNewGraph(DG<T> &newGraph,
 
 template <class T>
 void DG<T>::clear(void) {
+  this->thaw();
+
   allNodes.clear();
   allEdges.clear();
   entryNode = nullptr;
@@ -680,6 +752,96 @@ std::vector<DGEdge<T, T> *> DG<T>::sortDependences(
   return v;
 }
 
+template <class T>
+void DG<T>::freeze(void) {
+  if (this->frozenForm != nullptr) {
+    return;
+  }
+  this->frozenForm =
+      std::make_shared<FrozenDG<T>>(this->allNodes, this->allEdges);
+
+  return;
+}
+
+template <class T>
+void DG<T>::thaw(void) {
+  this->frozenForm = nullptr;
+
+  return;
+}
+
+template <class T>
+bool DG<T>::isFrozen(void) const {
+  return this->frozenForm != nullptr;
+}
+
+template <class T>
+std::shared_ptr<const FrozenDG<T>> DG<T>::getFrozenForm(void) const {
+  return this->frozenForm;
+}
+
+template <class T>
+const DGArena &DG<T>::getArena(void) const {
+  return *(this->arena);
+}
+
+template <class T>
+void DG<T>::destroyEdge(DGEdge<T, T> *edge, bool recycle) {
+  assert(edge != nullptr);
+
+  /*
+   * The arena needs the concrete type of the edge to know its size.
+   */
+  switch (edge->getKind()) {
+    case DGEdge<T, T>::CONTROL_DEPENDENCE:
+      this->arena->destroy(cast<ControlDependence<T, T>>(edge), recycle);
+      break;
+    case DGEdge<T, T>::VARIABLE_DEPENDENCE:
+      this->arena->destroy(cast<VariableDependence<T, T>>(edge), recycle);
+      break;
+    case DGEdge<T, T>::MAY_MEMORY_DEPENDENCE:
+      this->arena->destroy(cast<MayMemoryDependence<T, T>>(edge), recycle);
+      break;
+    case DGEdge<T, T>::MUST_MEMORY_DEPENDENCE:
+      this->arena->destroy(cast<MustMemoryDependence<T, T>>(edge), recycle);
+      break;
+    case DGEdge<T, T>::UNDEFINED_DEPENDENCE:
+      this->arena->destroy(cast<UndefinedDependence<T, T>>(edge), recycle);
+      break;
+    default:
+      abort();
+  }
+
+  return;
+}
+
+template <class T>
+void DG<T>::destroyNodesAndEdges(void) {
+  this->thaw();
+
+  /*
+   * Destroy the edges and the nodes.
+   * There is no need to recycle their memory as the graph is going away.
+   */
+  for (auto edge : this->allEdges) {
+    if (edge) {
+      this->destroyEdge(edge, false);
+    }
+  }
+  for (auto node : this->allNodes) {
+    if (node) {
+      this->arena->destroy(node, false);
+    }
+  }
+  this->allEdges.clear();
+  this->allNodes.clear();
+  this->internalNodeMap.clear();
+  this->externalNodeMap.clear();
+  this->entryNode = nullptr;
+
+  return;
+}
+
 template <class T>
 uint64_t DG<T>::numNodes(void) const {
   return allNodes.size();
@@ -48,19 +48,23 @@ template <class DG, class T>
 class DGGraphWrapper {
 public:
   DGGraphWrapper(DG *graph) : wrappedGraph{ graph }, entryNode{ nullptr } {
-    std::unordered_map<DGNode<T> *, DGNodeWrapper<T> *> nodeToWrapperMap;
+
+    /*
+     * Check if the graph is frozen.
+     * In this case, the adjacency is read from its CSR form.
+     */
+    if (auto frozen = graph->getFrozenForm()) {
+      this->wrapFrozenGraph(frozen.get());
+      return;
+    }
+
     for (auto node : graph->getNodes()) {
       auto wrappedNode = new DGNodeWrapper<T>(node);
       this->nodes.insert(wrappedNode);
       nodeToWrapperMap.insert(std::make_pair(node, wrappedNode));
     }
 
-    auto unwrappedEntryNode = graph->getEntryNode();
-    if (unwrappedEntryNode
-        && nodeToWrapperMap.find(unwrappedEntryNode)
-               != nodeToWrapperMap.end()) {
-      this->entryNode = nodeToWrapperMap.at(unwrappedEntryNode);
-    }
+    this->setEntryNode(graph->getEntryNode());
 
     for (auto node : this->nodes) {
       auto wrapped = node->wrappedNode;
@@ -80,6 +84,19 @@ public:
     }
   }
 
+  /*
+   * Set the node where traversals (e.g., scc_begin) start from.
+   * This allows a wrapper to be reused for different entry nodes.
+   */
+  void setEntryNode(DGNode<T> *unwrappedEntryNode) {
+    this->entryNode = nullptr;
+    if (unwrappedEntryNode
+        && nodeToWrapperMap.find(unwrappedEntryNode)
+               != nodeToWrapperMap.end()) {
+      this->entryNode = nodeToWrapperMap.at(unwrappedEntryNode);
+    }
+  }
+
   ~DGGraphWrapper() {
     for (auto node : this->nodes)
       delete node;
@@ -101,6 +118,39 @@ public:
   DG *wrappedGraph;
   NodeRef entryNode;
   std::unordered_set<NodeRef> nodes;
+
+private:
+  std::unordered_map<DGNode<T> *, NodeRef> nodeToWrapperMap;
+
+  void wrapFrozenGraph(const FrozenDG<T> *frozen) {
+
+    /*
+     * Wrap the nodes following their IDs.
+     */
+    std::vector<NodeRef> wrappers(frozen->getNumberOfNodes());
+    for (auto nodeID = 0u; nodeID < frozen->getNumberOfNodes(); nodeID++) {
+      auto node = frozen->getNode(nodeID);
+      auto wrappedNode = new DGNodeWrapper<T>(node);
+      wrappers[nodeID] = wrappedNode;
+      this->nodes.insert(wrappedNode);
+      nodeToWrapperMap.insert(std::make_pair(node, wrappedNode));
+    }
+
+    this->setEntryNode(this->wrappedGraph->getEntryNode());
+
+    /*
+     * Connect the wrappers.
+     * The outgoing edges of a node are sorted as in the mutable form.
+     */
+    for (auto nodeID = 0u; nodeID < frozen->getNumberOfNodes(); nodeID++) {
+      auto wrappedNode = wrappers[nodeID];
+      for (auto edgeID : frozen->getOutgoingEdgeIDs(nodeID)) {
+        wrappedNode->outgoingNodeInstances.push_back(
+            wrappers[frozen->getDstID(edgeID)]);
+        wrappedNode->outgoingEdgeInstances.push_back(frozen->getEdge(edgeID));
+      }
+    }
+  }
 };
 
 template <class T>
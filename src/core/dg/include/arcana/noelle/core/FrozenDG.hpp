@@ -0,0 +1,355 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Yian Su, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_DG_FROZENDG_H_
+#define NOELLE_SRC_CORE_DG_FROZENDG_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/DGNode.hpp"
+#include "arcana/noelle/core/DGEdge.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Read-optimized form of a dependence graph.
+ *
+ * Nodes and edges are numbered densely.
+ * The adjacency is stored in compressed sparse row (CSR) form: the outgoing
+ * (incoming) edges of node N are the IDs stored between offsets N and N+1.
+ * The attributes of the edges are stored as a structure of arrays, so
+ * traversals that filter edges by kind do not dereference the edges.
+ *
+ * Nodes and edges are numbered following the sets of the graph (i.e., by
+ * increasing address of their objects), and the edges of a node are stored by
+ * increasing ID.
+ * Hence, the edges of a node follow the order of DG::getEdges(), not the one
+ * of the (unordered) edge sets of DGNode.
+ */
+template <class T>
+class FrozenDG {
+public:
+  FrozenDG(const std::set<DGNode<T> *> &nodes,
+           const std::set<DGEdge<T, T> *> &edges);
+
+  uint32_t getNumberOfNodes(void) const;
+
+  uint32_t getNumberOfEdges(void) const;
+
+  bool hasNode(T *theT) const;
+
+  uint32_t getNodeID(T *theT) const;
+
+  uint32_t getNodeID(DGNode<T> *node) const;
+
+  DGNode<T> *getNode(uint32_t nodeID) const;
+
+  T *getT(uint32_t nodeID) const;
+
+  DGEdge<T, T> *getEdge(uint32_t edgeID) const;
+
+  uint32_t getSrcID(uint32_t edgeID) const;
+
+  uint32_t getDstID(uint32_t edgeID) const;
+
+  typename DGEdge<T, T>::DependenceKind getKind(uint32_t edgeID) const;
+
+  iterator_range<const uint32_t *> getOutgoingEdgeIDs(uint32_t nodeID) const;
+
+  iterator_range<const uint32_t *> getIncomingEdgeIDs(uint32_t nodeID) const;
+
+  /*
+   * Iterate over the edges that start from (end to) the node of @theT and
+   * that are of the kinds specified until @f returns true.
+   *
+   * Return true if the iteration ended earlier.
+   */
+  template <class CallbackFunction>
+  bool iterateOverEdgesFrom(T *theT,
+                            bool includeControl,
+                            bool includeMemoryData,
+                            bool includeRegisterData,
+                            CallbackFunction &&f) const;
+
+  template <class CallbackFunction>
+  bool iterateOverEdgesTo(T *theT,
+                          bool includeControl,
+                          bool includeMemoryData,
+                          bool includeRegisterData,
+                          CallbackFunction &&f) const;
+
+private:
+  std::vector<DGNode<T> *> nodes;
+  std::vector<T *> values;
+  std::unordered_map<T *, uint32_t> valueIDs;
+
+  /*
+   * Adjacency in CSR form.
+   */
+  std::vector<uint32_t> outgoingOffsets;
+  std::vector<uint32_t> outgoingEdgeIDs;
+  std::vector<uint32_t> incomingOffsets;
+  std::vector<uint32_t> incomingEdgeIDs;
+
+  /*
+   * Attributes of the edges.
+   */
+  std::vector<DGEdge<T, T> *> edges;
+  std::vector<uint32_t> srcIDs;
+  std::vector<uint32_t> dstIDs;
+  std::vector<uint8_t> kinds;
+
+  bool isIncluded(uint32_t edgeID,
+                  bool includeControl,
+                  bool includeMemoryData,
+                  bool includeRegisterData) const;
+
+  static void buildCSR(const std::vector<uint32_t> &endpoints,
+                       uint32_t numberOfNodes,
+                       std::vector<uint32_t> &offsets,
+                       std::vector<uint32_t> &edgeIDs);
+};
+
+template <class T>
+FrozenDG<T>::FrozenDG(const std::set<DGNode<T> *> &nodes,
+                      const std::set<DGEdge<T, T> *> &edges) {
+
+  /*
+   * Number the nodes.
+   */
+  this->nodes.reserve(nodes.size());
+  this->values.reserve(nodes.size());
+  this->valueIDs.reserve(nodes.size());
+  for (auto node : nodes) {
+    auto nodeID = (uint32_t)this->nodes.size();
+    this->nodes.push_back(node);
+    this->values.push_back(node->getT());
+    this->valueIDs[node->getT()] = nodeID;
+  }
+
+  /*
+   * Number the edges and store their attributes.
+   */
+  this->edges.reserve(edges.size());
+  this->srcIDs.reserve(edges.size());
+  this->dstIDs.reserve(edges.size());
+  this->kinds.reserve(edges.size());
+  for (auto edge : edges) {
+    this->edges.push_back(edge);
+    this->srcIDs.push_back(this->valueIDs.at(edge->getSrc()));
+    this->dstIDs.push_back(this->valueIDs.at(edge->getDst()));
+    this->kinds.push_back((uint8_t)edge->getKind());
+  }
+
+  /*
+   * Build the adjacency.
+   */
+  FrozenDG<T>::buildCSR(this->srcIDs,
+                        this->nodes.size(),
+                        this->outgoingOffsets,
+                        this->outgoingEdgeIDs);
+  FrozenDG<T>::buildCSR(this->dstIDs,
+                        this->nodes.size(),
+                        this->incomingOffsets,
+                        this->incomingEdgeIDs);
+
+  return;
+}
+
+template <class T>
+void FrozenDG<T>::buildCSR(const std::vector<uint32_t> &endpoints,
+                           uint32_t numberOfNodes,
+                           std::vector<uint32_t> &offsets,
+                           std::vector<uint32_t> &edgeIDs) {
+
+  /*
+   * Count the edges of every node.
+   */
+  offsets.assign(numberOfNodes + 1, 0);
+  for (auto nodeID : endpoints) {
+    offsets[nodeID + 1]++;
+  }
+  for (auto i = 0u; i < numberOfNodes; i++) {
+    offsets[i + 1] += offsets[i];
+  }
+
+  /*
+   * Place the edges.
+   * Edges are visited following their IDs, so the edges of a node keep the
+   * order of the edge set.
+   */
+  std::vector<uint32_t> next(offsets.begin(), offsets.end() - 1);
+  edgeIDs.resize(endpoints.size());
+  for (auto edgeID = 0u; edgeID < endpoints.size(); edgeID++) {
+    edgeIDs[next[endpoints[edgeID]]++] = edgeID;
+  }
+
+  return;
+}
+
+template <class T>
+uint32_t FrozenDG<T>::getNumberOfNodes(void) const {
+  return this->nodes.size();
+}
+
+template <class T>
+uint32_t FrozenDG<T>::getNumberOfEdges(void) const {
+  return this->edges.size();
+}
+
+template <class T>
+bool FrozenDG<T>::hasNode(T *theT) const {
+  return this->valueIDs.find(theT) != this->valueIDs.end();
+}
+
+template <class T>
+uint32_t FrozenDG<T>::getNodeID(T *theT) const {
+  return this->valueIDs.at(theT);
+}
+
+template <class T>
+uint32_t FrozenDG<T>::getNodeID(DGNode<T> *node) const {
+  return this->valueIDs.at(node->getT());
+}
+
+template <class T>
+DGNode<T> *FrozenDG<T>::getNode(uint32_t nodeID) const {
+  return this->nodes[nodeID];
+}
+
+template <class T>
+T *FrozenDG<T>::getT(uint32_t nodeID) const {
+  return this->values[nodeID];
+}
+
+template <class T>
+DGEdge<T, T> *FrozenDG<T>::getEdge(uint32_t edgeID) const {
+  return this->edges[edgeID];
+}
+
+template <class T>
+uint32_t FrozenDG<T>::getSrcID(uint32_t edgeID) const {
+  return this->srcIDs[edgeID];
+}
+
+template <class T>
+uint32_t FrozenDG<T>::getDstID(uint32_t edgeID) const {
+  return this->dstIDs[edgeID];
+}
+
+template <class T>
+typename DGEdge<T, T>::DependenceKind FrozenDG<T>::getKind(
+    uint32_t edgeID) const {
+  return static_cast<typename DGEdge<T, T>::DependenceKind>(
+      this->kinds[edgeID]);
+}
+
+template <class T>
+iterator_range<const uint32_t *> FrozenDG<T>::getOutgoingEdgeIDs(
+    uint32_t nodeID) const {
+  auto base = this->outgoingEdgeIDs.data();
+  return make_range(base + this->outgoingOffsets[nodeID],
+                    base + this->outgoingOffsets[nodeID + 1]);
+}
+
+template <class T>
+iterator_range<const uint32_t *> FrozenDG<T>::getIncomingEdgeIDs(
+    uint32_t nodeID) const {
+  auto base = this->incomingEdgeIDs.data();
+  return make_range(base + this->incomingOffsets[nodeID],
+                    base + this->incomingOffsets[nodeID + 1]);
+}
+
+template <class T>
+bool FrozenDG<T>::isIncluded(uint32_t edgeID,
+                             bool includeControl,
+                             bool includeMemoryData,
+                             bool includeRegisterData) const {
+  using Edge = DGEdge<T, T>;
+  auto kind = this->kinds[edgeID];
+  if (kind == Edge::CONTROL_DEPENDENCE) {
+    return includeControl;
+  }
+  if ((kind >= Edge::FIRST_MEMORY_DEPENDENCE)
+      && (kind <= Edge::LAST_MEMORY_DEPENDENCE)) {
+    return includeMemoryData;
+  }
+  if (kind == Edge::VARIABLE_DEPENDENCE) {
+    return includeRegisterData;
+  }
+
+  return false;
+}
+
+template <class T>
+template <class CallbackFunction>
+bool FrozenDG<T>::iterateOverEdgesFrom(T *theT,
+                                       bool includeControl,
+                                       bool includeMemoryData,
+                                       bool includeRegisterData,
+                                       CallbackFunction &&f) const {
+  auto it = this->valueIDs.find(theT);
+  if (it == this->valueIDs.end()) {
+    return false;
+  }
+  for (auto edgeID : this->getOutgoingEdgeIDs(it->second)) {
+    if (!this->isIncluded(edgeID,
+                          includeControl,
+                          includeMemoryData,
+                          includeRegisterData)) {
+      continue;
+    }
+    if (f(this->values[this->dstIDs[edgeID]], this->edges[edgeID])) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+template <class T>
+template <class CallbackFunction>
+bool FrozenDG<T>::iterateOverEdgesTo(T *theT,
+                                     bool includeControl,
+                                     bool includeMemoryData,
+                                     bool includeRegisterData,
+                                     CallbackFunction &&f) const {
+  auto it = this->valueIDs.find(theT);
+  if (it == this->valueIDs.end()) {
+    return false;
+  }
+  for (auto edgeID : this->getIncomingEdgeIDs(it->second)) {
+    if (!this->isIncluded(edgeID,
+                          includeControl,
+                          includeMemoryData,
+                          includeRegisterData)) {
+      continue;
+    }
+    if (f(this->values[this->srcIDs[edgeID]], this->edges[edgeID])) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_DG_FROZENDG_H_
@@ -0,0 +1,87 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Yian Su, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/DGArena.hpp"
+
+namespace arcana::noelle {
+
+DGArena::DGArena() : bytesInUse{ 0 },
+                     bytesToRecycle{ 0 },
+                     recycledObjects{ 0 } {
+  return;
+}
+
+void *DGArena::allocate(size_t size, size_t alignment) {
+  this->bytesInUse += size;
+
+  /*
+   * Check if there is memory of a destroyed object of the same size.
+   */
+  auto freeListIt = this->freeLists.find(size);
+  if ((freeListIt != this->freeLists.end())
+      && (!freeListIt->second.empty())) {
+    auto memory = freeListIt->second.back();
+    freeListIt->second.pop_back();
+    this->bytesToRecycle -= size;
+    this->recycledObjects++;
+    return memory;
+  }
+
+  /*
+   * Allocate new memory from the current slab.
+   */
+  auto memory = this->allocator.Allocate(size, Align(alignment));
+
+  return memory;
+}
+
+void DGArena::deallocate(void *memory, size_t size, bool recycle) {
+  this->bytesInUse -= size;
+  if (!recycle) {
+    return;
+  }
+
+  /*
+   * Keep the memory for the next object of the same size.
+   */
+  this->freeLists[size].push_back(memory);
+  this->bytesToRecycle += size;
+
+  return;
+}
+
+uint64_t DGArena::getNumberOfBytesReserved(void) const {
+  return this->allocator.getTotalMemory();
+}
+
+uint64_t DGArena::getNumberOfBytesInUse(void) const {
+  return this->bytesInUse;
+}
+
+uint64_t DGArena::getNumberOfBytesToRecycle(void) const {
+  return this->bytesToRecycle;
+}
+
+uint64_t DGArena::getNumberOfRecycledObjects(void) const {
+  return this->recycledObjects;
+}
+
+} // namespace arcana::noelle
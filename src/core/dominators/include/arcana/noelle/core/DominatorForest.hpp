@@ -81,6 +81,8 @@ private:
   void cloneLLVMNodes(std::set<DTAliases::Node *> &nodesToClone);
 
   void addDescendants(DominatorNode *n, std::set<BasicBlock *> &ds) const;
+
+  void numberNodes(void);
 };
 
 } // namespace arcana::noelle
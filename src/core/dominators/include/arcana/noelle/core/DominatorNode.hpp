@@ -51,6 +51,14 @@ private:
 
   DominatorNode *parent;
   std::vector<DominatorNode *> children;
+
+  /*
+   * Depth-first numbering of the tree the node belongs to.
+   * The descendants of the node are the nodes numbered within
+   * [preOrder, postOrder].
+   */
+  uint32_t preOrder;
+  uint32_t postOrder;
 };
 
 } // namespace arcana::noelle
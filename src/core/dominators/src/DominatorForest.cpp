@@ -39,12 +39,14 @@ DominatorForest::DominatorForest(std::set<DTAliases::Node *> nodeSubset)
   : nodes{},
     bbNodeMap{} {
   this->cloneLLVMNodes(nodeSubset);
+  this->numberNodes();
   return;
 }
 
 DominatorForest::DominatorForest(DominatorForest &DTS,
                                  std::set<BasicBlock *> &bbSubset)
   : DominatorForest{ filterNodes(DTS.nodes, bbSubset) } {
+  this->post = DTS.post;
   return;
 }
 
@@ -52,6 +54,7 @@ DominatorForest::DominatorForest(std::set<DominatorNode *> nodeSubset)
   : nodes{},
     bbNodeMap{} {
   this->cloneNodes<DominatorNode>(nodeSubset);
+  this->numberNodes();
   return;
 }
 
@@ -64,10 +67,50 @@ DominatorForest::~DominatorForest() {
 
 void DominatorForest::transferToClones(
     std::unordered_map<BasicBlock *, BasicBlock *> &bbCloneMap) {
+
+  /*
+   * The shape of the forest does not change, so the numbering of its nodes
+   * stays valid.
+   */
+  this->bbNodeMap.clear();
   for (auto node : nodes) {
     assert(bbCloneMap.find(node->B) != bbCloneMap.end());
     node->B = bbCloneMap[node->B];
+    this->bbNodeMap[node->B] = node;
+  }
+}
+
+void DominatorForest::numberNodes(void) {
+
+  /*
+   * Number the nodes of every tree of the forest in depth-first order.
+   * The stack holds the nodes being visited and the index of the next child
+   * to visit.
+   */
+  uint32_t counter = 0;
+  std::vector<std::pair<DominatorNode *, uint32_t>> stack;
+  for (auto root : this->nodes) {
+    if (root->parent != nullptr) {
+      continue;
+    }
+    root->preOrder = counter++;
+    stack.push_back({ root, 0 });
+    while (!stack.empty()) {
+      auto &top = stack.back();
+      auto node = top.first;
+      if (top.second < node->children.size()) {
+        auto child = node->children[top.second];
+        top.second++;
+        child->preOrder = counter++;
+        stack.push_back({ child, 0 });
+        continue;
+      }
+      node->postOrder = counter++;
+      stack.pop_back();
+    }
   }
+
+  return;
 }
 
 template <typename TreeType>
@@ -186,56 +229,27 @@ bool DominatorForest::dominates(Instruction *I, Instruction *J) const {
   if (B1 == B2) {
 
     /*
-     * Define the first and second instruction.
-     */
-    auto firstOne = I;
-    auto secondOne = J;
-
-    /*
-     * Check the dominance relation between I and J
+     * The order of the instructions within a basic block is cached by LLVM and
+     * it is kept up to date when instructions are added or moved.
      */
-    while (firstOne != nullptr) {
-      if (firstOne == secondOne) {
-
-        /*
-         * The secondOne instruction is found after the first one.
-         * Hence, I dominates J.
-         * Also, J postdominates I.
-         */
-        if (this->post) {
-
-          /*
-           * I does not post-dominate J.
-           */
-          return false;
-        }
-
-        /*
-         * I dominates J
-         */
-        return true;
-      }
-
-      firstOne = firstOne->getNextNode();
-    }
-
-    /*
-     * The secondOne instruction has not been found after the first one.
-     * Hence, J dominates I.
-     * Also, I post-dominates J.
-     */
-    if (this->post) {
+    if (I == J) {
 
       /*
-       * I post-dominates J.
+       * An instruction dominates itself, but it is not considered to
+       * post-dominate itself.
        */
-      return true;
+      return !this->post;
     }
+    auto IComesFirst = I->comesBefore(J);
 
     /*
-     * I does not dominates J.
+     * If I comes first, then I dominates J and J postdominates I.
+     * Otherwise, J dominates I and I post-dominates J.
      */
-    return false;
+    if (this->post) {
+      return !IComesFirst;
+    }
+    return IComesFirst;
   }
 
   /*
@@ -275,20 +289,13 @@ bool DominatorForest::strictlyDominates(BasicBlock *B1, BasicBlock *B2) const {
 
 bool DominatorForest::dominates(DominatorNode *node1,
                                 DominatorNode *node2) const {
-  std::queue<DominatorNode *> worklist;
-  worklist.push(node1);
-  while (!worklist.empty()) {
-    auto node = worklist.front();
-    worklist.pop();
-
-    if (node == node2) {
-      return true;
-    }
-    for (auto child : node->children)
-      worklist.push(child);
-  }
 
-  return false;
+  /*
+   * @node1 dominates @node2 if @node2 is numbered within the subtree of
+   * @node1.
+   */
+  return (node1->preOrder <= node2->preOrder)
+         && (node2->postOrder <= node1->postOrder);
 }
 
 std::set<DominatorNode *> DominatorForest::dominates(
@@ -418,19 +425,11 @@ DominatorNode *DominatorForest::findNearestCommonDominator(
     DominatorNode *node1,
     DominatorNode *node2) const {
 
-  /*
-   * Helpers to determine whether a node n dominates node2
-   */
-  auto dominatorsOf2 = this->dominates(node2);
-  auto dominates2 = [&](DominatorNode *node) -> bool {
-    return dominatorsOf2.find(node) != dominatorsOf2.end();
-  };
-
   /*
    * Traversal of parents of node1 to find common dominator
    */
   DominatorNode *node = node1;
-  while (node && !dominates2(node))
+  while (node && !this->dominates(node, node2))
     node = node->parent;
   return node;
 }
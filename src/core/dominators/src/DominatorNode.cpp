@@ -27,7 +27,9 @@ DominatorNode::DominatorNode(const DTAliases::Node &node)
   : B{ node.getBlock() },
     level{ node.getLevel() },
     parent{ nullptr },
-    children{} {
+    children{},
+    preOrder{ 0 },
+    postOrder{ 0 } {
 
   return;
 }
@@ -36,7 +38,9 @@ DominatorNode::DominatorNode(const DominatorNode &node)
   : B{ node.getBlock() },
     level{ node.getLevel() },
     parent{ nullptr },
-    children{} {
+    children{},
+    preOrder{ 0 },
+    postOrder{ 0 } {
 
   return;
 }
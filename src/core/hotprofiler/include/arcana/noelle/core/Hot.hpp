@@ -166,6 +166,12 @@ public:
    */
   double getBranchFrequency(BasicBlock *sourceBB, BasicBlock *targetBB) const;
 
+  /*
+   * Recompute the aggregated counters of the code of @f (e.g., because it has
+   * been modified).
+   */
+  void invalidate(Function *f);
+
 private:
   std::unordered_map<BasicBlock *, std::unordered_map<BasicBlock *, double>>
       branchProbability;
@@ -174,6 +180,9 @@ private:
   std::unordered_map<Function *, uint64_t> functionSelfInstructions;
   std::unordered_map<Function *, uint64_t> functionTotalInstructions;
   std::unordered_map<Instruction *, uint64_t> instructionTotalInstructions;
+  std::unordered_map<BasicBlock *, uint64_t> bbTotalInstructions;
+  mutable std::unordered_map<BasicBlock *, uint64_t>
+      loopTotalInstructions; /* Indexed by the header of the loop. */
   uint64_t moduleNumberOfInstructionsExecuted;
   std::function<llvm::BlockFrequencyInfo &(Function &F)> getBFI;
   std::function<llvm::BranchProbabilityInfo &(Function &F)> getBPI;
@@ -190,6 +199,8 @@ private:
 
   void setBasicBlockInvocations(BasicBlock *bb, uint64_t invocations);
 
+  void computeBasicBlockTotalInstructions(BasicBlock *bb);
+
   void setBranchFrequency(BasicBlock *src,
                           BasicBlock *dst,
                           double branchFrequency);
@@ -163,6 +163,36 @@ void Hot::computeProgramInvocations(Module &M) {
    */
   this->computeTotalInstructions(M);
 
+  /*
+   * Aggregate the total instructions of each basic block.
+   * The aggregates of loops are built on top of them when first requested.
+   */
+  for (auto pairs : this->bbInvocations) {
+    this->computeBasicBlockTotalInstructions(pairs.first);
+  }
+
+  return;
+}
+
+void Hot::invalidate(Function *f) {
+  assert(f != nullptr);
+
+  /*
+   * Loops of @f might have changed their blocks or might have been removed.
+   * Hence, forget all of them.
+   */
+  this->loopTotalInstructions.clear();
+
+  /*
+   * Recompute the aggregates of the basic blocks we have profiles for.
+   */
+  for (auto &bb : *f) {
+    if (this->bbInvocations.find(&bb) == this->bbInvocations.end()) {
+      continue;
+    }
+    this->computeBasicBlockTotalInstructions(&bb);
+  }
+
   return;
 }
 
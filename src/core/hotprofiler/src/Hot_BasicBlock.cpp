@@ -70,8 +70,19 @@ uint64_t Hot::getSelfInstructions(BasicBlock *bb) const {
 }
 
 uint64_t Hot::getTotalInstructions(BasicBlock *bb) const {
-  uint64_t t = 0;
 
+  /*
+   * Check if the total has been aggregated already.
+   */
+  auto it = this->bbTotalInstructions.find(bb);
+  if (it != this->bbTotalInstructions.end()) {
+    return it->second;
+  }
+
+  /*
+   * Aggregate the total.
+   */
+  uint64_t t = 0;
   for (auto &inst : *bb) {
     t += this->getTotalInstructions(&inst);
   }
@@ -79,6 +90,17 @@ uint64_t Hot::getTotalInstructions(BasicBlock *bb) const {
   return t;
 }
 
+void Hot::computeBasicBlockTotalInstructions(BasicBlock *bb) {
+  uint64_t t = 0;
+
+  for (auto &inst : *bb) {
+    t += this->getTotalInstructions(&inst);
+  }
+  this->bbTotalInstructions[bb] = t;
+
+  return;
+}
+
 uint64_t Hot::getStaticInstructions(BasicBlock *bb) const {
   auto bbLength = std::distance(bb->begin(), bb->end());
   assert(bbLength > 0);
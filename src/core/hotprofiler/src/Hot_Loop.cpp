@@ -78,11 +78,26 @@ uint64_t Hot::getSelfInstructions(LoopStructure *loop) const {
 }
 
 uint64_t Hot::getTotalInstructions(LoopStructure *loop) const {
-  uint64_t insts = 0;
 
+  /*
+   * Check if the total has been aggregated already.
+   * Loops are identified by their header because LoopStructure objects are
+   * re-allocated every time the loops of a function are fetched.
+   */
+  auto header = loop->getHeader();
+  auto it = this->loopTotalInstructions.find(header);
+  if (it != this->loopTotalInstructions.end()) {
+    return it->second;
+  }
+
+  /*
+   * Aggregate the total.
+   */
+  uint64_t insts = 0;
   for (auto bb : loop->getBasicBlocks()) {
     insts += this->getTotalInstructions(bb);
   }
+  this->loopTotalInstructions[header] = insts;
 
   return insts;
 }
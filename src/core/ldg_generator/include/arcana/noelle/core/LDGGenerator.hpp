@@ -25,6 +25,9 @@
 #include "arcana/noelle/core/SystemHeaders.hpp"
 #include "arcana/noelle/core/CompilationOptionsManager.hpp"
 #include "arcana/noelle/core/DependenceAnalysis.hpp"
+#include "arcana/noelle/core/DependenceAnalysisPipeline.hpp"
+#include "arcana/noelle/core/DependenceQueryCache.hpp"
+#include "arcana/noelle/core/InstructionReachabilityCache.hpp"
 #include "arcana/noelle/core/PDG.hpp"
 #include "arcana/noelle/core/LoopStructure.hpp"
 #include "arcana/noelle/core/InductionVariables.hpp"
@@ -44,6 +47,16 @@ public:
 
   void enableLoopDependenceAnalyses(bool enabled);
 
+  /*
+   * Memoize the answers of the loop-centric dependence analyses in @cache.
+   */
+  void setDependenceQueryCache(DependenceQueryCache *cache);
+
+  /*
+   * Fetch the reachability of the instructions of loops from @cache.
+   */
+  void setInstructionReachabilityCache(InstructionReachabilityCache *cache);
+
   PDG *generateLoopDependenceGraph(PDG *functionDG,
                                    ScalarEvolution &scalarEvolution,
                                    DominatorSummary &DS,
@@ -53,13 +66,24 @@ public:
 
   SCCDAG *computeSCCDAGWithOnlyVariableAndControlDependences(PDG *loopDG);
 
+  /*
+   * Return the dependence analyses with their statistics.
+   */
+  const DependenceAnalysisPipeline &getDependenceAnalyses(void) const;
+
   static std::set<AliasAnalysisEngine *> getLoopAliasAnalysisEngines(void);
 
 private:
-  std::set<DependenceAnalysis *> ddAnalyses;
+  DependenceAnalysisPipeline ddAnalyses;
   bool loopDependenceAnalysesEnabled;
+  DependenceQueryCache *queryCache;
+  InstructionReachabilityCache *reachabilityCache;
 
   void removeDependences(PDG *loopDG, LoopStructure *loop);
+  std::vector<uint8_t> queryTheCache(
+      const std::vector<DependenceQueryCache::Query> &queries,
+      std::function<std::vector<uint8_t>(
+          const std::vector<uint64_t> &queryIndexes)> answer);
   void removeLoopCarriedDependences(PDG *loopDG, LoopStructure *loop);
   void runAffineAnalysis(PDG &loopDG,
                          ScalarEvolution &scalarEvolution,
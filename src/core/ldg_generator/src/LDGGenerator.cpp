@@ -19,74 +19,16 @@
  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
  OR OTHER DEALINGS IN THE SOFTWARE.
  */
+#include <chrono>
+#include <numeric>
+
 #include "arcana/noelle/core/LDGGenerator.hpp"
 #include "arcana/noelle/core/LoopIterationSpaceAnalysis.hpp"
 #include "arcana/noelle/core/LoopCarriedDependencies.hpp"
-#include "arcana/noelle/core/DataFlow.hpp"
 #include "LoopAwareMemDepAnalysis.hpp"
 
 namespace arcana::noelle {
 
-// TODO: Refactor along with HELIX's exact same implementation of this method
-DataFlowResult *computeReachabilityFromInstructions(
-    LoopStructure *loopStructure) {
-  assert(loopStructure != nullptr);
-
-  auto loopHeader = loopStructure->getHeader();
-  auto loopFunction = loopStructure->getFunction();
-
-  /*
-   * Run the data flow analysis needed to identify the locations where signal
-   * instructions will be placed.
-   */
-  auto dfa = DataFlowEngine{};
-  auto computeGEN = [](Instruction *i, DataFlowResult *df) {
-    assert(i != nullptr);
-    assert(df != nullptr);
-    auto &gen = df->GEN(i);
-    gen.insert(i);
-    return;
-  };
-  auto computeOUT = [loopHeader](Instruction *inst,
-                                 Instruction *succ,
-                                 std::set<Value *> &OUT,
-                                 DataFlowResult *df) {
-    assert(succ != nullptr);
-    assert(df != nullptr);
-
-    /*
-     * Check if the successor is the header.
-     * In this case, we do not propagate the reachable instructions.
-     * We do this because we are interested in understanding the reachability of
-     * instructions within a single iteration.
-     */
-    auto succBB = succ->getParent();
-    if (succBB == loopHeader) {
-      return;
-    }
-
-    /*
-     * Propagate the data flow values.
-     */
-    auto &inS = df->IN(succ);
-    OUT.insert(inS.begin(), inS.end());
-    return;
-  };
-  auto computeIN =
-      [](Instruction *inst, std::set<Value *> &IN, DataFlowResult *df) {
-        assert(inst != nullptr);
-        assert(df != nullptr);
-
-        auto &genI = df->GEN(inst);
-        auto &outI = df->OUT(inst);
-        IN.insert(outI.begin(), outI.end());
-        IN.insert(genI.begin(), genI.end());
-        return;
-      };
-
-  return dfa.applyBackward(loopFunction, computeGEN, computeIN, computeOUT);
-}
-
 void LDGGenerator::improveDependenceGraph(PDG *loopDG, LoopStructure *loop) {
 
   /*
@@ -108,9 +50,9 @@ void LDGGenerator::removeDependences(PDG *loopDG, LoopStructure *loop) {
   auto deps = loopDG->getSortedDependences();
 
   /*
-   * Identify dependences to remove.
+   * Identify the dependences that the analyses can try to remove.
    */
-  std::set<DGEdge<Value, Value> *> toDelete{};
+  std::vector<MemoryDependence<Value, Value> *> candidates{};
   for (auto dep : deps) {
 
     /*
@@ -153,51 +95,192 @@ void LDGGenerator::removeDependences(PDG *loopDG, LoopStructure *loop) {
       continue;
     }
 
+    candidates.push_back(memDep);
+  }
+
+  /*
+   * Try to remove the memory dependences.
+   *
+   * Every analysis is asked about all dependences that the previous analyses
+   * could not remove, so the queries to the same analysis are batched.
+   * Queries are about the loop identified by its header.
+   */
+  auto header = loop->getHeader();
+  for (auto dda : this->ddAnalyses.getAnalyses()) {
+    if (candidates.empty()) {
+      break;
+    }
+
+    /*
+     * Check if the analysis can remove dependences of the loop.
+     */
+    if (!dda->canRemoveDependencesOf(*loop)) {
+      continue;
+    }
+    auto id = (this->queryCache != nullptr)
+                  ? this->queryCache->getAnalysisID(dda, dda->getName())
+                  : 0;
+
     /*
-     * Try to remove the current memory dependence.
+     * Check if the dependences can exist.
      */
-    for (auto dda : this->ddAnalyses) {
-      if (!dda->canThereBeAMemoryDataDependence(srcInst, dstInst, *loop)) {
-        toDelete.insert(memDep);
-        break;
+    std::vector<DependenceQueryCache::Query> queries{};
+    for (auto memDep : candidates) {
+      queries.push_back({ DependenceQueryCache::CAN_THERE_BE_A_DEPENDENCE,
+                          id,
+                          memDep->getSrc(),
+                          memDep->getDst(),
+                          header,
+                          0 });
+    }
+    auto canExist = this->queryTheCache(
+        queries,
+        [this, dda, loop, &candidates](
+            const std::vector<uint64_t> &queryIndexes)
+            -> std::vector<uint8_t> {
+          std::vector<std::pair<Instruction *, Instruction *>> pairs;
+          for (auto i : queryIndexes) {
+            pairs.push_back(
+                std::make_pair(cast<Instruction>(candidates[i]->getSrc()),
+                               cast<Instruction>(candidates[i]->getDst())));
+          }
+          auto start = std::chrono::steady_clock::now();
+          auto answers = dda->canThereBeMemoryDataDependences(pairs, *loop);
+          auto end = std::chrono::steady_clock::now();
+          assert(answers.size() == pairs.size());
+          auto removed = std::count(answers.begin(), answers.end(), false);
+          this->ddAnalyses.account(
+              dda,
+              pairs.size(),
+              removed,
+              std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+                  .count());
+
+          return std::vector<uint8_t>(answers.begin(), answers.end());
+        });
+
+    /*
+     * Check if the dependences that can exist are of their type.
+     */
+    std::vector<MemoryDependence<Value, Value> *> remaining{};
+    queries.clear();
+    for (auto i = 0u; i < candidates.size(); i++) {
+      auto memDep = candidates[i];
+      if (!canExist[i]) {
+        loopDG->removeEdge(memDep);
+        continue;
       }
-      auto r = dda->isThereThisMemoryDataDependenceType(
-          memDep->getDataDependenceType(),
-          srcInst,
-          dstInst,
-          *loop);
-      switch (r) {
-
-        case MemoryDataDependenceStrength::CANNOT_EXIST:
-          toDelete.insert(memDep);
-          break;
-
-        default:
-          break;
+      remaining.push_back(memDep);
+      queries.push_back(
+          { DependenceQueryCache::DEPENDENCE_TYPE,
+            id,
+            memDep->getSrc(),
+            memDep->getDst(),
+            header,
+            static_cast<uint8_t>(memDep->getDataDependenceType()) });
+    }
+    auto strengths = this->queryTheCache(
+        queries,
+        [this, dda, loop, &remaining](
+            const std::vector<uint64_t> &queryIndexes)
+            -> std::vector<uint8_t> {
+          std::vector<DataDependenceType> types;
+          std::vector<std::pair<Instruction *, Instruction *>> pairs;
+          for (auto i : queryIndexes) {
+            auto memDep = remaining[i];
+            types.push_back(memDep->getDataDependenceType());
+            pairs.push_back(
+                std::make_pair(cast<Instruction>(memDep->getSrc()),
+                               cast<Instruction>(memDep->getDst())));
+          }
+          auto start = std::chrono::steady_clock::now();
+          auto answers =
+              dda->areThereTheseMemoryDataDependenceTypes(types, pairs, *loop);
+          auto end = std::chrono::steady_clock::now();
+          assert(answers.size() == pairs.size());
+          auto removed = std::count(answers.begin(),
+                                    answers.end(),
+                                    MemoryDataDependenceStrength::CANNOT_EXIST);
+          this->ddAnalyses.account(
+              dda,
+              pairs.size(),
+              removed,
+              std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+                  .count());
+
+          return std::vector<uint8_t>(answers.begin(), answers.end());
+        });
+
+    /*
+     * Remove the dependences that cannot exist.
+     */
+    candidates.clear();
+    for (auto i = 0u; i < remaining.size(); i++) {
+      auto memDep = remaining[i];
+      if (strengths[i] == MemoryDataDependenceStrength::CANNOT_EXIST) {
+        loopDG->removeEdge(memDep);
+        continue;
       }
+      candidates.push_back(memDep);
     }
   }
 
+  return;
+}
+
+std::vector<uint8_t> LDGGenerator::queryTheCache(
+    const std::vector<DependenceQueryCache::Query> &queries,
+    std::function<std::vector<uint8_t>(
+        const std::vector<uint64_t> &queryIndexes)> answer) {
+
   /*
-   * Remove dependences.
+   * Check if answers are memoized.
    */
-  for (auto dep : toDelete) {
-    loopDG->removeEdge(dep);
+  if (this->queryCache != nullptr) {
+    return this->queryCache->queryAll(queries, answer);
   }
 
+  /*
+   * Compute all answers.
+   */
+  std::vector<uint64_t> queryIndexes(queries.size());
+  std::iota(queryIndexes.begin(), queryIndexes.end(), 0);
+
+  return answer(queryIndexes);
+}
+
+void LDGGenerator::setDependenceQueryCache(DependenceQueryCache *cache) {
+  this->queryCache = cache;
+
+  return;
+}
+
+void LDGGenerator::setInstructionReachabilityCache(
+    InstructionReachabilityCache *cache) {
+  this->reachabilityCache = cache;
+
   return;
 }
 
-LDGGenerator::LDGGenerator() {
+LDGGenerator::LDGGenerator()
+  : queryCache{ nullptr },
+    reachabilityCache{ nullptr } {
   return;
 }
 
 void LDGGenerator::addAnalysis(DependenceAnalysis *a) {
-  this->ddAnalyses.insert(a);
+  this->ddAnalyses.addAnalysis(a);
 }
 
 void LDGGenerator::removeAnalysis(DependenceAnalysis *a) {
-  this->ddAnalyses.erase(a);
+  this->ddAnalyses.removeAnalysis(a);
+
+  /*
+   * Forget the answers given by @a.
+   */
+  if (this->queryCache != nullptr) {
+    this->queryCache->invalidate(a);
+  }
 }
 
 PDG *LDGGenerator::generateLoopDependenceGraph(PDG *functionDG,
@@ -324,7 +407,7 @@ PDG *LDGGenerator::generateLoopDependenceGraph(PDG *functionDG,
     /*
      * Run SCAF.
      */
-    refinePDGWithSCAF(loopDG, loopNode);
+    refinePDGWithSCAF(loopDG, loopNode, this->queryCache);
 
     /*
      * Run the iteration space analysis.
@@ -357,9 +440,12 @@ void LDGGenerator::runAffineAnalysis(PDG &loopDG,
       LoopIterationSpaceAnalysis(&loopNode, ivManager, scalarEvolution);
 
   /*
-   * Compute the reachability of instructions within the loop.
+   * Fetch the reachability of instructions within an iteration of the loop.
    */
-  auto dfr = computeReachabilityFromInstructions(loopStructure);
+  auto reachability =
+      (this->reachabilityCache != nullptr)
+          ? this->reachabilityCache->getReachability(*loopStructure)
+          : std::make_shared<const InstructionReachability>(*loopStructure);
 
   std::unordered_set<DGEdge<Value, Value> *> edgesToRemove;
   for (auto dependency :
@@ -385,8 +471,7 @@ void LDGGenerator::runAffineAnalysis(PDG &loopDG,
      * remove dependencies between a producer and consumer where we know the
      * producer can NEVER reach the consumer during the same iteration
      */
-    auto &afterInstructions = dfr->OUT(fromInst);
-    if (afterInstructions.find(toInst) != afterInstructions.end()) {
+    if (reachability->canReach(fromInst, toInst)) {
       continue;
     }
 
@@ -403,11 +488,6 @@ void LDGGenerator::runAffineAnalysis(PDG &loopDG,
     loopDG.removeEdge(edge);
   }
 
-  /*
-   * Free the memory
-   */
-  delete dfr;
-
   return;
 }
 
@@ -459,8 +539,20 @@ void LDGGenerator::removeLoopCarriedDependences(PDG *loopDG,
     /*
      * Try to disprove the loop-carried property of the dependence.
      */
-    for (auto dda : this->ddAnalyses) {
-      if (!dda->canThisDependenceBeLoopCarried(dep, *loop)) {
+    for (auto dda : this->ddAnalyses.getAnalyses()) {
+      if (!dda->canRemoveDependencesOf(*loop)) {
+        continue;
+      }
+      auto start = std::chrono::steady_clock::now();
+      auto canBeLoopCarried = dda->canThisDependenceBeLoopCarried(dep, *loop);
+      auto end = std::chrono::steady_clock::now();
+      this->ddAnalyses.account(
+          dda,
+          1,
+          canBeLoopCarried ? 0 : 1,
+          std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+              .count());
+      if (!canBeLoopCarried) {
         dep->setLoopCarried(false);
         break;
       }
@@ -513,4 +605,9 @@ bool LDGGenerator::areLoopDependenceAnalysesEnabled(void) const {
   return this->loopDependenceAnalysesEnabled;
 }
 
+const DependenceAnalysisPipeline &LDGGenerator::getDependenceAnalyses(
+    void) const {
+  return this->ddAnalyses;
+}
+
 } // namespace arcana::noelle
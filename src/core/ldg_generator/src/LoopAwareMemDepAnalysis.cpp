@@ -62,7 +62,9 @@ char NoelleSCAFIntegration::ID = 0;
 static RegisterPass<NoelleSCAFIntegration> X("noelle-scaf",
                                              "Integration with SCAF");
 
-void refinePDGWithSCAF(PDG *loopDG, LoopTree &loopNode) {
+void refinePDGWithSCAF(PDG *loopDG,
+                       LoopTree &loopNode,
+                       DependenceQueryCache *cache) {
 #ifdef NOELLE_ENABLE_SCAF
   assert(NoelleSCAFAA != nullptr);
 
@@ -71,7 +73,33 @@ void refinePDGWithSCAF(PDG *loopDG, LoopTree &loopNode) {
    */
   auto loopStructure = loopNode.getLoop();
   auto li = &ModuleLoops->getAnalysis_LoopInfo(loopStructure->getFunction());
-  auto l = li->getLoopFor(loopStructure->getHeader());
+  auto header = loopStructure->getHeader();
+  auto l = li->getLoopFor(header);
+
+  /*
+   * Queries to SCAF are about the loop identified by its header.
+   * The parameter of a query is the set of dependence types to disprove and
+   * whether they are intra-iteration ones.
+   */
+  auto scafID = (cache != nullptr)
+                    ? cache->getAnalysisID(&NoelleSCAFIntegration::ID, "SCAF")
+                    : 0;
+  auto askSCAF = [cache, scafID, header](Instruction *i,
+                                          Instruction *j,
+                                          uint8_t parameter,
+                                          std::function<uint8_t(void)> answer) {
+    if (cache == nullptr) {
+      return answer();
+    }
+    DependenceQueryCache::Query query{ DependenceQueryCache::LOOP_DEPENDENCE,
+                                       scafID,
+                                       i,
+                                       j,
+                                       header,
+                                       parameter };
+    return cache->query(query, answer);
+  };
+  const uint8_t intraIteration = 1 << 3;
 
   /*
    * Iterate over all the edges of the loop PDG and collect memory deps to be
@@ -152,17 +180,25 @@ void refinePDGWithSCAF(PDG *loopDG, LoopTree &loopNode) {
     }
     // Try to disprove all the reported loop-carried deps
     uint8_t disprovedLCDepTypes =
-        disproveLoopCarriedMemoryDep(i, j, depTypes, l, NoelleSCAFAA);
+        askSCAF(i, j, depTypes, [i, j, depTypes, l](void) -> uint8_t {
+          return disproveLoopCarriedMemoryDep(i, j, depTypes, l, NoelleSCAFAA);
+        });
 
     // for every disproved loop-carried dependence
     // check if there is a intra-iteration dependence
     uint8_t disprovedIIDepTypes = 0;
     if (disprovedLCDepTypes) {
-      disprovedIIDepTypes = disproveIntraIterationMemoryDep(i,
-                                                            j,
-                                                            disprovedLCDepTypes,
-                                                            l,
-                                                            NoelleSCAFAA);
+      disprovedIIDepTypes =
+          askSCAF(i,
+                  j,
+                  disprovedLCDepTypes | intraIteration,
+                  [i, j, disprovedLCDepTypes, l](void) -> uint8_t {
+                    return disproveIntraIterationMemoryDep(i,
+                                                           j,
+                                                           disprovedLCDepTypes,
+                                                           l,
+                                                           NoelleSCAFAA);
+                  });
 
       // remove any edge that SCAF disproved both its loop-carried and
       // intra-iteration version
@@ -29,8 +29,11 @@
 
 namespace arcana::noelle {
 
-// Refine the loop PDG with SCAF
-void refinePDGWithSCAF(PDG *loopDG, LoopTree &loopNode);
+// Refine the loop PDG with SCAF.
+// The answers of SCAF are memoized in @cache if it is not nullptr.
+void refinePDGWithSCAF(PDG *loopDG,
+                       LoopTree &loopNode,
+                       DependenceQueryCache *cache);
 
 } // namespace arcana::noelle
 
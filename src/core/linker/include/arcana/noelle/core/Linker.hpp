@@ -32,6 +32,12 @@ class Linker {
 public:
   Linker(Module &m, TypesManager *tm);
 
+  /*
+   * @envIndexForExitVariable is the index of the exit block variable within
+   * the environment array.
+   * Each variable is assumed to own a cache line (i.e., the padded layout of
+   * the environment).
+   */
   void linkTransformedLoopToOriginalFunction(
       BasicBlock *originalPreHeader,
       BasicBlock *startOfParLoopInOriginalFunc,
@@ -50,9 +56,58 @@ public:
       std::vector<BasicBlock *> &loopExitBlocks,
       uint32_t minIdleCores);
 
+  /*
+   * @envOffsetForExitVariable is the position (in 64-bit slots) of the exit
+   * block variable within the environment array.
+   * These work with every layout of the environment: the position must be
+   * obtained from the environment builder (getOffsetOfEnvironmentVariable).
+   */
+  void linkTransformedLoopToOriginalFunctionAtOffset(
+      BasicBlock *originalPreHeader,
+      BasicBlock *startOfParLoopInOriginalFunc,
+      BasicBlock *endOfParLoopInOriginalFunc,
+      Value *envArray,
+      Value *envOffsetForExitVariable,
+      std::vector<BasicBlock *> &loopExitBlocks,
+      uint32_t minIdleCores);
+
+  void substituteOriginalLoopWithTransformedLoopAtOffset(
+      LoopStructure *originalLoop,
+      BasicBlock *startOfParLoopInOriginalFunc,
+      BasicBlock *endOfParLoopInOriginalFunc,
+      Value *envArray,
+      Value *envOffsetForExitVariable,
+      std::vector<BasicBlock *> &loopExitBlocks,
+      uint32_t minIdleCores);
+
 private:
   Module &program;
   TypesManager *tm;
+
+  void linkTransformedLoopToOriginalFunction(
+      BasicBlock *originalPreHeader,
+      BasicBlock *startOfParLoopInOriginalFunc,
+      BasicBlock *endOfParLoopInOriginalFunc,
+      Value *envArray,
+      Value *envPositionForExitVariable,
+      uint64_t slotsPerPosition,
+      std::vector<BasicBlock *> &loopExitBlocks,
+      uint32_t minIdleCores);
+
+  void substituteOriginalLoopWithTransformedLoop(
+      LoopStructure *originalLoop,
+      BasicBlock *startOfParLoopInOriginalFunc,
+      BasicBlock *endOfParLoopInOriginalFunc,
+      Value *envArray,
+      Value *envPositionForExitVariable,
+      uint64_t slotsPerPosition,
+      std::vector<BasicBlock *> &loopExitBlocks,
+      uint32_t minIdleCores);
+
+  Value *createExitVariablePointer(IRBuilder<> &builder,
+                                   Value *envArray,
+                                   Value *envPositionForExitVariable,
+                                   uint64_t slotsPerPosition);
 };
 
 } // namespace arcana::noelle
@@ -38,6 +38,117 @@ void Linker::linkTransformedLoopToOriginalFunction(
     std::vector<BasicBlock *> &loopExitBlocks,
     uint32_t minIdleCores) {
 
+  /*
+   * Compute how many values can fit in a cache line.
+   */
+  auto valuesInCacheLine = Architecture::getCacheLineBytes() / sizeof(int64_t);
+
+  this->linkTransformedLoopToOriginalFunction(originalPreHeader,
+                                              startOfParLoopInOriginalFunc,
+                                              endOfParLoopInOriginalFunc,
+                                              envArray,
+                                              envIndexForExitVariable,
+                                              valuesInCacheLine,
+                                              loopExitBlocks,
+                                              minIdleCores);
+
+  return;
+}
+
+void Linker::linkTransformedLoopToOriginalFunctionAtOffset(
+    BasicBlock *originalPreHeader,
+    BasicBlock *startOfParLoopInOriginalFunc,
+    BasicBlock *endOfParLoopInOriginalFunc,
+    Value *envArray,
+    Value *envOffsetForExitVariable,
+    std::vector<BasicBlock *> &loopExitBlocks,
+    uint32_t minIdleCores) {
+  this->linkTransformedLoopToOriginalFunction(originalPreHeader,
+                                              startOfParLoopInOriginalFunc,
+                                              endOfParLoopInOriginalFunc,
+                                              envArray,
+                                              envOffsetForExitVariable,
+                                              1,
+                                              loopExitBlocks,
+                                              minIdleCores);
+
+  return;
+}
+
+void Linker::substituteOriginalLoopWithTransformedLoop(
+    LoopStructure *originalLoop,
+    BasicBlock *startOfParLoopInOriginalFunc,
+    BasicBlock *endOfParLoopInOriginalFunc,
+    Value *envArray,
+    Value *envIndexForExitVariable,
+    std::vector<BasicBlock *> &loopExitBlocks,
+    uint32_t minIdleCores) {
+
+  /*
+   * Compute how many values can fit in a cache line.
+   */
+  auto valuesInCacheLine = Architecture::getCacheLineBytes() / sizeof(int64_t);
+
+  this->substituteOriginalLoopWithTransformedLoop(originalLoop,
+                                                  startOfParLoopInOriginalFunc,
+                                                  endOfParLoopInOriginalFunc,
+                                                  envArray,
+                                                  envIndexForExitVariable,
+                                                  valuesInCacheLine,
+                                                  loopExitBlocks,
+                                                  minIdleCores);
+
+  return;
+}
+
+void Linker::substituteOriginalLoopWithTransformedLoopAtOffset(
+    LoopStructure *originalLoop,
+    BasicBlock *startOfParLoopInOriginalFunc,
+    BasicBlock *endOfParLoopInOriginalFunc,
+    Value *envArray,
+    Value *envOffsetForExitVariable,
+    std::vector<BasicBlock *> &loopExitBlocks,
+    uint32_t minIdleCores) {
+  this->substituteOriginalLoopWithTransformedLoop(originalLoop,
+                                                  startOfParLoopInOriginalFunc,
+                                                  endOfParLoopInOriginalFunc,
+                                                  envArray,
+                                                  envOffsetForExitVariable,
+                                                  1,
+                                                  loopExitBlocks,
+                                                  minIdleCores);
+
+  return;
+}
+
+Value *Linker::createExitVariablePointer(IRBuilder<> &builder,
+                                         Value *envArray,
+                                         Value *envPositionForExitVariable,
+                                         uint64_t slotsPerPosition) {
+  auto int64 = this->tm->getIntegerType(64);
+  auto envOffset = envPositionForExitVariable;
+  if (slotsPerPosition != 1) {
+    envOffset =
+        builder.CreateMul(envPositionForExitVariable,
+                          ConstantInt::get(int64, slotsPerPosition));
+  }
+
+  return builder.CreateGEP(
+      envArray->getType()->getPointerElementType(),
+      envArray,
+      ArrayRef<Value *>({ cast<Value>(ConstantInt::get(int64, 0)), envOffset }));
+}
+
+void Linker::linkTransformedLoopToOriginalFunction(
+    BasicBlock *originalPreHeader,
+    BasicBlock *startOfParLoopInOriginalFunc,
+    BasicBlock *endOfParLoopInOriginalFunc,
+    Value *envArray,
+    Value *envPositionForExitVariable,
+    uint64_t slotsPerPosition,
+    std::vector<BasicBlock *> &loopExitBlocks,
+    uint32_t minIdleCores) {
+
   /*
    * Fetch the runtime API to invoke.
    */
@@ -83,20 +194,11 @@ void Linker::linkTransformedLoopToOriginalFunction(
 
   } else {
 
-    /*
-     * Compute how many values can fit in a cache line.
-     */
-    auto valuesInCacheLine =
-        Architecture::getCacheLineBytes() / sizeof(int64_t);
-
-    auto int64 = this->tm->getIntegerType(64);
-    auto exitEnvPtr = endBuilder.CreateGEP(
-        envArray->getType()->getPointerElementType(),
-        envArray,
-        ArrayRef<Value *>({ cast<Value>(ConstantInt::get(int64, 0)),
-                            endBuilder.CreateMul(
-                                envIndexForExitVariable,
-                                ConstantInt::get(int64, valuesInCacheLine)) }));
+    auto exitEnvPtr =
+        this->createExitVariablePointer(endBuilder,
+                                        envArray,
+                                        envPositionForExitVariable,
+                                        slotsPerPosition);
     auto newLoad =
         endBuilder.CreateLoad(exitEnvPtr->getType()->getPointerElementType(),
                               exitEnvPtr);
@@ -139,7 +241,8 @@ void Linker::substituteOriginalLoopWithTransformedLoop(
     BasicBlock *startOfParLoopInOriginalFunc,
     BasicBlock *endOfParLoopInOriginalFunc,
     Value *envArray,
-    Value *envIndexForExitVariable,
+    Value *envPositionForExitVariable,
+    uint64_t slotsPerPosition,
     std::vector<BasicBlock *> &loopExitBlocks,
     uint32_t minIdleCores) {
 
@@ -171,20 +274,11 @@ void Linker::substituteOriginalLoopWithTransformedLoop(
 
   } else {
 
-    /*
-     * Compute how many values can fit in a cache line.
-     */
-    auto valuesInCacheLine =
-        Architecture::getCacheLineBytes() / sizeof(int64_t);
-
-    auto int64 = this->tm->getIntegerType(64);
-    auto exitEnvPtr = endBuilder.CreateGEP(
-        envArray->getType()->getPointerElementType(),
-        envArray,
-        ArrayRef<Value *>({ cast<Value>(ConstantInt::get(int64, 0)),
-                            endBuilder.CreateMul(
-                                envIndexForExitVariable,
-                                ConstantInt::get(int64, valuesInCacheLine)) }));
+    auto exitEnvPtr =
+        this->createExitVariablePointer(endBuilder,
+                                        envArray,
+                                        envPositionForExitVariable,
+                                        slotsPerPosition);
     auto integerType = this->tm->getIntegerType(32);
     auto newLoad =
         endBuilder.CreateLoad(exitEnvPtr->getType()->getPointerElementType(),
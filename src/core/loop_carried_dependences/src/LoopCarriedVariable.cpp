@@ -317,10 +317,14 @@ std::unordered_set<Value *> LoopCarriedVariable::getConsumersOfVariable(
     if (!outermostLoopOfVariable.isIncluded(consumer))
       continue;
 
+    /*
+     * Only dependences from internal nodes are considered because the nodes of
+     * the SCC might be shared with the graph it has been computed from.
+     */
     auto node = externalNodePair.second;
     for (auto edge : node->getIncomingEdges()) {
       auto producer = edge->getSrc();
-      if (sccOfVariableOnly->isExternal(producer))
+      if (!sccOfVariableOnly->isInternal(producer))
         continue;
 
       /*
@@ -38,6 +38,18 @@
 
 namespace arcana::noelle {
 
+/*
+ * Abstractions of a loop that LoopContent computes on top of its dependence
+ * graph.
+ */
+enum LoopContentComponent {
+  LOOP_ENVIRONMENT_ID,
+  LOOP_INVARIANTS_ID,
+  LOOP_INDUCTION_VARIABLES_ID,
+  LOOP_SCC_MANAGER_ID,
+  LOOP_ITERATION_SPACE_ID
+};
+
 class LoopContent {
 public:
   /*
@@ -103,6 +115,31 @@ public:
               bool enableLoopAwareDependenceAnalyses,
               uint32_t chunkSize);
 
+  /*
+   * The dependence graph of the loop is always computed by the constructor.
+   * The components in @componentsToPrefetch (and the ones they depend on) are
+   * computed by the constructor as well.
+   * The other components are computed the first time they are requested,
+   * using the code of the loop and the analyses returned by @getLLVMLoop and
+   * @getSCEV at that time.
+   * Hence, the code of the loop must not be modified until all the components
+   * needed have been requested.
+   */
+  LoopContent(LDGGenerator &ldgGenerator,
+              CompilationOptionsManager *compilationOptionsManager,
+              PDG *fG,
+              LoopTree *loop,
+              Loop *l,
+              DominatorSummary &DS,
+              ScalarEvolution &SE,
+              uint32_t maxCores,
+              std::unordered_set<LoopContentOptimization> optimizations,
+              bool enableLoopAwareDependenceAnalyses,
+              uint32_t chunkSize,
+              std::unordered_set<LoopContentComponent> componentsToPrefetch,
+              std::function<Loop *(void)> getLLVMLoop,
+              std::function<ScalarEvolution &(void)> getSCEV);
+
   LoopContent() = delete;
 
   /*
@@ -157,6 +194,16 @@ public:
 
   uint64_t getCompileTimeTripCount(void) const;
 
+  /*
+   * Check whether a component has already been computed.
+   */
+  bool isComputed(LoopContentComponent component) const;
+
+  /*
+   * Return all the components of a LoopContent.
+   */
+  static std::unordered_set<LoopContentComponent> getAllComponents(void);
+
   /*
    * Deconstructor.
    */
@@ -168,18 +215,18 @@ private:
    */
   LoopTree *loop;
 
-  LoopEnvironment *environment;
+  mutable LoopEnvironment *environment;
 
   PDG *loopDG; /* Dependence graph of the loop.
                 * This graph does not include instructions outside the loop
                 * (i.e., no external dependences are included).
                 */
 
-  InductionVariableManager *inductionVariables;
+  mutable InductionVariableManager *inductionVariables;
 
-  InvariantManager *invariantManager;
+  mutable InvariantManager *invariantManager;
 
-  LoopIterationSpaceAnalysis *domainSpaceAnalysis;
+  mutable LoopIterationSpaceAnalysis *domainSpaceAnalysis;
 
   MemoryCloningAnalysis *memoryCloningAnalysis;
 
@@ -187,24 +234,47 @@ private:
 
   uint64_t tripCount;
 
-  SCCDAGAttrs *sccdagAttrs;
+  mutable SCCDAGAttrs *sccdagAttrs;
 
   LoopTransformationsManager *loopTransformationsManager;
 
   CompilationOptionsManager *com;
 
+  LDGGenerator &ldgGenerator;
+
+  mutable DominatorSummary *DS; /* Dominators of the function of the loop.
+                                 * They are kept only until the SCC manager is
+                                 * computed.
+                                 */
+
+  std::function<Loop *(void)> getLLVMLoop;
+
+  std::function<ScalarEvolution &(void)> getSCEV;
+
   /*
    * Methods
    */
   void fetchLoopAndBBInfo(Loop *l, ScalarEvolution &SE);
 
-  std::pair<PDG *, SCCDAG *> createDGsForLoop(LDGGenerator &ldgGenerator,
-                                              CompilationOptionsManager *com,
-                                              Loop *l,
-                                              LoopTree *loopNode,
-                                              PDG *functionDG,
-                                              DominatorSummary &DS,
-                                              ScalarEvolution &SE);
+  PDG *createDGsForLoop(LDGGenerator &ldgGenerator,
+                        CompilationOptionsManager *com,
+                        Loop *l,
+                        LoopTree *loopNode,
+                        PDG *functionDG,
+                        DominatorSummary &DS,
+                        ScalarEvolution &SE);
+
+  SCCDAG *computeSCCDAG(void) const;
+
+  void computeEnvironment(void) const;
+
+  void computeInvariants(void) const;
+
+  void computeInductionVariables(void) const;
+
+  void computeSCCManager(DominatorSummary &DS) const;
+
+  void computeIterationSpace(void) const;
 
   uint64_t computeTripCounts(Loop *l, ScalarEvolution &SE);
 
@@ -154,9 +154,51 @@ LoopContent::LoopContent(
     std::unordered_set<LoopContentOptimization> optimizations,
     bool enableLoopAwareDependenceAnalyses,
     uint32_t chunkSize)
+  : LoopContent(
+      ldgGenerator,
+      compilationOptionsManager,
+      fG,
+      loopNode,
+      l,
+      DS,
+      SE,
+      maxCores,
+      optimizations,
+      enableLoopAwareDependenceAnalyses,
+      chunkSize,
+      LoopContent::getAllComponents(),
+      [l](void) -> Loop * { return l; },
+      [&SE](void) -> ScalarEvolution & { return SE; }) {
+  return;
+}
+
+LoopContent::LoopContent(
+    LDGGenerator &ldgGenerator,
+    CompilationOptionsManager *compilationOptionsManager,
+    PDG *fG,
+    LoopTree *loopNode,
+    Loop *l,
+    DominatorSummary &DS,
+    ScalarEvolution &SE,
+    uint32_t maxCores,
+    std::unordered_set<LoopContentOptimization> optimizations,
+    bool enableLoopAwareDependenceAnalyses,
+    uint32_t chunkSize,
+    std::unordered_set<LoopContentComponent> componentsToPrefetch,
+    std::function<Loop *(void)> getLLVMLoop,
+    std::function<ScalarEvolution &(void)> getSCEV)
   : loop{ loopNode },
+    environment{ nullptr },
+    inductionVariables{ nullptr },
+    invariantManager{ nullptr },
+    domainSpaceAnalysis{ nullptr },
     memoryCloningAnalysis{ nullptr },
-    com{ compilationOptionsManager } {
+    sccdagAttrs{ nullptr },
+    com{ compilationOptionsManager },
+    ldgGenerator{ ldgGenerator },
+    DS{ nullptr },
+    getLLVMLoop{ [l](void) -> Loop * { return l; } },
+    getSCEV{ [&SE](void) -> ScalarEvolution & { return SE; } } {
   assert(this->loop != nullptr);
 
   /*
@@ -182,20 +224,92 @@ LoopContent::LoopContent(
 
   /*
    * Fetch the loop dependence graph (i.e., the subset of the PDG that relates
-   * to the loop @l) and its SCCDAG.
+   * to the loop @l).
+   *
+   * This graph is always needed and it relies on the dominators, which are
+   * owned by the caller.
    */
   this->fetchLoopAndBBInfo(l, SE);
-  auto ls = this->getLoopStructure();
-  auto loopExitBlocks = ls->getLoopExitBasicBlocks();
-  auto DGs = this->createDGsForLoop(ldgGenerator,
-                                    compilationOptionsManager,
-                                    l,
-                                    loopNode,
-                                    fG,
-                                    DS,
-                                    SE);
-  this->loopDG = DGs.first;
-  auto loopSCCDAG = DGs.second;
+  this->loopDG = this->createDGsForLoop(ldgGenerator,
+                                        compilationOptionsManager,
+                                        l,
+                                        loopNode,
+                                        fG,
+                                        DS,
+                                        SE);
+
+  /*
+   * Check if the SCC manager will be computed on demand.
+   * In this case, we need to keep our own copy of the dominators because the
+   * ones given as input will be freed by the caller.
+   */
+  if (componentsToPrefetch.count(LOOP_SCC_MANAGER_ID) == 0) {
+    std::set<BasicBlock *> functionBlocks;
+    auto function = this->getLoopStructure()->getFunction();
+    for (auto &bb : *function) {
+      functionBlocks.insert(&bb);
+    }
+    this->DS = new DominatorSummary(DS, functionBlocks);
+  }
+
+  /*
+   * Compute the components requested.
+   * The order of the components is the one they depend on each other.
+   */
+  if (componentsToPrefetch.count(LOOP_ENVIRONMENT_ID) > 0) {
+    this->getEnvironment();
+  }
+  if (componentsToPrefetch.count(LOOP_INVARIANTS_ID) > 0) {
+    this->getInvariantManager();
+  }
+  if (componentsToPrefetch.count(LOOP_INDUCTION_VARIABLES_ID) > 0) {
+    this->getInductionVariableManager();
+  }
+  if (componentsToPrefetch.count(LOOP_SCC_MANAGER_ID) > 0) {
+    this->computeSCCManager(DS);
+  }
+  if (componentsToPrefetch.count(LOOP_ITERATION_SPACE_ID) > 0) {
+    this->getLoopIterationSpaceAnalysis();
+  }
+
+  /*
+   * The LLVM loop and the scalar evolution given as input are valid only
+   * while the constructor runs.
+   * From now on, use the ones provided by the caller.
+   */
+  this->getLLVMLoop = getLLVMLoop;
+  this->getSCEV = getSCEV;
+
+  return;
+}
+
+std::unordered_set<LoopContentComponent> LoopContent::getAllComponents(
+    void) {
+  return { LOOP_ENVIRONMENT_ID,
+           LOOP_INVARIANTS_ID,
+           LOOP_INDUCTION_VARIABLES_ID,
+           LOOP_SCC_MANAGER_ID,
+           LOOP_ITERATION_SPACE_ID };
+}
+
+bool LoopContent::isComputed(LoopContentComponent component) const {
+  switch (component) {
+    case LOOP_ENVIRONMENT_ID:
+      return this->environment != nullptr;
+    case LOOP_INVARIANTS_ID:
+      return this->invariantManager != nullptr;
+    case LOOP_INDUCTION_VARIABLES_ID:
+      return this->inductionVariables != nullptr;
+    case LOOP_SCC_MANAGER_ID:
+      return this->sccdagAttrs != nullptr;
+    case LOOP_ITERATION_SPACE_ID:
+      return this->domainSpaceAnalysis != nullptr;
+  }
+
+  return false;
+}
+
+void LoopContent::computeEnvironment(void) const {
 
   /*
    * Create the environment for the loop.
@@ -225,8 +339,15 @@ LoopContent::LoopContent(
       stackObjectsThatWillBeCloned.insert(stackObject);
     }
   }
-  this->environment =
-      new LoopEnvironment(loopDG, loopExitBlocks, stackObjectsThatWillBeCloned);
+  auto loopExitBlocks = this->getLoopStructure()->getLoopExitBasicBlocks();
+  this->environment = new LoopEnvironment(this->loopDG,
+                                          loopExitBlocks,
+                                          stackObjectsThatWillBeCloned);
+
+  return;
+}
+
+void LoopContent::computeInvariants(void) const {
 
   /*
    * Create the invariant manager.
@@ -236,6 +357,17 @@ LoopContent::LoopContent(
   auto topLoop = this->loop->getLoop();
   this->invariantManager = new InvariantManager(topLoop, this->loopDG);
 
+  return;
+}
+
+void LoopContent::computeInductionVariables(void) const {
+
+  /*
+   * Fetch the components the induction variables depend on.
+   */
+  auto environment = this->getEnvironment();
+  auto invariantManager = this->getInvariantManager();
+
   /*
    * Create the induction variable manager.
    *
@@ -247,32 +379,61 @@ LoopContent::LoopContent(
    * And then, we can identify IVs from this new SCCDAG.
    */
   auto loopSCCDAGWithoutMemoryDeps =
-      ldgGenerator.computeSCCDAGWithOnlyVariableAndControlDependences(loopDG);
+      this->ldgGenerator.computeSCCDAGWithOnlyVariableAndControlDependences(
+          this->loopDG);
+  auto l = this->getLLVMLoop();
+  assert(l != nullptr);
   this->inductionVariables =
       new InductionVariableManager(this->loop,
                                    *invariantManager,
-                                   SE,
+                                   this->getSCEV(),
                                    *loopSCCDAGWithoutMemoryDeps,
                                    *environment,
                                    *l);
 
+  /*
+   * Collect induction variable information
+   */
+  auto topLoop = this->loop->getLoop();
+  this->inductionVariables->getLoopGoverningInductionVariable(*topLoop);
+
+  return;
+}
+
+void LoopContent::computeSCCManager(DominatorSummary &DS) const {
+
+  /*
+   * Fetch the components the SCC manager depends on.
+   */
+  auto ivManager = this->getInductionVariableManager();
+  auto loopSCCDAG = this->computeSCCDAG();
+
   /*
    * Calculate various attributes on SCCs
    */
-  this->sccdagAttrs = new SCCDAGAttrs(
-      compilationOptionsManager->canFloatsBeConsideredRealNumbers(),
-      loopDG,
-      loopSCCDAG,
-      this->loop,
-      *inductionVariables,
-      DS);
-  this->domainSpaceAnalysis =
-      new LoopIterationSpaceAnalysis(this->loop, *this->inductionVariables, SE);
+  this->sccdagAttrs =
+      new SCCDAGAttrs(this->com->canFloatsBeConsideredRealNumbers(),
+                      this->loopDG,
+                      loopSCCDAG,
+                      this->loop,
+                      *ivManager,
+                      DS);
+
+  return;
+}
+
+void LoopContent::computeIterationSpace(void) const {
 
   /*
-   * Collect induction variable information
+   * Fetch the components the iteration space analysis depends on.
    */
-  this->inductionVariables->getLoopGoverningInductionVariable(*topLoop);
+  auto ivManager = this->getInductionVariableManager();
+
+  /*
+   * Analyze the iteration space of the loop.
+   */
+  this->domainSpaceAnalysis =
+      new LoopIterationSpaceAnalysis(this->loop, *ivManager, this->getSCEV());
 
   return;
 }
@@ -322,14 +483,13 @@ uint64_t LoopContent::computeTripCounts(Loop *l, ScalarEvolution &SE) {
   return tripCount;
 }
 
-std::pair<PDG *, SCCDAG *> LoopContent::createDGsForLoop(
-    LDGGenerator &ldgGenerator,
-    CompilationOptionsManager *com,
-    Loop *l,
-    LoopTree *loopNode,
-    PDG *functionDG,
-    DominatorSummary &DS,
-    ScalarEvolution &SE) {
+PDG *LoopContent::createDGsForLoop(LDGGenerator &ldgGenerator,
+                                   CompilationOptionsManager *com,
+                                   Loop *l,
+                                   LoopTree *loopNode,
+                                   PDG *functionDG,
+                                   DominatorSummary &DS,
+                                   ScalarEvolution &SE) {
 
   /*
    * Perform loop-aware memory dependence analysis to refine the loop dependence
@@ -362,10 +522,15 @@ std::pair<PDG *, SCCDAG *> LoopContent::createDGsForLoop(
                                                                       DS);
   }
 
+  return loopDG;
+}
+
+SCCDAG *LoopContent::computeSCCDAG(void) const {
+
   /*
    * Build a SCCDAG of loop-internal instructions
    */
-  auto loopInternalDG = loopDG->clone(false);
+  auto loopInternalDG = this->loopDG->clone(false);
   auto loopSCCDAG = new SCCDAG(loopInternalDG);
 
   /*
@@ -379,7 +544,7 @@ std::pair<PDG *, SCCDAG *> LoopContent::createDGsForLoop(
    */
   {
     int64_t numberOfInstructionsInLoop = 0;
-    for (auto bbIter : l->blocks()) {
+    for (auto bbIter : this->getLoopStructure()->getBasicBlocks()) {
       for (auto &I : *bbIter) {
         assert(std::find(loopInternals.begin(), loopInternals.end(), &I)
                != loopInternals.end());
@@ -397,7 +562,7 @@ std::pair<PDG *, SCCDAG *> LoopContent::createDGsForLoop(
   }
 #endif
 
-  return std::make_pair(loopDG, loopSCCDAG);
+  return loopSCCDAG;
 }
 
 void LoopContent::removeUnnecessaryDependenciesWithThreadSafeLibraryFunctions(
@@ -597,7 +762,11 @@ LoopStructure *LoopContent::getNestedMostLoopStructure(Instruction *I) const {
 }
 
 InductionVariableManager *LoopContent::getInductionVariableManager(void) const {
-  return inductionVariables;
+  if (this->inductionVariables == nullptr) {
+    this->computeInductionVariables();
+  }
+
+  return this->inductionVariables;
 }
 
 MemoryCloningAnalysis *LoopContent::getMemoryCloningAnalysis(void) const {
@@ -616,11 +785,19 @@ uint64_t LoopContent::getCompileTimeTripCount(void) const {
 }
 
 InvariantManager *LoopContent::getInvariantManager(void) const {
+  if (this->invariantManager == nullptr) {
+    this->computeInvariants();
+  }
+
   return this->invariantManager;
 }
 
 LoopIterationSpaceAnalysis *LoopContent::getLoopIterationSpaceAnalysis(
     void) const {
+  if (this->domainSpaceAnalysis == nullptr) {
+    this->computeIterationSpace();
+  }
+
   return this->domainSpaceAnalysis;
 }
 
@@ -629,10 +806,25 @@ LoopTree *LoopContent::getLoopHierarchyStructures(void) const {
 }
 
 SCCDAGAttrs *LoopContent::getSCCManager(void) const {
+  if (this->sccdagAttrs == nullptr) {
+    assert(this->DS != nullptr);
+    this->computeSCCManager(*this->DS);
+
+    /*
+     * The copy of the dominators is not needed anymore.
+     */
+    delete this->DS;
+    this->DS = nullptr;
+  }
+
   return this->sccdagAttrs;
 }
 
 LoopEnvironment *LoopContent::getEnvironment(void) const {
+  if (this->environment == nullptr) {
+    this->computeEnvironment();
+  }
+
   return this->environment;
 }
 
@@ -649,10 +841,12 @@ LoopContent::~LoopContent() {
     delete this->inductionVariables;
   }
 
-  assert(this->invariantManager);
-  delete this->invariantManager;
+  if (this->invariantManager) {
+    delete this->invariantManager;
+  }
 
   delete this->domainSpaceAnalysis;
+  delete this->DS;
 
   return;
 }
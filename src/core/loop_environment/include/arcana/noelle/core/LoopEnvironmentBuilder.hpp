@@ -29,11 +29,24 @@
 
 namespace arcana::noelle {
 
+/*
+ * Layout of the environment array.
+ *
+ * Padded: every variable gets a cache line of its own.
+ * Compact: variables that can be written while the loop runs (e.g., live-outs)
+ * and the pointers to the private copies of reducable variables get a cache
+ * line each, while variables that are only read while the loop runs (i.e.,
+ * live-ins) are packed together after them.
+ */
+enum class LoopEnvironmentLayout { Padded, Compact };
+
 class LoopEnvironmentBuilder {
 public:
-  LoopEnvironmentBuilder(LLVMContext &cxt,
-                         LoopEnvironment *env,
-                         uint64_t numberOfUsers);
+  LoopEnvironmentBuilder(
+      LLVMContext &cxt,
+      LoopEnvironment *env,
+      uint64_t numberOfUsers,
+      LoopEnvironmentLayout layout = LoopEnvironmentLayout::Padded);
 
   LoopEnvironmentBuilder(
       LLVMContext &cxt,
@@ -41,7 +54,8 @@ public:
       std::function<bool(uint32_t variableID, bool isLiveOut)>
           shouldThisVariableBeReduced,
       uint64_t reducerCount,
-      uint64_t numberOfUsers);
+      uint64_t numberOfUsers,
+      LoopEnvironmentLayout layout = LoopEnvironmentLayout::Padded);
 
   LoopEnvironmentBuilder(
       LLVMContext &cxt,
@@ -51,7 +65,8 @@ public:
       std::function<bool(uint32_t variableID, bool isLiveOut)>
           shouldThisVariableBeSkipped,
       uint64_t reducerCount,
-      uint64_t numberOfUsers);
+      uint64_t numberOfUsers,
+      LoopEnvironmentLayout layout = LoopEnvironmentLayout::Padded);
 
   LoopEnvironmentBuilder(LLVMContext &CXT,
                          const std::vector<Type *> &varTypes,
@@ -94,6 +109,16 @@ public:
 
   virtual Value *getEnvironmentVariable(uint32_t id) const;
   virtual uint32_t getIndexOfEnvironmentVariable(uint32_t id) const;
+
+  /*
+   * Return the position (in 64-bit slots) of the variable @id within the
+   * environment array.
+   * Code that accesses the environment array must use it rather than
+   * deriving the position from the index of the variable.
+   */
+  virtual uint32_t getOffsetOfEnvironmentVariable(uint32_t id) const;
+
+  LoopEnvironmentLayout getLayout(void) const;
   virtual bool isIncludedEnvironmentVariable(uint32_t id) const;
   virtual Value *getAccumulatedReducedEnvironmentVariable(uint32_t id) const;
   virtual Value *getReducedEnvironmentVariable(uint32_t id,
@@ -116,6 +141,15 @@ protected:
   std::unordered_map<uint32_t, uint32_t> envIDToIndex;
   std::unordered_map<uint32_t, uint32_t> indexToEnvID;
 
+  /*
+   * Layout of the environment array.
+   * The read-only variables are packed only by the compact layout.
+   */
+  LoopEnvironmentLayout layout;
+  std::set<uint32_t> readOnlyVarIDs;
+  std::unordered_map<uint32_t, uint32_t> envIDToOffset;
+  uint64_t envSlots;
+
   /*
    * The environment variable types and their allocations
    */
@@ -28,7 +28,8 @@ namespace arcana::noelle {
 
 class LoopEnvironmentUser {
 public:
-  LoopEnvironmentUser(std::unordered_map<uint32_t, uint32_t> &envIDToIndex);
+  LoopEnvironmentUser(std::unordered_map<uint32_t, uint32_t> &envIDToIndex,
+                      std::unordered_map<uint32_t, uint32_t> &envIDToOffset);
 
   LoopEnvironmentUser() = delete;
 
@@ -68,6 +69,14 @@ protected:
   std::set<uint32_t> liveInIDs;
   std::set<uint32_t> liveOutIDs;
   std::unordered_map<uint32_t, uint32_t> &envIDToIndex;
+
+  /*
+   * Map from environment ID to the slot of the environment array that stores
+   * the variable (see LoopEnvironmentBuilder).
+   */
+  std::unordered_map<uint32_t, uint32_t> &envIDToOffset;
+
+  uint64_t getOffset(uint32_t envID) const;
 };
 
 } // namespace arcana::noelle
@@ -27,13 +27,15 @@ namespace arcana::noelle {
 
 LoopEnvironmentBuilder::LoopEnvironmentBuilder(LLVMContext &cxt,
                                                LoopEnvironment *environment,
-                                               uint64_t numberOfUsers)
+                                               uint64_t numberOfUsers,
+                                               LoopEnvironmentLayout layout)
   : LoopEnvironmentBuilder(
       cxt,
       environment,
       [](uint32_t variableID, bool isLiveOut) -> bool { return false; },
       1,
-      numberOfUsers) {
+      numberOfUsers,
+      layout) {
 
   return;
 }
@@ -44,14 +46,16 @@ LoopEnvironmentBuilder::LoopEnvironmentBuilder(
     std::function<bool(uint32_t variableID, bool isLiveOut)>
         shouldThisVariableBeReduced,
     uint64_t reducerCount,
-    uint64_t numberOfUsers)
+    uint64_t numberOfUsers,
+    LoopEnvironmentLayout layout)
   : LoopEnvironmentBuilder(
       cxt,
       environment,
       shouldThisVariableBeReduced,
       [](uint32_t variableID, bool isLiveOut) -> bool { return false; },
       reducerCount,
-      numberOfUsers) {
+      numberOfUsers,
+      layout) {
 
   return;
 }
@@ -64,8 +68,10 @@ LoopEnvironmentBuilder::LoopEnvironmentBuilder(
     std::function<bool(uint32_t variableID, bool isLiveOut)>
         shouldThisVariableBeSkipped,
     uint64_t reducerCount,
-    uint64_t numberOfUsers)
-  : CXT{ cxt } {
+    uint64_t numberOfUsers,
+    LoopEnvironmentLayout layout)
+  : CXT{ cxt },
+    layout{ layout } {
   assert(environment != nullptr);
 
   /*
@@ -101,6 +107,18 @@ LoopEnvironmentBuilder::LoopEnvironmentBuilder(
     nonReducableVars.insert(environment->getExitBlockID());
   }
 
+  /*
+   * Live-in variables that are not reduced are only read while the loop runs.
+   * They are packed together by the compact layout.
+   */
+  if (this->layout == LoopEnvironmentLayout::Compact) {
+    for (auto liveInVariableID : environment->getEnvIDsOfLiveInVars()) {
+      if (nonReducableVars.count(liveInVariableID) > 0) {
+        this->readOnlyVarIDs.insert(liveInVariableID);
+      }
+    }
+  }
+
   /*
    * Initialize the builder
    */
@@ -120,7 +138,8 @@ LoopEnvironmentBuilder::LoopEnvironmentBuilder(
     const std::set<uint32_t> &reducableVarIDs,
     uint64_t reducerCount,
     uint64_t numberOfUsers)
-  : CXT{ cxt } {
+  : CXT{ cxt },
+    layout{ LoopEnvironmentLayout::Padded } {
 
   /*
    * Initialize the builder
@@ -142,20 +161,47 @@ void LoopEnvironmentBuilder::initializeBuilder(
     uint64_t numberOfUsers) {
 
   /*
-   * Build up envID to index map and reverse map
+   * Compute how many values can fit in a cache line.
+   */
+  auto valuesInCacheLine = Architecture::getCacheLineBytes() / sizeof(int64_t);
+
+  /*
+   * Build up envID to index map and reverse map.
+   *
+   * Variables that need a cache line each come first.
+   * Read-only variables (compact layout only) are packed after them.
    */
   uint32_t index = 0;
-  for (auto singleVarID : singleVarIDs) {
-    this->envIDToIndex[singleVarID] = index;
-    this->indexToEnvID[index] = singleVarID;
+  uint64_t slots = 0;
+  auto addVariable = [this, &index, &slots](uint32_t varID, uint64_t size) {
+    this->envIDToIndex[varID] = index;
+    this->indexToEnvID[index] = varID;
+    this->envIDToOffset[varID] = slots;
     index++;
+    slots += size;
+  };
+  for (auto singleVarID : singleVarIDs) {
+    if (this->readOnlyVarIDs.count(singleVarID) > 0) {
+      continue;
+    }
+    addVariable(singleVarID, valuesInCacheLine);
   }
   for (auto reducableVarID : reducableVarIDs) {
-    this->envIDToIndex[reducableVarID] = index;
-    this->indexToEnvID[index] = reducableVarID;
-    index++;
+    addVariable(reducableVarID, valuesInCacheLine);
+  }
+  for (auto singleVarID : singleVarIDs) {
+    if (this->readOnlyVarIDs.count(singleVarID) == 0) {
+      continue;
+    }
+    addVariable(singleVarID, 1);
   }
 
+  /*
+   * Round the size of the environment up to a whole number of cache lines.
+   */
+  this->envSlots = ((slots + valuesInCacheLine - 1) / valuesInCacheLine)
+                   * valuesInCacheLine;
+
   /*
    * Initialize fields
    */
@@ -175,16 +221,11 @@ void LoopEnvironmentBuilder::initializeBuilder(
   assert(this->envSize == this->envTypes.size()
          && "Environment variables must either be singular or reducible\n");
 
-  /*
-   * Compute how many values can fit in a cache line.
-   */
-  auto valuesInCacheLine = Architecture::getCacheLineBytes() / sizeof(int64_t);
-
   /*
    * Define the LLVM type for the array of environment values.
    */
   auto int64 = IntegerType::get(this->CXT, 64);
-  this->envArrayType = ArrayType::get(int64, this->envSize * valuesInCacheLine);
+  this->envArrayType = ArrayType::get(int64, this->envSlots);
 
   /*
    * Initialize the index-to-variable map.
@@ -208,7 +249,8 @@ void LoopEnvironmentBuilder::initializeBuilder(
 
 void LoopEnvironmentBuilder::createUsers(uint32_t numUsers) {
   for (auto i = 0u; i < numUsers; ++i) {
-    this->envUsers.push_back(new LoopEnvironmentUser(this->envIDToIndex));
+    this->envUsers.push_back(
+        new LoopEnvironmentUser(this->envIDToIndex, this->envIDToOffset));
   }
 
   return;
@@ -235,15 +277,17 @@ void LoopEnvironmentBuilder::addVariableToEnvironment(uint64_t varID,
   this->envTypes.push_back(varType);
 
   /*
-   * Compute how many values can fit in a cache line.
+   * The new variable gets its own cache line at the end of the environment.
    */
   auto valuesInCacheLine = Architecture::getCacheLineBytes() / sizeof(int64_t);
+  this->envIDToOffset[varID] = this->envSlots;
+  this->envSlots += valuesInCacheLine;
 
   /*
    * Define the LLVM type for the array of environment values.
    */
   auto int64 = IntegerType::get(this->CXT, 64);
-  this->envArrayType = ArrayType::get(int64, this->envSize * valuesInCacheLine);
+  this->envArrayType = ArrayType::get(int64, this->envSlots);
 
   /*
    * Set the index-to-var map for the new variable.
@@ -265,9 +309,11 @@ void LoopEnvironmentBuilder::allocateEnvironmentArray(IRBuilder<> &builder) {
 
   auto int8 = IntegerType::get(builder.getContext(), 8);
   auto ptrTy_int8 = PointerType::getUnqual(int8);
-  this->envArray = builder.CreateAlloca(this->envArrayType,
+  auto envAlloca = builder.CreateAlloca(this->envArrayType,
                                         nullptr,
                                         "noelle.loop_environment");
+  envAlloca->setAlignment(Align(Architecture::getCacheLineBytes()));
+  this->envArray = envAlloca;
   this->envArrayInt8Ptr =
       cast<Value>(builder.CreateBitCast(this->envArray, ptrTy_int8));
 
@@ -288,21 +334,13 @@ void LoopEnvironmentBuilder::generateEnvVariables(IRBuilder<> &builder) {
 
   auto int64 = IntegerType::get(builder.getContext(), 64);
   auto zeroV = cast<Value>(ConstantInt::get(int64, 0));
+  auto valuesInCacheLine = Architecture::getCacheLineBytes() / sizeof(int64_t);
   auto fetchCastedEnvPtr =
-      [&](Value *arr, uint32_t envIndex, Type *ptrType) -> Value * {
-    /*
-     * Compute the offset of the variable with index "envIndex" that is stored
-     * inside the environment.
-     *
-     * Compute how many values can fit in a cache line.
-     */
-    auto valuesInCacheLine =
-        Architecture::getCacheLineBytes() / sizeof(int64_t);
-    auto indValue =
-        cast<Value>(ConstantInt::get(int64, envIndex * valuesInCacheLine));
+      [&](Value *arr, uint64_t offset, Type *ptrType) -> Value * {
+    auto indValue = cast<Value>(ConstantInt::get(int64, offset));
 
     /*
-     * Compute the address of the variable with index "envIndex".
+     * Compute the address of the value stored at "offset".
      */
     auto envPtr = builder.CreateGEP(arr->getType()->getPointerElementType(),
                                     arr,
@@ -328,8 +366,9 @@ void LoopEnvironmentBuilder::generateEnvVariables(IRBuilder<> &builder) {
   }
   for (auto envIndex : singleIndices) {
     auto ptrType = PointerType::getUnqual(this->envTypes[envIndex]);
+    auto offset = this->envIDToOffset.at(this->indexToEnvID.at(envIndex));
     this->envIndexToVar[envIndex] =
-        fetchCastedEnvPtr(this->envArray, envIndex, ptrType);
+        fetchCastedEnvPtr(this->envArray, offset, ptrType);
   }
 
   /*
@@ -354,19 +393,20 @@ void LoopEnvironmentBuilder::generateEnvVariables(IRBuilder<> &builder) {
     /*
      * Define the type of the vectorized form of the reducable variable.
      */
-    auto valuesInCacheLine =
-        Architecture::getCacheLineBytes() / sizeof(int64_t);
     auto reduceArrType =
         ArrayType::get(int64, this->numReducers * valuesInCacheLine);
 
     /*
      * Allocate the vectorized form of the current reducable variable on the
      * stack.
+     * The array is aligned to a cache line, so the private copy of each
+     * reducer has a cache line of its own.
      */
     auto reduceArrAlloca =
         builder.CreateAlloca(reduceArrType,
                              nullptr,
                              "noelle.private_variable_for_all_tasks");
+    reduceArrAlloca->setAlignment(Align(Architecture::getCacheLineBytes()));
     this->envIndexToVectorOfReducableVar[envIndex] = reduceArrAlloca;
 
     /*
@@ -374,14 +414,16 @@ void LoopEnvironmentBuilder::generateEnvVariables(IRBuilder<> &builder) {
      * environment.
      */
     auto reduceArrPtrType = PointerType::getUnqual(reduceArrAlloca->getType());
-    auto envPtr = fetchCastedEnvPtr(this->envArray, envIndex, reduceArrPtrType);
+    auto offset = this->envIDToOffset.at(this->indexToEnvID.at(envIndex));
+    auto envPtr = fetchCastedEnvPtr(this->envArray, offset, reduceArrPtrType);
     builder.CreateStore(reduceArrAlloca, envPtr);
 
     /*
      * Compute and cache the pointer of each element of the vectorized variable.
      */
     for (auto i = 0u; i < this->numReducers; ++i) {
-      auto reducePtr = fetchCastedEnvPtr(reduceArrAlloca, i, ptrType);
+      auto reducePtr =
+          fetchCastedEnvPtr(reduceArrAlloca, i * valuesInCacheLine, ptrType);
       this->envIndexToReducableVar[envIndex].push_back(reducePtr);
     }
   }
@@ -650,6 +692,17 @@ uint32_t LoopEnvironmentBuilder::getIndexOfEnvironmentVariable(
   return this->envIDToIndex.at(id);
 }
 
+LoopEnvironmentLayout LoopEnvironmentBuilder::getLayout(void) const {
+  return this->layout;
+}
+
+uint32_t LoopEnvironmentBuilder::getOffsetOfEnvironmentVariable(
+    uint32_t id) const {
+  assert(this->envIDToOffset.find(id) != this->envIDToOffset.end()
+         && "The environment variable is not included in the builder\n");
+  return this->envIDToOffset.at(id);
+}
+
 bool LoopEnvironmentBuilder::isIncludedEnvironmentVariable(uint32_t id) const {
   return (this->envIDToIndex.find(id) != this->envIDToIndex.end());
 }
@@ -25,11 +25,13 @@
 namespace arcana::noelle {
 
 LoopEnvironmentUser::LoopEnvironmentUser(
-    std::unordered_map<uint32_t, uint32_t> &envIDToIndex)
+    std::unordered_map<uint32_t, uint32_t> &envIDToIndex,
+    std::unordered_map<uint32_t, uint32_t> &envIDToOffset)
   : envIndexToPtr{},
     liveInIDs{},
     liveOutIDs{},
-    envIDToIndex{ envIDToIndex } {
+    envIDToIndex{ envIDToIndex },
+    envIDToOffset{ envIDToOffset } {
   envIndexToPtr.clear();
   liveInIDs.clear();
   liveOutIDs.clear();
@@ -70,16 +72,10 @@ Instruction *LoopEnvironmentUser::createEnvironmentVariablePointer(
   auto int64 = IntegerType::get(builder.getContext(), 64);
   auto zeroV = cast<Value>(ConstantInt::get(int64, 0));
 
-  /*
-   * Compute how many values can fit in a cache line.
-   */
-  auto valuesInCacheLine = Architecture::getCacheLineBytes() / sizeof(int64_t);
-
   /*
    * Compute the offset of the environment variable.
    */
-  auto envIndV =
-      cast<Value>(ConstantInt::get(int64, envIndex * valuesInCacheLine));
+  auto envIndV = cast<Value>(ConstantInt::get(int64, this->getOffset(envID)));
 
   /*
    * Compute the address of the environment variable
@@ -124,8 +120,7 @@ void LoopEnvironmentUser::createReducableEnvPtr(IRBuilder<> &builder,
 
   auto int64 = IntegerType::get(builder.getContext(), 64);
   auto zeroV = cast<Value>(ConstantInt::get(int64, 0));
-  auto envIndV =
-      cast<Value>(ConstantInt::get(int64, envIndex * valuesInCacheLine));
+  auto envIndV = cast<Value>(ConstantInt::get(int64, this->getOffset(envID)));
 
   auto envReduceGEP =
       builder.CreateGEP(this->envArray->getType()->getPointerElementType(),
@@ -192,6 +187,10 @@ iterator_range<std::set<uint32_t>::iterator> LoopEnvironmentUser::
   return make_range(liveOutIDs.begin(), liveOutIDs.end());
 }
 
+uint64_t LoopEnvironmentUser::getOffset(uint32_t envID) const {
+  return this->envIDToOffset.at(envID);
+}
+
 LoopEnvironmentUser::~LoopEnvironmentUser() {
   return;
 }
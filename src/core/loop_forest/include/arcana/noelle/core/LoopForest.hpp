@@ -22,6 +22,9 @@
 #ifndef NOELLE_SRC_CORE_LOOP_FOREST_LOOPFOREST_H_
 #define NOELLE_SRC_CORE_LOOP_FOREST_LOOPFOREST_H_
 
+#include <memory>
+#include <mutex>
+
 #include "arcana/noelle/core/SystemHeaders.hpp"
 #include "arcana/noelle/core/Dominators.hpp"
 #include "arcana/noelle/core/LoopStructure.hpp"
@@ -30,6 +33,77 @@ namespace arcana::noelle {
 
 class LoopForest;
 
+/*
+ * Facts about loops that only depend on the loops themselves (i.e., not on the
+ * loop nest they are analyzed from).
+ * They are computed at most once and shared by all the nodes of a forest
+ * (e.g., by the LoopContent of every loop that includes a given loop).
+ * The forests created by Noelle share the same cache.
+ *
+ * Loops are identified by their header, so the facts outlive the
+ * LoopStructure they have been computed from. They are kept until the code of
+ * their function is reported as modified.
+ */
+class LoopNestCache {
+public:
+  /*
+   * Classification of the PHIs of the header of a loop done by the scalar
+   * evolution analysis.
+   */
+  struct HeaderPHIs {
+    /*
+     * PHIs whose SCEV is an add recurrence.
+     */
+    std::unordered_set<PHINode *> addRecurrences;
+
+    /*
+     * PHIs whose SCEV is not an add recurrence.
+     */
+    std::unordered_set<PHINode *> otherSCEVs;
+  };
+
+  /*
+   * Return the number of iterations that @loop executes every time it is
+   * invoked, if it is known at compile time.
+   * @compute is invoked only the first time @loop is queried.
+   */
+  std::optional<int64_t> getIterationsPerInvocation(
+      LoopStructure *loop,
+      std::function<std::optional<int64_t>(LoopStructure *loop)> compute);
+
+  /*
+   * Return the classification of the PHIs of the header of @loop.
+   * @compute is invoked only the first time @loop is queried.
+   */
+  const HeaderPHIs &getHeaderPHIs(
+      LoopStructure *loop,
+      std::function<HeaderPHIs(LoopStructure *loop)> compute);
+
+  /*
+   * Forget the facts about @loop (e.g., because its code has been modified).
+   */
+  void invalidate(LoopStructure *loop);
+
+  /*
+   * Forget the facts about the loops of @F.
+   */
+  void invalidate(Function &F);
+
+  void invalidateAll(void);
+
+private:
+  struct Facts {
+    std::optional<std::optional<int64_t>> iterationsPerInvocation;
+    std::optional<HeaderPHIs> headerPHIs;
+  };
+
+  mutable std::mutex lock;
+  std::unordered_map<Function *, std::unordered_map<BasicBlock *, Facts>>
+      facts;
+
+  Facts &getFacts(LoopStructure *loop);
+};
+
 class LoopTree {
 public:
   LoopTree(LoopForest *f, LoopStructure *l);
@@ -64,6 +138,11 @@ public:
    */
   uint32_t getNumberOfSubLoops(void) const;
 
+  /*
+   * Return the facts shared by all the nodes of the forest that includes @this.
+   */
+  LoopNestCache &getNestCache(void) const;
+
   bool visitPreOrder(
       std::function<bool(LoopTree *n, uint32_t treeLevel)> funcToInvoke);
 
@@ -92,6 +171,13 @@ public:
   LoopForest(std::vector<LoopStructure *> const &loops,
              std::unordered_map<Function *, DominatorSummary *> const &doms);
 
+  /*
+   * The facts about the loops are shared with the other users of @nestCache.
+   */
+  LoopForest(std::vector<LoopStructure *> const &loops,
+             std::unordered_map<Function *, DominatorSummary *> const &doms,
+             std::shared_ptr<LoopNestCache> nestCache);
+
   uint64_t getNumberOfLoops(void) const;
 
   std::unordered_set<LoopTree *> getTrees(void) const;
@@ -106,6 +192,8 @@ public:
 
   LoopTree *getInnermostLoopThatContains(BasicBlock *bb) const;
 
+  LoopNestCache &getNestCache(void);
+
   ~LoopForest();
 
 private:
@@ -114,6 +202,7 @@ private:
   std::unordered_map<Function *, std::unordered_set<LoopStructure *>>
       functionLoops;
   std::unordered_map<BasicBlock *, LoopTree *> headerLoops;
+  std::shared_ptr<LoopNestCache> nestCache;
 
   void addChildrenToTree(
       LoopTree *root,
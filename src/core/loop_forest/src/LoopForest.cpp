@@ -25,7 +25,17 @@ namespace arcana::noelle {
 
 LoopForest::LoopForest(
     std::vector<LoopStructure *> const &loops,
-    std::unordered_map<Function *, DominatorSummary *> const &doms) {
+    std::unordered_map<Function *, DominatorSummary *> const &doms)
+  : LoopForest(loops, doms, std::make_shared<LoopNestCache>()) {
+  return;
+}
+
+LoopForest::LoopForest(
+    std::vector<LoopStructure *> const &loops,
+    std::unordered_map<Function *, DominatorSummary *> const &doms,
+    std::shared_ptr<LoopNestCache> nestCache)
+  : nestCache{ nestCache } {
+  assert(this->nestCache != nullptr);
 
   /*
    * Allocate the nodes.
@@ -244,6 +254,10 @@ LoopForest::~LoopForest() {
   }
 }
 
+LoopNestCache &LoopForest::getNestCache(void) {
+  return *this->nestCache;
+}
+
 LoopTree *LoopForest::getNode(LoopStructure *loop) const {
 
   /*
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Yian Su, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/LoopForest.hpp"
+
+namespace arcana::noelle {
+
+LoopNestCache::Facts &LoopNestCache::getFacts(LoopStructure *loop) {
+  assert(loop != nullptr);
+  auto header = loop->getHeader();
+  auto &factsOfFunction = this->facts[header->getParent()];
+
+  return factsOfFunction[header];
+}
+
+std::optional<int64_t> LoopNestCache::getIterationsPerInvocation(
+    LoopStructure *loop,
+    std::function<std::optional<int64_t>(LoopStructure *loop)> compute) {
+  std::lock_guard<std::mutex> guard(this->lock);
+
+  /*
+   * Check if we already know the answer.
+   */
+  auto &loopFacts = this->getFacts(loop);
+  if (!loopFacts.iterationsPerInvocation.has_value()) {
+
+    /*
+     * Compute the answer.
+     */
+    loopFacts.iterationsPerInvocation = compute(loop);
+  }
+
+  return loopFacts.iterationsPerInvocation.value();
+}
+
+const LoopNestCache::HeaderPHIs &LoopNestCache::getHeaderPHIs(
+    LoopStructure *loop,
+    std::function<HeaderPHIs(LoopStructure *loop)> compute) {
+  std::lock_guard<std::mutex> guard(this->lock);
+
+  /*
+   * Check if we already know the answer.
+   */
+  auto &loopFacts = this->getFacts(loop);
+  if (!loopFacts.headerPHIs.has_value()) {
+
+    /*
+     * Compute the answer.
+     */
+    loopFacts.headerPHIs = compute(loop);
+  }
+
+  return loopFacts.headerPHIs.value();
+}
+
+void LoopNestCache::invalidate(LoopStructure *loop) {
+  assert(loop != nullptr);
+  std::lock_guard<std::mutex> guard(this->lock);
+
+  auto header = loop->getHeader();
+  auto it = this->facts.find(header->getParent());
+  if (it == this->facts.end()) {
+    return;
+  }
+  it->second.erase(header);
+
+  return;
+}
+
+void LoopNestCache::invalidate(Function &F) {
+  std::lock_guard<std::mutex> guard(this->lock);
+  this->facts.erase(&F);
+
+  return;
+}
+
+void LoopNestCache::invalidateAll(void) {
+  std::lock_guard<std::mutex> guard(this->lock);
+  this->facts.clear();
+
+  return;
+}
+
+} // namespace arcana::noelle
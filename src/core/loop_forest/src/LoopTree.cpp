@@ -285,6 +285,11 @@ bool LoopTree::visitPostOrder(
   return false;
 }
 
+LoopNestCache &LoopTree::getNestCache(void) const {
+  assert(this->forest != nullptr);
+  return this->forest->getNestCache();
+}
+
 LoopTree::~LoopTree() {
 
   /*
@@ -88,6 +88,20 @@ private:
       loopToIVsMap;
   std::unordered_map<LoopStructure *, LoopGoverningInductionVariable *>
       loopToGoverningIVAttrMap;
+
+  /*
+   * Return the number of iterations that @loop executes every time it is
+   * invoked, if its governing IV has constant start, step, and bound.
+   */
+  static std::optional<int64_t> computeIterationsPerInvocation(
+      LoopStructure *loop,
+      ScalarEvolution &SE);
+
+  /*
+   * Classify the PHIs of the header of @loop by their SCEV.
+   */
+  static LoopNestCache::HeaderPHIs classifyHeaderPHIs(LoopStructure *loop,
+                                                      ScalarEvolution &SE);
 };
 
 } // namespace arcana::noelle
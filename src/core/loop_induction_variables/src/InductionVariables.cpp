@@ -46,6 +46,29 @@ InductionVariableManager::InductionVariableManager(LoopTree *loopNode,
    */
   auto &F = *loopToAnalyze->getHeader()->getParent();
 
+  /*
+   * The classification of the header PHIs done by SCEV only depends on the
+   * loop they belong to, so it is shared with the other loops of the nest that
+   * include it.
+   */
+  auto &nestCache = this->loop->getNestCache();
+  auto getHeaderPHIs = [&nestCache, &SE](LoopStructure *l)
+      -> const LoopNestCache::HeaderPHIs & {
+    return nestCache.getHeaderPHIs(
+        l,
+        [&SE](LoopStructure *l) -> LoopNestCache::HeaderPHIs {
+          return InductionVariableManager::classifyHeaderPHIs(l, SE);
+        });
+  };
+  auto isAddRecurrence = [&](Instruction *I) -> bool {
+    auto l = this->loop->getInnermostLoopThatContains(I);
+    if ((l != nullptr) && (l->getHeader() == I->getParent())) {
+      auto &headerPHIs = getHeaderPHIs(l);
+      return headerPHIs.addRecurrences.count(cast<PHINode>(I)) > 0;
+    }
+    return SE.getSCEV(I)->getSCEVType() == SCEVTypes::scAddRecExpr;
+  };
+
   /*
    * Identify the induction variables.
    */
@@ -58,6 +81,7 @@ InductionVariableManager::InductionVariableManager(LoopTree *loopNode,
      */
     auto header = loop->getHeader();
     auto preHeader = loop->getPreHeader();
+    auto &headerPHIs = getHeaderPHIs(loop);
 
     /*
      * Iterate over all phis within the loop header.
@@ -98,19 +122,13 @@ InductionVariableManager::InductionVariableManager(LoopTree *loopNode,
       } else {
 
         /*
-         * Fetch the SCEV and check if it suggests this is an induction
-         * variable.
-         */
-        auto scev = SE.getSCEV(&phi);
-        if (!scev) {
-          noelleDeterminedValidIV = false;
-        }
-        /*
+         * Check if the SCEV of the PHI suggests this is an induction variable.
+         *
          * For a PHI that has a SCEV that is not an AddRecExpr, it may still be
          * an IV that is being updated in a subloop if the proceeding conditions
          * are met.
          */
-        else if (scev->getSCEVType() != SCEVTypes::scAddRecExpr) {
+        if (headerPHIs.addRecurrences.count(&phi) == 0) {
           noelleDeterminedValidIV = false;
           int64_t stepMultiplier = 1;
 
@@ -122,8 +140,7 @@ InductionVariableManager::InductionVariableManager(LoopTree *loopNode,
           PHINode *internalPHI = nullptr;
 
           sccContainingIV->iterateOverInstructions([&](Instruction *I) -> bool {
-            if (isa<PHINode>(I) && I != &phi
-                && SE.getSCEV(I)->getSCEVType() == SCEVTypes::scAddRecExpr
+            if (isa<PHINode>(I) && I != &phi && isAddRecurrence(I)
                 && this->loop->isIncludedInItsSubLoops(I)) {
               if (!foundOnePHI) {
                 foundOnePHI = true;
@@ -143,165 +160,36 @@ InductionVariableManager::InductionVariableManager(LoopTree *loopNode,
           /*
            * 2. The subloop has only one exit condition, which compares
            * the subloop's governing IV to a constant.
+           *
+           * This only depends on the subloop, so it is shared with the other
+           * loops of the nest that include it.
            */
           auto subloop = this->loop->getInnermostLoopThatContains(internalPHI);
-          if (subloop->getLoopExitBasicBlocks().size() != 1) {
+          auto subloopIterations = nestCache.getIterationsPerInvocation(
+              subloop,
+              [&SE](LoopStructure *l) -> std::optional<int64_t> {
+                return InductionVariableManager::
+                    computeIterationsPerInvocation(l, SE);
+              });
+          if (!subloopIterations) {
             continue;
           }
 
           /*
-           * Note: a BranchInst is expected to terminate the loop header.
-           * We don't handle do-while loops at the moment.
+           * If all conditions are met, the number of inner loop iterations is
+           * the step multiplier of the IV.
            */
-          auto subloopHeader = subloop->getHeader();
-          if (subloopHeader->getUniqueSuccessor() != nullptr) {
-
-            /*
-             * This is a do-while loop.
-             */
-            continue;
-          }
-          if (auto subloopExitBr =
-                  dyn_cast<BranchInst>(subloopHeader->getTerminator())) {
-
-            /*
-             * Fetch the condition.
-             */
-            auto subloopExitBrCondition = subloopExitBr->getCondition();
-            if (!isa<CmpInst>(subloopExitBrCondition)) {
-              continue;
-            }
-            auto subloopExitCond = cast<CmpInst>(subloopExitBrCondition);
-            auto subloopExitCondL = subloopExitCond->getOperand(0);
-            auto subloopExitCondR = subloopExitCond->getOperand(1);
-
-            const SCEV *subloopIV = nullptr;
-            const SCEV *subloopExitSCEV = nullptr;
-            if (SE.getSCEV(subloopExitCondL)->getSCEVType()
-                    == SCEVTypes::scAddRecExpr
-                && SE.getSCEV(subloopExitCondR)->getSCEVType()
-                       == SCEVTypes::scConstant) {
-              subloopIV = SE.getSCEV(subloopExitCondL);
-              subloopExitSCEV = SE.getSCEV(subloopExitCondR);
-            } else if (SE.getSCEV(subloopExitCondR)->getSCEVType()
-                           == SCEVTypes::scAddRecExpr
-                       && SE.getSCEV(subloopExitCondL)->getSCEVType()
-                              == SCEVTypes::scConstant) {
-              subloopIV = SE.getSCEV(subloopExitCondR);
-              subloopExitSCEV = SE.getSCEV(subloopExitCondL);
-            }
-
-            if (subloopExitSCEV == nullptr || subloopIV == nullptr) {
-              continue;
-            }
-
-            /*
-             * If all conditions are met, calculate the number of inner loop
-             * iterations (step multiplier) and allocate the IV.
-             */
-            assert(subloopExitSCEV->getSCEVType() == SCEVTypes::scConstant);
-            auto subloopExitConstant =
-                cast<SCEVConstant>(subloopExitSCEV)->getValue()->getSExtValue();
-
-            assert(subloopIV->getSCEVType() == SCEVTypes::scAddRecExpr);
-            auto subloopIVSCEV = cast<SCEVAddRecExpr>(subloopIV);
-
-            auto subloopExitBBs = subloop->getLoopExitBasicBlocks();
-            bool exitsOnTrue = false;
-            if (std::find(subloopExitBBs.begin(),
-                          subloopExitBBs.end(),
-                          subloopExitBr->getSuccessor(0))
-                != subloopExitBBs.end()) {
-              exitsOnTrue = true;
-            }
-
-            if (auto startSCEVConstant =
-                    dyn_cast<SCEVConstant>(subloopIVSCEV->getStart())) {
-              auto subloopStartValue =
-                  startSCEVConstant->getValue()->getSExtValue();
-              if (auto stepSCEVConstant = dyn_cast<SCEVConstant>(
-                      subloopIVSCEV->getStepRecurrence(SE))) {
-                auto subloopStepSize =
-                    stepSCEVConstant->getValue()->getSExtValue();
-                auto negativeStep = stepSCEVConstant->getValue()->isNegative();
-
-                /*
-                 * We ignore the combinations that don't make sense for IVs.
-                 * Example: an increasing IV that exits when it is < C.
-                 * In this case, if the start value is < C, the loop wouldn't
-                 * execute. Otherwise, it will never be < C and run infinitely.
-                 */
-                auto unhandledCmp = false;
-                switch (subloopExitCond->getPredicate()) {
-
-                  case CmpInst::Predicate::ICMP_EQ:
-                    if (!exitsOnTrue)
-                      unhandledCmp = true;
-                    break;
-
-                  case CmpInst::Predicate::ICMP_NE:
-                    if (exitsOnTrue)
-                      unhandledCmp = true;
-                    break;
-
-                  case CmpInst::Predicate::ICMP_UGT:
-                  case CmpInst::Predicate::ICMP_SGT:
-                    if (negativeStep == exitsOnTrue)
-                      unhandledCmp = true;
-                    if (!negativeStep)
-                      subloopExitConstant += 1;
-                    break;
-
-                  case CmpInst::Predicate::ICMP_SGE:
-                  case CmpInst::Predicate::ICMP_UGE:
-                    if (negativeStep == exitsOnTrue)
-                      unhandledCmp = true;
-                    if (negativeStep)
-                      subloopExitConstant += 1;
-                    break;
-
-                  case CmpInst::Predicate::ICMP_SLT:
-                  case CmpInst::Predicate::ICMP_ULT:
-                    if (negativeStep != exitsOnTrue)
-                      unhandledCmp = true;
-                    if (negativeStep)
-                      subloopExitConstant += 1;
-                    break;
-
-                  case CmpInst::Predicate::ICMP_SLE:
-                  case CmpInst::Predicate::ICMP_ULE:
-                    if (negativeStep != exitsOnTrue)
-                      unhandledCmp = true;
-                    if (!negativeStep)
-                      subloopExitConstant += 1;
-                    break;
-
-                  default:
-                    unhandledCmp = true;
-                    break;
-                }
-
-                if (unhandledCmp) {
-                  continue;
-                }
-
-                auto d = std::div(subloopExitConstant - subloopStartValue,
-                                  subloopStepSize);
-                stepMultiplier = d.quot + (d.rem ? 1 : 0);
-
-                IV = new InductionVariable(
-                    loop,
-                    IVM,
-                    SE,
-                    stepMultiplier,
-                    &phi,
-                    std::unordered_set<PHINode *>({ internalPHI }),
-                    *sccContainingIV,
-                    loopEnv,
-                    referentialExpander);
-              }
-            }
-          }
+          stepMultiplier = subloopIterations.value();
+          IV = new InductionVariable(
+              loop,
+              IVM,
+              SE,
+              stepMultiplier,
+              &phi,
+              std::unordered_set<PHINode *>({ internalPHI }),
+              *sccContainingIV,
+              loopEnv,
+              referentialExpander);
         }
       }
 
@@ -369,6 +257,179 @@ InductionVariableManager::InductionVariableManager(LoopTree *loopNode,
   return;
 }
 
+LoopNestCache::HeaderPHIs InductionVariableManager::classifyHeaderPHIs(
+    LoopStructure *loop,
+    ScalarEvolution &SE) {
+  LoopNestCache::HeaderPHIs headerPHIs{};
+  for (auto &phi : loop->getHeader()->phis()) {
+    if (!SE.isSCEVable(phi.getType())) {
+      continue;
+    }
+    auto scev = SE.getSCEV(&phi);
+    if (scev->getSCEVType() == SCEVTypes::scAddRecExpr) {
+      headerPHIs.addRecurrences.insert(&phi);
+    } else {
+      headerPHIs.otherSCEVs.insert(&phi);
+    }
+  }
+
+  return headerPHIs;
+}
+
+std::optional<int64_t> InductionVariableManager::
+    computeIterationsPerInvocation(LoopStructure *loop, ScalarEvolution &SE) {
+
+  /*
+   * The loop must have only one exit condition, which compares the loop's
+   * governing IV to a constant.
+   */
+  auto loopExitBBs = loop->getLoopExitBasicBlocks();
+  if (loopExitBBs.size() != 1) {
+    return std::nullopt;
+  }
+
+  /*
+   * Note: a BranchInst is expected to terminate the loop header.
+   * We don't handle do-while loops at the moment.
+   */
+  auto header = loop->getHeader();
+  if (header->getUniqueSuccessor() != nullptr) {
+
+    /*
+     * This is a do-while loop.
+     */
+    return std::nullopt;
+  }
+  auto exitBr = dyn_cast<BranchInst>(header->getTerminator());
+  if (exitBr == nullptr) {
+    return std::nullopt;
+  }
+
+  /*
+   * Fetch the condition.
+   */
+  auto exitBrCondition = exitBr->getCondition();
+  if (!isa<CmpInst>(exitBrCondition)) {
+    return std::nullopt;
+  }
+  auto exitCond = cast<CmpInst>(exitBrCondition);
+  auto exitCondL = exitCond->getOperand(0);
+  auto exitCondR = exitCond->getOperand(1);
+
+  const SCEV *loopIV = nullptr;
+  const SCEV *exitSCEV = nullptr;
+  if (SE.getSCEV(exitCondL)->getSCEVType() == SCEVTypes::scAddRecExpr
+      && SE.getSCEV(exitCondR)->getSCEVType() == SCEVTypes::scConstant) {
+    loopIV = SE.getSCEV(exitCondL);
+    exitSCEV = SE.getSCEV(exitCondR);
+  } else if (SE.getSCEV(exitCondR)->getSCEVType() == SCEVTypes::scAddRecExpr
+             && SE.getSCEV(exitCondL)->getSCEVType()
+                    == SCEVTypes::scConstant) {
+    loopIV = SE.getSCEV(exitCondR);
+    exitSCEV = SE.getSCEV(exitCondL);
+  }
+  if (exitSCEV == nullptr || loopIV == nullptr) {
+    return std::nullopt;
+  }
+
+  /*
+   * Fetch the bound, the start value, and the step of the governing IV.
+   */
+  assert(exitSCEV->getSCEVType() == SCEVTypes::scConstant);
+  auto exitConstant = cast<SCEVConstant>(exitSCEV)->getValue()->getSExtValue();
+
+  assert(loopIV->getSCEVType() == SCEVTypes::scAddRecExpr);
+  auto loopIVSCEV = cast<SCEVAddRecExpr>(loopIV);
+
+  auto exitsOnTrue = false;
+  if (std::find(loopExitBBs.begin(),
+                loopExitBBs.end(),
+                exitBr->getSuccessor(0))
+      != loopExitBBs.end()) {
+    exitsOnTrue = true;
+  }
+
+  auto startSCEVConstant = dyn_cast<SCEVConstant>(loopIVSCEV->getStart());
+  if (startSCEVConstant == nullptr) {
+    return std::nullopt;
+  }
+  auto startValue = startSCEVConstant->getValue()->getSExtValue();
+  auto stepSCEVConstant =
+      dyn_cast<SCEVConstant>(loopIVSCEV->getStepRecurrence(SE));
+  if (stepSCEVConstant == nullptr) {
+    return std::nullopt;
+  }
+  auto stepSize = stepSCEVConstant->getValue()->getSExtValue();
+  auto negativeStep = stepSCEVConstant->getValue()->isNegative();
+
+  /*
+   * We ignore the combinations that don't make sense for IVs.
+   * Example: an increasing IV that exits when it is < C.
+   * In this case, if the start value is < C, the loop wouldn't
+   * execute. Otherwise, it will never be < C and run infinitely.
+   */
+  auto unhandledCmp = false;
+  switch (exitCond->getPredicate()) {
+
+    case CmpInst::Predicate::ICMP_EQ:
+      if (!exitsOnTrue)
+        unhandledCmp = true;
+      break;
+
+    case CmpInst::Predicate::ICMP_NE:
+      if (exitsOnTrue)
+        unhandledCmp = true;
+      break;
+
+    case CmpInst::Predicate::ICMP_UGT:
+    case CmpInst::Predicate::ICMP_SGT:
+      if (negativeStep == exitsOnTrue)
+        unhandledCmp = true;
+      if (!negativeStep)
+        exitConstant += 1;
+      break;
+
+    case CmpInst::Predicate::ICMP_SGE:
+    case CmpInst::Predicate::ICMP_UGE:
+      if (negativeStep == exitsOnTrue)
+        unhandledCmp = true;
+      if (negativeStep)
+        exitConstant += 1;
+      break;
+
+    case CmpInst::Predicate::ICMP_SLT:
+    case CmpInst::Predicate::ICMP_ULT:
+      if (negativeStep != exitsOnTrue)
+        unhandledCmp = true;
+      if (negativeStep)
+        exitConstant += 1;
+      break;
+
+    case CmpInst::Predicate::ICMP_SLE:
+    case CmpInst::Predicate::ICMP_ULE:
+      if (negativeStep != exitsOnTrue)
+        unhandledCmp = true;
+      if (!negativeStep)
+        exitConstant += 1;
+      break;
+
+    default:
+      unhandledCmp = true;
+      break;
+  }
+  if (unhandledCmp) {
+    return std::nullopt;
+  }
+
+  /*
+   * Compute the number of iterations.
+   */
+  auto d = std::div(exitConstant - startValue, stepSize);
+  int64_t iterations = d.quot + (d.rem ? 1 : 0);
+
+  return iterations;
+}
+
 std::unordered_set<InductionVariable *> InductionVariableManager::
     getInductionVariables(void) const {
 
@@ -83,6 +83,7 @@ SCCDAGPartition::~SCCDAGPartition() {
     auto set = node->getT();
     delete set;
   }
+  this->destroyNodesAndEdges();
 }
 
 SCC *SCCDAGPartition::sccOfValue(Value *V) {
@@ -27,6 +27,11 @@
 
 #include "arcana/noelle/core/SystemHeaders.hpp"
 #include "arcana/noelle/core/LoopContent.hpp"
+#include "arcana/noelle/core/FunctionDependenceGraphCache.hpp"
+#include "arcana/noelle/core/DependenceQueryCache.hpp"
+#include "arcana/noelle/core/InstructionReachabilityCache.hpp"
+#include "arcana/noelle/core/PDGGenerator.hpp"
+#include "arcana/noelle/core/Hot.hpp"
 
 namespace arcana::noelle {
 
@@ -41,6 +46,43 @@ public:
 
   void setPDG(PDG *programDependenceGraph);
 
+  /*
+   * The dependence graphs of the functions modified by this transformer are
+   * dropped from @cache.
+   */
+  void setFunctionDependenceGraphCache(FunctionDependenceGraphCache *cache);
+
+  /*
+   * The answers about the functions modified by this transformer are dropped
+   * from @cache.
+   */
+  void setDependenceQueryCache(DependenceQueryCache *cache);
+
+  /*
+   * The reachability of the functions modified by this transformer is dropped
+   * from @cache.
+   */
+  void setInstructionReachabilityCache(InstructionReachabilityCache *cache);
+
+  /*
+   * The PDG of @generator is updated after the loops are modified, so it
+   * does not need to be computed again.
+   * The caches given to @generator are invalidated by it.
+   */
+  void setPDGGenerator(PDGGenerator *generator);
+
+  /*
+   * The facts about the loops of the functions modified by this transformer
+   * are dropped from @cache.
+   */
+  void setLoopNestCache(LoopNestCache *cache);
+
+  /*
+   * The aggregated counters of the functions modified by this transformer are
+   * recomputed in @profiles.
+   */
+  void setProfiles(Hot *profiles);
+
   LoopUnrollResult unrollLoop(LoopContent *loop, uint32_t unrollFactor);
 
   bool fullyUnrollLoop(LoopContent *loop);
@@ -56,11 +98,19 @@ public:
 
 private:
   PDG *pdg;
+  FunctionDependenceGraphCache *fdgCache;
+  DependenceQueryCache *queryCache;
+  InstructionReachabilityCache *reachabilityCache;
+  PDGGenerator *pdgGenerator;
+  LoopNestCache *nestCache;
+  Hot *profiles;
   std::function<llvm::ScalarEvolution &(Function &F)> getSCEV;
   std::function<llvm::LoopInfo &(Function &F)> getLoopInfo;
   std::function<llvm::PostDominatorTree &(Function &F)> getPDT;
   std::function<llvm::DominatorTree &(Function &F)> getDT;
   std::function<llvm::AssumptionCache &(Function &F)> getAssumptionCache;
+
+  void codeModified(Function &F);
 };
 
 } // namespace arcana::noelle
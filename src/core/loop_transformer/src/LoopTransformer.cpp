@@ -33,7 +33,14 @@ LoopTransformer::LoopTransformer(
     std::function<llvm::PostDominatorTree &(Function &F)> getPDT,
     std::function<llvm::DominatorTree &(Function &F)> getDT,
     std::function<llvm::AssumptionCache &(Function &F)> getAssumptionCache)
-  : getSCEV{ getSCEV },
+  : pdg{ nullptr },
+    fdgCache{ nullptr },
+    queryCache{ nullptr },
+    reachabilityCache{ nullptr },
+    pdgGenerator{ nullptr },
+    nestCache{ nullptr },
+    profiles{ nullptr },
+    getSCEV{ getSCEV },
     getLoopInfo{ getLoopInfo },
     getPDT{ getPDT },
     getDT{ getDT },
@@ -48,6 +55,44 @@ void LoopTransformer::setPDG(PDG *programDependenceGraph) {
   return;
 }
 
+void LoopTransformer::setFunctionDependenceGraphCache(
+    FunctionDependenceGraphCache *cache) {
+  this->fdgCache = cache;
+
+  return;
+}
+
+void LoopTransformer::setDependenceQueryCache(DependenceQueryCache *cache) {
+  this->queryCache = cache;
+
+  return;
+}
+
+void LoopTransformer::setInstructionReachabilityCache(
+    InstructionReachabilityCache *cache) {
+  this->reachabilityCache = cache;
+
+  return;
+}
+
+void LoopTransformer::setPDGGenerator(PDGGenerator *generator) {
+  this->pdgGenerator = generator;
+
+  return;
+}
+
+void LoopTransformer::setLoopNestCache(LoopNestCache *cache) {
+  this->nestCache = cache;
+
+  return;
+}
+
+void LoopTransformer::setProfiles(Hot *profiles) {
+  this->profiles = profiles;
+
+  return;
+}
+
 LoopUnrollResult LoopTransformer::unrollLoop(LoopContent *loop,
                                              uint32_t unrollFactor) {
 
@@ -72,6 +117,11 @@ LoopUnrollResult LoopTransformer::unrollLoop(LoopContent *loop,
   auto llvmLoop = LLVMLoops.getLoopFor(h);
   assert(llvmLoop != nullptr);
 
+  /*
+   * Fetch the instructions of the loop before unrolling it.
+   */
+  auto loopInstructions = ls->getInstructions();
+
   /*
    * Try to unroll the loop
    */
@@ -86,6 +136,12 @@ LoopUnrollResult LoopTransformer::unrollLoop(LoopContent *loop,
   TargetTransformInfo TTI(lsFunction->getParent()->getDataLayout());
   auto unrolled =
       UnrollLoop(llvmLoop, opts, &LLVMLoops, &SE, &DT, &AC, &TTI, &ORE, true);
+  if (unrolled != LoopUnrollResult::Unmodified) {
+    if (this->pdgGenerator != nullptr) {
+      this->pdgGenerator->loopUnrolled(*lsFunction, loopInstructions);
+    }
+    this->codeModified(*lsFunction);
+  }
 
   return unrolled;
 }
@@ -106,7 +162,14 @@ bool LoopTransformer::fullyUnrollLoop(LoopContent *loop) {
   auto &DT = this->getDT(loopFunction);
   auto &SE = this->getSCEV(loopFunction);
   auto &AC = this->getAssumptionCache(loopFunction);
+  auto loopInstructions = ls->getInstructions();
   auto modified = loopUnroll.fullyUnrollLoop(*loop, LS, DT, SE, AC);
+  if (modified) {
+    if (this->pdgGenerator != nullptr) {
+      this->pdgGenerator->loopUnrolled(loopFunction, loopInstructions);
+    }
+    this->codeModified(loopFunction);
+  }
 
   return modified;
 }
@@ -128,16 +191,58 @@ bool LoopTransformer::whilifyLoop(LoopContent *loop) {
   auto &DT = this->getDT(*func);
   auto &PDT = this->getPDT(*func);
   auto DS = new DominatorSummary(DT, PDT);
-  auto FDG = this->pdg->createFunctionSubgraph(*func);
+  auto FDG = (this->fdgCache != nullptr)
+                 ? this->fdgCache->getFunctionDependenceGraph(*func)
+                 : this->pdg->createFunctionSubgraph(*func);
 
   /*
    * Whilify the loop.
    */
+  auto loopInstructions = loopStructure->getInstructions();
   auto modified = loopWhilify.whilifyLoop(*loop, scheduler, DS, FDG);
+  if (modified) {
+    if (this->pdgGenerator != nullptr) {
+      this->pdgGenerator->loopWhilified(*func, loopInstructions);
+    }
+    this->codeModified(*func);
+  }
 
   return modified;
 }
 
+void LoopTransformer::codeModified(Function &F) {
+
+  /*
+   * The facts about the loops and the profiles are not maintained by the PDG
+   * generator.
+   */
+  if (this->nestCache != nullptr) {
+    this->nestCache->invalidate(F);
+  }
+  if (this->profiles != nullptr) {
+    this->profiles->invalidate(&F);
+  }
+
+  /*
+   * The PDG generator has already dropped what it knows about @F from its
+   * caches.
+   */
+  if (this->pdgGenerator != nullptr) {
+    return;
+  }
+  if (this->fdgCache != nullptr) {
+    this->fdgCache->invalidate(F);
+  }
+  if (this->queryCache != nullptr) {
+    this->queryCache->invalidate(F);
+  }
+  if (this->reachabilityCache != nullptr) {
+    this->reachabilityCache->invalidate(F);
+  }
+
+  return;
+}
+
 LoopTransformer::~LoopTransformer() {
   return;
 }
@@ -162,6 +267,15 @@ bool LoopTransformer::splitLoop(LoopContent *loop,
                                SCCsToPullOut,
                                instructionsRemoved,
                                instructionsAdded);
+  if (modified) {
+    auto &F = *loop->getLoopStructure()->getFunction();
+    if (this->pdgGenerator != nullptr) {
+      std::unordered_set<Instruction *> added(instructionsAdded.begin(),
+                                              instructionsAdded.end());
+      this->pdgGenerator->codeModified(F, added);
+    }
+    this->codeModified(F);
+  }
 
   return modified;
 }
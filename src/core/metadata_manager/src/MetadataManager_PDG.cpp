@@ -44,6 +44,9 @@ void MetadataManager::removePDGMetadata(void) {
   if (auto n = this->program.getNamedMetadata("noelle.module.pdg")) {
     this->program.eraseNamedMetadata(n);
   }
+  if (auto n = this->program.getNamedMetadata("noelle.module.pdg.edges")) {
+    this->program.eraseNamedMetadata(n);
+  }
 
   return;
 }
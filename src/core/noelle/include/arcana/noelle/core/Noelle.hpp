@@ -28,6 +28,7 @@
 #include "arcana/noelle/core/Queue.hpp"
 #include "arcana/noelle/core/LoopForest.hpp"
 #include "arcana/noelle/core/PDGGenerator.hpp"
+#include "arcana/noelle/core/FunctionDependenceGraphCache.hpp"
 #include "arcana/noelle/core/LDGGenerator.hpp"
 #include "arcana/noelle/core/DataFlow.hpp"
 #include "arcana/noelle/core/LoopContent.hpp"
@@ -41,6 +42,7 @@
 #include "arcana/noelle/core/ConstantsManager.hpp"
 #include "arcana/noelle/core/CompilationOptionsManager.hpp"
 #include "arcana/noelle/core/CFGAnalysis.hpp"
+#include "arcana/noelle/core/InstructionReachabilityCache.hpp"
 #include "arcana/noelle/core/CFGTransformer.hpp"
 #include "arcana/noelle/core/Linker.hpp"
 #include "arcana/noelle/core/AliasAnalysisEngine.hpp"
@@ -79,7 +81,11 @@ public:
          bool disableSVF,
          bool disableSVFCallGraph,
          bool disableAllocAA,
-         bool disableRA);
+         bool disableRA,
+         bool sparseMemoryCandidates,
+         uint32_t pdgThreads,
+         std::string pdgCacheFileName,
+         std::string aliasAnalyses);
 
   FunctionsManager *getFunctionsManager(void);
 
@@ -154,6 +160,14 @@ public:
 
   std::vector<LoopContent *> *getLoopContents(double minimumHotness);
 
+  /*
+   * Only the components in @componentsToPrefetch are computed upfront.
+   * The other components are computed the first time they are requested.
+   */
+  std::vector<LoopContent *> *getLoopContents(
+      double minimumHotness,
+      std::unordered_set<LoopContentComponent> componentsToPrefetch);
+
   std::vector<LoopContent *> *getLoopContents(Function *function);
 
   std::vector<LoopContent *> *getLoopContents(Function *function,
@@ -165,6 +179,11 @@ public:
       LoopStructure *loop,
       std::unordered_set<LoopContentOptimization> optimizations);
 
+  LoopContent *getLoopContent(
+      LoopStructure *loop,
+      std::unordered_set<LoopContentOptimization> optimizations,
+      std::unordered_set<LoopContentComponent> componentsToPrefetch);
+
   LoopContent *getLoopContent(BasicBlock *header,
                               PDG *functionPDG,
                               LoopTransformationsManager *ltm,
@@ -210,11 +229,55 @@ public:
 
   PDG *getProgramDependenceGraph(void);
 
+  /*
+   * Return a view of the dependences of @f that does not copy them.
+   */
+  FunctionDependenceGraphView getFunctionDependenceGraphView(Function *f);
+
+  /*
+   * Drop the cached dependence graph of @f, the memoized answers of the
+   * dependence analyses about @f, the reachability of its instructions, and
+   * the facts about its loops. The aggregated profile counters of @f are
+   * recomputed.
+   * If the PDG has been computed, all the dependences of @f are computed again.
+   * This must be invoked after modifying the code of @f outside of
+   * LoopTransformer and CFGTransformer.
+   */
+  void invalidateFunctionDependenceGraph(Function *f);
+
+  /*
+   * Like invalidateFunctionDependenceGraph, but only the dependences of the
+   * instructions of @f that have been erased and of @modifiedInstructions
+   * (i.e., the instructions that have been added or moved) are computed again.
+   */
+  void codeModified(
+      Function *f,
+      const std::unordered_set<Instruction *> &modifiedInstructions);
+
+  const FunctionDependenceGraphCache &getFunctionDependenceGraphCache(
+      void) const;
+
+  const DependenceQueryCache &getDependenceQueryCache(void) const;
+
   DataFlowAnalysis getDataFlowAnalyses(void) const;
 
   CFGAnalysis getCFGAnalysis(void) const;
 
-  CFGTransformer getCFGTransformer(void) const;
+  /*
+   * Return the reachability of the instructions of @f.
+   * It is computed once and kept until the code of @f is reported as modified.
+   */
+  std::shared_ptr<const InstructionReachability> getInstructionReachability(
+      Function *f);
+
+  /*
+   * Return the reachability of the instructions of @loop within a single
+   * iteration of @loop.
+   */
+  std::shared_ptr<const InstructionReachability> getInstructionReachability(
+      LoopStructure *loop);
+
+  CFGTransformer getCFGTransformer(void);
 
   DataFlowEngine getDataFlowEngine(void) const;
 
@@ -259,6 +322,10 @@ private:
   Module &program;
   Hot *profiles;
   PDG *programDependenceGraph;
+  FunctionDependenceGraphCache *fdgCache;
+  DependenceQueryCache *queryCache;
+  InstructionReachabilityCache *reachabilityCache;
+  std::shared_ptr<LoopNestCache> nestCache;
   std::unordered_set<Transformation> enabledTransformations;
   Verbosity verbose;
   PDGGenerator pdgGenerator;
@@ -286,8 +353,23 @@ private:
   std::set<AliasAnalysisEngine *> aaEngines;
   Logger log;
 
+  /*
+   * Return a new function dependence graph of @f.
+   * The caller owns the returned graph.
+   */
   PDG *getFunctionDependenceGraph(Function *f);
 
+  /*
+   * Return the function dependence graph of @f shared through the cache.
+   * It must not be modified or freed by the caller.
+   */
+  PDG *getCachedFunctionDependenceGraph(Function *f);
+
+  /*
+   * Drop what is known about @f that is not maintained by the PDG generator.
+   */
+  void invalidateAnalysesOf(Function &F);
+
   uint32_t fetchTheNextValue(std::stringstream &stream);
 
   bool checkToGetLoopFilteringInfo(void);
@@ -299,7 +381,8 @@ private:
       uint32_t techniquesToDisable,
       uint32_t DOALLChunkSize,
       uint32_t maxCores,
-      std::unordered_set<LoopContentOptimization> optimizations);
+      std::unordered_set<LoopContentOptimization> optimizations,
+      std::unordered_set<LoopContentComponent> componentsToPrefetch);
 
   LoopContent *getLoopContentForLoop(
       LoopTree *loopNode,
@@ -310,7 +393,19 @@ private:
       uint32_t techniquesToDisable,
       uint32_t DOALLChunkSize,
       uint32_t maxCores,
-      std::unordered_set<LoopContentOptimization> optimizations);
+      std::unordered_set<LoopContentOptimization> optimizations,
+      std::unordered_set<LoopContentComponent> componentsToPrefetch);
+
+  LoopContent *allocateLoopContent(
+      LoopTree *loopNode,
+      Loop *loop,
+      PDG *functionPDG,
+      DominatorSummary *DS,
+      ScalarEvolution *SE,
+      uint32_t DOALLChunkSize,
+      uint32_t maxCores,
+      std::unordered_set<LoopContentOptimization> optimizations,
+      std::unordered_set<LoopContentComponent> componentsToPrefetch);
 
   bool isLoopHot(LoopStructure *loopStructure, double minimumHotness);
   bool isFunctionHot(Function *function, double minimumHotness);
@@ -48,6 +48,8 @@ public:
 
 private:
   Noelle *n;
+
+  std::string describeAliasAnalyses(void);
 };
 
 } // namespace arcana::noelle
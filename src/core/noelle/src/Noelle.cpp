@@ -46,11 +46,19 @@ Noelle::Noelle(
     bool disableSVF,
     bool disableSVFCallGraph,
     bool disableAllocAA,
-    bool disableRA)
+    bool disableRA,
+    bool sparseMemoryCandidates,
+    uint32_t pdgThreads,
+    std::string pdgCacheFileName,
+    std::string aliasAnalyses)
   : minHot{ minHot },
     program{ m },
     profiles{ nullptr },
     programDependenceGraph{ nullptr },
+    fdgCache{ nullptr },
+    queryCache{ nullptr },
+    reachabilityCache{ nullptr },
+    nestCache{ std::make_shared<LoopNestCache>() },
     enabledTransformations{ enabledTransformations },
     verbose{ v },
     pdgGenerator{ m,
@@ -65,7 +73,11 @@ Noelle::Noelle(
                   disableSVFCallGraph,
                   disableAllocAA,
                   disableRA,
-                  pdgVerbose },
+                  sparseMemoryCandidates,
+                  pdgVerbose,
+                  pdgThreads,
+                  pdgCacheFileName,
+                  aliasAnalyses },
     ldgGenerator{ ldgGenerator },
     filterFileName{ nullptr },
     hasReadFilterFile{ false },
@@ -92,6 +104,29 @@ Noelle::Noelle(
 
   this->filterFileName = getenv("INDEX_FILE");
 
+  /*
+   * Allocate the cache of the function dependence graphs.
+   */
+  this->fdgCache = new FunctionDependenceGraphCache(
+      [this](void) -> PDG * { return this->getProgramDependenceGraph(); });
+  this->pdgGenerator.setFunctionDependenceGraphCache(this->fdgCache);
+
+  /*
+   * Allocate the cache of the answers of the alias and dependence analyses.
+   */
+  this->queryCache =
+      new DependenceQueryCache(DependenceQueryCache::defaultCapacity);
+  this->pdgGenerator.setDependenceQueryCache(this->queryCache);
+  this->ldgGenerator.setDependenceQueryCache(this->queryCache);
+
+  /*
+   * Allocate the cache of the reachability of instructions.
+   */
+  this->reachabilityCache = new InstructionReachabilityCache(
+      InstructionReachabilityCache::defaultCapacity);
+  this->pdgGenerator.setInstructionReachabilityCache(this->reachabilityCache);
+  this->ldgGenerator.setInstructionReachabilityCache(this->reachabilityCache);
+
   return;
 }
 
@@ -153,6 +188,7 @@ double Noelle::getMinimumHotness(void) const {
 Hot *Noelle::getProfiles(void) {
   if (this->profiles == nullptr) {
     this->profiles = new Hot(this->program, this->getBFI, this->getBPI);
+    this->lt.setProfiles(this->profiles);
   }
 
   return this->profiles;
@@ -166,8 +202,33 @@ CFGAnalysis Noelle::getCFGAnalysis(void) const {
   return CFGAnalysis{};
 }
 
-CFGTransformer Noelle::getCFGTransformer(void) const {
-  return CFGTransformer{};
+std::shared_ptr<const InstructionReachability> Noelle::
+    getInstructionReachability(Function *f) {
+  assert(f != nullptr);
+
+  return this->reachabilityCache->getReachability(*f);
+}
+
+std::shared_ptr<const InstructionReachability> Noelle::
+    getInstructionReachability(LoopStructure *loop) {
+  assert(loop != nullptr);
+
+  return this->reachabilityCache->getReachability(*loop);
+}
+
+CFGTransformer Noelle::getCFGTransformer(void) {
+
+  /*
+   * The PDG generator updates the PDG and drops the dependence graph of the
+   * function, the answers of the analyses about it, and the reachability of
+   * its instructions.
+   * The facts about its loops and its profile aggregates are refreshed too.
+   */
+  auto codeModified = [this](Function &F) {
+    this->codeModified(&F, {});
+  };
+
+  return CFGTransformer{ codeModified };
 }
 
 DataFlowEngine Noelle::getDataFlowEngine(void) const {
@@ -185,6 +246,12 @@ MayPointsToAnalysis Noelle::getMayPointsToAnalysis(void) const {
 LoopTransformer &Noelle::getLoopTransformer(void) {
   auto pdg = this->getProgramDependenceGraph();
   this->lt.setPDG(pdg);
+  this->lt.setFunctionDependenceGraphCache(this->fdgCache);
+  this->lt.setDependenceQueryCache(this->queryCache);
+  this->lt.setInstructionReachabilityCache(this->reachabilityCache);
+  this->lt.setPDGGenerator(&this->pdgGenerator);
+  this->lt.setLoopNestCache(this->nestCache.get());
+  this->lt.setProfiles(this->profiles);
 
   return lt;
 }
@@ -205,6 +272,20 @@ uint64_t Noelle::numberOfProgramInstructions(void) const {
 
 Noelle::~Noelle() {
 
+  /*
+   * Print the statistics of the loop dependence analyses.
+   */
+  auto &ldgAnalyses = this->ldgGenerator.getDependenceAnalyses();
+  if ((this->pdgGenerator.getVerbosity() >= PDGVerbosity::Minimal)
+      && (!ldgAnalyses.empty())) {
+    errs() << "LDGGenerator: Dependence analyses\n";
+    ldgAnalyses.printStatistics(errs(), "LDGGenerator:   ");
+  }
+
+  delete this->fdgCache;
+  delete this->queryCache;
+  delete this->reachabilityCache;
+
   return;
 }
 
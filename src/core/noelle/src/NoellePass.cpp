@@ -19,6 +19,14 @@
  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
  OR OTHER DEALINGS IN THE SOFTWARE.
  */
+#include "llvm/Analysis/CFLAndersAliasAnalysis.h"
+#include "llvm/Analysis/CFLSteensAliasAnalysis.h"
+#include "llvm/Analysis/GlobalsModRef.h"
+#include "llvm/Analysis/ObjCARCAliasAnalysis.h"
+#include "llvm/Analysis/ScalarEvolutionAliasAnalysis.h"
+#include "llvm/Analysis/ScopedNoAliasAA.h"
+#include "llvm/Analysis/TypeBasedAliasAnalysis.h"
+
 #include "arcana/noelle/core/NoellePass.hpp"
 #include "arcana/noelle/core/Architecture.hpp"
 
@@ -133,6 +141,36 @@ static cl::opt<bool> PDGRADisable(
     cl::Hidden,
     cl::desc("Disable the use of reaching analysis to compute the PDG"));
 
+static cl::opt<bool> PDGSparseMemoryCandidates(
+    "noelle-pdg-sparse-memory-candidates",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc(
+        "Skip the pairs of memory instructions that cannot depend on each other (e.g., accesses to distinct objects) when computing the PDG"));
+
+static cl::opt<int> PDGThreads(
+    "noelle-pdg-threads",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc(
+        "Number of threads used to compute the PDG (0: all logical cores, 1: single thread)"));
+
+static cl::opt<std::string> PDGCacheFile(
+    "noelle-pdg-cache",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::init(""),
+    cl::desc(
+        "File used to cache the memory dependences of functions across invocations"));
+
+static cl::opt<std::string> CoreLatenciesFile(
+    "noelle-core-latencies",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::init(""),
+    cl::desc(
+        "File used to cache the latencies between logical cores (they are measured if the file does not exist)"));
+
 NoellePass::NoellePass() : ModulePass{ ID }, n{ nullptr } {
 
   return;
@@ -221,6 +259,25 @@ bool NoellePass::runOnModule(Module &M) {
   auto disableAllocAA =
       (PDGAllocAADisable.getNumOccurrences() > 0) ? true : false;
   auto disableRA = (PDGRADisable.getNumOccurrences() > 0) ? true : false;
+  auto sparseMemoryCandidates =
+      (PDGSparseMemoryCandidates.getNumOccurrences() > 0) ? true : false;
+  uint32_t pdgThreads = 1;
+  if (PDGThreads.getNumOccurrences() > 0) {
+    pdgThreads = (PDGThreads.getValue() <= 0)
+                     ? Architecture::getNumberOfLogicalCores()
+                     : PDGThreads.getValue();
+  }
+
+  /*
+   * Check if the latencies between cores are requested.
+   * They are then available through Architecture::getCoreToCoreLatency.
+   */
+  if (CoreLatenciesFile.getNumOccurrences() > 0) {
+    if (!Architecture::measureCoreToCoreLatencies(
+            CoreLatenciesFile.getValue())) {
+      errs() << "NOELLE: the latencies between cores are not available\n";
+    }
+  }
 
   /*
    * Allocate the managers.
@@ -296,11 +353,56 @@ bool NoellePass::runOnModule(Module &M) {
                        disableSVF,
                        disableSVFCallGraph,
                        disableAllocAA,
-                       disableRA);
+                       disableRA,
+                       sparseMemoryCandidates,
+                       pdgThreads,
+                       PDGCacheFile.getValue(),
+                       this->describeAliasAnalyses());
 
   return false;
 }
 
+std::string NoellePass::describeAliasAnalyses(void) {
+  std::string description;
+
+  /*
+   * Check if the basic alias analysis has been disabled.
+   */
+  auto &options = cl::getRegisteredOptions();
+  auto disableBasicAA = options.find("disable-basic-aa");
+  if ((disableBasicAA == options.end())
+      || (!static_cast<cl::opt<bool> *>(disableBasicAA->second)->getValue())) {
+    description += "basic-aa ";
+  }
+
+  /*
+   * Describe the alias analyses that AAResultsWrapperPass aggregates.
+   */
+  if (this->getAnalysisIfAvailable<ScopedNoAliasAAWrapperPass>()) {
+    description += "scoped-noalias-aa ";
+  }
+  if (this->getAnalysisIfAvailable<TypeBasedAAWrapperPass>()) {
+    description += "tbaa ";
+  }
+  if (this->getAnalysisIfAvailable<objcarc::ObjCARCAAWrapperPass>()) {
+    description += "objc-arc-aa ";
+  }
+  if (this->getAnalysisIfAvailable<GlobalsAAWrapperPass>()) {
+    description += "globals-aa ";
+  }
+  if (this->getAnalysisIfAvailable<SCEVAAWrapperPass>()) {
+    description += "scev-aa ";
+  }
+  if (this->getAnalysisIfAvailable<CFLAndersAAWrapperPass>()) {
+    description += "cfl-anders-aa ";
+  }
+  if (this->getAnalysisIfAvailable<CFLSteensAAWrapperPass>()) {
+    description += "cfl-steens-aa ";
+  }
+
+  return description;
+}
+
 Noelle &NoellePass::getNoelle(void) const {
   return *(this->n);
 }
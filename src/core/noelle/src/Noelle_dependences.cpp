@@ -32,21 +32,83 @@ PDG *Noelle::getProgramDependenceGraph(void) {
 }
 
 PDG *Noelle::getFunctionDependenceGraph(Function *f) {
+  assert(f != nullptr);
 
   /*
-   * Get the PDG
-   * The FDG is a subset of it.
+   * Create the function dependence graph (FDG).
+   * It is copied from the cached one, which includes only the dependences of
+   * @f, rather than from the whole PDG.
    */
-  auto pdg = this->getProgramDependenceGraph();
+  auto cachedFDG = this->getCachedFunctionDependenceGraph(f);
+  auto fdg = cachedFDG->createFunctionSubgraph(*f);
+
+  return fdg;
+}
+
+PDG *Noelle::getCachedFunctionDependenceGraph(Function *f) {
+  assert(f != nullptr);
 
   /*
-   * Create the function dependence graph (FDG).
+   * Fetch the function dependence graph (FDG).
+   * It is created from the PDG only the first time it is requested after the
+   * last modification of @f.
    */
-  auto fdg = pdg->createFunctionSubgraph(*f);
+  auto fdg = this->fdgCache->getFunctionDependenceGraph(*f);
 
   return fdg;
 }
 
+FunctionDependenceGraphView Noelle::getFunctionDependenceGraphView(
+    Function *f) {
+  assert(f != nullptr);
+
+  return this->fdgCache->getFunctionDependenceGraphView(*f);
+}
+
+void Noelle::invalidateFunctionDependenceGraph(Function *f) {
+  assert(f != nullptr);
+
+  /*
+   * The PDG generator drops the dependence graph of @f, the answers of the
+   * analyses about @f, and the reachability of its instructions.
+   * The way @f has been modified is not known, so all its dependences are
+   * computed again.
+   */
+  this->pdgGenerator.codeModified(*f);
+  this->invalidateAnalysesOf(*f);
+
+  return;
+}
+
+void Noelle::codeModified(
+    Function *f,
+    const std::unordered_set<Instruction *> &modifiedInstructions) {
+  assert(f != nullptr);
+
+  this->pdgGenerator.codeModified(*f, modifiedInstructions);
+  this->invalidateAnalysesOf(*f);
+
+  return;
+}
+
+void Noelle::invalidateAnalysesOf(Function &F) {
+  this->nestCache->invalidate(F);
+  if (this->profiles != nullptr) {
+    this->profiles->invalidate(&F);
+  }
+
+  return;
+}
+
+const FunctionDependenceGraphCache &Noelle::getFunctionDependenceGraphCache(
+    void) const {
+  return *(this->fdgCache);
+}
+
+const DependenceQueryCache &Noelle::getDependenceQueryCache(void) const {
+  return *(this->queryCache);
+}
+
 std::vector<SCC *> Noelle::sortByHotness(const std::set<SCC *> &SCCs) {
   std::vector<SCC *> s;
 
@@ -69,18 +131,29 @@ std::vector<SCC *> Noelle::sortByHotness(const std::set<SCC *> &SCCs) {
    */
   auto hot = this->getProfiles();
 
+  /*
+   * Fetch the hotness of each SCC once.
+   * Computing it requires visiting all instructions of the SCC, so it should
+   * not be done by the comparator.
+   */
+  std::unordered_map<SCC *, uint64_t> sccInsts;
+  for (auto scc : s) {
+    assert(scc != nullptr);
+    sccInsts[scc] = hot->getTotalInstructions(scc);
+  }
+
   /*
    * Define the order between loops.
    */
-  auto compareSCCs = [hot](SCC *s0, SCC *s1) -> bool {
+  auto compareSCCs = [&sccInsts](SCC *s0, SCC *s1) -> bool {
     assert(s0 != nullptr);
     assert(s1 != nullptr);
 
     /*
      * Fetch the information.
      */
-    auto s0Insts = hot->getTotalInstructions(s0);
-    auto s1Insts = hot->getTotalInstructions(s1);
+    auto s0Insts = sccInsts.at(s0);
+    auto s1Insts = sccInsts.at(s1);
 
     return s0Insts > s1Insts;
   };
@@ -348,6 +348,17 @@ LoopContent *Noelle::getLoopContent(LoopStructure *l) {
 LoopContent *Noelle::getLoopContent(
     LoopStructure *loop,
     std::unordered_set<LoopContentOptimization> optimizations) {
+  auto LC = this->getLoopContent(loop,
+                                 optimizations,
+                                 LoopContent::getAllComponents());
+
+  return LC;
+}
+
+LoopContent *Noelle::getLoopContent(
+    LoopStructure *loop,
+    std::unordered_set<LoopContentOptimization> optimizations,
+    std::unordered_set<LoopContentComponent> componentsToPrefetch) {
 
   /*
    * Fetch the the function dependence graph, post dominators, and scalar
@@ -355,7 +366,7 @@ LoopContent *Noelle::getLoopContent(
    */
   auto header = loop->getHeader();
   auto function = header->getParent();
-  auto funcPDG = this->getFunctionDependenceGraph(function);
+  auto funcPDG = this->getCachedFunctionDependenceGraph(function);
   auto DS = this->getDominators(function);
 
   /*
@@ -368,7 +379,8 @@ LoopContent *Noelle::getLoopContent(
                                           0,
                                           8,
                                           this->om->getMaximumNumberOfCores(),
-                                          optimizations);
+                                          optimizations,
+                                          componentsToPrefetch);
 
     delete DS;
     return LC;
@@ -389,7 +401,8 @@ LoopContent *Noelle::getLoopContent(
                                   this->techniquesToDisable[loopIndex],
                                   this->DOALLChunkSize[loopIndex],
                                   maximumNumberOfCoresForTheParallelization,
-                                  optimizations);
+                                  optimizations,
+                                  componentsToPrefetch);
 
   delete DS;
   return LC;
@@ -451,7 +464,8 @@ LoopContent *Noelle::getLoopContent(BasicBlock *header,
                                         techniquesToDisable,
                                         ltm->getChunkSize(),
                                         ltm->getMaximumNumberOfCores(),
-                                        ltm->getOptimizationsEnabled());
+                                        ltm->getOptimizationsEnabled(),
+                                        LoopContent::getAllComponents());
 
   /*
    * Check if we need to re-enable the loop-centric dependence analysis.
@@ -502,7 +516,7 @@ std::vector<LoopContent *> *Noelle::getLoopContents(Function *function,
   /*
    * Fetch the function dependence graph.
    */
-  auto funcPDG = this->getFunctionDependenceGraph(function);
+  auto funcPDG = this->getCachedFunctionDependenceGraph(function);
 
   /*
    * Fetch the post dominators
@@ -590,6 +604,15 @@ std::vector<LoopContent *> *Noelle::getLoopContents(void) {
 }
 
 std::vector<LoopContent *> *Noelle::getLoopContents(double minimumHotness) {
+  auto v =
+      this->getLoopContents(minimumHotness, LoopContent::getAllComponents());
+
+  return v;
+}
+
+std::vector<LoopContent *> *Noelle::getLoopContents(
+    double minimumHotness,
+    std::unordered_set<LoopContentComponent> componentsToPrefetch) {
 
   /*
    * Allocate the vector of loops.
@@ -646,7 +669,7 @@ std::vector<LoopContent *> *Noelle::getLoopContents(double minimumHotness) {
     /*
      * Fetch the function dependence graph.
      */
-    auto funcPDG = this->getFunctionDependenceGraph(function);
+    auto funcPDG = this->getCachedFunctionDependenceGraph(function);
 
     /*
      * Fetch the post dominators and scalar evolutions
@@ -761,14 +784,15 @@ std::vector<LoopContent *> *Noelle::getLoopContents(double minimumHotness) {
          */
         LoopContent *LC = nullptr;
         if (!filterLoops) {
-          LC = new LoopContent(this->ldgGenerator,
-                               this->getCompilationOptionsManager(),
-                               funcPDG,
-                               loopNode,
-                               LLVMLoop,
-                               *DS,
-                               SE,
-                               this->om->getMaximumNumberOfCores());
+          LC = this->allocateLoopContent(loopNode,
+                                         LLVMLoop,
+                                         funcPDG,
+                                         DS,
+                                         &SE,
+                                         8,
+                                         this->om->getMaximumNumberOfCores(),
+                                         {},
+                                         componentsToPrefetch);
 
         } else {
           auto maximumNumberOfCoresForTheParallelization =
@@ -783,7 +807,8 @@ std::vector<LoopContent *> *Noelle::getLoopContents(double minimumHotness) {
               this->techniquesToDisable[currentLoopIndex],
               this->DOALLChunkSize[currentLoopIndex],
               maximumNumberOfCoresForTheParallelization,
-              {});
+              {},
+              componentsToPrefetch);
         }
         allLoops->push_back(LC);
       }
@@ -1169,7 +1194,8 @@ LoopContent *Noelle::getLoopContentForLoop(
     uint32_t techniquesToDisable,
     uint32_t DOALLChunkSize,
     uint32_t maxCores,
-    std::unordered_set<LoopContentOptimization> optimizations) {
+    std::unordered_set<LoopContentOptimization> optimizations,
+    std::unordered_set<LoopContentComponent> componentsToPrefetch) {
 
   /*
    * Fetch the function
@@ -1201,7 +1227,8 @@ LoopContent *Noelle::getLoopContentForLoop(
                                         techniquesToDisable,
                                         DOALLChunkSize,
                                         maxCores,
-                                        optimizations);
+                                        optimizations,
+                                        componentsToPrefetch);
 
   return LC;
 }
@@ -1316,21 +1343,21 @@ LoopContent *Noelle::getLoopContentForLoop(
     uint32_t techniquesToDisableForLoop,
     uint32_t DOALLChunkSizeForLoop,
     uint32_t maxCores,
-    std::unordered_set<LoopContentOptimization> optimizations) {
+    std::unordered_set<LoopContentOptimization> optimizations,
+    std::unordered_set<LoopContentComponent> componentsToPrefetch) {
 
   /*
    * Allocate the LC.
    */
-  auto LC = new LoopContent(this->ldgGenerator,
-                            this->getCompilationOptionsManager(),
-                            functionPDG,
-                            loopNode,
-                            loop,
-                            *DS,
-                            *SE,
-                            maxCores,
-                            optimizations,
-                            DOALLChunkSizeForLoop);
+  auto LC = this->allocateLoopContent(loopNode,
+                                      loop,
+                                      functionPDG,
+                                      DS,
+                                      SE,
+                                      DOALLChunkSizeForLoop,
+                                      maxCores,
+                                      optimizations,
+                                      componentsToPrefetch);
 
   /*
    * Set the techniques that are enabled.
@@ -1377,6 +1404,54 @@ LoopContent *Noelle::getLoopContentForLoop(
   return LC;
 }
 
+LoopContent *Noelle::allocateLoopContent(
+    LoopTree *loopNode,
+    Loop *loop,
+    PDG *functionPDG,
+    DominatorSummary *DS,
+    ScalarEvolution *SE,
+    uint32_t DOALLChunkSize,
+    uint32_t maxCores,
+    std::unordered_set<LoopContentOptimization> optimizations,
+    std::unordered_set<LoopContentComponent> componentsToPrefetch) {
+
+  /*
+   * The components that are not prefetched are computed later.
+   * By then, the LLVM loop and the scalar evolution given as input might have
+   * been freed by the pass manager, so they will be fetched again.
+   */
+  auto header = loopNode->getLoop()->getHeader();
+  auto getLLVMLoop = [this, header](void) -> Loop * {
+    auto &LI = this->getLoopInfo(*header->getParent());
+    return LI.getLoopFor(header);
+  };
+  auto getSCEV = [this, header](void) -> ScalarEvolution & {
+    return this->getSCEV(*header->getParent());
+  };
+
+  /*
+   * Allocate the LC.
+   * The flag that enables the loop-aware dependence analyses goes before the
+   * chunk size.
+   */
+  auto LC = new LoopContent(this->ldgGenerator,
+                            this->getCompilationOptionsManager(),
+                            functionPDG,
+                            loopNode,
+                            loop,
+                            *DS,
+                            *SE,
+                            maxCores,
+                            optimizations,
+                            true,
+                            DOALLChunkSize,
+                            componentsToPrefetch,
+                            getLLVMLoop,
+                            getSCEV);
+
+  return LC;
+}
+
 bool Noelle::isLoopHot(LoopStructure *loopStructure, double minimumHotness) {
 
   /*
@@ -1486,7 +1561,7 @@ LoopForest *Noelle::organizeLoopsInTheirNestingForest(
   /*
    * Compute the forest.
    */
-  auto n = new noelle::LoopForest(loops, doms);
+  auto n = new noelle::LoopForest(loops, doms, this->nestCache);
 
   /*
    * Free the memory.
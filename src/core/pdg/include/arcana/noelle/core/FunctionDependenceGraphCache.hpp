@@ -0,0 +1,86 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Yian Su, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_PDG_FUNCTIONDEPENDENCEGRAPHCACHE_H_
+#define NOELLE_SRC_CORE_PDG_FUNCTIONDEPENDENCEGRAPHCACHE_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/PDG.hpp"
+#include "arcana/noelle/core/FunctionDependenceGraphView.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Function dependence graphs (FDGs) derived from the program dependence graph.
+ *
+ * An FDG is created the first time it is requested and it is kept until the
+ * code of its function is reported as modified.
+ * The cache owns the FDGs it returns.
+ */
+class FunctionDependenceGraphCache {
+public:
+  FunctionDependenceGraphCache(std::function<PDG *(void)> getPDG);
+
+  FunctionDependenceGraphCache() = delete;
+
+  FunctionDependenceGraphCache(const FunctionDependenceGraphCache &other) =
+      delete;
+
+  /*
+   * Return the FDG of @F.
+   * The FDG must not be modified or freed by the caller.
+   */
+  PDG *getFunctionDependenceGraph(Function &F);
+
+  /*
+   * Return a view of the dependences of @F that does not copy them.
+   */
+  FunctionDependenceGraphView getFunctionDependenceGraphView(Function &F);
+
+  /*
+   * Drop the FDG of @F because the code of @F has been modified.
+   */
+  void invalidate(Function &F);
+
+  /*
+   * Drop all FDGs.
+   */
+  void invalidateAll(void);
+
+  uint64_t getNumberOfHits(void) const;
+
+  uint64_t getNumberOfMisses(void) const;
+
+  uint64_t getNumberOfInvalidations(void) const;
+
+  ~FunctionDependenceGraphCache();
+
+private:
+  std::function<PDG *(void)> getPDG;
+  std::unordered_map<Function *, PDG *> fdgs;
+  uint64_t hits;
+  uint64_t misses;
+  uint64_t invalidations;
+};
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_PDG_FUNCTIONDEPENDENCEGRAPHCACHE_H_
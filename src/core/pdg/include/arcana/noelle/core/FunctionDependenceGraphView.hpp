@@ -0,0 +1,92 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Yian Su, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_PDG_FUNCTIONDEPENDENCEGRAPHVIEW_H_
+#define NOELLE_SRC_CORE_PDG_FUNCTIONDEPENDENCEGRAPHVIEW_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/PDG.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Read-only view of the dependences of a function.
+ *
+ * The view includes the same dependences of the function dependence graph
+ * returned by PDG::createFunctionSubgraph (i.e., the dependences with at least
+ * one end in the function), but it does not copy them: they are fetched from
+ * the program dependence graph on demand.
+ * The view is valid as long as the program dependence graph is.
+ */
+class FunctionDependenceGraphView {
+public:
+  FunctionDependenceGraphView(PDG *programDependenceGraph, Function &F);
+
+  FunctionDependenceGraphView() = delete;
+
+  Function &getFunction(void) const;
+
+  PDG *getProgramDependenceGraph(void) const;
+
+  /*
+   * Return true if @value is an instruction or an argument of the function.
+   */
+  bool isInternal(Value *value) const;
+
+  /*
+   * Iterators: they have the same semantics of the ones of PDG, but they only
+   * consider the dependences included in the view.
+   */
+  bool iterateOverDependencesFrom(
+      Value *fromValue,
+      bool includeControlDependences,
+      bool includeMemoryDataDependences,
+      bool includeRegisterDataDependences,
+      std::function<bool(Value *to, DGEdge<Value, Value> *dependence)>
+          functionToInvokePerDependence) const;
+
+  bool iterateOverDependencesTo(
+      Value *toValue,
+      bool includeControlDependences,
+      bool includeMemoryDataDependences,
+      bool includeRegisterDataDependences,
+      std::function<bool(Value *fromValue, DGEdge<Value, Value> *dependence)>
+          functionToInvokePerDependence) const;
+
+  /*
+   * Iterator: iterate over all the dependences of the view (each one once)
+   * until @functionToInvokePerDependence returns true.
+   */
+  bool iterateOverDependences(
+      bool includeControlDependences,
+      bool includeMemoryDataDependences,
+      bool includeRegisterDataDependences,
+      std::function<bool(DGEdge<Value, Value> *dependence)>
+          functionToInvokePerDependence) const;
+
+private:
+  PDG *pdg;
+  Function &F;
+};
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_PDG_FUNCTIONDEPENDENCEGRAPHVIEW_H_
@@ -0,0 +1,119 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Yian Su, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/FunctionDependenceGraphCache.hpp"
+
+namespace arcana::noelle {
+
+FunctionDependenceGraphCache::FunctionDependenceGraphCache(
+    std::function<PDG *(void)> getPDG)
+  : getPDG{ getPDG },
+    hits{ 0 },
+    misses{ 0 },
+    invalidations{ 0 } {
+  return;
+}
+
+PDG *FunctionDependenceGraphCache::getFunctionDependenceGraph(Function &F) {
+
+  /*
+   * Check if the FDG has already been computed.
+   */
+  auto it = this->fdgs.find(&F);
+  if (it != this->fdgs.end()) {
+    this->hits++;
+    return it->second;
+  }
+  this->misses++;
+
+  /*
+   * Create the FDG from the PDG.
+   */
+  auto pdg = this->getPDG();
+  assert(pdg != nullptr);
+  auto fdg = pdg->createFunctionSubgraph(F);
+
+  /*
+   * Freeze the FDG as it is read-only.
+   */
+  if (fdg != nullptr) {
+    fdg->freeze();
+  }
+  this->fdgs[&F] = fdg;
+
+  return fdg;
+}
+
+FunctionDependenceGraphView FunctionDependenceGraphCache::
+    getFunctionDependenceGraphView(Function &F) {
+  auto pdg = this->getPDG();
+  assert(pdg != nullptr);
+
+  return FunctionDependenceGraphView(pdg, F);
+}
+
+void FunctionDependenceGraphCache::invalidate(Function &F) {
+  auto it = this->fdgs.find(&F);
+  if (it == this->fdgs.end()) {
+    return;
+  }
+
+  /*
+   * Free the FDG.
+   */
+  delete it->second;
+  this->fdgs.erase(it);
+  this->invalidations++;
+
+  return;
+}
+
+void FunctionDependenceGraphCache::invalidateAll(void) {
+  for (auto &pair : this->fdgs) {
+    delete pair.second;
+    this->invalidations++;
+  }
+  this->fdgs.clear();
+
+  return;
+}
+
+uint64_t FunctionDependenceGraphCache::getNumberOfHits(void) const {
+  return this->hits;
+}
+
+uint64_t FunctionDependenceGraphCache::getNumberOfMisses(void) const {
+  return this->misses;
+}
+
+uint64_t FunctionDependenceGraphCache::getNumberOfInvalidations(void) const {
+  return this->invalidations;
+}
+
+FunctionDependenceGraphCache::~FunctionDependenceGraphCache() {
+  for (auto &pair : this->fdgs) {
+    delete pair.second;
+  }
+
+  return;
+}
+
+} // namespace arcana::noelle
@@ -0,0 +1,187 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Yian Su, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/FunctionDependenceGraphView.hpp"
+
+namespace arcana::noelle {
+
+FunctionDependenceGraphView::FunctionDependenceGraphView(
+    PDG *programDependenceGraph,
+    Function &F)
+  : pdg{ programDependenceGraph },
+    F{ F } {
+  assert(this->pdg != nullptr);
+
+  return;
+}
+
+Function &FunctionDependenceGraphView::getFunction(void) const {
+  return this->F;
+}
+
+PDG *FunctionDependenceGraphView::getProgramDependenceGraph(void) const {
+  return this->pdg;
+}
+
+bool FunctionDependenceGraphView::isInternal(Value *value) const {
+  if (auto inst = dyn_cast<Instruction>(value)) {
+    return inst->getFunction() == &this->F;
+  }
+  if (auto arg = dyn_cast<Argument>(value)) {
+    return arg->getParent() == &this->F;
+  }
+
+  return false;
+}
+
+bool FunctionDependenceGraphView::iterateOverDependencesFrom(
+    Value *fromValue,
+    bool includeControlDependences,
+    bool includeMemoryDataDependences,
+    bool includeRegisterDataDependences,
+    std::function<bool(Value *to, DGEdge<Value, Value> *dependence)>
+        functionToInvokePerDependence) const {
+
+  /*
+   * All dependences from an internal value belong to the view.
+   */
+  if (this->isInternal(fromValue)) {
+    return this->pdg->iterateOverDependencesFrom(
+        fromValue,
+        includeControlDependences,
+        includeMemoryDataDependences,
+        includeRegisterDataDependences,
+        functionToInvokePerDependence);
+  }
+
+  /*
+   * Only dependences that reach the function belong to the view.
+   */
+  auto f = [this, &functionToInvokePerDependence](
+               Value *to,
+               DGEdge<Value, Value> *dependence) -> bool {
+    if (!this->isInternal(to)) {
+      return false;
+    }
+    return functionToInvokePerDependence(to, dependence);
+  };
+  return this->pdg->iterateOverDependencesFrom(fromValue,
+                                               includeControlDependences,
+                                               includeMemoryDataDependences,
+                                               includeRegisterDataDependences,
+                                               f);
+}
+
+bool FunctionDependenceGraphView::iterateOverDependencesTo(
+    Value *toValue,
+    bool includeControlDependences,
+    bool includeMemoryDataDependences,
+    bool includeRegisterDataDependences,
+    std::function<bool(Value *fromValue, DGEdge<Value, Value> *dependence)>
+        functionToInvokePerDependence) const {
+
+  /*
+   * All dependences to an internal value belong to the view.
+   */
+  if (this->isInternal(toValue)) {
+    return this->pdg->iterateOverDependencesTo(toValue,
+                                               includeControlDependences,
+                                               includeMemoryDataDependences,
+                                               includeRegisterDataDependences,
+                                               functionToInvokePerDependence);
+  }
+
+  /*
+   * Only dependences that leave the function belong to the view.
+   */
+  auto f = [this, &functionToInvokePerDependence](
+               Value *from,
+               DGEdge<Value, Value> *dependence) -> bool {
+    if (!this->isInternal(from)) {
+      return false;
+    }
+    return functionToInvokePerDependence(from, dependence);
+  };
+  return this->pdg->iterateOverDependencesTo(toValue,
+                                             includeControlDependences,
+                                             includeMemoryDataDependences,
+                                             includeRegisterDataDependences,
+                                             f);
+}
+
+bool FunctionDependenceGraphView::iterateOverDependences(
+    bool includeControlDependences,
+    bool includeMemoryDataDependences,
+    bool includeRegisterDataDependences,
+    std::function<bool(DGEdge<Value, Value> *dependence)>
+        functionToInvokePerDependence) const {
+
+  /*
+   * Every dependence of the view is visited from its internal end.
+   * Dependences between two internal values are visited only from their
+   * source.
+   */
+  auto outgoing = [&functionToInvokePerDependence](
+                      Value *to,
+                      DGEdge<Value, Value> *dependence) -> bool {
+    return functionToInvokePerDependence(dependence);
+  };
+  auto incoming = [this, &functionToInvokePerDependence](
+                      Value *from,
+                      DGEdge<Value, Value> *dependence) -> bool {
+    if (this->isInternal(from)) {
+      return false;
+    }
+    return functionToInvokePerDependence(dependence);
+  };
+  auto visit = [&](Value *v) -> bool {
+    if (this->pdg->iterateOverDependencesFrom(v,
+                                              includeControlDependences,
+                                              includeMemoryDataDependences,
+                                              includeRegisterDataDependences,
+                                              outgoing)) {
+      return true;
+    }
+    return this->pdg->iterateOverDependencesTo(v,
+                                               includeControlDependences,
+                                               includeMemoryDataDependences,
+                                               includeRegisterDataDependences,
+                                               incoming);
+  };
+
+  /*
+   * Visit the arguments and the instructions of the function.
+   */
+  for (auto &arg : this->F.args()) {
+    if (visit(&arg)) {
+      return true;
+    }
+  }
+  for (auto &inst : instructions(this->F)) {
+    if (visit(&inst)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+} // namespace arcana::noelle
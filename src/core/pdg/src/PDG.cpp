@@ -234,6 +234,20 @@ bool PDG::iterateOverDependencesFrom(
     std::function<bool(Value *to, DGEdge<Value, Value> *dependence)>
         functionToInvokePerDependence) {
 
+  /*
+   * Check if the PDG is frozen.
+   * In this case, use its read-optimized form.
+   * The frozen form is held until the end of the walk, so it stays valid even
+   * if the callback modifies the PDG.
+   */
+  if (auto frozen = this->getFrozenForm()) {
+    return frozen->iterateOverEdgesFrom(from,
+                                        includeControlDependences,
+                                        includeMemoryDataDependences,
+                                        includeRegisterDataDependences,
+                                        functionToInvokePerDependence);
+  }
+
   /*
    * Fetch the node in the PDG.
    */
@@ -300,6 +314,20 @@ bool PDG::iterateOverDependencesTo(
     std::function<bool(Value *fromValue, DGEdge<Value, Value> *dependence)>
         functionToInvokePerDependence) {
 
+  /*
+   * Check if the PDG is frozen.
+   * In this case, use its read-optimized form.
+   * The frozen form is held until the end of the walk, so it stays valid even
+   * if the callback modifies the PDG.
+   */
+  if (auto frozen = this->getFrozenForm()) {
+    return frozen->iterateOverEdgesTo(toValue,
+                                      includeControlDependences,
+                                      includeMemoryDataDependences,
+                                      includeRegisterDataDependences,
+                                      functionToInvokePerDependence);
+  }
+
   /*
    * Fetch the node in the PDG.
    */
@@ -437,12 +465,9 @@ PDG *PDG::clone(bool includeExternalNodes) {
 }
 
 PDG::~PDG() {
-  for (auto *edge : allEdges)
-    if (edge)
-      delete edge;
-  for (auto *node : allNodes)
-    if (node)
-      delete node;
+  this->destroyNodesAndEdges();
+
+  return;
 }
 
 } // namespace arcana::noelle
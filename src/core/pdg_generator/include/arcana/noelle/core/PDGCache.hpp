@@ -0,0 +1,110 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Yian Su, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_PDG_ANALYSIS_PDGCACHE_H_
+#define NOELLE_SRC_CORE_PDG_ANALYSIS_PDGCACHE_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/PDG.hpp"
+#include "llvm/Support/MemoryBuffer.h"
+
+namespace arcana::noelle {
+
+/*
+ * On-disk cache of the memory dependences of functions.
+ *
+ * The dependences of a function are stored under a key that hashes the IR of
+ * the function, the definitions of the global variables of the program, and
+ * the summaries (attributes and IR) of the functions it can reach.
+ * Hence, a function that did not change between two invocations of NOELLE
+ * (e.g., across the iterations of noelle-fixedpoint) does not need to be
+ * analyzed again.
+ *
+ * The file is memory-mapped and it is composed of a header, a sorted index of
+ * keys, and the dependences of every key encoded as fixed-size records.
+ */
+class PDGCache {
+public:
+  /*
+   * @configuration hashes the options that change the dependences computed
+   * (e.g., which LLVM alias analyses and dependence analyses are enabled, and
+   * whether SVF analyzes the whole program).
+   * Entries generated with a different configuration are ignored.
+   */
+  PDGCache(const std::string &fileName, uint64_t configuration);
+
+  /*
+   * Compute the key of every function with a body of @M.
+   * If @dependOnWholeProgram is true (e.g., a whole-program analysis like SVF
+   * or GlobalsAA is enabled), the key of a function includes every function of
+   * the program.
+   */
+  void computeKeys(Module &M, bool dependOnWholeProgram);
+
+  /*
+   * Add to @pdg the memory dependences of @F stored in the cache.
+   *
+   * Return false if @F is not in the cache.
+   */
+  bool loadDependences(PDG *pdg, Function &F);
+
+  /*
+   * Record the memory dependences of @F included in @pdg.
+   * They will be written to the file by the next invocation of "save".
+   */
+  void storeDependences(PDG *pdg, Function &F);
+
+  /*
+   * Write the file.
+   * Only the functions recorded by "storeDependences" are kept.
+   *
+   * Return false if the file could not be written.
+   */
+  bool save(void);
+
+  uint64_t getNumberOfHits(void) const;
+
+  uint64_t getNumberOfMisses(void) const;
+
+private:
+  std::string fileName;
+  uint64_t configuration;
+  std::unique_ptr<MemoryBuffer> buffer;
+  std::unordered_map<uint64_t, std::pair<const char *, uint32_t>> entries;
+  std::map<uint64_t, std::string> newEntries;
+  std::unordered_map<Function *, uint64_t> keys;
+  uint64_t hits;
+  uint64_t misses;
+
+  void readFile(void);
+
+  std::string describeFunction(Function &F);
+
+  std::vector<Value *> getValuesOfFunction(Function &F);
+
+  static const uint32_t version;
+
+  static const uint32_t recordSize;
+};
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_PDG_ANALYSIS_PDGCACHE_H_
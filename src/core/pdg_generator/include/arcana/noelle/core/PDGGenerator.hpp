@@ -22,20 +22,32 @@
 #ifndef NOELLE_SRC_CORE_PDG_ANALYSIS_PDGGENERATOR_H_
 #define NOELLE_SRC_CORE_PDG_ANALYSIS_PDGGENERATOR_H_
 
+#include <memory>
+#include <mutex>
+
 #include "arcana/noelle/core/SystemHeaders.hpp"
 #include "arcana/noelle/core/TalkDown.hpp"
 #include "arcana/noelle/core/AllocAA.hpp"
 #include "arcana/noelle/core/PDG.hpp"
 #include "arcana/noelle/core/PDGPrinter.hpp"
+#include "arcana/noelle/core/PDGCache.hpp"
 #include "arcana/noelle/core/DataFlow.hpp"
 #include "arcana/noelle/core/CallGraph.hpp"
+#include "arcana/noelle/core/FunctionReachabilitySummary.hpp"
 #include "arcana/noelle/core/AliasAnalysisEngine.hpp"
 #include "arcana/noelle/core/MayPointsToAnalysis.hpp"
 #include "arcana/noelle/core/DependenceAnalysis.hpp"
+#include "arcana/noelle/core/DependenceAnalysisPipeline.hpp"
+#include "arcana/noelle/core/DependenceQueryCache.hpp"
+#include "arcana/noelle/core/InstructionReachabilityCache.hpp"
+#include "arcana/noelle/core/FunctionDependenceGraphCache.hpp"
 #include "arcana/noelle/core/CallGraphAnalysis.hpp"
+#include "llvm/IR/ValueHandle.h"
 
 namespace arcana::noelle {
 
+class MemoryDependenceCandidates;
+
 enum class PDGVerbosity { Disabled, Minimal, Maximal, MaximalAndPDG };
 
 class PDGGenerator {
@@ -52,7 +64,11 @@ public:
                bool disableSVFCallGraph,
                bool disableAllocAA,
                bool disableRA,
-               PDGVerbosity verbose);
+               bool sparseMemoryCandidates,
+               PDGVerbosity verbose,
+               uint32_t numberOfThreads,
+               std::string cacheFileName,
+               std::string aliasAnalyses);
 
   void addAnalysis(DependenceAnalysis *a);
 
@@ -66,10 +82,105 @@ public:
 
   noelle::CallGraph *getProgramCallGraph(void);
 
-  void cleanAndEmbedPDGAsMetadata(PDG *pdg);
+  /*
+   * Embed @pdg in the IR.
+   * The IDs of the PDG nodes are attached to the values as metadata, while
+   * the memory dependences are encoded by PDGSerializer.
+   * The encoding is stored in the IR or, if @fileName is not empty, in the
+   * file @fileName, which the IR refers to.
+   *
+   * Return false if the file could not be written.
+   */
+  bool cleanAndEmbedPDGAsMetadata(PDG *pdg, const std::string &fileName = "");
 
   void embedSCCAsMetadata(PDG *dg);
 
+  /*
+   * Number of pairs of memory instructions checked by the alias analyses
+   * while computing the memory dependences, and number of pairs skipped
+   * because they cannot depend on each other.
+   */
+  uint64_t getNumberOfMemoryPairQueries(void) const;
+
+  uint64_t getNumberOfPrunedMemoryPairs(void) const;
+
+  PDGVerbosity getVerbosity(void) const;
+
+  /*
+   * Memoize the answers of the alias analyses and of the dependence analyses
+   * in @cache.
+   */
+  void setDependenceQueryCache(DependenceQueryCache *cache);
+
+  /*
+   * Fetch the reachability of the instructions of functions from @cache.
+   */
+  void setInstructionReachabilityCache(InstructionReachabilityCache *cache);
+
+  /*
+   * The dependence graphs of the functions whose PDG is updated are dropped
+   * from @cache.
+   */
+  void setFunctionDependenceGraphCache(FunctionDependenceGraphCache *cache);
+
+  /*
+   * Update the PDG returned by getPDG after the code of @F has been modified,
+   * so the PDG does not need to be computed again.
+   *
+   * @modifiedInstructions have been moved or changed. Instructions added to @F
+   * since the PDG has been computed or updated (e.g., clones) are considered
+   * modified as well.
+   * Erased instructions are tracked by value handles, so they do not need to
+   * be reported. Erasing an instruction can change the memory dependences of
+   * the others, so all instructions of @F are considered modified if one of
+   * them has been erased.
+   *
+   * The variable and control dependences of @F are computed again. The memory
+   * dependences are computed again only for pairs of instructions that include
+   * a modified one, so the alias analyses are not queried about the others.
+   * The code that a call executes includes the callees of the callee, so the
+   * memory dependences of the calls that can reach @F, directly or through
+   * other functions, are computed again as well, and the dependence graphs
+   * and the answers about their functions are dropped.
+   * If the PDG comparison is enabled, the whole updated PDG is compared with
+   * the one computed from scratch.
+   */
+  void codeModified(
+      Function &F,
+      const std::unordered_set<Instruction *> &modifiedInstructions);
+
+  /*
+   * Update the PDG after the code of @F has been modified in a way that is
+   * not known: all instructions of @F are considered modified.
+   */
+  void codeModified(Function &F);
+
+  void instructionMoved(Instruction *inst);
+
+  void instructionCloned(Instruction *clone);
+
+  void basicBlockSplit(BasicBlock *original, BasicBlock *newBlock);
+
+  /*
+   * The loop of @F that included @loopInstructions has been whilified or
+   * unrolled.
+   * The order in which the instructions of the loop execute changed, so they
+   * are all considered modified.
+   */
+  void loopWhilified(Function &F,
+                     const std::unordered_set<Instruction *> &loopInstructions);
+
+  void loopUnrolled(Function &F,
+                    const std::unordered_set<Instruction *> &loopInstructions);
+
+  /*
+   * Compute the PDG of the current code without relying on any answer
+   * computed before (e.g., caches), so it can be compared with the one
+   * returned by getPDG.
+   * The caller owns the returned PDG.
+   */
+  PDG *constructPDGFromScratch(void);
+
   virtual ~PDGGenerator();
 
   static bool isTheLibraryFunctionPure(Function *libraryFunction);
@@ -106,16 +217,50 @@ private:
   bool disableSVFCallGraph;
   bool disableAllocAA;
   bool disableRA;
+  bool sparseMemoryCandidates;
+  uint32_t numberOfThreads;
+  std::string cacheFileName;
+  std::string aliasAnalyses;
   PDGPrinter printer;
   noelle::CallGraph *noelleCG;
-  std::set<DependenceAnalysis *> ddAnalyses;
+  DependenceAnalysisPipeline ddAnalyses;
   std::set<CallGraphAnalysis *> cgAnalyses;
   std::unordered_set<const Function *> internalFuncs;
   std::unordered_set<const Function *> unhandledExternalFuncs;
-  std::unordered_map<const Function *, std::unordered_set<const Function *>>
-      reachableUnhandledExternalFuncs;
+  FunctionReachabilitySummary *unhandledExternalFuncsReachability;
+  std::once_flag unhandledExternalFuncsReachabilityFlag;
+  uint64_t numberOfMemoryPairQueries;
+  uint64_t numberOfPrunedMemoryPairs;
+  DependenceQueryCache *queryCache;
+  InstructionReachabilityCache *reachabilityCache;
+  FunctionDependenceGraphCache *fdgCache;
+
+  /*
+   * Handle of an instruction of the PDG.
+   * It records the erasure of the instruction, so the node of the instruction
+   * is removed even if a new instruction reuses its memory.
+   */
+  class InstructionHandle : public CallbackVH {
+  public:
+    InstructionHandle(Instruction *inst, PDGGenerator *generator);
+
+    void deleted(void) override;
+
+  private:
+    Instruction *inst;
+    Function *function;
+    PDGGenerator *generator;
+  };
+  std::unordered_map<Instruction *, std::unique_ptr<InstructionHandle>>
+      instructionHandles;
+  std::unordered_set<Instruction *> erasedInstructions;
+  std::unordered_set<Function *> functionsWithErasedInstructions;
+
+  void trackInstructionsOf(Function &F);
+  void removeNodesOfErasedInstructions(PDG *pdg);
 
   void identifyFunctionsThatInvokeUnhandledLibrary(Module &M);
+  FunctionReachabilitySummary *getUnhandledExternalFunctionsReachability(void);
   void printFunctionReachabilityResult();
   bool isSafeToQueryModRefOfSVF(CallBase *call, BitVector &bv);
   bool isUnhandledExternalFunction(const Function *F);
@@ -136,7 +281,7 @@ private:
   void cleanPDGMetadata();
 
   PDG *constructPDGFromMetadata(Module &);
-  void constructNodesFromMetadata(PDG *,
+  bool constructNodesFromMetadata(PDG *,
                                   Function &,
                                   std::unordered_map<MDNode *, Value *> &);
   void constructEdgesFromMetadata(PDG *,
@@ -147,44 +292,62 @@ private:
       MDNode *,
       std::unordered_map<MDNode *, Value *> &);
 
-  void embedPDGAsMetadata(PDG *);
+  bool constructEdgesFromBinaryMetadata(PDG *, Module &, NamedMDNode *);
+  bool getValuesFromMetadata(Module &, std::vector<Value *> &values);
+
+  bool embedPDGAsMetadata(PDG *, const std::string &fileName);
   void embedNodesAsMetadata(PDG *,
                             LLVMContext &,
-                            std::unordered_map<Value *, MDNode *> &);
-  void embedEdgesAsMetadata(PDG *,
+                            std::unordered_map<Value *, uint64_t> &);
+  bool embedEdgesAsMetadata(PDG *,
                             LLVMContext &,
-                            std::unordered_map<Value *, MDNode *> &);
-  MDNode *getEdgeMetadata(DGEdge<Value, Value> *,
-                          LLVMContext &,
-                          std::unordered_map<Value *, MDNode *> &);
-  MDNode *getSubEdgesMetadata(DGEdge<Value, Value> *,
-                              LLVMContext &,
-                              std::unordered_map<Value *, MDNode *> &);
+                            std::unordered_map<Value *, uint64_t> &,
+                            const std::string &fileName);
 
   void trimDGUsingCustomAliasAnalysis(PDG *pdg);
 
   PDG *constructPDGFromAnalysis(Module &M);
   void constructEdgesFromUseDefs(PDG *pdg);
   void constructEdgesFromAliases(PDG *pdg, Module &M);
+  void constructEdgesFromAliases(PDG *pdg,
+                                 const std::vector<Function *> &functions);
+  void constructEdgesFromAliasesUsingTheCache(PDG *pdg,
+                                              Module &M,
+                                              PDGCache &cache);
+  void updateCache(PDG *pdg, Module &M, PDGCache &cache);
+  uint64_t getCacheConfiguration(void);
+  bool dependOnWholeProgram(void) const;
   void constructEdgesFromControl(PDG *pdg, Module &M);
   void constructEdgesFromAliasesForFunction(PDG *pdg, Function &F);
+  void constructEdgesFromAliasesForFunction(
+      PDG *pdg,
+      Function &F,
+      const InstructionReachability *reachability,
+      const std::unordered_set<Instruction *> *instructionsToCheck = nullptr);
   void constructEdgesFromControlForFunction(PDG *pdg, Function &F);
-
-  void iterateInstForStore(PDG *,
-                           Function &,
-                           AAResults &,
-                           DataFlowResult *,
-                           StoreInst *);
-  void iterateInstForLoad(PDG *,
-                          Function &,
-                          AAResults &,
-                          DataFlowResult *,
-                          LoadInst *);
-  void iterateInstForCall(PDG *,
-                          Function &,
-                          AAResults &,
-                          DataFlowResult *,
-                          CallBase *);
+  std::shared_ptr<const InstructionReachability> getReachability(Function &F);
+  std::vector<std::pair<Instruction *, Instruction *>>
+  computeControlDependencesOfFunction(Function &F,
+                                      PostDominatorTree &postDomTree);
+  std::vector<Function *> getFunctionsWithBody(Module &M);
+
+  void addEdgesFromStore(PDG *,
+                         Function &,
+                         AAResults &,
+                         StoreInst *,
+                         Instruction *);
+  void addEdgesFromLoad(PDG *,
+                        Function &,
+                        AAResults &,
+                        LoadInst *,
+                        Instruction *);
+  void addEdgesFromCall(PDG *,
+                        Function &,
+                        AAResults &,
+                        const InstructionReachability *,
+                        CallBase *,
+                        Instruction *);
+  bool canBeTheSourceOfAMemoryDependence(Instruction *inst);
 
   void addEdgeFromMemoryAlias(PDG *,
                               Function &,
@@ -212,6 +375,44 @@ private:
                                  bool);
 
   void removeEdgesNotUsedByParSchemes(PDG *pdg);
+  bool canEdgeBeRemovedByParSchemes(PDG *pdg, DGEdge<Value, Value> *edge);
+
+  void updateVariableAndControlDependences(PDG *pdg, Function &F);
+  void updateMemoryDependences(
+      PDG *pdg,
+      Function &F,
+      const std::unordered_set<Instruction *> &modifiedInstructions);
+  void checkTheUpdatedPDG(Function &F);
+
+  /*
+   * Return the calls, grouped by their function, that can invoke @F directly
+   * or through other functions.
+   */
+  std::unordered_map<Function *, std::unordered_set<Instruction *>>
+  getCallsThatCanReach(Function &F);
+
+  uint8_t queryTheCache(DependenceQueryCache::QueryKind kind,
+                        const void *analysis,
+                        const std::string &analysisName,
+                        const Value *from,
+                        const Value *to,
+                        const Value *context,
+                        uint8_t parameter,
+                        std::function<uint8_t(void)> answer);
+  std::vector<uint8_t> queryTheCache(
+      const std::vector<DependenceQueryCache::Query> &queries,
+      std::function<std::vector<uint8_t>(
+          const std::vector<uint64_t> &queryIndexes)> answer);
+  AliasResult alias(const void *analysis,
+                    const std::string &analysisName,
+                    Value *v1,
+                    Value *v2,
+                    std::function<AliasResult(void)> answer);
+  ModRefInfo getModRefInfo(AAResults &AA, CallBase *call, Instruction *inst);
+  ModRefInfo getModRefInfo(AAResults &AA, CallBase *call, CallBase *otherCall);
+  ModRefInfo getSVFModRefInfo(CallBase *call);
+  ModRefInfo getSVFModRefInfo(CallBase *call, Instruction *inst);
+  ModRefInfo getSVFModRefInfo(CallBase *call, CallBase *otherCall);
 
   AliasResult doTheyAlias(PDG *pdg,
                           Function &F,
@@ -231,9 +432,9 @@ private:
 
   bool canMemoryEdgeBeRemoved(PDG *pdg, DGEdge<Value, Value> *edge);
 
-  bool canThereBeAMemoryDataDependence(Instruction *fromInst,
-                                       Instruction *toInst,
-                                       Function &F);
+  std::vector<bool> canThereBeMemoryDataDependences(
+      const std::vector<std::pair<Instruction *, Instruction *>> &pairs,
+      Function &F);
 
   std::pair<bool, bool> isThereThisMemoryDataDependenceType(
       DataDependenceType t,
@@ -244,6 +445,12 @@ private:
   static const StringSet<> externalFuncsHaveNoSideEffectOrHandledBySVF;
 
   static const StringSet<> externalThreadSafeFunctions;
+
+  /*
+   * Number of pairs of memory instructions given to the dependence analyses at
+   * once.
+   */
+  static constexpr uint64_t memoryPairsPerBatch = 1 << 16;
 };
 
 } // namespace arcana::noelle
@@ -0,0 +1,69 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Yian Su, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_PDG_GENERATOR_PDGSERIALIZER_H_
+#define NOELLE_SRC_CORE_PDG_GENERATOR_PDGSERIALIZER_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/PDG.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Compact binary encoding of the dependences of a PDG.
+ *
+ * Values are identified by the IDs of the PDG nodes embedded in the IR (i.e.,
+ * noelle.pdg.inst.id and noelle.pdg.args.id).
+ * Dependences are sorted by their source and every ID is encoded as a
+ * variable-length delta from a nearby one, so most dependences take a few
+ * bytes.
+ * Dependences are decoded while the buffer is read, without creating any
+ * intermediate object.
+ */
+class PDGSerializer {
+public:
+  /*
+   * Encode @dependences.
+   * @valueIDs must include the source and the destination of every dependence
+   * and of its sub-dependences.
+   */
+  static std::string serialize(
+      const std::vector<DGEdge<Value, Value> *> &dependences,
+      const std::unordered_map<Value *, uint64_t> &valueIDs);
+
+  /*
+   * Add to @pdg the dependences encoded in @data.
+   * @values maps IDs to values; IDs without a value are nullptr.
+   *
+   * Return false if @data is not a valid encoding or if it refers to values
+   * that do not exist. In this case, @pdg might include some of the
+   * dependences encoded.
+   */
+  static bool deserialize(StringRef data,
+                          PDG *pdg,
+                          const std::vector<Value *> &values);
+
+  static const uint32_t version;
+};
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_PDG_GENERATOR_PDGSERIALIZER_H_
@@ -0,0 +1,141 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Yian Su, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "llvm/Analysis/ValueTracking.h"
+#include "MemoryDependenceCandidates.hpp"
+
+namespace arcana::noelle {
+
+MemoryDependenceCandidates::MemoryDependenceCandidates(Function &F,
+                                                       AAResults &AA,
+                                                       bool sparse)
+  : sparse{ sparse },
+    DT{ nullptr },
+    MSSA{ nullptr },
+    pairQueries{ 0 },
+    prunedPairs{ 0 } {
+
+  /*
+   * Check if every pair is a candidate.
+   */
+  if (!this->sparse) {
+    return;
+  }
+
+  /*
+   * Build the memory SSA of @F.
+   */
+  this->DT = std::make_unique<DominatorTree>(F);
+  this->MSSA = std::make_unique<MemorySSA>(F, &AA, this->DT.get());
+
+  /*
+   * Partition the loads and stores by the objects they access.
+   * The underlying object is looked up the same way as the LLVM basic alias
+   * analysis does, so two distinct identified objects are known not to alias.
+   */
+  for (auto &inst : instructions(F)) {
+    Value *pointer = nullptr;
+    if (auto load = dyn_cast<LoadInst>(&inst)) {
+      pointer = load->getPointerOperand();
+    } else if (auto store = dyn_cast<StoreInst>(&inst)) {
+      pointer = store->getPointerOperand();
+    } else {
+      continue;
+    }
+    auto object = llvm::getUnderlyingObject(pointer);
+    if (!isIdentifiedObject(object)) {
+
+      /*
+       * The object is unknown.
+       */
+      continue;
+    }
+    this->underlyingObjects[&inst] = object;
+  }
+
+  return;
+}
+
+bool MemoryDependenceCandidates::isCandidate(Instruction *fromInst,
+                                             Instruction *toInst) {
+  assert(fromInst != nullptr);
+  assert(toInst != nullptr);
+
+  if (this->sparse) {
+
+    /*
+     * Check if one of the instructions does not access memory.
+     */
+    if ((!this->accessesMemory(fromInst)) || (!this->accessesMemory(toInst))) {
+      this->prunedPairs++;
+      return false;
+    }
+
+    /*
+     * Check if the instructions access different objects.
+     */
+    auto fromObject = this->getUnderlyingObject(fromInst);
+    auto toObject = this->getUnderlyingObject(toInst);
+    if ((fromObject != nullptr) && (toObject != nullptr)
+        && (fromObject != toObject)) {
+      this->prunedPairs++;
+      return false;
+    }
+  }
+
+  this->pairQueries++;
+
+  return true;
+}
+
+bool MemoryDependenceCandidates::accessesMemory(Instruction *inst) const {
+
+  /*
+   * Only calls are filtered: loads and stores might not be memory accesses
+   * for MemorySSA (e.g., loads from constant memory) while still aliasing
+   * other instructions.
+   */
+  if (!isa<CallBase>(inst)) {
+    return true;
+  }
+
+  return this->MSSA->getMemoryAccess(inst) != nullptr;
+}
+
+const Value *MemoryDependenceCandidates::getUnderlyingObject(
+    Instruction *inst) const {
+  auto it = this->underlyingObjects.find(inst);
+  if (it == this->underlyingObjects.end()) {
+    return nullptr;
+  }
+
+  return it->second;
+}
+
+uint64_t MemoryDependenceCandidates::getNumberOfPairQueries(void) const {
+  return this->pairQueries;
+}
+
+uint64_t MemoryDependenceCandidates::getNumberOfPrunedPairs(void) const {
+  return this->prunedPairs;
+}
+
+} // namespace arcana::noelle
@@ -0,0 +1,77 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Yian Su, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_PDG_ANALYSIS_MEMORYDEPENDENCECANDIDATES_H_
+#define NOELLE_SRC_CORE_PDG_ANALYSIS_MEMORYDEPENDENCECANDIDATES_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "llvm/Analysis/MemorySSA.h"
+
+namespace arcana::noelle {
+
+/*
+ * Pairs of memory instructions of a function that need to be checked by the
+ * alias analyses to compute the memory dependences of the PDG.
+ *
+ * In dense mode, every pair is a candidate.
+ * In sparse mode, a pair is not a candidate if its answer is already known to
+ * be "no dependence":
+ * - calls that MemorySSA does not consider as memory accesses cannot depend
+ *   on anything;
+ * - loads and stores are partitioned by their underlying objects, and two of
+ *   them that access distinct identified objects (e.g., different allocas or
+ *   globals) cannot alias.
+ * Loads and stores of unknown objects are candidates with all the others.
+ */
+class MemoryDependenceCandidates {
+public:
+  MemoryDependenceCandidates(Function &F, AAResults &AA, bool sparse);
+
+  MemoryDependenceCandidates() = delete;
+
+  MemoryDependenceCandidates(const MemoryDependenceCandidates &other) = delete;
+
+  /*
+   * Return true if the alias analyses must be queried about @fromInst and
+   * @toInst.
+   */
+  bool isCandidate(Instruction *fromInst, Instruction *toInst);
+
+  uint64_t getNumberOfPairQueries(void) const;
+
+  uint64_t getNumberOfPrunedPairs(void) const;
+
+private:
+  bool sparse;
+  std::unique_ptr<DominatorTree> DT;
+  std::unique_ptr<MemorySSA> MSSA;
+  std::unordered_map<Instruction *, const Value *> underlyingObjects;
+  uint64_t pairQueries;
+  uint64_t prunedPairs;
+
+  bool accessesMemory(Instruction *inst) const;
+
+  const Value *getUnderlyingObject(Instruction *inst) const;
+};
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_PDG_ANALYSIS_MEMORYDEPENDENCECANDIDATES_H_
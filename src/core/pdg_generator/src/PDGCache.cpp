@@ -0,0 +1,675 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Yian Su, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/PDGCache.hpp"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/xxhash.h"
+
+namespace arcana::noelle {
+
+/*
+ * Layout of the file (little endian):
+ *
+ *   header: magic (8 bytes), version (4), number of entries (4),
+ *           configuration (8)
+ *   index:  for every entry, key (8), offset of its records from the start of
+ *           the data section (8), number of records (4), unused (4)
+ *   data:   records, each one being source ID (4), destination ID (4),
+ *           data dependence type (1), flags (1)
+ *
+ * IDs identify the arguments of a function first and then its instructions
+ * following their order in the function.
+ */
+static const char cacheMagic[] = "NOELLEPC";
+static const uint32_t headerSize = 24;
+static const uint32_t indexEntrySize = 24;
+static const uint8_t mustFlag = 1;
+static const uint8_t loopCarriedFlag = 2;
+
+const uint32_t PDGCache::version = 1;
+
+const uint32_t PDGCache::recordSize = 10;
+
+PDGCache::PDGCache(const std::string &fileName, uint64_t configuration)
+  : fileName{ fileName },
+    configuration{ configuration },
+    buffer{ nullptr },
+    hits{ 0 },
+    misses{ 0 } {
+
+  /*
+   * Load the entries from the file.
+   */
+  this->readFile();
+
+  return;
+}
+
+void PDGCache::readFile(void) {
+
+  /*
+   * Map the file into memory.
+   * A missing file is an empty cache.
+   */
+  auto bufferOrError = MemoryBuffer::getFile(this->fileName,
+                                             /*IsText=*/false,
+                                             /*RequiresNullTerminator=*/false);
+  if (!bufferOrError) {
+    return;
+  }
+  this->buffer = std::move(bufferOrError.get());
+  auto start = this->buffer->getBufferStart();
+  auto size = this->buffer->getBufferSize();
+
+  /*
+   * Check the header.
+   * Files written by a different version or with a different configuration
+   * are ignored.
+   */
+  if (size < headerSize) {
+    return;
+  }
+  if (std::memcmp(start, cacheMagic, 8) != 0) {
+    return;
+  }
+  if (support::endian::read32le(start + 8) != PDGCache::version) {
+    return;
+  }
+  if (support::endian::read64le(start + 16) != this->configuration) {
+    return;
+  }
+  uint64_t numberOfEntries = support::endian::read32le(start + 12);
+  auto dataStart = headerSize + (numberOfEntries * indexEntrySize);
+  if (dataStart > size) {
+    return;
+  }
+
+  /*
+   * Fetch the entries.
+   */
+  for (auto i = 0u; i < numberOfEntries; i++) {
+    auto entry = start + headerSize + (i * indexEntrySize);
+    auto key = support::endian::read64le(entry);
+    auto offset = support::endian::read64le(entry + 8);
+    auto numberOfRecords = support::endian::read32le(entry + 16);
+
+    /*
+     * Skip entries that go beyond the end of the file.
+     */
+    auto entryEnd = dataStart + offset
+                    + (((uint64_t)numberOfRecords) * PDGCache::recordSize);
+    if (entryEnd > size) {
+      continue;
+    }
+
+    this->entries[key] = std::make_pair(start + dataStart + offset,
+                                        numberOfRecords);
+  }
+
+  return;
+}
+
+std::vector<Value *> PDGCache::getValuesOfFunction(Function &F) {
+  std::vector<Value *> values;
+  for (auto &arg : F.args()) {
+    values.push_back(&arg);
+  }
+  for (auto &inst : instructions(F)) {
+    values.push_back(&inst);
+  }
+
+  return values;
+}
+
+std::string PDGCache::describeFunction(Function &F) {
+  std::string description;
+  raw_string_ostream os(description);
+
+  /*
+   * Number the values and the basic blocks of the function.
+   * Names of local values do not change the dependences, so they are not part
+   * of the description.
+   */
+  std::unordered_map<Value *, uint64_t> valueIDs;
+  for (auto v : this->getValuesOfFunction(F)) {
+    auto id = valueIDs.size();
+    valueIDs[v] = id;
+  }
+  std::unordered_map<BasicBlock *, uint64_t> blockIDs;
+  for (auto &bb : F) {
+    auto id = blockIDs.size();
+    blockIDs[&bb] = id;
+  }
+
+  /*
+   * Describe the signature of the function.
+   */
+  F.getFunctionType()->print(os);
+  os << " cc" << F.getCallingConv();
+  auto attributes = F.getAttributes();
+  for (auto index : attributes.indexes()) {
+    os << " " << attributes.getAsString(index);
+  }
+  os << "\n";
+
+  /*
+   * Describe the metadata attached to instructions.
+   * The metadata generated by NOELLE (e.g., the IDs of the PDG embedded in the
+   * IR) is skipped.
+   */
+  SmallVector<StringRef, 32> metadataKindNames;
+  F.getContext().getMDKindNames(metadataKindNames);
+  std::unordered_map<const MDNode *, uint64_t> visitedNodes;
+  std::function<void(const Metadata *)> describeMetadata;
+  describeMetadata = [&](const Metadata *md) {
+    if (md == nullptr) {
+      os << "null";
+      return;
+    }
+    if (auto str = dyn_cast<MDString>(md)) {
+      os << "\"" << str->getString() << "\"";
+      return;
+    }
+    if (auto c = dyn_cast<ConstantAsMetadata>(md)) {
+      c->getValue()->printAsOperand(os, true);
+      return;
+    }
+    if (auto node = dyn_cast<MDNode>(md)) {
+      auto visited = visitedNodes.find(node);
+      if (visited != visitedNodes.end()) {
+        os << "^" << visited->second;
+        return;
+      }
+      auto id = visitedNodes.size();
+      visitedNodes[node] = id;
+      os << "{";
+      for (auto &operand : node->operands()) {
+        describeMetadata(operand.get());
+        os << ",";
+      }
+      os << "}";
+      return;
+    }
+    os << "?";
+    return;
+  };
+
+  /*
+   * Describe the operands.
+   */
+  auto describeOperand = [&](Value *v) {
+    if (auto bb = dyn_cast<BasicBlock>(v)) {
+      os << " b" << blockIDs.at(bb);
+      return;
+    }
+    if (valueIDs.find(v) != valueIDs.end()) {
+      os << " v" << valueIDs.at(v);
+      return;
+    }
+    if (auto gv = dyn_cast<GlobalVariable>(v)) {
+      os << " @" << gv->getName() << (gv->isConstant() ? "c" : "");
+      return;
+    }
+    if (auto gv = dyn_cast<GlobalValue>(v)) {
+      os << " @" << gv->getName();
+      return;
+    }
+    if (isa<MetadataAsValue>(v)) {
+      os << " m";
+      return;
+    }
+    os << " ";
+    v->printAsOperand(os, true);
+    return;
+  };
+
+  /*
+   * Describe the instructions.
+   */
+  for (auto &inst : instructions(F)) {
+    os << inst.getOpcodeName() << " ";
+    inst.getType()->print(os);
+    os << " o" << inst.getRawSubclassOptionalData();
+    for (auto &operand : inst.operands()) {
+      describeOperand(operand.get());
+    }
+
+    /*
+     * Describe the properties of the instruction that are not operands.
+     */
+    if (auto cmp = dyn_cast<CmpInst>(&inst)) {
+      os << " p" << cmp->getPredicate();
+    } else if (auto alloca = dyn_cast<AllocaInst>(&inst)) {
+      os << " ";
+      alloca->getAllocatedType()->print(os);
+      os << " a" << alloca->getAlign().value();
+    } else if (auto load = dyn_cast<LoadInst>(&inst)) {
+      os << " a" << load->getAlign().value() << " v" << load->isVolatile()
+         << " o" << (uint32_t)load->getOrdering();
+    } else if (auto store = dyn_cast<StoreInst>(&inst)) {
+      os << " a" << store->getAlign().value() << " v" << store->isVolatile()
+         << " o" << (uint32_t)store->getOrdering();
+    } else if (auto gep = dyn_cast<GetElementPtrInst>(&inst)) {
+      os << " ";
+      gep->getSourceElementType()->print(os);
+    } else if (auto phi = dyn_cast<PHINode>(&inst)) {
+      for (auto bb : phi->blocks()) {
+        os << " b" << blockIDs.at(bb);
+      }
+    } else if (auto call = dyn_cast<CallBase>(&inst)) {
+      os << " cc" << call->getCallingConv() << " ";
+      call->getFunctionType()->print(os);
+      auto callAttributes = call->getAttributes();
+      for (auto index : callAttributes.indexes()) {
+        os << " " << callAttributes.getAsString(index);
+      }
+    } else if (auto extract = dyn_cast<ExtractValueInst>(&inst)) {
+      for (auto index : extract->indices()) {
+        os << " i" << index;
+      }
+    } else if (auto insert = dyn_cast<InsertValueInst>(&inst)) {
+      for (auto index : insert->indices()) {
+        os << " i" << index;
+      }
+    } else if (auto shuffle = dyn_cast<ShuffleVectorInst>(&inst)) {
+      for (auto index : shuffle->getShuffleMask()) {
+        os << " i" << index;
+      }
+    } else if (auto rmw = dyn_cast<AtomicRMWInst>(&inst)) {
+      os << " op" << rmw->getOperation() << " v" << rmw->isVolatile();
+    } else if (auto cmpXchg = dyn_cast<AtomicCmpXchgInst>(&inst)) {
+      os << " v" << cmpXchg->isVolatile();
+    }
+
+    /*
+     * Describe the metadata.
+     */
+    SmallVector<std::pair<unsigned, MDNode *>, 4> metadata;
+    inst.getAllMetadataOtherThanDebugLoc(metadata);
+    for (auto &pair : metadata) {
+      auto kindName = metadataKindNames[pair.first];
+      if (kindName.startswith("noelle.")) {
+        continue;
+      }
+      os << " !" << kindName;
+      describeMetadata(pair.second);
+    }
+    os << "\n";
+  }
+
+  return os.str();
+}
+
+void PDGCache::computeKeys(Module &M, bool dependOnWholeProgram) {
+
+  /*
+   * Describe the named structures of the program.
+   * They define the layout of the memory accessed by all functions.
+   */
+  std::string typesDescription;
+  raw_string_ostream typesOS(typesDescription);
+  for (auto structType : M.getIdentifiedStructTypes()) {
+    structType->print(typesOS);
+    typesOS << "\n";
+  }
+  auto typesHash = xxHash64(typesOS.str());
+
+  /*
+   * Describe the global variables of the program.
+   * Their definitions (e.g., initializers) and whether their address escapes
+   * change what the alias analyses can prove about the memory they name.
+   */
+  std::string globalsDescription;
+  raw_string_ostream globalsOS(globalsDescription);
+  for (auto &gv : M.globals()) {
+    globalsOS << "@" << gv.getName() << " ";
+    gv.getValueType()->print(globalsOS);
+    globalsOS << " l" << gv.getLinkage() << " c" << gv.isConstant() << " t"
+              << gv.isThreadLocal() << " a"
+              << gv.getAlign().valueOrOne().value();
+    if (gv.hasInitializer()) {
+      globalsOS << " ";
+      gv.getInitializer()->print(globalsOS);
+    }
+    auto isAddressTaken = false;
+    for (auto user : gv.users()) {
+      if (isa<LoadInst>(user)) {
+        continue;
+      }
+      if (auto store = dyn_cast<StoreInst>(user)) {
+        if (store->getPointerOperand() == &gv) {
+          continue;
+        }
+      }
+      isAddressTaken = true;
+      break;
+    }
+    globalsOS << " e" << isAddressTaken << "\n";
+  }
+  auto globalsHash = xxHash64(globalsOS.str());
+
+  /*
+   * Hash the IR of every function with a body.
+   */
+  std::unordered_map<Function *, uint64_t> localHashes;
+  for (auto &F : M) {
+    if (F.empty()) {
+      continue;
+    }
+    localHashes[&F] = xxHash64(this->describeFunction(F));
+  }
+
+  /*
+   * Summarize every function.
+   * A summary includes the attributes of the function (e.g., readonly) and, for
+   * functions with a body, the hash of their IR.
+   */
+  auto summarize = [&localHashes](Function *F, raw_ostream &os) {
+    os << F->getName();
+    auto attributes = F->getAttributes();
+    for (auto index : attributes.indexes()) {
+      os << " " << attributes.getAsString(index);
+    }
+    if (F->empty()) {
+      os << " declaration\n";
+    } else {
+      os << " " << localHashes.at(F) << "\n";
+    }
+  };
+
+  /*
+   * Collect the functions referenced by every function.
+   * An indirect call can reach every function whose address is taken.
+   */
+  std::vector<Function *> addressTakenFunctions;
+  for (auto &F : M) {
+    if (F.hasAddressTaken()) {
+      addressTakenFunctions.push_back(&F);
+    }
+  }
+  std::unordered_map<Function *, std::set<Function *>> referencedFunctions;
+  for (auto &F : M) {
+    if (F.empty()) {
+      continue;
+    }
+    auto &references = referencedFunctions[&F];
+    for (auto &inst : instructions(F)) {
+      if (auto call = dyn_cast<CallBase>(&inst)) {
+        if ((call->getCalledFunction() == nullptr) && (!call->isInlineAsm())) {
+          auto callee = call->getCalledOperand()->stripPointerCasts();
+          if (!isa<Function>(callee)) {
+            references.insert(addressTakenFunctions.begin(),
+                              addressTakenFunctions.end());
+          }
+        }
+      }
+      for (auto &operand : inst.operands()) {
+        if (auto referencedF =
+                dyn_cast<Function>(operand.get()->stripPointerCasts())) {
+          references.insert(referencedF);
+        }
+      }
+    }
+  }
+
+  /*
+   * Compute the key of every function.
+   */
+  for (auto &F : M) {
+    if (F.empty()) {
+      continue;
+    }
+    std::string keyDescription;
+    raw_string_ostream os(keyDescription);
+    os << this->configuration << " " << typesHash << " " << globalsHash << " "
+       << localHashes.at(&F) << "\n";
+
+    /*
+     * Fetch the functions that can change the dependences of F.
+     */
+    std::vector<Function *> functions;
+    if (dependOnWholeProgram) {
+      for (auto &otherF : M) {
+        functions.push_back(&otherF);
+      }
+
+    } else {
+      std::unordered_set<Function *> reached;
+      std::vector<Function *> toVisit{ &F };
+      reached.insert(&F);
+      while (!toVisit.empty()) {
+        auto current = toVisit.back();
+        toVisit.pop_back();
+        if (current->empty()) {
+          continue;
+        }
+        for (auto referencedF : referencedFunctions.at(current)) {
+          if (reached.insert(referencedF).second) {
+            toVisit.push_back(referencedF);
+          }
+        }
+      }
+      reached.erase(&F);
+      functions.insert(functions.end(), reached.begin(), reached.end());
+      std::sort(functions.begin(),
+                functions.end(),
+                [](Function *f1, Function *f2) {
+                  return f1->getName() < f2->getName();
+                });
+    }
+
+    /*
+     * Add their summaries.
+     */
+    for (auto otherF : functions) {
+      summarize(otherF, os);
+    }
+
+    this->keys[&F] = xxHash64(os.str());
+  }
+
+  return;
+}
+
+bool PDGCache::loadDependences(PDG *pdg, Function &F) {
+  assert(pdg != nullptr);
+
+  /*
+   * Check if the function is in the cache.
+   */
+  auto keyIt = this->keys.find(&F);
+  assert(keyIt != this->keys.end());
+  auto entryIt = this->entries.find(keyIt->second);
+  if (entryIt == this->entries.end()) {
+    this->misses++;
+    return false;
+  }
+  auto records = entryIt->second.first;
+  auto numberOfRecords = entryIt->second.second;
+
+  /*
+   * Check that the records refer to values of the function.
+   */
+  auto values = this->getValuesOfFunction(F);
+  for (auto i = 0u; i < numberOfRecords; i++) {
+    auto record = records + (i * PDGCache::recordSize);
+    auto srcID = support::endian::read32le(record);
+    auto dstID = support::endian::read32le(record + 4);
+    auto dataDepType = (uint8_t)record[8];
+    if ((srcID >= values.size()) || (dstID >= values.size())
+        || (dataDepType > DG_DATA_WAW)) {
+      this->misses++;
+      return false;
+    }
+  }
+
+  /*
+   * Add the dependences.
+   */
+  for (auto i = 0u; i < numberOfRecords; i++) {
+    auto record = records + (i * PDGCache::recordSize);
+    auto src = values[support::endian::read32le(record)];
+    auto dst = values[support::endian::read32le(record + 4)];
+    auto dataDepType = static_cast<DataDependenceType>(record[8]);
+    auto flags = (uint8_t)record[9];
+    auto edge = pdg->addMemoryDataDependenceEdge(src,
+                                                 dst,
+                                                 dataDepType,
+                                                 (flags & mustFlag) != 0);
+    edge->setLoopCarried((flags & loopCarriedFlag) != 0);
+  }
+  this->hits++;
+
+  return true;
+}
+
+void PDGCache::storeDependences(PDG *pdg, Function &F) {
+  assert(pdg != nullptr);
+
+  /*
+   * Number the values of the function.
+   */
+  auto values = this->getValuesOfFunction(F);
+  std::unordered_map<Value *, uint32_t> valueIDs;
+  for (auto i = 0u; i < values.size(); i++) {
+    valueIDs[values[i]] = i;
+  }
+
+  /*
+   * Encode the memory dependences that start from the function.
+   */
+  std::string records;
+  char record[PDGCache::recordSize];
+  for (auto v : values) {
+    if (!pdg->isInternal(v)) {
+      continue;
+    }
+    auto node = pdg->fetchNode(v);
+    for (auto edge : node->getOutgoingEdges()) {
+      if (!isa<MemoryDependence<Value, Value>>(edge)) {
+        continue;
+      }
+
+      /*
+       * Dependences that leave the function or that have sub-dependences
+       * cannot be encoded.
+       * Hence, the function is not cached.
+       */
+      auto dstIt = valueIDs.find(edge->getDst());
+      if ((dstIt == valueIDs.end()) || (edge->getNumberOfSubEdges() > 0)) {
+        return;
+      }
+
+      auto dataDep = cast<DataDependence<Value, Value>>(edge);
+      uint8_t flags = 0;
+      if (isa<MustMemoryDependence<Value, Value>>(edge)) {
+        flags |= mustFlag;
+      }
+      if (edge->isLoopCarriedDependence()) {
+        flags |= loopCarriedFlag;
+      }
+      support::endian::write32le(record, valueIDs.at(v));
+      support::endian::write32le(record + 4, dstIt->second);
+      record[8] = (char)dataDep->getDataDependenceType();
+      record[9] = (char)flags;
+      records.append(record, PDGCache::recordSize);
+    }
+  }
+
+  /*
+   * Record the dependences.
+   */
+  auto key = this->keys.at(&F);
+  this->newEntries[key] = std::move(records);
+
+  return;
+}
+
+bool PDGCache::save(void) {
+
+  /*
+   * Serialize the header and the index.
+   */
+  std::string content;
+  char field[8];
+  content.append(cacheMagic, 8);
+  support::endian::write32le(field, PDGCache::version);
+  content.append(field, 4);
+  support::endian::write32le(field, this->newEntries.size());
+  content.append(field, 4);
+  support::endian::write64le(field, this->configuration);
+  content.append(field, 8);
+  uint64_t offset = 0;
+  for (auto &pair : this->newEntries) {
+    support::endian::write64le(field, pair.first);
+    content.append(field, 8);
+    support::endian::write64le(field, offset);
+    content.append(field, 8);
+    support::endian::write32le(field,
+                               pair.second.size() / PDGCache::recordSize);
+    content.append(field, 4);
+    support::endian::write32le(field, 0);
+    content.append(field, 4);
+    offset += pair.second.size();
+  }
+
+  /*
+   * Serialize the records.
+   */
+  for (auto &pair : this->newEntries) {
+    content.append(pair.second);
+  }
+
+  /*
+   * The current file might be mapped in memory, so write a new file and
+   * replace the old one.
+   */
+  auto tmpFileName = this->fileName + ".tmp";
+  {
+    std::error_code EC;
+    raw_fd_ostream file(tmpFileName, EC, sys::fs::OF_None);
+    if (EC) {
+      return false;
+    }
+    file << content;
+    file.close();
+    if (file.has_error()) {
+      file.clear_error();
+      return false;
+    }
+  }
+  if (sys::fs::rename(tmpFileName, this->fileName)) {
+    return false;
+  }
+
+  return true;
+}
+
+uint64_t PDGCache::getNumberOfHits(void) const {
+  return this->hits;
+}
+
+uint64_t PDGCache::getNumberOfMisses(void) const {
+  return this->misses;
+}
+
+} // namespace arcana::noelle
@@ -23,7 +23,9 @@
 #include "arcana/noelle/core/TalkDown.hpp"
 #include "arcana/noelle/core/PDGPrinter.hpp"
 #include "arcana/noelle/core/PDGGenerator.hpp"
+#include "MemoryDependenceCandidates.hpp"
 #include "arcana/noelle/core/Utils.hpp"
+#include "llvm/Support/ThreadPool.h"
 
 namespace arcana::noelle {
 
@@ -40,7 +42,11 @@ PDGGenerator::PDGGenerator(
     bool disableSVFCallGraph,
     bool disableAllocAA,
     bool disableRA,
-    PDGVerbosity verbose)
+    bool sparseMemoryCandidates,
+    PDGVerbosity verbose,
+    uint32_t numberOfThreads,
+    std::string cacheFileName,
+    std::string aliasAnalyses)
   : M{ M },
     getSCEV{ getSCEV },
     getLoopInfo{ getLoopInfo },
@@ -57,11 +63,22 @@ PDGGenerator::PDGGenerator(
     disableSVFCallGraph{ disableSVFCallGraph },
     disableAllocAA{ disableAllocAA },
     disableRA{ disableRA },
+    sparseMemoryCandidates{ sparseMemoryCandidates },
+    numberOfThreads{ numberOfThreads },
+    cacheFileName{ cacheFileName },
+    aliasAnalyses{ aliasAnalyses },
     printer{},
-    noelleCG{ nullptr } {
+    noelleCG{ nullptr },
+    unhandledExternalFuncsReachability{ nullptr },
+    numberOfMemoryPairQueries{ 0 },
+    numberOfPrunedMemoryPairs{ 0 },
+    queryCache{ nullptr },
+    reachabilityCache{ nullptr },
+    fdgCache{ nullptr } {
 
   /*
-   * Function reachability analysis.
+   * Collect the functions for the reachability analysis.
+   * The reachability is computed the first time it is needed.
    */
   identifyFunctionsThatInvokeUnhandledLibrary(M);
 
@@ -102,10 +119,20 @@ void PDGGenerator::printFunctionReachabilityResult() {
   /*
    * Print reachability results.
    */
-  for (auto &pair : this->reachableUnhandledExternalFuncs) {
-    errs()
-        << "Reachable external functions of " << pair.first->getName() << "\n";
-    for (auto &external : pair.second) {
+  for (auto &internal : this->internalFuncs) {
+#ifdef NOELLE_ENABLE_SVF
+    auto reachable =
+        this->getUnhandledExternalFunctionsReachability()->getReachableTargets(
+            internal);
+#else
+    std::set<const Function *> reachable(this->unhandledExternalFuncs.begin(),
+                                         this->unhandledExternalFuncs.end());
+#endif
+    if (reachable.empty()) {
+      continue;
+    }
+    errs() << "Reachable external functions of " << internal->getName() << "\n";
+    for (auto &external : reachable) {
       errs() << "\t" << external->getName() << "\n";
     }
   }
@@ -135,6 +162,15 @@ PDG *PDGGenerator::getPDG(void) {
      * Load the embedded PDG.
      */
     this->programDependenceGraph = constructPDGFromMetadata(this->M);
+    if (this->programDependenceGraph == nullptr) {
+      errs() << "PDGGenerator: Warning = the embedded PDG is not valid\n";
+    }
+  }
+  if (this->programDependenceGraph != nullptr) {
+
+    /*
+     * The embedded PDG has been loaded.
+     */
     if (this->performThePDGComparison) {
       auto PDGFromAnalysis = this->constructPDGFromAnalysis(this->M);
       auto arePDGsEquivalent =
@@ -155,11 +191,36 @@ PDG *PDGGenerator::getPDG(void) {
      */
     this->programDependenceGraph = constructPDGFromAnalysis(this->M);
 
+    /*
+     * Check that the PDG built by the worker pool, by using the caches, or by
+     * using the sparse memory candidates matches the one built serially from
+     * scratch considering all pairs of memory instructions.
+     */
+    if ((this->performThePDGComparison)
+        && ((this->numberOfThreads > 1) || (!this->cacheFileName.empty())
+            || (this->sparseMemoryCandidates)
+            || (this->queryCache != nullptr)
+            || (this->reachabilityCache != nullptr))) {
+      auto serialPDG = this->constructPDGFromScratch();
+      auto arePDGsEquivalent =
+          this->comparePDGs(serialPDG, this->programDependenceGraph);
+      if (!arePDGsEquivalent) {
+        errs()
+            << "PDGGenerator: Error = PDGs constructed from scratch and by using the worker pool, the caches, or the sparse memory candidates are not the same\n";
+        abort();
+      }
+      delete serialPDG;
+    }
+
     /*
      * Check if we should embed the PDG.
      */
     if ((this->performThePDGComparison) && (this->hasPDGAsMetadata(this->M))) {
       auto PDGFromMetadata = this->constructPDGFromMetadata(this->M);
+      if (PDGFromMetadata == nullptr) {
+        errs() << "PDGGenerator: Error = the embedded PDG is not valid\n";
+        abort();
+      }
       auto arePDGsEquivalen =
           this->comparePDGs(this->programDependenceGraph, PDGFromMetadata);
       if (!arePDGsEquivalen) {
@@ -181,22 +242,78 @@ PDG *PDGGenerator::getPDG(void) {
                            this->getLoopInfo);
   }
 
+  /*
+   * Track the instructions of the PDG, so the PDG can be updated when the code
+   * is modified.
+   */
+  for (auto &F : this->M) {
+    this->trackInstructionsOf(F);
+  }
+
+  /*
+   * The program dependence graph is mostly read from now on.
+   * Build its read-optimized form, which is dropped if the PDG changes.
+   */
+  this->programDependenceGraph->freeze();
+
   return this->programDependenceGraph;
 }
 
+uint64_t PDGGenerator::getNumberOfMemoryPairQueries(void) const {
+  return this->numberOfMemoryPairQueries;
+}
+
+uint64_t PDGGenerator::getNumberOfPrunedMemoryPairs(void) const {
+  return this->numberOfPrunedMemoryPairs;
+}
+
 PDG *PDGGenerator::constructPDGFromAnalysis(Module &M) {
   if (verbose >= PDGVerbosity::Maximal) {
     errs() << "PDGGenerator: Construct PDG from Analysis\n";
   }
+  if ((verbose >= PDGVerbosity::Minimal) && (this->numberOfThreads > 1)) {
+    errs() << "PDGGenerator:   Use " << this->numberOfThreads
+           << " threads to compute memory and control dependences\n";
+  }
 
   auto pdg = new PDG(M);
+  this->numberOfMemoryPairQueries = 0;
+  this->numberOfPrunedMemoryPairs = 0;
 
   constructEdgesFromUseDefs(pdg);
-  constructEdgesFromAliases(pdg, M);
+
+  /*
+   * Check if the memory dependences of the functions that did not change
+   * since the last invocation can be fetched from the cache.
+   */
+  std::unique_ptr<PDGCache> cache = nullptr;
+  if (this->cacheFileName.empty()) {
+    constructEdgesFromAliases(pdg, M);
+  } else {
+    cache = std::make_unique<PDGCache>(this->cacheFileName,
+                                       this->getCacheConfiguration());
+    constructEdgesFromAliasesUsingTheCache(pdg, M, *cache);
+  }
+  if (verbose >= PDGVerbosity::Minimal) {
+    errs() << "PDGGenerator:   Memory instruction pairs checked: "
+           << this->numberOfMemoryPairQueries << " (skipped "
+           << this->numberOfPrunedMemoryPairs << ")\n";
+    if (!this->ddAnalyses.empty()) {
+      errs() << "PDGGenerator:   Dependence analyses\n";
+      this->ddAnalyses.printStatistics(errs(), "PDGGenerator:     ");
+    }
+  }
   constructEdgesFromControl(pdg, M);
 
   trimDGUsingCustomAliasAnalysis(pdg);
 
+  /*
+   * Update the cache with the final memory dependences.
+   */
+  if (cache != nullptr) {
+    updateCache(pdg, M, *cache);
+  }
+
   return pdg;
 }
 
@@ -256,83 +373,247 @@ void PDGGenerator::constructEdgesFromUseDefs(PDG *pdg) {
   return;
 }
 
+std::vector<Function *> PDGGenerator::getFunctionsWithBody(Module &M) {
+  std::vector<Function *> functions;
+  for (auto &F : M) {
+    if (F.empty()) {
+      continue;
+    }
+    functions.push_back(&F);
+  }
+
+  return functions;
+}
+
 void PDGGenerator::constructEdgesFromAliases(PDG *pdg, Module &M) {
 
   /*
-   * Use alias analysis on stores, loads, and function calls to construct PDG
-   * edges
+   * Fetch the functions with a body.
    */
-  for (auto &F : M) {
+  auto functions = this->getFunctionsWithBody(M);
+
+  /*
+   * Add the memory dependences of these functions.
+   */
+  this->constructEdgesFromAliases(pdg, functions);
+
+  return;
+}
+
+void PDGGenerator::constructEdgesFromAliases(
+    PDG *pdg,
+    const std::vector<Function *> &functions) {
+
+  /*
+   * Check if we should use a single thread.
+   */
+  if (this->numberOfThreads <= 1) {
 
     /*
-     * Check if the function has a body.
+     * Use alias analysis on stores, loads, and function calls to construct PDG
+     * edges
      */
-    if (F.empty())
-      continue;
+    for (auto F : functions) {
+      constructEdgesFromAliasesForFunction(pdg, *F);
+    }
+
+    return;
+  }
+
+  /*
+   * The reachability analysis only reads the IR, so the workers compute it for
+   * the functions ahead of the current one.
+   * Alias queries go through the legacy pass manager (getAA), the SVF
+   * integration, and the dependence analyses added by the user, none of which
+   * can be invoked concurrently.
+   * Hence, edges are added by this thread following the order of functions in
+   * the module, which is the order used by the serial construction.
+   *
+   * Unless they are kept by the reachability cache, the number of
+   * reachability results alive at any time is bounded by the look-ahead
+   * window.
+   */
+  ThreadPool workers(hardware_concurrency(this->numberOfThreads));
+  auto lookAhead = this->numberOfThreads * 2;
+  std::vector<std::shared_ptr<const InstructionReachability>> reachabilities(
+      functions.size());
+  std::vector<std::shared_future<void>> jobs;
+  auto submitJob = [&](uint64_t index) {
+    auto F = functions[index];
+    jobs.push_back(workers.async([this, F, index, &reachabilities]() {
+      reachabilities[index] = this->getReachability(*F);
+    }));
+  };
+  for (auto i = 0u; (i < lookAhead) && (i < functions.size()); i++) {
+    submitJob(i);
+  }
+  for (auto i = 0u; i < functions.size(); i++) {
+
+    /*
+     * Keep the workers busy.
+     */
+    auto nextJob = i + lookAhead;
+    if (nextJob < functions.size()) {
+      submitJob(nextJob);
+    }
+
+    /*
+     * Wait for the reachability of the current function.
+     */
+    jobs[i].wait();
 
     /*
      * Add the edges to the PDG.
      */
-    constructEdgesFromAliasesForFunction(pdg, F);
+    this->constructEdgesFromAliasesForFunction(pdg,
+                                               *functions[i],
+                                               reachabilities[i].get());
+
+    /*
+     * Free the memory.
+     */
+    reachabilities[i].reset();
   }
+  workers.wait();
 
   return;
 }
 
+std::shared_ptr<const InstructionReachability> PDGGenerator::getReachability(
+    Function &F) {
+
+  /*
+   * Check if the reachable analysis has been disabled.
+   * In this case, every instruction is assumed to be reachable from every
+   * other one.
+   */
+  if (this->disableRA) {
+    return nullptr;
+  }
+
+  /*
+   * Fetch the reachability of the instructions of @F.
+   */
+  if (this->reachabilityCache != nullptr) {
+    return this->reachabilityCache->getReachability(F);
+  }
+
+  return std::make_shared<const InstructionReachability>(F);
+}
+
 void PDGGenerator::constructEdgesFromAliasesForFunction(PDG *pdg, Function &F) {
 
+  /*
+   * Fetch the reachability of the instructions.
+   */
+  auto reachability = this->getReachability(F);
+
+  /*
+   * Add the edges.
+   */
+  this->constructEdgesFromAliasesForFunction(pdg, F, reachability.get());
+
+  return;
+}
+
+void PDGGenerator::constructEdgesFromAliasesForFunction(
+    PDG *pdg,
+    Function &F,
+    const InstructionReachability *reachability,
+    const std::unordered_set<Instruction *> *instructionsToCheck) {
+
   /*
    * Fetch the alias analysis.
    */
   auto &AA = this->getAA(F);
 
   /*
-   * Run the reachable analysis.
+   * Identify the pairs of memory instructions to check.
    */
-  auto onlyMemoryInstructionFilter = [](Instruction *i) -> bool {
-    if (isa<LoadInst>(i)) {
-      return true;
-    }
-    if (isa<StoreInst>(i)) {
-      return true;
+  MemoryDependenceCandidates candidates(F, AA, this->sparseMemoryCandidates);
+
+  /*
+   * Collect the instructions that can access memory.
+   */
+  std::vector<Instruction *> memoryInstructions;
+  for (auto &I : instructions(F)) {
+    if (PDGGenerator::canAccessMemory(&I)) {
+      memoryInstructions.push_back(&I);
     }
-    if (isa<CallBase>(i)) {
-      return true;
+  }
+
+  /*
+   * Check the memory dependences of pairs of memory instructions.
+   * Pairs are checked in batches so the dependence analyses can be asked
+   * about many of them at once, while bounding the memory used.
+   */
+  std::vector<std::pair<Instruction *, Instruction *>> pairs;
+  auto checkPairs = [&](void) {
+
+    /*
+     * Check if any of the data dependence analyses can assert the lack of
+     * dependence between the pairs.
+     */
+    auto canExist = this->canThereBeMemoryDataDependences(pairs, F);
+
+    /*
+     * Check the memory dependences of the pairs left.
+     */
+    for (auto i = 0u; i < pairs.size(); i++) {
+      if (!canExist[i]) {
+        continue;
+      }
+      auto I = pairs[i].first;
+      auto J = pairs[i].second;
+      if (auto store = dyn_cast<StoreInst>(I)) {
+        this->addEdgesFromStore(pdg, F, AA, store, J);
+      } else if (auto load = dyn_cast<LoadInst>(I)) {
+        this->addEdgesFromLoad(pdg, F, AA, load, J);
+      } else if (auto call = dyn_cast<CallBase>(I)) {
+        this->addEdgesFromCall(pdg, F, AA, reachability, call, J);
+      }
     }
-    return false;
+    pairs.clear();
   };
-  auto dfr =
-      this->disableRA
-          ? this->dfa.getFullSets(&F)
-          : this->dfa.runReachableAnalysis(&F, onlyMemoryInstructionFilter);
+  for (auto I : memoryInstructions) {
+    if (!this->canBeTheSourceOfAMemoryDependence(I)) {
+      continue;
+    }
+    for (auto J : memoryInstructions) {
 
-  for (auto &B : F) {
-    for (auto &I : B) {
+      /*
+       * Check if @J can be executed after @I.
+       */
+      if ((reachability != nullptr) && !reachability->canReach(I, J)) {
+        continue;
+      }
 
       /*
-       * Check if the instruction can access memory.
+       * Check if the pair includes an instruction to check.
        */
-      if (!PDGGenerator::canAccessMemory(&I)) {
+      if ((instructionsToCheck != nullptr)
+          && (instructionsToCheck->count(I) == 0)
+          && (instructionsToCheck->count(J) == 0)) {
         continue;
       }
 
       /*
-       * Check the memory dependences that start from @I
+       * Check if the alias analyses need to be queried about @I and @J.
        */
-      if (auto store = dyn_cast<StoreInst>(&I)) {
-        iterateInstForStore(pdg, F, AA, dfr, store);
-      } else if (auto load = dyn_cast<LoadInst>(&I)) {
-        iterateInstForLoad(pdg, F, AA, dfr, load);
-      } else if (auto call = dyn_cast<CallBase>(&I)) {
-        iterateInstForCall(pdg, F, AA, dfr, call);
+      if (!candidates.isCandidate(I, J)) {
+        continue;
       }
+      pairs.push_back(std::make_pair(I, J));
+    }
+    if (pairs.size() >= PDGGenerator::memoryPairsPerBatch) {
+      checkPairs();
     }
   }
+  checkPairs();
+  this->numberOfMemoryPairQueries += candidates.getNumberOfPairQueries();
+  this->numberOfPrunedMemoryPairs += candidates.getNumberOfPrunedPairs();
 
-  /*
-   * Free the memory.
-   */
-  delete dfr;
+  return;
 }
 
 void PDGGenerator::removeEdgesNotUsedByParSchemes(PDG *pdg) {
@@ -342,31 +623,7 @@ void PDGGenerator::removeEdgesNotUsedByParSchemes(PDG *pdg) {
    * Collect the edges in the PDG that can be safely removed.
    */
   for (auto edge : pdg->getEdges()) {
-
-    /*
-     * Fetch the source of the dependence.
-     */
-    auto source = edge->getSrc();
-    if (!isa<Instruction>(source)) {
-      continue;
-    }
-
-    /*
-     * Check if the dependence can be removed because the instructions accessing
-     * separate memory regions.
-     */
-    if (isa<MemoryDependence<Value, Value>>(edge)
-        && this->canMemoryEdgeBeRemoved(pdg, edge)) {
-      removeEdges.insert(edge);
-      continue;
-    }
-
-    /*
-     * Check if the function of the dependence destination cannot be reached
-     * from main.
-     */
-    if (edgeIsNotLoopCarriedMemoryDependency(edge)
-        || edgeIsAlongNonMemoryWritingFunctions(edge)) {
+    if (this->canEdgeBeRemovedByParSchemes(pdg, edge)) {
       removeEdges.insert(edge);
     }
   }
@@ -381,6 +638,34 @@ void PDGGenerator::removeEdgesNotUsedByParSchemes(PDG *pdg) {
   return;
 }
 
+bool PDGGenerator::canEdgeBeRemovedByParSchemes(PDG *pdg,
+                                                DGEdge<Value, Value> *edge) {
+
+  /*
+   * Fetch the source of the dependence.
+   */
+  auto source = edge->getSrc();
+  if (!isa<Instruction>(source)) {
+    return false;
+  }
+
+  /*
+   * Check if the dependence can be removed because the instructions accessing
+   * separate memory regions.
+   */
+  if (isa<MemoryDependence<Value, Value>>(edge)
+      && this->canMemoryEdgeBeRemoved(pdg, edge)) {
+    return true;
+  }
+
+  /*
+   * Check if the function of the dependence destination cannot be reached
+   * from main.
+   */
+  return edgeIsNotLoopCarriedMemoryDependency(edge)
+         || edgeIsAlongNonMemoryWritingFunctions(edge);
+}
+
 bool PDGGenerator::canMemoryEdgeBeRemoved(PDG *pdg,
                                           DGEdge<Value, Value> *edge) {
   assert(pdg != nullptr);
@@ -784,11 +1069,18 @@ bool PDGGenerator::edgeIsAlongNonMemoryWritingFunctions(
 }
 
 void PDGGenerator::addAnalysis(DependenceAnalysis *a) {
-  this->ddAnalyses.insert(a);
+  this->ddAnalyses.addAnalysis(a);
 }
 
 void PDGGenerator::removeAnalysis(DependenceAnalysis *a) {
-  this->ddAnalyses.erase(a);
+  this->ddAnalyses.removeAnalysis(a);
+
+  /*
+   * Forget the answers given by @a.
+   */
+  if (this->queryCache != nullptr) {
+    this->queryCache->invalidate(a);
+  }
 }
 
 void PDGGenerator::addAnalysis(CallGraphAnalysis *a) {
@@ -800,9 +1092,11 @@ void PDGGenerator::removeAnalysis(CallGraphAnalysis *a) {
 }
 
 PDGGenerator::~PDGGenerator() {
+  this->instructionHandles.clear();
   if (this->programDependenceGraph) {
     delete this->programDependenceGraph;
   }
+  delete this->unhandledExternalFuncsReachability;
 }
 
 } // namespace arcana::noelle
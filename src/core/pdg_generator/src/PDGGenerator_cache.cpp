@@ -0,0 +1,142 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Yian Su, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/PDGGenerator.hpp"
+#include "llvm/Support/xxhash.h"
+
+namespace arcana::noelle {
+
+uint64_t PDGGenerator::getCacheConfiguration(void) {
+
+  /*
+   * Describe the options that change the memory dependences computed.
+   */
+  std::string configuration;
+  raw_string_ostream os(configuration);
+  os << this->disableSVF << this->disableSVFCallGraph << this->disableAllocAA
+     << this->disableRA;
+#ifdef NOELLE_ENABLE_SVF
+  os << " svf";
+#endif
+  os << " " << this->dependOnWholeProgram();
+
+  /*
+   * Describe the LLVM alias analyses that answer the alias queries.
+   */
+  os << " " << this->aliasAnalyses;
+
+  /*
+   * Describe the dependence analyses added by the user.
+   */
+  std::vector<std::string> analyses;
+  for (auto ddAnalysis : this->ddAnalyses.getAnalyses()) {
+    analyses.push_back(ddAnalysis->getName());
+  }
+  std::sort(analyses.begin(), analyses.end());
+  for (auto &name : analyses) {
+    os << " " << name;
+  }
+
+  return xxHash64(os.str());
+}
+
+bool PDGGenerator::dependOnWholeProgram(void) const {
+  auto wholeProgram = false;
+#ifdef NOELLE_ENABLE_SVF
+  wholeProgram = !this->disableSVF;
+#endif
+
+  /*
+   * GlobalsAA analyzes the uses of the global variables in the whole module,
+   * so its answers change when any function starts or stops taking the
+   * address of a global.
+   */
+  if (this->aliasAnalyses.find("globals-aa") != std::string::npos) {
+    wholeProgram = true;
+  }
+
+  return wholeProgram;
+}
+
+void PDGGenerator::constructEdgesFromAliasesUsingTheCache(PDG *pdg,
+                                                          Module &M,
+                                                          PDGCache &cache) {
+
+  /*
+   * Compute the keys of the functions.
+   * SVF and GlobalsAA analyze the whole program, so a change anywhere can
+   * change the dependences of every function.
+   */
+  cache.computeKeys(M, this->dependOnWholeProgram());
+
+  /*
+   * Fetch the memory dependences of the functions that are in the cache.
+   */
+  std::vector<Function *> functionsToAnalyze;
+  for (auto F : this->getFunctionsWithBody(M)) {
+    if (cache.loadDependences(pdg, *F)) {
+      if (this->verbose >= PDGVerbosity::Maximal) {
+        errs() << "PDGGenerator:   Cache hit for " << F->getName() << "\n";
+      }
+      continue;
+    }
+    if (this->verbose >= PDGVerbosity::Maximal) {
+      errs() << "PDGGenerator:   Cache miss for " << F->getName() << "\n";
+    }
+    functionsToAnalyze.push_back(F);
+  }
+  if (this->verbose >= PDGVerbosity::Minimal) {
+    errs() << "PDGGenerator: PDG cache " << this->cacheFileName << ": "
+           << cache.getNumberOfHits() << " hits, " << cache.getNumberOfMisses()
+           << " misses\n";
+  }
+
+  /*
+   * Compute the memory dependences of the other functions.
+   */
+  this->constructEdgesFromAliases(pdg, functionsToAnalyze);
+
+  return;
+}
+
+void PDGGenerator::updateCache(PDG *pdg, Module &M, PDGCache &cache) {
+
+  /*
+   * Record the memory dependences of all functions.
+   * Entries of functions that no longer exist are dropped.
+   */
+  for (auto F : this->getFunctionsWithBody(M)) {
+    cache.storeDependences(pdg, *F);
+  }
+
+  /*
+   * Write the cache.
+   */
+  if (!cache.save()) {
+    errs() << "PDGGenerator: Warning = the PDG cache " << this->cacheFileName
+           << " could not be written\n";
+  }
+
+  return;
+}
+
+} // namespace arcana::noelle
@@ -162,19 +162,31 @@ void PDGGenerator::identifyFunctionsThatInvokeUnhandledLibrary(Module &M) {
     }
   }
 
+  return;
+}
+
+FunctionReachabilitySummary *PDGGenerator::
+    getUnhandledExternalFunctionsReachability(void) {
+
   /*
-   * Identify function reachability.
+   * Identify function reachability the first time it is needed.
+   * The program call graph is not computed for clients that never query it.
+   *
+   * The unhandled external functions reachable from every function are
+   * computed with a single bottom-up pass over the program call graph.
+   * Memory dependences are computed by a pool of workers, so only one of them
+   * computes the summary.
    */
-  for (auto &internal : this->internalFuncs) {
-    for (auto &external : this->unhandledExternalFuncs) {
-      if (NoelleSVFIntegration::isReachableBetweenFunctions(internal,
-                                                            external)) {
-        this->reachableUnhandledExternalFuncs[internal].insert(external);
-      }
-    }
-  }
-
-  return;
+  std::call_once(this->unhandledExternalFuncsReachabilityFlag, [this](void) {
+    std::vector<const Function *> externals(
+        this->unhandledExternalFuncs.begin(),
+        this->unhandledExternalFuncs.end());
+    auto cg = this->getProgramCallGraph();
+    this->unhandledExternalFuncsReachability =
+        new FunctionReachabilitySummary(cg, externals);
+  });
+
+  return this->unhandledExternalFuncsReachability;
 }
 
 bool PDGGenerator::cannotReachUnhandledExternalFunction(CallBase *call) {
@@ -204,7 +216,22 @@ bool PDGGenerator::isUnhandledExternalFunction(const Function *F) {
 
 bool PDGGenerator::isInternalFunctionThatReachUnhandledExternalFunction(
     const Function *F) {
-  return !F->empty() && !this->reachableUnhandledExternalFuncs[F].empty();
+  if (F->empty()) {
+    return false;
+  }
+
+#ifdef NOELLE_ENABLE_SVF
+  return this->getUnhandledExternalFunctionsReachability()->canReachATarget(F);
+#else
+
+  /*
+   * Without SVF, the reachability between functions is not known
+   * (see NoelleSVFIntegration::isReachableBetweenFunctions).
+   * Hence, every internal function is conservatively considered to reach
+   * every unhandled external function.
+   */
+  return !this->unhandledExternalFuncs.empty();
+#endif
 }
 
 std::set<const Function *> PDGGenerator::getFunctionsWithSignature(
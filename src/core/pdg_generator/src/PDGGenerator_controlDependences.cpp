@@ -24,26 +24,62 @@
 #include "arcana/noelle/core/PDGPrinter.hpp"
 #include "arcana/noelle/core/PDGGenerator.hpp"
 #include "llvm/Analysis/PostDominators.h"
+#include "llvm/Support/ThreadPool.h"
 
 namespace arcana::noelle {
 
 void PDGGenerator::constructEdgesFromControl(PDG *pdg, Module &M) {
   assert(pdg != nullptr);
 
-  for (auto &F : M) {
+  /*
+   * Fetch the functions with a body.
+   */
+  auto functions = this->getFunctionsWithBody(M);
 
-    /*
-     * Fetch the next function with a body.
-     */
-    if (F.empty()) {
-      continue;
+  /*
+   * Check if we should use a single thread.
+   */
+  if (this->numberOfThreads <= 1) {
+    for (auto F : functions) {
+
+      /*
+       * Compute the control dependences of the function based on its
+       * post-dominator tree.
+       */
+      this->constructEdgesFromControlForFunction(pdg, *F);
     }
 
-    /*
-     * Compute the control dependences of the function based on its
-     * post-dominator tree.
-     */
-    this->constructEdgesFromControlForFunction(pdg, F);
+    return;
+  }
+
+  /*
+   * Compute the control dependences of the functions in parallel.
+   *
+   * Each worker computes its own post-dominator tree because the one provided
+   * by the pass manager cannot be requested concurrently.
+   * The dependences of a function are kept in a buffer owned by that function
+   * until all workers are done.
+   */
+  std::vector<std::vector<std::pair<Instruction *, Instruction *>>> buffers(
+      functions.size());
+  ThreadPool workers(hardware_concurrency(this->numberOfThreads));
+  for (auto i = 0u; i < functions.size(); i++) {
+    auto F = functions[i];
+    workers.async([this, F, i, &buffers]() {
+      PostDominatorTree postDomTree(*F);
+      buffers[i] = this->computeControlDependencesOfFunction(*F, postDomTree);
+    });
+  }
+  workers.wait();
+
+  /*
+   * Add the dependences to the PDG following the order of functions in the
+   * module.
+   */
+  for (auto &controlDependences : buffers) {
+    for (auto &[src, dst] : controlDependences) {
+      pdg->addControlDependenceEdge(src, dst);
+    }
   }
 
   return;
@@ -53,17 +89,43 @@ void PDGGenerator::constructEdgesFromControlForFunction(PDG *pdg, Function &F) {
   assert(pdg != nullptr);
 
   /*
-   * There is a control dependence from a basic block A to a basic block B iff
-   * 1) there is E such that E is a successor of A, and
-   * 2) B post-dominates E, and
-   * 3) B doesn't strictly post-dominate A
+   * Fetch the post-dominator tree of the function.
    */
+  auto &postDomTree = this->getPDT(F);
 
   /*
-   * Fetch the post-dominator tree of the function.
+   * Compute the control dependences.
    */
-  auto &postDomTree = this->getPDT(F);
+  auto controlDependences =
+      this->computeControlDependencesOfFunction(F, postDomTree);
+
+  /*
+   * Add the control dependences.
+   */
+  for (auto &[src, dst] : controlDependences) {
+    pdg->addControlDependenceEdge(src, dst);
+  }
+
+  return;
+}
 
+std::vector<std::pair<Instruction *, Instruction *>> PDGGenerator::
+    computeControlDependencesOfFunction(Function &F,
+                                        PostDominatorTree &postDomTree) {
+  std::vector<std::pair<Instruction *, Instruction *>> controlDependences;
+  std::unordered_map<Instruction *, std::unordered_set<Instruction *>>
+      controlProducersOf;
+  auto addControlDependence = [&](Instruction *src, Instruction *dst) {
+    controlDependences.push_back(std::make_pair(src, dst));
+    controlProducersOf[dst].insert(src);
+  };
+
+  /*
+   * There is a control dependence from a basic block A to a basic block B iff
+   * 1) there is E such that E is a successor of A, and
+   * 2) B post-dominates E, and
+   * 3) B doesn't strictly post-dominate A
+   */
   for (auto &B : F) {
 
     /*
@@ -124,27 +186,19 @@ void PDGGenerator::constructEdgesFromControlForFunction(PDG *pdg, Function &F) {
          * Add the control dependences.
          */
         for (auto &I : B) {
-          auto srcNode = pdg->fetchNode(controlTerminator);
-          auto dstNode = pdg->fetchNode(&I);
-          assert(srcNode != nullptr);
-          assert(dstNode != nullptr);
-          ControlDependence<Value, Value> edge{ srcNode, dstNode };
-          pdg->copyAddEdge(edge);
+          addControlDependence(controlTerminator, &I);
         }
       }
     }
   }
 
-  auto getControlProducers = [&](Value *V) -> std::unordered_set<Value *> {
-    std::unordered_set<Value *> controlProducers;
-    auto node = pdg->fetchNode(V);
-    for (auto edge : node->getIncomingEdges()) {
-      if (!isa<ControlDependence<Value, Value>>(edge))
-        continue;
-      auto controlProducer = edge->getSrc();
-      controlProducers.insert(controlProducer);
+  auto getControlProducers =
+      [&](Instruction *I) -> std::unordered_set<Instruction *> {
+    auto it = controlProducersOf.find(I);
+    if (it == controlProducersOf.end()) {
+      return {};
     }
-    return controlProducers;
+    return it->second;
   };
 
   /*
@@ -159,7 +213,7 @@ void PDGGenerator::constructEdgesFromControlForFunction(PDG *pdg, Function &F) {
        * Locate control producers of incoming blocks to PHIs
        * where the incoming value doesn't reside in incoming block
        */
-      std::unordered_set<Value *> controlProducers;
+      std::unordered_set<Instruction *> controlProducers;
       for (auto i = 0u; i < phi.getNumIncomingValues(); ++i) {
         auto incomingValue = phi.getIncomingValue(i);
         if (!incomingValue)
@@ -182,25 +236,18 @@ void PDGGenerator::constructEdgesFromControlForFunction(PDG *pdg, Function &F) {
        * Determine which of these control producers do NOT have a control edge
        * to the PHI already Add a control edge from those producers to the PHI
        */
-      std::unordered_set<Value *> currentControlProducersOnPHI =
-          getControlProducers(&phi);
+      auto currentControlProducersOnPHI = getControlProducers(&phi);
       for (auto producer : controlProducers) {
         if (currentControlProducersOnPHI.find(producer)
             != currentControlProducersOnPHI.end()) {
           continue;
         }
-
-        auto srcNode = pdg->fetchNode(producer);
-        auto dstNode = pdg->fetchNode(&phi);
-        assert(srcNode != nullptr);
-        assert(dstNode != nullptr);
-        ControlDependence<Value, Value> edge{ srcNode, dstNode };
-        pdg->copyAddEdge(edge);
+        addControlDependence(producer, &phi);
       }
     }
   }
 
-  return;
+  return controlDependences;
 }
 
 } // namespace arcana::noelle
@@ -19,38 +19,110 @@
  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
  OR OTHER DEALINGS IN THE SOFTWARE.
  */
+#include <chrono>
+#include <numeric>
+
 #include "arcana/noelle/core/SystemHeaders.hpp"
 #include "arcana/noelle/core/TalkDown.hpp"
 #include "arcana/noelle/core/PDGPrinter.hpp"
 #include "arcana/noelle/core/PDGGenerator.hpp"
 #include "IntegrationWithSVF.hpp"
+#include "MemoryDependenceCandidates.hpp"
 #include "arcana/noelle/core/Utils.hpp"
 
 namespace arcana::noelle {
 
-bool PDGGenerator::canThereBeAMemoryDataDependence(Instruction *fromInst,
-                                                   Instruction *toInst,
-                                                   Function &F) {
+std::vector<bool> PDGGenerator::canThereBeMemoryDataDependences(
+    const std::vector<std::pair<Instruction *, Instruction *>> &pairs,
+    Function &F) {
+  std::vector<bool> canExist(pairs.size(), true);
 
   /*
    * Check if any of the data dependence analyses can assert the lack of
-   * dependence from @fromInst to @toInst.
+   * dependence for the pairs.
+   * Every analysis is asked at once about all the pairs that the previous
+   * analyses could not resolve.
    */
-  for (auto ddAnalysis : this->ddAnalyses) {
-    if (!ddAnalysis->canThereBeAMemoryDataDependence(fromInst, toInst, F)) {
+  std::vector<uint64_t> unresolved(pairs.size());
+  std::iota(unresolved.begin(), unresolved.end(), 0);
+  for (auto ddAnalysis : this->ddAnalyses.getAnalyses()) {
+    if (unresolved.empty()) {
+      break;
+    }
 
-      /*
-       * We found a dependence analysis that can assert the lack of dependence.
-       */
-      return false;
+    /*
+     * Check if the analysis can remove dependences of @F.
+     */
+    if (!ddAnalysis->canRemoveDependencesOf(F)) {
+      continue;
     }
+
+    /*
+     * Query the analysis.
+     */
+    auto id = (this->queryCache != nullptr)
+                  ? this->queryCache->getAnalysisID(ddAnalysis,
+                                                    ddAnalysis->getName())
+                  : 0;
+    std::vector<DependenceQueryCache::Query> queries;
+    for (auto pairIndex : unresolved) {
+      queries.push_back({ DependenceQueryCache::CAN_THERE_BE_A_DEPENDENCE,
+                          id,
+                          pairs[pairIndex].first,
+                          pairs[pairIndex].second,
+                          &F,
+                          0 });
+    }
+    auto answers = this->queryTheCache(
+        queries,
+        [this, ddAnalysis, &pairs, &unresolved, &F](
+            const std::vector<uint64_t> &queryIndexes)
+            -> std::vector<uint8_t> {
+          std::vector<std::pair<Instruction *, Instruction *>> pairsToAsk;
+          for (auto i : queryIndexes) {
+            pairsToAsk.push_back(pairs[unresolved[i]]);
+          }
+          auto start = std::chrono::steady_clock::now();
+          auto canExist =
+              ddAnalysis->canThereBeMemoryDataDependences(pairsToAsk, F);
+          auto end = std::chrono::steady_clock::now();
+          assert(canExist.size() == pairsToAsk.size());
+          auto removed = std::count(canExist.begin(), canExist.end(), false);
+          this->ddAnalyses.account(
+              ddAnalysis,
+              pairsToAsk.size(),
+              removed,
+              std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+                  .count());
+
+          return std::vector<uint8_t>(canExist.begin(), canExist.end());
+        });
+
+    /*
+     * Keep the pairs that the analysis could not resolve.
+     */
+    std::vector<uint64_t> stillUnresolved;
+    for (auto i = 0u; i < unresolved.size(); i++) {
+      if (!answers[i]) {
+
+        /*
+         * We found a dependence analysis that can assert the lack of
+         * dependence.
+         */
+        canExist[unresolved[i]] = false;
+        continue;
+      }
+      stillUnresolved.push_back(unresolved[i]);
+    }
+    unresolved = std::move(stillUnresolved);
   }
 
   /*
-   * We did not find a single dependence analysis that can assert the lack of
-   * dependence. So we must assume this dependence can happen at run time.
+   * For the other pairs, we did not find a single dependence analysis that can
+   * assert the lack of dependence. So we must assume these dependences can
+   * happen at run time.
    */
-  return true;
+  return canExist;
 }
 
 std::pair<bool, bool> PDGGenerator::isThereThisMemoryDataDependenceType(
@@ -61,223 +133,196 @@ std::pair<bool, bool> PDGGenerator::isThereThisMemoryDataDependenceType(
   auto noDep = false;
   auto mustExist = false;
 
-  for (auto ddAnalysis : this->ddAnalyses) {
-    auto resp =
-        ddAnalysis->isThereThisMemoryDataDependenceType(t, fromInst, toInst, F);
+  /*
+   * The analyses are sorted by their cost, which changes while they run.
+   * Hence, the answer must not depend on the order in which they are asked.
+   *
+   * An analysis that asserts the lack of dependence wins over any other
+   * answer, so we can stop as soon as one of them does.
+   * An analysis that asserts the dependence does not stop the iteration
+   * because a later analysis could still assert its lack.
+   */
+  for (auto ddAnalysis : this->ddAnalyses.getAnalyses()) {
+    if (!ddAnalysis->canRemoveDependencesOf(F)) {
+      continue;
+    }
+    auto resp = static_cast<MemoryDataDependenceStrength>(this->queryTheCache(
+        DependenceQueryCache::DEPENDENCE_TYPE,
+        ddAnalysis,
+        ddAnalysis->getName(),
+        fromInst,
+        toInst,
+        &F,
+        static_cast<uint8_t>(t),
+        [this, ddAnalysis, t, fromInst, toInst, &F](void) -> uint8_t {
+          auto start = std::chrono::steady_clock::now();
+          auto strength =
+              ddAnalysis->isThereThisMemoryDataDependenceType(t,
+                                                              fromInst,
+                                                              toInst,
+                                                              F);
+          auto end = std::chrono::steady_clock::now();
+          this->ddAnalyses.account(
+              ddAnalysis,
+              1,
+              (strength == CANNOT_EXIST) ? 1 : 0,
+              std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+                  .count());
+
+          return strength;
+        }));
     if (resp == CANNOT_EXIST) {
       noDep = true;
+      mustExist = false;
       break;
     }
     if (resp == MUST_EXIST) {
       mustExist = true;
-      break;
     }
   }
 
   return std::make_pair(noDep, mustExist);
 }
 
-void PDGGenerator::iterateInstForStore(PDG *pdg,
-                                       Function &F,
-                                       AAResults &AA,
-                                       DataFlowResult *dfr,
-                                       StoreInst *store) {
+void PDGGenerator::addEdgesFromStore(PDG *pdg,
+                                     Function &F,
+                                     AAResults &AA,
+                                     StoreInst *store,
+                                     Instruction *inst) {
 
-  for (auto I : dfr->OUT(store)) {
+  /*
+   * Check stores.
+   */
+  if (auto otherStore = dyn_cast<StoreInst>(inst)) {
+    this->addEdgeFromMemoryAlias(pdg, F, AA, store, otherStore, DG_DATA_WAW);
+    return;
+  }
 
-    /*
-     * Check if the instruction can access memory.
-     */
-    auto inst = dyn_cast<Instruction>(I);
-    if (inst == nullptr) {
-      continue;
-    }
-    if (!PDGGenerator::canAccessMemory(inst)) {
-      continue;
-    }
+  /*
+   * Check loads.
+   */
+  if (auto load = dyn_cast<LoadInst>(inst)) {
+    this->addEdgeFromMemoryAlias(pdg, F, AA, store, load, DG_DATA_RAW);
+    return;
+  }
 
-    /*
-     * The instruction can access memory.
-     *
-     * Check if any of the data dependence analyses can assert the lack of
-     * dependence from @store to @I.
-     */
-    if (!this->canThereBeAMemoryDataDependence(store, inst, F)) {
-      continue;
+  /*
+   * Check calls.
+   */
+  if (auto call = dyn_cast<CallBase>(inst)) {
+    if (!Utils::isActualCode(call)) {
+      return;
     }
+    this->addEdgeFromFunctionModRef(pdg, F, AA, call, store, false);
+    return;
+  }
 
-    /*
-     * Check stores.
-     */
-    if (auto otherStore = dyn_cast<StoreInst>(inst)) {
-      this->addEdgeFromMemoryAlias(pdg, F, AA, store, otherStore, DG_DATA_WAW);
-      continue;
-    }
+  return;
+}
 
-    /*
-     * Check loads.
-     */
-    if (auto load = dyn_cast<LoadInst>(inst)) {
-      this->addEdgeFromMemoryAlias(pdg, F, AA, store, load, DG_DATA_RAW);
-      continue;
-    }
+void PDGGenerator::addEdgesFromLoad(PDG *pdg,
+                                    Function &F,
+                                    AAResults &AA,
+                                    LoadInst *load,
+                                    Instruction *inst) {
 
-    /*
-     * Check calls.
-     */
-    if (auto call = dyn_cast<CallBase>(inst)) {
-      if (!Utils::isActualCode(call)) {
-        continue;
-      }
-      this->addEdgeFromFunctionModRef(pdg, F, AA, call, store, false);
-      continue;
-    }
+  /*
+   * Check stores.
+   */
+  if (auto store = dyn_cast<StoreInst>(inst)) {
+    this->addEdgeFromMemoryAlias(pdg, F, AA, load, store, DG_DATA_WAR);
+    return;
+  }
+
+  /*
+   * Check calls.
+   */
+  if (auto call = dyn_cast<CallBase>(inst)) {
+    this->addEdgeFromFunctionModRef(pdg, F, AA, call, load, false);
+    return;
   }
 
   return;
 }
 
-void PDGGenerator::iterateInstForLoad(PDG *pdg,
-                                      Function &F,
-                                      AAResults &AA,
-                                      DataFlowResult *dfr,
-                                      LoadInst *load) {
-
-  for (auto I : dfr->OUT(load)) {
+bool PDGGenerator::canBeTheSourceOfAMemoryDependence(Instruction *inst) {
 
-    /*
-     * Check if the instruction can access memory.
-     */
-    auto inst = dyn_cast<Instruction>(I);
-    if (inst == nullptr) {
-      continue;
-    }
-    if (!PDGGenerator::canAccessMemory(inst)) {
-      continue;
-    }
+  /*
+   * Check if the instruction can access memory.
+   */
+  if (!PDGGenerator::canAccessMemory(inst)) {
+    return false;
+  }
 
-    /*
-     * The instruction can access memory.
-     *
-     * Check if any of the data dependence analyses can assert the lack of
-     * dependence from @load to @I.
-     */
-    if (!this->canThereBeAMemoryDataDependence(load, inst, F)) {
-      continue;
-    }
+  /*
+   * Check calls.
+   */
+  if (auto call = dyn_cast<CallBase>(inst)) {
 
     /*
-     * Check stores.
+     * Check if the call instruction is not actual code.
      */
-    if (auto store = dyn_cast<StoreInst>(inst)) {
-      this->addEdgeFromMemoryAlias(pdg, F, AA, load, store, DG_DATA_WAR);
-      continue;
+    if (!Utils::isActualCode(call)) {
+      return false;
     }
 
     /*
-     * Check calls.
+     * Check if the call instruction is pure.
      */
-    if (auto call = dyn_cast<CallBase>(inst)) {
-      this->addEdgeFromFunctionModRef(pdg, F, AA, call, load, false);
-      continue;
+    if (this->hasNoMemoryOperations(call)) {
+      return false;
     }
   }
 
-  return;
+  return true;
 }
 
-void PDGGenerator::iterateInstForCall(PDG *pdg,
-                                      Function &F,
-                                      AAResults &AA,
-                                      DataFlowResult *dfr,
-                                      CallBase *call) {
-
-  /*
-   * Check if the call instruction is not actual code.
-   */
-  if (!Utils::isActualCode(call)) {
-    return;
-  }
+void PDGGenerator::addEdgesFromCall(PDG *pdg,
+                                    Function &F,
+                                    AAResults &AA,
+                                    const InstructionReachability *reachability,
+                                    CallBase *call,
+                                    Instruction *inst) {
 
   /*
-   * Check if the call instruction is pure.
+   * Check stores.
    */
-  if (this->hasNoMemoryOperations(call)) {
+  if (auto store = dyn_cast<StoreInst>(inst)) {
+    addEdgeFromFunctionModRef(pdg, F, AA, call, store, true);
     return;
   }
 
   /*
-   * Check if the instruction can access memory.
+   * Check loads.
    */
-  if (!PDGGenerator::canAccessMemory(call)) {
+  if (auto load = dyn_cast<LoadInst>(inst)) {
+    addEdgeFromFunctionModRef(pdg, F, AA, call, load, true);
     return;
   }
 
   /*
-   * Identify all dependences from @call.
+   * Check calls.
    */
-  for (auto I : dfr->OUT(call)) {
-
-    /*
-     * Check if the instruction can access memory.
-     */
-    auto inst = dyn_cast<Instruction>(I);
-    if (inst == nullptr) {
-      continue;
-    }
-    if (!PDGGenerator::canAccessMemory(inst)) {
-      continue;
-    }
+  if (auto baseOtherCall = dyn_cast<CallBase>(inst)) {
 
     /*
-     * The instruction can access memory.
-     *
-     * Check if any of the data dependence analyses can assert the lack of
-     * dependence from @call to @I.
+     * Check direct calls
      */
-    if (!this->canThereBeAMemoryDataDependence(call, inst, F)) {
-      continue;
-    }
-
-    /*
-     * Check stores.
-     */
-    if (auto store = dyn_cast<StoreInst>(inst)) {
-      addEdgeFromFunctionModRef(pdg, F, AA, call, store, true);
-      continue;
-    }
-
-    /*
-     * Check loads.
-     */
-    if (auto load = dyn_cast<LoadInst>(inst)) {
-      addEdgeFromFunctionModRef(pdg, F, AA, call, load, true);
-      continue;
-    }
-
-    /*
-     * Check calls.
-     */
-    if (auto baseOtherCall = dyn_cast<CallBase>(inst)) {
-
-      /*
-       * Check direct calls
-       */
-      if (auto otherCall = dyn_cast<CallInst>(baseOtherCall)) {
-        if (!Utils::isActualCode(otherCall)) {
-          continue;
-        }
+    if (auto otherCall = dyn_cast<CallInst>(baseOtherCall)) {
+      if (!Utils::isActualCode(otherCall)) {
+        return;
       }
-      bool isCallReachableFromOtherCall =
-          dfr->OUT(baseOtherCall).count(call) > 0 ? true : false;
-      this->addEdgeFromFunctionModRef(pdg,
-                                      F,
-                                      AA,
-                                      call,
-                                      baseOtherCall,
-                                      isCallReachableFromOtherCall);
-      continue;
     }
+    auto isCallReachableFromOtherCall =
+        (reachability == nullptr)
+        || reachability->canReach(baseOtherCall, call);
+    this->addEdgeFromFunctionModRef(pdg,
+                                    F,
+                                    AA,
+                                    call,
+                                    baseOtherCall,
+                                    isCallReachableFromOtherCall);
+    return;
   }
 
   return;
@@ -310,7 +355,7 @@ bool PDGGenerator::hasNoMemoryOperations(CallBase *call) {
    * SVF is enabled.
    * We can use it.
    */
-  auto svfResult = NoelleSVFIntegration::getModRefInfo(call);
+  auto svfResult = this->getSVFModRefInfo(call);
   if ((svfResult == ModRefInfo::NoModRef) || (svfResult == ModRefInfo::Must)) {
     return true;
   }
@@ -338,7 +383,7 @@ void PDGGenerator::addEdgeFromFunctionModRef(PDG *pdg,
   /*
    * Query the LLVM alias analyses.
    */
-  switch (AA.getModRefInfo(call, MemoryLocation::get(store))) {
+  switch (this->getModRefInfo(AA, call, store)) {
     case ModRefInfo::NoModRef:
     case ModRefInfo::Must:
       return;
@@ -383,8 +428,7 @@ void PDGGenerator::addEdgeFromFunctionModRef(PDG *pdg,
      * correctly.
      */
     if (this->isSafeToQueryModRefOfSVF(call, bv)) {
-      auto const &loc = MemoryLocation::get(store);
-      switch (NoelleSVFIntegration::getModRefInfo(call, loc)) {
+      switch (this->getSVFModRefInfo(call, store)) {
         case ModRefInfo::NoModRef:
         case ModRefInfo::Must:
           return;
@@ -530,7 +574,7 @@ void PDGGenerator::addEdgeFromFunctionModRef(PDG *pdg,
   /*
    * Query the LLVM alias analyses.
    */
-  switch (AA.getModRefInfo(call, MemoryLocation::get(load))) {
+  switch (this->getModRefInfo(AA, call, load)) {
     case ModRefInfo::NoModRef:
     case ModRefInfo::Must:
     case ModRefInfo::Ref:
@@ -570,8 +614,7 @@ void PDGGenerator::addEdgeFromFunctionModRef(PDG *pdg,
      * correctly.
      */
     if (isSafeToQueryModRefOfSVF(call, bv)) {
-      switch (NoelleSVFIntegration::getModRefInfo(call,
-                                                  MemoryLocation::get(load))) {
+      switch (this->getSVFModRefInfo(call, load)) {
         case ModRefInfo::NoModRef:
         case ModRefInfo::Must:
         case ModRefInfo::Ref:
@@ -684,7 +727,7 @@ void PDGGenerator::addEdgeFromFunctionModRef(
   /*
    * Query the LLVM alias analyses.
    */
-  switch (AA.getModRefInfo(otherCall, call)) {
+  switch (this->getModRefInfo(AA, otherCall, call)) {
     case ModRefInfo::NoModRef:
     case ModRefInfo::Must:
       return;
@@ -699,7 +742,7 @@ void PDGGenerator::addEdgeFromFunctionModRef(
       bv[0] = true;
 
       if (isCallReachableFromOtherCall) {
-        switch (AA.getModRefInfo(call, otherCall)) {
+        switch (this->getModRefInfo(AA, call, otherCall)) {
           case ModRefInfo::NoModRef:
           case ModRefInfo::Must:
           case ModRefInfo::Ref:
@@ -730,7 +773,7 @@ void PDGGenerator::addEdgeFromFunctionModRef(
       bv[1] = true;
 
       if (isCallReachableFromOtherCall) {
-        switch (AA.getModRefInfo(call, otherCall)) {
+        switch (this->getModRefInfo(AA, call, otherCall)) {
           case ModRefInfo::NoModRef:
           case ModRefInfo::Must:
             return;
@@ -760,7 +803,7 @@ void PDGGenerator::addEdgeFromFunctionModRef(
       bv[2] = true;
 
       if (isCallReachableFromOtherCall) {
-        switch (AA.getModRefInfo(call, otherCall)) {
+        switch (this->getModRefInfo(AA, call, otherCall)) {
           case ModRefInfo::NoModRef:
           case ModRefInfo::Must:
             return;
@@ -817,7 +860,7 @@ void PDGGenerator::addEdgeFromFunctionModRef(
      */
     if (isSafeToQueryModRefOfSVF(call, bv)
         && isSafeToQueryModRefOfSVF(otherCall, bv)) {
-      switch (NoelleSVFIntegration::getModRefInfo(otherCall, call)) {
+      switch (this->getSVFModRefInfo(otherCall, call)) {
         case ModRefInfo::NoModRef:
         case ModRefInfo::Must:
           return;
@@ -826,7 +869,7 @@ void PDGGenerator::addEdgeFromFunctionModRef(
         case ModRefInfo::MustRef:
           bv[0] = true;
           if (isCallReachableFromOtherCall) {
-            switch (NoelleSVFIntegration::getModRefInfo(call, otherCall)) {
+            switch (this->getSVFModRefInfo(call, otherCall)) {
               case ModRefInfo::NoModRef:
               case ModRefInfo::Must:
               case ModRefInfo::Ref:
@@ -845,7 +888,7 @@ void PDGGenerator::addEdgeFromFunctionModRef(
         case ModRefInfo::MustMod:
           bv[1] = true;
           if (isCallReachableFromOtherCall) {
-            switch (NoelleSVFIntegration::getModRefInfo(call, otherCall)) {
+            switch (this->getSVFModRefInfo(call, otherCall)) {
               case ModRefInfo::NoModRef:
               case ModRefInfo::Must:
                 return;
@@ -869,7 +912,7 @@ void PDGGenerator::addEdgeFromFunctionModRef(
         case ModRefInfo::MustModRef:
           bv[2] = true;
           if (isCallReachableFromOtherCall) {
-            switch (NoelleSVFIntegration::getModRefInfo(call, otherCall)) {
+            switch (this->getSVFModRefInfo(call, otherCall)) {
               case ModRefInfo::NoModRef:
               case ModRefInfo::Must:
                 return;
@@ -1314,17 +1357,27 @@ AliasResult PDGGenerator::doTheyAlias(PDG *pdg,
    */
   AliasResult aaResult{ AliasResult::MayAlias };
   if (haveMemoryLocations) {
-    auto memI = MemoryLocation::get(instIAsInst);
-    auto memJ = MemoryLocation::get(instJAsInst);
-    auto areTheSame = memI == memJ;
-    if (areTheSame) {
-      aaResult = AliasResult::MustAlias;
-    } else {
-      aaResult = AA.alias(memI, memJ);
-    }
+    aaResult = this->alias(&AAResultsWrapperPass::ID,
+                           "LLVM AA",
+                           instI,
+                           instJ,
+                           [&AA, instIAsInst, instJAsInst](void) {
+                             auto memI = MemoryLocation::get(instIAsInst);
+                             auto memJ = MemoryLocation::get(instJAsInst);
+                             if (memI == memJ) {
+                               return AliasResult(AliasResult::MustAlias);
+                             }
+                             return AA.alias(memI, memJ);
+                           });
 
   } else {
-    aaResult = AA.alias(instI, instJ);
+    aaResult = this->alias(&AAResultsWrapperPass::ID,
+                           "LLVM AA",
+                           instI,
+                           instJ,
+                           [&AA, instI, instJ](void) {
+                             return AA.alias(instI, instJ);
+                           });
   }
   switch (aaResult) {
     case AliasResult::NoAlias:
@@ -1353,13 +1406,19 @@ AliasResult PDGGenerator::doTheyAlias(PDG *pdg,
      * SVF is enabled, so let's use it.
      */
     AliasResult SVFAAResult{ AliasResult::MayAlias };
-    if (haveMemoryLocations) {
-      SVFAAResult =
-          NoelleSVFIntegration::alias(MemoryLocation::get(instIAsInst),
-                                      MemoryLocation::get(instJAsInst));
-    } else {
-      SVFAAResult = NoelleSVFIntegration::alias(instI, instJ);
-    }
+    SVFAAResult = this->alias(
+        &NoelleSVFIntegration::ID,
+        "SVF",
+        instI,
+        instJ,
+        [haveMemoryLocations, instI, instJ, instIAsInst, instJAsInst](void) {
+          if (haveMemoryLocations) {
+            return NoelleSVFIntegration::alias(
+                MemoryLocation::get(instIAsInst),
+                MemoryLocation::get(instJAsInst));
+          }
+          return NoelleSVFIntegration::alias(instI, instJ);
+        });
     switch (SVFAAResult) {
       case AliasResult::NoAlias:
         return AliasResult::NoAlias;
@@ -23,139 +23,186 @@
 #include "arcana/noelle/core/TalkDown.hpp"
 #include "arcana/noelle/core/PDGPrinter.hpp"
 #include "arcana/noelle/core/PDGGenerator.hpp"
+#include "arcana/noelle/core/PDGSerializer.hpp"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
 
 namespace arcana::noelle {
 
-MDNode *PDGGenerator::getEdgeMetadata(
-    DGEdge<Value, Value> *edge,
-    LLVMContext &C,
-    std::unordered_map<Value *, MDNode *> &nodeIDMap) {
-  assert(edge != nullptr);
+bool PDGGenerator::hasPDGAsMetadata(Module &M) {
+  if (auto n = M.getNamedMetadata("noelle.module.pdg")) {
+    if (auto m = dyn_cast<MDNode>(n->getOperand(0))) {
+      if (cast<MDString>(m->getOperand(0))->getString() == "true") {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+PDG *PDGGenerator::constructPDGFromMetadata(Module &M) {
+  if (verbose >= PDGVerbosity::Maximal) {
+    errs() << "PDGGenerator: Construct PDG from Metadata\n";
+  }
 
   /*
-   * Check if the dependence is a must.
+   * Create the PDG.
    */
-  auto isMust = isa<MustMemoryDependence<Value, Value>>(edge);
+  auto pdg = new PDG(M);
 
   /*
-   * Get the data dependence type.
+   * Fill up the PDG.
+   *
+   * Check if the memory dependences have been encoded by PDGSerializer.
+   * Otherwise, they have been embedded as metadata attached to the functions.
    */
-  std::string dataDepType{};
-  if (auto dataDep = dyn_cast<DataDependence<Value, Value>>(edge)) {
-    dataDepType = dataDep->dataDepToString();
+  if (auto edgesM = M.getNamedMetadata("noelle.module.pdg.edges")) {
+    if (!this->constructEdgesFromBinaryMetadata(pdg, M, edgesM)) {
+      delete pdg;
+      return nullptr;
+    }
+
   } else {
-    dataDepType = "NONE";
+    std::unordered_map<MDNode *, Value *> IDNodeMap;
+    for (auto &F : M) {
+      if (!constructNodesFromMetadata(pdg, F, IDNodeMap)) {
+        delete pdg;
+        return nullptr;
+      }
+      constructEdgesFromMetadata(pdg, F, IDNodeMap);
+    }
   }
 
-  Metadata *edgeM[] = {
-    nodeIDMap[edge->getSrc()],
-    nodeIDMap[edge->getDst()],
-    MDNode::get(
-        C,
-        MDString::get(
-            C,
-            isa<MemoryDependence<Value, Value>>(edge) ? "true" : "false")),
-    MDNode::get(C, MDString::get(C, isMust ? "true" : "false")),
-    MDNode::get(C, MDString::get(C, dataDepType)),
-    MDNode::get(
-        C,
-        MDString::get(
-            C,
-            isa<ControlDependence<Value, Value>>(edge) ? "true" : "false")),
-    MDNode::get(
-        C,
-        MDString::get(C, edge->isLoopCarriedDependence() ? "true" : "false")),
-    getSubEdgesMetadata(edge, C, nodeIDMap)
-  };
+  constructEdgesFromUseDefs(pdg);
+  constructEdgesFromControl(pdg, M);
 
-  return MDNode::get(C, edgeM);
+  return pdg;
 }
 
-MDNode *PDGGenerator::getSubEdgesMetadata(
-    DGEdge<Value, Value> *edge,
-    LLVMContext &C,
-    std::unordered_map<Value *, MDNode *> &nodeIDMap) {
-  std::vector<Metadata *> subEdgesVec;
+bool PDGGenerator::getValuesFromMetadata(Module &M,
+                                         std::vector<Value *> &values) {
 
   /*
-   * Check if the dependence is a must.
+   * An ID given to more than one value (e.g., an instruction cloned after the
+   * PDG has been embedded) makes the embedded PDG invalid.
    */
-  auto isMust = isa<MustMemoryDependence<Value, Value>>(edge);
-
-  /*
-   * Get the data dependence type.
-   */
-  std::string dataDepType{};
-  if (auto dataDep = dyn_cast<DataDependence<Value, Value>>(edge)) {
-    dataDepType = dataDep->dataDepToString();
-  } else {
-    dataDepType = "NONE";
-  }
+  auto isValid = true;
+  auto setValue = [&values, &isValid](Metadata *m, Value *v) {
+    auto idM = dyn_cast<MDNode>(m);
+    if ((idM == nullptr) || (idM->getNumOperands() != 1)) {
+      return;
+    }
+    auto id = mdconst::dyn_extract<ConstantInt>(idM->getOperand(0));
+    if (id == nullptr) {
+      return;
+    }
+    auto index = id->getZExtValue();
+    if (index >= values.size()) {
+      values.resize(index + 1, nullptr);
+    }
+    if (values[index] != nullptr) {
+      isValid = false;
+      return;
+    }
+    values[index] = v;
+  };
 
-  for (auto &subEdge : edge->getSubEdges()) {
-    Metadata *subEdgeM[] = {
-      nodeIDMap[subEdge->getSrc()],
-      nodeIDMap[subEdge->getDst()],
-      MDNode::get(
-          C,
-          MDString::get(
-              C,
-              isa<MemoryDependence<Value, Value>>(edge) ? "true" : "false")),
-      MDNode::get(C, MDString::get(C, isMust ? "true" : "false")),
-      MDNode::get(C, MDString::get(C, dataDepType)),
-      MDNode::get(
-          C,
-          MDString::get(
-              C,
-              isa<ControlDependence<Value, Value>>(edge) ? "true" : "false")),
-      MDNode::get(
-          C,
-          MDString::get(C, edge->isLoopCarriedDependence() ? "true" : "false")),
-    };
-    subEdgesVec.push_back(MDNode::get(C, subEdgeM));
-  }
+  for (auto &F : M) {
 
-  return MDTuple::get(C, subEdgesVec);
-}
+    /*
+     * Fetch the IDs of the arguments.
+     */
+    if (auto argsM = F.getMetadata("noelle.pdg.args.id")) {
+      for (auto &arg : F.args()) {
+        if (arg.getArgNo() < argsM->getNumOperands()) {
+          setValue(argsM->getOperand(arg.getArgNo()), &arg);
+        }
+      }
+    }
 
-bool PDGGenerator::hasPDGAsMetadata(Module &M) {
-  if (auto n = M.getNamedMetadata("noelle.module.pdg")) {
-    if (auto m = dyn_cast<MDNode>(n->getOperand(0))) {
-      if (cast<MDString>(m->getOperand(0))->getString() == "true") {
-        return true;
+    /*
+     * Fetch the IDs of the instructions.
+     */
+    for (auto &I : instructions(F)) {
+      if (auto m = I.getMetadata("noelle.pdg.inst.id")) {
+        setValue(m, &I);
       }
     }
   }
 
-  return false;
+  return isValid;
 }
 
-PDG *PDGGenerator::constructPDGFromMetadata(Module &M) {
-  if (verbose >= PDGVerbosity::Maximal) {
-    errs() << "PDGGenerator: Construct PDG from Metadata\n";
-  }
+bool PDGGenerator::constructEdgesFromBinaryMetadata(PDG *pdg,
+                                                    Module &M,
+                                                    NamedMDNode *edgesM) {
 
   /*
-   * Create the PDG.
+   * Fetch where the encoding is stored.
    */
-  auto pdg = new PDG(M);
+  if (edgesM->getNumOperands() != 1) {
+    return false;
+  }
+  auto m = edgesM->getOperand(0);
+  if (m->getNumOperands() != 2) {
+    return false;
+  }
+  auto location = dyn_cast<MDString>(m->getOperand(0));
+  auto content = dyn_cast<MDString>(m->getOperand(1));
+  if ((location == nullptr) || (content == nullptr)) {
+    return false;
+  }
 
   /*
-   * Fill up the PDG.
+   * Fetch the encoding.
+   * A file is mapped in memory.
    */
-  std::unordered_map<MDNode *, Value *> IDNodeMap;
-  for (auto &F : M) {
-    constructNodesFromMetadata(pdg, F, IDNodeMap);
-    constructEdgesFromMetadata(pdg, F, IDNodeMap);
+  StringRef data;
+  std::unique_ptr<MemoryBuffer> buffer;
+  if (location->getString() == "ir") {
+    data = content->getString();
+
+  } else if (location->getString() == "file") {
+
+    /*
+     * A relative path is relative to the directory of the bitcode.
+     */
+    SmallString<256> filePath(content->getString());
+    if (sys::path::is_relative(filePath)) {
+      SmallString<256> bitcodeDirectory(
+          sys::path::parent_path(M.getModuleIdentifier()));
+      sys::path::append(bitcodeDirectory, filePath);
+      filePath = bitcodeDirectory;
+    }
+    auto bufferOrError =
+        MemoryBuffer::getFile(filePath,
+                              /*IsText=*/false,
+                              /*RequiresNullTerminator=*/false);
+    if (!bufferOrError) {
+      errs() << "PDGGenerator: Warning = the file " << filePath
+             << " of the embedded PDG could not be read\n";
+      return false;
+    }
+    buffer = std::move(bufferOrError.get());
+    data = buffer->getBuffer();
+
+  } else {
+    return false;
   }
 
-  constructEdgesFromUseDefs(pdg);
-  constructEdgesFromControl(pdg, M);
+  /*
+   * Decode the memory dependences.
+   */
+  std::vector<Value *> values;
+  if (!this->getValuesFromMetadata(M, values)) {
+    return false;
+  }
 
-  return pdg;
+  return PDGSerializer::deserialize(data, pdg, values);
 }
 
-void PDGGenerator::constructNodesFromMetadata(
+bool PDGGenerator::constructNodesFromMetadata(
     PDG *pdg,
     Function &F,
     std::unordered_map<MDNode *, Value *> &IDNodeMap) {
@@ -173,16 +220,21 @@ void PDGGenerator::constructNodesFromMetadata(
 
   /*
    * Construct id to node map and add nodes of instructions to pdg
+   *
+   * An ID given to more than one instruction (e.g., an instruction cloned after
+   * the PDG has been embedded) makes the embedded PDG invalid.
    */
   for (auto &B : F) {
     for (auto &I : B) {
       if (MDNode *m = I.getMetadata("noelle.pdg.inst.id")) {
-        IDNodeMap[m] = &I;
+        if (!IDNodeMap.insert(std::make_pair(m, &I)).second) {
+          return false;
+        }
       }
     }
   }
 
-  return;
+  return true;
 }
 
 void PDGGenerator::constructEdgesFromMetadata(
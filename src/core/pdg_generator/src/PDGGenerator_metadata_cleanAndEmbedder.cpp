@@ -26,10 +26,10 @@
 
 namespace arcana::noelle {
 
-void PDGGenerator::cleanAndEmbedPDGAsMetadata(PDG *pdg) {
+bool PDGGenerator::cleanAndEmbedPDGAsMetadata(PDG *pdg,
+                                              const std::string &fileName) {
   this->cleanPDGMetadata();
-  this->embedPDGAsMetadata(pdg);
-  return;
+  return this->embedPDGAsMetadata(pdg, fileName);
 }
 
 } // namespace arcana::noelle
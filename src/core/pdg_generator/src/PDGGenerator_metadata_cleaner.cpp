@@ -49,6 +49,9 @@ void PDGGenerator::cleanPDGMetadata() {
   if (auto n = this->M.getNamedMetadata("noelle.module.pdg")) {
     this->M.eraseNamedMetadata(n);
   }
+  if (auto n = this->M.getNamedMetadata("noelle.module.pdg.edges")) {
+    this->M.eraseNamedMetadata(n);
+  }
 
   return;
 }
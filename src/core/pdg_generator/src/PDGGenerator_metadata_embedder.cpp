@@ -23,28 +23,33 @@
 #include "arcana/noelle/core/TalkDown.hpp"
 #include "arcana/noelle/core/PDGPrinter.hpp"
 #include "arcana/noelle/core/PDGGenerator.hpp"
+#include "arcana/noelle/core/PDGSerializer.hpp"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
 
 namespace arcana::noelle {
 
-void PDGGenerator::embedPDGAsMetadata(PDG *pdg) {
+bool PDGGenerator::embedPDGAsMetadata(PDG *pdg, const std::string &fileName) {
   errs() << "Embed PDG as metadata\n";
 
   auto &C = this->M.getContext();
-  std::unordered_map<Value *, MDNode *> nodeIDMap;
+  std::unordered_map<Value *, uint64_t> nodeIDMap;
 
   embedNodesAsMetadata(pdg, C, nodeIDMap);
-  embedEdgesAsMetadata(pdg, C, nodeIDMap);
+  if (!embedEdgesAsMetadata(pdg, C, nodeIDMap, fileName)) {
+    return false;
+  }
 
   auto n = this->M.getOrInsertNamedMetadata("noelle.module.pdg");
   n->addOperand(MDNode::get(C, MDString::get(C, "true")));
 
-  return;
+  return true;
 }
 
 void PDGGenerator::embedNodesAsMetadata(
     PDG *pdg,
     LLVMContext &C,
-    std::unordered_map<Value *, MDNode *> &nodeIDMap) {
+    std::unordered_map<Value *, uint64_t> &nodeIDMap) {
   uint64_t i = 0;
   std::unordered_map<Function *, std::unordered_map<uint64_t, Metadata *>>
       functionArgsIDMap;
@@ -58,7 +63,7 @@ void PDGGenerator::embedNodesAsMetadata(
     /*
      * Compute its ID.
      */
-    auto id = ConstantInt::get(Type::getInt64Ty(C), i++);
+    auto id = ConstantInt::get(Type::getInt64Ty(C), i);
 
     /*
      * Wrap its ID into a metadata node.
@@ -82,7 +87,7 @@ void PDGGenerator::embedNodesAsMetadata(
        */
       inst->setMetadata("noelle.pdg.inst.id", m);
     }
-    nodeIDMap[v] = m;
+    nodeIDMap[v] = i++;
   }
 
   /*
@@ -101,46 +106,72 @@ void PDGGenerator::embedNodesAsMetadata(
   return;
 }
 
-void PDGGenerator::embedEdgesAsMetadata(
+bool PDGGenerator::embedEdgesAsMetadata(
     PDG *pdg,
     LLVMContext &C,
-    std::unordered_map<Value *, MDNode *> &nodeIDMap) {
-  std::unordered_map<Function *, std::vector<Metadata *>> functionEdgesMap;
+    std::unordered_map<Value *, uint64_t> &nodeIDMap,
+    const std::string &fileName) {
 
   /*
-   * Construct edge metadata
+   * Fetch the memory dependences.
+   * The other dependences are computed from the IR when the PDG is loaded.
    */
+  std::vector<DGEdge<Value, Value> *> memoryDependences;
   for (auto &edge : pdg->getSortedDependences()) {
-
-    /*
-     * Fetch the next memory dependence.
-     */
     if (!isa<MemoryDependence<Value, Value>>(edge)) {
       continue;
     }
-
-    /*
-     * Embed the current memory dependence into the IR.
-     */
-    auto edgeM = this->getEdgeMetadata(edge, C, nodeIDMap);
-    if (auto arg = dyn_cast<Argument>(edge->getSrc())) {
-      functionEdgesMap[arg->getParent()].push_back(edgeM);
-    } else if (auto inst = dyn_cast<Instruction>(edge->getSrc())) {
-      functionEdgesMap[inst->getFunction()].push_back(edgeM);
-    } else {
+    if (!isa<Argument>(edge->getSrc()) && !isa<Instruction>(edge->getSrc())) {
       abort();
     }
+    memoryDependences.push_back(edge);
   }
 
   /*
-   * Embed metadata of edges to function
+   * Encode the memory dependences.
+   */
+  auto data = PDGSerializer::serialize(memoryDependences, nodeIDMap);
+
+  /*
+   * Store the encoding in the IR or in the file.
    */
-  for (auto &funEdge : functionEdgesMap) {
-    auto m = MDTuple::get(C, funEdge.second);
-    funEdge.first->setMetadata("noelle.pdg.edges", m);
+  MDString *location = nullptr;
+  MDString *content = nullptr;
+  if (fileName.empty()) {
+    location = MDString::get(C, "ir");
+    content = MDString::get(C, data);
+
+  } else {
+
+    /*
+     * The path is stored as an absolute one, so the file can be found no
+     * matter the directory the bitcode is loaded from.
+     */
+    SmallString<256> filePath(fileName);
+    if (sys::fs::make_absolute(filePath)) {
+      return false;
+    }
+    sys::path::remove_dots(filePath, /*remove_dot_dot=*/true);
+
+    std::error_code EC;
+    raw_fd_ostream file(filePath, EC, sys::fs::OF_None);
+    if (EC) {
+      return false;
+    }
+    file << data;
+    file.close();
+    if (file.has_error()) {
+      file.clear_error();
+      return false;
+    }
+    location = MDString::get(C, "file");
+    content = MDString::get(C, filePath);
   }
+  Metadata *edgesM[] = { location, content };
+  auto n = this->M.getOrInsertNamedMetadata("noelle.module.pdg.edges");
+  n->addOperand(MDNode::get(C, edgesM));
 
-  return;
+  return true;
 }
 
 } // namespace arcana::noelle
@@ -0,0 +1,215 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Yian Su, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <numeric>
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/PDGGenerator.hpp"
+#include "IntegrationWithSVF.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Identifiers of the alias analyses in the dependence query cache.
+ */
+static const std::string LLVMAliasAnalysesName = "LLVM AA";
+static const std::string SVFName = "SVF";
+
+PDGVerbosity PDGGenerator::getVerbosity(void) const {
+  return this->verbose;
+}
+
+void PDGGenerator::setDependenceQueryCache(DependenceQueryCache *cache) {
+  this->queryCache = cache;
+
+  return;
+}
+
+void PDGGenerator::setInstructionReachabilityCache(
+    InstructionReachabilityCache *cache) {
+  this->reachabilityCache = cache;
+
+  return;
+}
+
+uint8_t PDGGenerator::queryTheCache(DependenceQueryCache::QueryKind kind,
+                                    const void *analysis,
+                                    const std::string &analysisName,
+                                    const Value *from,
+                                    const Value *to,
+                                    const Value *context,
+                                    uint8_t parameter,
+                                    std::function<uint8_t(void)> answer) {
+
+  /*
+   * Check if answers are memoized.
+   */
+  if (this->queryCache == nullptr) {
+    return answer();
+  }
+
+  /*
+   * Fetch the answer.
+   */
+  auto id = this->queryCache->getAnalysisID(analysis, analysisName);
+  DependenceQueryCache::Query query{ kind, id, from, to, context, parameter };
+
+  return this->queryCache->query(query, answer);
+}
+
+std::vector<uint8_t> PDGGenerator::queryTheCache(
+    const std::vector<DependenceQueryCache::Query> &queries,
+    std::function<std::vector<uint8_t>(
+        const std::vector<uint64_t> &queryIndexes)> answer) {
+
+  /*
+   * Check if answers are memoized.
+   */
+  if (this->queryCache != nullptr) {
+    return this->queryCache->queryAll(queries, answer);
+  }
+
+  /*
+   * Compute all answers.
+   */
+  std::vector<uint64_t> queryIndexes(queries.size());
+  std::iota(queryIndexes.begin(), queryIndexes.end(), 0);
+
+  return answer(queryIndexes);
+}
+
+AliasResult PDGGenerator::alias(const void *analysis,
+                                const std::string &analysisName,
+                                Value *v1,
+                                Value *v2,
+                                std::function<AliasResult(void)> answer) {
+
+  /*
+   * Aliasing is symmetric: the same answer is used for both orders.
+   */
+  if (std::less<Value *>{}(v2, v1)) {
+    std::swap(v1, v2);
+  }
+  auto r = this->queryTheCache(DependenceQueryCache::ALIAS,
+                               analysis,
+                               analysisName,
+                               v1,
+                               v2,
+                               nullptr,
+                               0,
+                               [&answer](void) -> uint8_t {
+                                 AliasResult::Kind k = answer();
+                                 return static_cast<uint8_t>(k);
+                               });
+
+  return AliasResult(static_cast<AliasResult::Kind>(r));
+}
+
+ModRefInfo PDGGenerator::getModRefInfo(AAResults &AA,
+                                       CallBase *call,
+                                       Instruction *inst) {
+  auto r = this->queryTheCache(
+      DependenceQueryCache::MOD_REF_LOCATION,
+      &AAResultsWrapperPass::ID,
+      LLVMAliasAnalysesName,
+      call,
+      inst,
+      nullptr,
+      0,
+      [&AA, call, inst](void) -> uint8_t {
+        return static_cast<uint8_t>(
+            AA.getModRefInfo(call, MemoryLocation::get(inst)));
+      });
+
+  return static_cast<ModRefInfo>(r);
+}
+
+ModRefInfo PDGGenerator::getModRefInfo(AAResults &AA,
+                                       CallBase *call,
+                                       CallBase *otherCall) {
+  auto r = this->queryTheCache(
+      DependenceQueryCache::MOD_REF_CALL,
+      &AAResultsWrapperPass::ID,
+      LLVMAliasAnalysesName,
+      call,
+      otherCall,
+      nullptr,
+      0,
+      [&AA, call, otherCall](void) -> uint8_t {
+        return static_cast<uint8_t>(AA.getModRefInfo(call, otherCall));
+      });
+
+  return static_cast<ModRefInfo>(r);
+}
+
+ModRefInfo PDGGenerator::getSVFModRefInfo(CallBase *call) {
+  auto r = this->queryTheCache(
+      DependenceQueryCache::MOD_REF_CALL,
+      &NoelleSVFIntegration::ID,
+      SVFName,
+      call,
+      nullptr,
+      nullptr,
+      0,
+      [call](void) -> uint8_t {
+        return static_cast<uint8_t>(NoelleSVFIntegration::getModRefInfo(call));
+      });
+
+  return static_cast<ModRefInfo>(r);
+}
+
+ModRefInfo PDGGenerator::getSVFModRefInfo(CallBase *call, Instruction *inst) {
+  auto r = this->queryTheCache(
+      DependenceQueryCache::MOD_REF_LOCATION,
+      &NoelleSVFIntegration::ID,
+      SVFName,
+      call,
+      inst,
+      nullptr,
+      0,
+      [call, inst](void) -> uint8_t {
+        return static_cast<uint8_t>(
+            NoelleSVFIntegration::getModRefInfo(call,
+                                                MemoryLocation::get(inst)));
+      });
+
+  return static_cast<ModRefInfo>(r);
+}
+
+ModRefInfo PDGGenerator::getSVFModRefInfo(CallBase *call,
+                                          CallBase *otherCall) {
+  auto r = this->queryTheCache(
+      DependenceQueryCache::MOD_REF_CALL,
+      &NoelleSVFIntegration::ID,
+      SVFName,
+      call,
+      otherCall,
+      nullptr,
+      0,
+      [call, otherCall](void) -> uint8_t {
+        return static_cast<uint8_t>(
+            NoelleSVFIntegration::getModRefInfo(call, otherCall));
+      });
+
+  return static_cast<ModRefInfo>(r);
+}
+
+} // namespace arcana::noelle
@@ -0,0 +1,504 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Yian Su, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/PDGGenerator.hpp"
+#include "llvm/Analysis/PostDominators.h"
+
+namespace arcana::noelle {
+
+void PDGGenerator::setFunctionDependenceGraphCache(
+    FunctionDependenceGraphCache *cache) {
+  this->fdgCache = cache;
+
+  return;
+}
+
+void PDGGenerator::codeModified(
+    Function &F,
+    const std::unordered_set<Instruction *> &modifiedInstructions) {
+
+  /*
+   * Drop what has been derived from the old code of the function.
+   */
+  if (this->fdgCache != nullptr) {
+    this->fdgCache->invalidate(F);
+  }
+  if (this->queryCache != nullptr) {
+    this->queryCache->invalidate(F);
+  }
+  if (this->reachabilityCache != nullptr) {
+    this->reachabilityCache->invalidate(F);
+  }
+
+  /*
+   * The calls that can reach @F execute its new code.
+   * Hence, the dependence graphs of their functions and the answers about
+   * them are stale as well.
+   */
+  auto callsThatReachF = this->getCallsThatCanReach(F);
+  for (auto &[caller, calls] : callsThatReachF) {
+    if (this->fdgCache != nullptr) {
+      this->fdgCache->invalidate(*caller);
+    }
+    if (this->queryCache != nullptr) {
+      this->queryCache->invalidate(*caller);
+    }
+  }
+
+  /*
+   * Check if the PDG has been computed.
+   */
+  auto pdg = this->programDependenceGraph;
+  if (pdg == nullptr) {
+    return;
+  }
+
+  /*
+   * Remove the nodes of the erased instructions of every function.
+   * This must happen before adding new nodes because a new instruction can
+   * reuse the memory of an erased one.
+   */
+  this->removeNodesOfErasedInstructions(pdg);
+
+  /*
+   * Check if an instruction of @F has been erased.
+   * In this case, the memory dependences of all instructions need to be
+   * computed again.
+   */
+  auto wasAnInstructionErased =
+      (this->functionsWithErasedInstructions.erase(&F) > 0);
+
+  /*
+   * Add the nodes of the new instructions (i.e., the ones without a handle).
+   * The memory dependences of the new and the modified instructions need to
+   * be computed.
+   */
+  std::unordered_set<Instruction *> instructionsToCheck;
+  for (auto &I : instructions(F)) {
+    if (this->instructionHandles.find(&I) == this->instructionHandles.end()) {
+      pdg->addNode(&I, /*inclusion=*/true);
+      instructionsToCheck.insert(&I);
+      continue;
+    }
+    if (wasAnInstructionErased || (modifiedInstructions.count(&I) > 0)) {
+      instructionsToCheck.insert(&I);
+    }
+  }
+
+  /*
+   * The recursive calls of @F are modified as well.
+   */
+  auto recursiveCalls = callsThatReachF.find(&F);
+  if (recursiveCalls != callsThatReachF.end()) {
+    for (auto call : recursiveCalls->second) {
+      instructionsToCheck.insert(call);
+    }
+    callsThatReachF.erase(recursiveCalls);
+  }
+  this->trackInstructionsOf(F);
+  if (this->verbose >= PDGVerbosity::Maximal) {
+    errs() << "PDGGenerator: Update the PDG of " << F.getName() << " ("
+           << instructionsToCheck.size() << " instructions to check)\n";
+  }
+
+  /*
+   * Update the dependences.
+   */
+  this->updateVariableAndControlDependences(pdg, F);
+  this->updateMemoryDependences(pdg, F, instructionsToCheck);
+  for (auto &[caller, calls] : callsThatReachF) {
+    this->updateMemoryDependences(pdg, *caller, calls);
+  }
+  pdg->freeze();
+
+  /*
+   * Check the updated PDG.
+   */
+  if (this->performThePDGComparison) {
+    this->checkTheUpdatedPDG(F);
+  }
+
+  return;
+}
+
+void PDGGenerator::codeModified(Function &F) {
+  std::unordered_set<Instruction *> allInstructions;
+  for (auto &I : instructions(F)) {
+    allInstructions.insert(&I);
+  }
+  this->codeModified(F, allInstructions);
+
+  return;
+}
+
+void PDGGenerator::instructionMoved(Instruction *inst) {
+  assert(inst != nullptr);
+
+  this->codeModified(*inst->getFunction(), { inst });
+
+  return;
+}
+
+void PDGGenerator::instructionCloned(Instruction *clone) {
+  assert(clone != nullptr);
+
+  this->codeModified(*clone->getFunction(), { clone });
+
+  return;
+}
+
+void PDGGenerator::basicBlockSplit(BasicBlock *original,
+                                   BasicBlock *newBlock) {
+  assert(original != nullptr);
+  assert(newBlock != nullptr);
+  assert(original->getParent() == newBlock->getParent());
+
+  /*
+   * The instructions keep their order, so only the new terminator and the
+   * control dependences need to be computed.
+   */
+  this->codeModified(*original->getParent(), {});
+
+  return;
+}
+
+void PDGGenerator::loopWhilified(
+    Function &F,
+    const std::unordered_set<Instruction *> &loopInstructions) {
+
+  /*
+   * Some of the instructions of the loop might have been erased.
+   * Only the instructions that are still in @F are considered by codeModified.
+   */
+  this->codeModified(F, loopInstructions);
+
+  return;
+}
+
+void PDGGenerator::loopUnrolled(
+    Function &F,
+    const std::unordered_set<Instruction *> &loopInstructions) {
+  this->loopWhilified(F, loopInstructions);
+
+  return;
+}
+
+PDGGenerator::InstructionHandle::InstructionHandle(Instruction *inst,
+                                                   PDGGenerator *generator)
+  : CallbackVH(inst),
+    inst{ inst },
+    function{ inst->getFunction() },
+    generator{ generator } {
+  return;
+}
+
+void PDGGenerator::InstructionHandle::deleted(void) {
+
+  /*
+   * Record the erasure.
+   * The PDG is not modified here because the code that erases the instruction
+   * might be iterating over it.
+   */
+  auto generator = this->generator;
+  auto inst = this->inst;
+  generator->erasedInstructions.insert(inst);
+  generator->functionsWithErasedInstructions.insert(this->function);
+
+  /*
+   * Destroy the handle.
+   * This must be the last use of the handle.
+   */
+  generator->instructionHandles.erase(inst);
+
+  return;
+}
+
+void PDGGenerator::trackInstructionsOf(Function &F) {
+  for (auto &I : instructions(F)) {
+    if (this->instructionHandles.find(&I) != this->instructionHandles.end()) {
+      continue;
+    }
+    this->instructionHandles[&I] =
+        std::make_unique<InstructionHandle>(&I, this);
+  }
+
+  return;
+}
+
+void PDGGenerator::removeNodesOfErasedInstructions(PDG *pdg) {
+
+  /*
+   * The erased instructions no longer exist, so they are only used as keys.
+   */
+  for (auto inst : this->erasedInstructions) {
+    if (!pdg->isInternal(inst)) {
+      continue;
+    }
+    pdg->removeNode(pdg->fetchNode(inst));
+  }
+  this->erasedInstructions.clear();
+
+  return;
+}
+
+void PDGGenerator::updateVariableAndControlDependences(PDG *pdg, Function &F) {
+
+  /*
+   * Fetch the values of the function.
+   */
+  std::vector<Value *> values;
+  for (auto &arg : F.args()) {
+    values.push_back(&arg);
+  }
+  for (auto &I : instructions(F)) {
+    values.push_back(&I);
+  }
+
+  /*
+   * Remove the variable and control dependences of the function.
+   */
+  std::unordered_set<DGEdge<Value, Value> *> edgesToRemove;
+  for (auto v : values) {
+    for (auto edge : pdg->fetchNode(v)->getAllEdges()) {
+      if (isa<VariableDependence<Value, Value>>(edge)
+          || isa<ControlDependence<Value, Value>>(edge)) {
+        edgesToRemove.insert(edge);
+      }
+    }
+  }
+  for (auto edge : edgesToRemove) {
+    pdg->removeEdge(edge);
+  }
+
+  /*
+   * Add the dependences due to variables.
+   */
+  for (auto v : values) {
+    for (auto &U : v->uses()) {
+      auto user = U.getUser();
+      if (isa<Instruction>(user) || isa<Argument>(user)) {
+        pdg->addVariableDataDependenceEdge(v, user, DG_DATA_RAW);
+      }
+    }
+  }
+
+  /*
+   * Add the control dependences.
+   * The post-dominator tree provided by the pass manager might not reflect the
+   * modified code, so a new one is computed.
+   */
+  PostDominatorTree postDomTree(F);
+  auto controlDependences =
+      this->computeControlDependencesOfFunction(F, postDomTree);
+  for (auto &[src, dst] : controlDependences) {
+    pdg->addControlDependenceEdge(src, dst);
+  }
+
+  return;
+}
+
+void PDGGenerator::updateMemoryDependences(
+    PDG *pdg,
+    Function &F,
+    const std::unordered_set<Instruction *> &modifiedInstructions) {
+  if (modifiedInstructions.empty()) {
+    return;
+  }
+
+  /*
+   * Remove the memory dependences of the modified instructions.
+   */
+  auto removeMemoryDependences =
+      [pdg, &modifiedInstructions](
+          std::function<bool(DGEdge<Value, Value> *)> shouldBeRemoved) {
+        std::unordered_set<DGEdge<Value, Value> *> edgesToRemove;
+        for (auto inst : modifiedInstructions) {
+          for (auto edge : pdg->fetchNode(inst)->getAllEdges()) {
+            if (isa<MemoryDependence<Value, Value>>(edge)
+                && shouldBeRemoved(edge)) {
+              edgesToRemove.insert(edge);
+            }
+          }
+        }
+        for (auto edge : edgesToRemove) {
+          pdg->removeEdge(edge);
+        }
+      };
+  removeMemoryDependences(
+      [](DGEdge<Value, Value> *edge) -> bool { return true; });
+
+  /*
+   * Compute the memory dependences of the pairs of instructions that include
+   * a modified one.
+   */
+  auto reachability = this->getReachability(F);
+  this->constructEdgesFromAliasesForFunction(pdg,
+                                             F,
+                                             reachability.get(),
+                                             &modifiedInstructions);
+
+  /*
+   * Trim the new memory dependences as it is done for the whole PDG.
+   */
+  if (!this->disableAllocAA) {
+    this->mpa = MayPointsToAnalysis{};
+    removeMemoryDependences([this, pdg](DGEdge<Value, Value> *edge) -> bool {
+      return this->canEdgeBeRemovedByParSchemes(pdg, edge);
+    });
+  }
+
+  return;
+}
+
+std::unordered_map<Function *, std::unordered_set<Instruction *>> PDGGenerator::
+    getCallsThatCanReach(Function &F) {
+  std::unordered_map<Function *, std::unordered_set<Instruction *>> calls;
+
+  /*
+   * Fetch the indirect calls of the program.
+   * They can invoke every function whose address is taken.
+   */
+  std::vector<CallBase *> indirectCalls;
+  auto collected = false;
+  auto collectIndirectCalls = [this, &indirectCalls, &collected]() {
+    if (collected) {
+      return;
+    }
+    collected = true;
+    for (auto &otherF : this->M) {
+      for (auto &I : instructions(otherF)) {
+        auto call = dyn_cast<CallBase>(&I);
+        if ((call != nullptr) && (call->getCalledFunction() == nullptr)
+            && (!call->isInlineAsm())) {
+          indirectCalls.push_back(call);
+        }
+      }
+    }
+  };
+
+  /*
+   * Visit the functions that can reach @F, from the callers of @F up.
+   */
+  std::unordered_set<Function *> reached{ &F };
+  std::vector<Function *> toVisit{ &F };
+  auto addCall = [&calls, &reached, &toVisit](CallBase *call) {
+    auto caller = call->getFunction();
+    calls[caller].insert(call);
+    if (reached.insert(caller).second) {
+      toVisit.push_back(caller);
+    }
+  };
+  while (!toVisit.empty()) {
+    auto callee = toVisit.back();
+    toVisit.pop_back();
+
+    /*
+     * Direct calls.
+     */
+    for (auto user : callee->users()) {
+      if (auto call = dyn_cast<CallBase>(user)) {
+        if (call->getCalledOperand() == callee) {
+          addCall(call);
+        }
+      }
+    }
+
+    /*
+     * Indirect calls.
+     */
+    if (callee->hasAddressTaken()) {
+      collectIndirectCalls();
+      for (auto call : indirectCalls) {
+        addCall(call);
+      }
+    }
+  }
+
+  return calls;
+}
+
+PDG *PDGGenerator::constructPDGFromScratch(void) {
+
+  /*
+   * Disable everything that could carry answers computed before: the on-disk
+   * cache, the cache of the answers of the analyses, and the cache of the
+   * reachability of instructions.
+   * The PDG is computed serially considering all pairs of memory
+   * instructions.
+   */
+  auto threads = this->numberOfThreads;
+  auto cacheFileName = this->cacheFileName;
+  auto sparseMemoryCandidates = this->sparseMemoryCandidates;
+  auto queryCache = this->queryCache;
+  auto reachabilityCache = this->reachabilityCache;
+  auto pairQueries = this->numberOfMemoryPairQueries;
+  auto prunedPairs = this->numberOfPrunedMemoryPairs;
+  this->numberOfThreads = 1;
+  this->cacheFileName = "";
+  this->sparseMemoryCandidates = false;
+  this->queryCache = nullptr;
+  this->reachabilityCache = nullptr;
+
+  /*
+   * Compute the PDG.
+   */
+  auto pdg = this->constructPDGFromAnalysis(this->M);
+
+  /*
+   * Restore the configuration and the statistics.
+   */
+  this->numberOfThreads = threads;
+  this->cacheFileName = cacheFileName;
+  this->sparseMemoryCandidates = sparseMemoryCandidates;
+  this->queryCache = queryCache;
+  this->reachabilityCache = reachabilityCache;
+  this->numberOfMemoryPairQueries = pairQueries;
+  this->numberOfPrunedMemoryPairs = prunedPairs;
+
+  return pdg;
+}
+
+void PDGGenerator::checkTheUpdatedPDG(Function &F) {
+
+  /*
+   * Compute the PDG from scratch.
+   */
+  auto pdgFromScratch = this->constructPDGFromScratch();
+
+  /*
+   * Compare the PDGs.
+   */
+  auto arePDGsEquivalent =
+      this->comparePDGs(pdgFromScratch, this->programDependenceGraph);
+  if (!arePDGsEquivalent) {
+    errs() << "PDGGenerator: Error = the PDG updated after modifying "
+           << F.getName()
+           << " (including the calls that can reach it) is not the same as"
+           << " the one computed from scratch\n";
+    abort();
+  }
+  delete pdgFromScratch;
+
+  return;
+}
+
+} // namespace arcana::noelle
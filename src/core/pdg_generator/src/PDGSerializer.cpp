@@ -0,0 +1,323 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Yian Su, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/PDGSerializer.hpp"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/LEB128.h"
+
+namespace arcana::noelle {
+
+/*
+ * Layout of the encoding:
+ *
+ *   header:      magic (8 bytes), version (4, little endian), number of
+ *                dependences (ULEB128)
+ *   dependence:  source ID as a delta from the source ID of the previous
+ *                dependence (ULEB128), destination ID as a delta from the
+ *                source ID (SLEB128), attributes (1), and, if the attributes
+ *                say so, the number of sub-dependences (ULEB128) followed by
+ *                the sub-dependences
+ *   sub-dependence: source ID as a delta from the source ID of its dependence
+ *                (SLEB128), destination ID as a delta from its source ID
+ *                (SLEB128), attributes (1)
+ *
+ * The attributes are the kind of the dependence (2 bits), its data dependence
+ * type (2 bits), whether it is loop-carried (1 bit), and whether it has
+ * sub-dependences (1 bit).
+ */
+static const char serializerMagic[] = "NOELLEPD";
+static const uint32_t headerSize = 12;
+static const uint8_t variableKind = 0;
+static const uint8_t mayMemoryKind = 1;
+static const uint8_t mustMemoryKind = 2;
+static const uint8_t controlKind = 3;
+static const uint8_t kindMask = 3;
+static const uint8_t dataDependenceTypeShift = 2;
+static const uint8_t dataDependenceTypeMask = 3;
+static const uint8_t loopCarriedFlag = 16;
+static const uint8_t subDependencesFlag = 32;
+
+const uint32_t PDGSerializer::version = 1;
+
+static uint8_t encodeAttributes(DGEdge<Value, Value> *dep) {
+  uint8_t attributes = 0;
+
+  /*
+   * Encode the kind of the dependence.
+   */
+  if (isa<ControlDependence<Value, Value>>(dep)) {
+    attributes = controlKind;
+  } else if (isa<MustMemoryDependence<Value, Value>>(dep)) {
+    attributes = mustMemoryKind;
+  } else if (isa<MemoryDependence<Value, Value>>(dep)) {
+    attributes = mayMemoryKind;
+  } else {
+    attributes = variableKind;
+  }
+
+  /*
+   * Encode the type of data dependence.
+   */
+  if (auto dataDep = dyn_cast<DataDependence<Value, Value>>(dep)) {
+    attributes |= (dataDep->getDataDependenceType()
+                   << dataDependenceTypeShift);
+  }
+
+  /*
+   * Encode the flags.
+   */
+  if (dep->isLoopCarriedDependence()) {
+    attributes |= loopCarriedFlag;
+  }
+  if (dep->getNumberOfSubEdges() > 0) {
+    attributes |= subDependencesFlag;
+  }
+
+  return attributes;
+}
+
+/*
+ * Allocate a dependence that does not belong to any graph.
+ * Return nullptr if @attributes is not valid.
+ */
+static DGEdge<Value, Value> *createDependence(PDG *pdg,
+                                              Value *src,
+                                              Value *dst,
+                                              uint8_t attributes) {
+  auto dataDepTypeID =
+      (attributes >> dataDependenceTypeShift) & dataDependenceTypeMask;
+  if (dataDepTypeID > DG_DATA_WAW) {
+    return nullptr;
+  }
+  auto dataDepType = static_cast<DataDependenceType>(dataDepTypeID);
+  auto srcNode = pdg->fetchNode(src);
+  auto dstNode = pdg->fetchNode(dst);
+
+  DGEdge<Value, Value> *dep = nullptr;
+  switch (attributes & kindMask) {
+    case variableKind:
+      dep = new VariableDependence<Value, Value>(srcNode, dstNode, dataDepType);
+      break;
+    case mayMemoryKind:
+      dep =
+          new MayMemoryDependence<Value, Value>(srcNode, dstNode, dataDepType);
+      break;
+    case mustMemoryKind:
+      dep =
+          new MustMemoryDependence<Value, Value>(srcNode, dstNode, dataDepType);
+      break;
+    default:
+      dep = new ControlDependence<Value, Value>(srcNode, dstNode);
+      break;
+  }
+  dep->setLoopCarried((attributes & loopCarriedFlag) != 0);
+
+  return dep;
+}
+
+std::string PDGSerializer::serialize(
+    const std::vector<DGEdge<Value, Value> *> &dependences,
+    const std::unordered_map<Value *, uint64_t> &valueIDs) {
+  std::string data;
+  raw_string_ostream os(data);
+
+  /*
+   * Sort the dependences by their IDs, so consecutive dependences have close
+   * IDs.
+   */
+  std::vector<std::tuple<uint64_t, uint64_t, DGEdge<Value, Value> *>> sorted;
+  for (auto dep : dependences) {
+    sorted.push_back(std::make_tuple(valueIDs.at(dep->getSrc()),
+                                     valueIDs.at(dep->getDst()),
+                                     dep));
+  }
+  std::stable_sort(sorted.begin(),
+                   sorted.end(),
+                   [](auto &t1, auto &t2) {
+                     return std::make_pair(std::get<0>(t1), std::get<1>(t1))
+                            < std::make_pair(std::get<0>(t2), std::get<1>(t2));
+                   });
+
+  /*
+   * Encode the header.
+   */
+  char field[4];
+  os.write(serializerMagic, 8);
+  support::endian::write32le(field, PDGSerializer::version);
+  os.write(field, 4);
+  encodeULEB128(sorted.size(), os);
+
+  /*
+   * Encode the dependences.
+   */
+  uint64_t previousSrcID = 0;
+  for (auto &t : sorted) {
+    auto srcID = std::get<0>(t);
+    auto dstID = std::get<1>(t);
+    auto dep = std::get<2>(t);
+    encodeULEB128(srcID - previousSrcID, os);
+    encodeSLEB128((int64_t)(dstID - srcID), os);
+    auto attributes = encodeAttributes(dep);
+    os << (char)attributes;
+    previousSrcID = srcID;
+
+    /*
+     * Encode the sub-dependences.
+     */
+    if ((attributes & subDependencesFlag) == 0) {
+      continue;
+    }
+    encodeULEB128(dep->getNumberOfSubEdges(), os);
+    for (auto subDep : dep->getSubEdges()) {
+      auto subSrcID = valueIDs.at(subDep->getSrc());
+      auto subDstID = valueIDs.at(subDep->getDst());
+      encodeSLEB128((int64_t)(subSrcID - srcID), os);
+      encodeSLEB128((int64_t)(subDstID - subSrcID), os);
+      os << (char)(encodeAttributes(subDep) & ~subDependencesFlag);
+    }
+  }
+
+  return os.str();
+}
+
+bool PDGSerializer::deserialize(StringRef data,
+                                PDG *pdg,
+                                const std::vector<Value *> &values) {
+  assert(pdg != nullptr);
+  auto current = data.bytes_begin();
+  auto end = data.bytes_end();
+
+  /*
+   * Check the header.
+   */
+  if (data.size() < headerSize) {
+    return false;
+  }
+  if (std::memcmp(current, serializerMagic, 8) != 0) {
+    return false;
+  }
+  if (support::endian::read32le(current + 8) != PDGSerializer::version) {
+    return false;
+  }
+  current += headerSize;
+
+  /*
+   * Define the readers of the fields.
+   */
+  auto isValid = true;
+  auto readUnsigned = [&current, end, &isValid](void) -> uint64_t {
+    unsigned length = 0;
+    const char *error = nullptr;
+    auto value = decodeULEB128(current, &length, end, &error);
+    if (error != nullptr) {
+      isValid = false;
+      return 0;
+    }
+    current += length;
+    return value;
+  };
+  auto readSigned = [&current, end, &isValid](void) -> int64_t {
+    unsigned length = 0;
+    const char *error = nullptr;
+    auto value = decodeSLEB128(current, &length, end, &error);
+    if (error != nullptr) {
+      isValid = false;
+      return 0;
+    }
+    current += length;
+    return value;
+  };
+  auto readByte = [&current, end, &isValid](void) -> uint8_t {
+    if (current == end) {
+      isValid = false;
+      return 0;
+    }
+    return *(current++);
+  };
+  auto fetchValue = [&values, &isValid](uint64_t id) -> Value * {
+    if ((id >= values.size()) || (values[id] == nullptr)) {
+      isValid = false;
+      return nullptr;
+    }
+    return values[id];
+  };
+
+  /*
+   * Decode the dependences.
+   */
+  auto numberOfDependences = readUnsigned();
+  uint64_t srcID = 0;
+  for (auto i = 0u; isValid && (i < numberOfDependences); i++) {
+    srcID += readUnsigned();
+    uint64_t dstID = srcID + readSigned();
+    auto attributes = readByte();
+    auto src = fetchValue(srcID);
+    auto dst = fetchValue(dstID);
+    if (!isValid) {
+      return false;
+    }
+    auto dep = createDependence(pdg, src, dst, attributes);
+    if (dep == nullptr) {
+      return false;
+    }
+
+    /*
+     * Decode the sub-dependences.
+     */
+    if ((attributes & subDependencesFlag) != 0) {
+      auto numberOfSubDependences = readUnsigned();
+      for (auto j = 0u; isValid && (j < numberOfSubDependences); j++) {
+        uint64_t subSrcID = srcID + readSigned();
+        uint64_t subDstID = subSrcID + readSigned();
+        auto subAttributes = readByte();
+        auto subSrc = fetchValue(subSrcID);
+        auto subDst = fetchValue(subDstID);
+        if (!isValid) {
+          break;
+        }
+        auto subDep = createDependence(pdg, subSrc, subDst, subAttributes);
+        if (subDep == nullptr) {
+          isValid = false;
+          break;
+        }
+        dep->addSubEdge(subDep);
+      }
+    }
+
+    /*
+     * Add the dependence to the PDG.
+     */
+    if (isValid) {
+      pdg->copyAddEdge(*dep);
+    }
+    delete dep;
+  }
+  if (!isValid) {
+    return false;
+  }
+
+  /*
+   * The whole buffer must have been consumed.
+   */
+  return current == end;
+}
+
+} // namespace arcana::noelle
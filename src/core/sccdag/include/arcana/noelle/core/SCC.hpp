@@ -29,6 +29,18 @@ namespace arcana::noelle {
 
 /*
  * Strongly Connected Component
+ *
+ * An SCC starts as a view of the dependence graph it has been computed from:
+ * its nodes and dependences are the ones of that graph, which must outlive the
+ * SCC.
+ * The nodes of the SCC are its internal nodes and the nodes they depend on (or
+ * that depend on them), which are the external nodes of the SCC.
+ * Notice that the dependences of a node of a view include the ones with nodes
+ * outside the SCC: only getEdges() is limited to the dependences of the SCC
+ * (see isDependenceOfSCC).
+ *
+ * The nodes and dependences are copied (materialize) the first time the SCC is
+ * modified through the methods below.
  */
 class SCC : public DG<Value> {
 public:
@@ -39,6 +51,35 @@ public:
   SCC(std::set<DGNode<Value> *> internalNodes,
       std::set<DGNode<Value> *> externalNodes);
 
+  /*
+   * Check if the nodes and dependences of the SCC are the ones of the graph it
+   * has been computed from.
+   */
+  bool isView(void) const;
+
+  /*
+   * Copy the nodes and dependences of the SCC, so the SCC no longer refers to
+   * the graph it has been computed from.
+   */
+  void materialize(void);
+
+  /*
+   * Methods that modify the SCC.
+   * They materialize the SCC first.
+   */
+  DGNode<Value> *addNode(Value *theT, bool inclusion);
+  void removeNode(DGNode<Value> *node);
+  DGEdge<Value, Value> *addVariableDataDependenceEdge(Value *from,
+                                                      Value *to,
+                                                      DataDependenceType t);
+  DGEdge<Value, Value> *addMemoryDataDependenceEdge(Value *from,
+                                                    Value *to,
+                                                    DataDependenceType t,
+                                                    bool isMust);
+  DGEdge<Value, Value> *addControlDependenceEdge(Value *from, Value *to);
+  DGEdge<Value, Value> *copyAddEdge(DGEdge<Value, Value> &edgeToCopy);
+  void removeEdge(DGEdge<Value, Value> *edge);
+
   /*
    * Iterate over values inside the SCC until @funcToInvoke returns true or no
    * other one exists.
@@ -73,6 +114,14 @@ public:
   bool iterateOverAllInstructions(
       std::function<bool(Instruction *)> funcToInvoke);
 
+  /*
+   * Check if @edge is a dependence of the SCC: its endpoints are nodes of the
+   * SCC and at least one of them is internal.
+   * The nodes of a view share their dependences with the graph the SCC has
+   * been computed from, so use this to filter the edges of a node.
+   */
+  bool isDependenceOfSCC(DGEdge<Value, Value> *edge) const;
+
   /*
    * Check if the SCC has cycles in it.
    */
@@ -101,8 +150,17 @@ public:
   ~SCC();
 
 private:
-  void copyNodesAndEdges(std::set<DGNode<Value> *> internalNodes,
-                         std::set<DGNode<Value> *> externalNodes);
+  bool view;
+
+  void viewNodesAndEdges(std::set<DGNode<Value> *> &internalNodes,
+                         std::set<DGNode<Value> *> &externalNodes);
+
+  std::unordered_map<DGEdge<Value, Value> *, DGEdge<Value, Value> *>
+  materializeAndMapEdges(void);
+
+  std::unordered_map<DGEdge<Value, Value> *, DGEdge<Value, Value> *>
+  copyNodesAndEdges(std::set<DGNode<Value> *> internalNodes,
+                    std::set<DGNode<Value> *> externalNodes);
 };
 
 template <>
@@ -23,7 +23,7 @@
 #define NOELLE_SRC_CORE_SCCDAG_H_
 
 #include "arcana/noelle/core/SystemHeaders.hpp"
-#include "arcana/noelle/core/BitMatrix.hpp"
+#include "arcana/noelle/core/DAGReachability.hpp"
 #include "arcana/noelle/core/DGBase.hpp"
 #include "arcana/noelle/core/PDG.hpp"
 #include "arcana/noelle/core/SCC.hpp"
@@ -90,6 +90,7 @@ public:
 
   /*
    * Merge SCCs of @sccSet to become a single node of the SCCDAG.
+   * The ordering between nodes is updated without recomputing it.
    */
   void mergeSCCs(std::set<DGNode<SCC> *> &sccSet);
 
@@ -128,14 +129,9 @@ protected:
 
 private:
   /*
-   * BitMatrix for keeping the topological order of the SCCDAG nodes.
+   * Transitive closure of the dependences between the SCCDAG nodes.
    */
-  BitMatrix ordered;
-
-  /*
-   * ordered_dirty is true if the ordering of SCCDAG nodes is invalid.
-   */
-  bool orderedDirty;
+  DAGReachability ordered;
 
   // SCC nodes to Ids map.
   std::unordered_map<const SCC *, uint32_t> sccIndexes;
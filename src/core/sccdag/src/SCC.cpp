@@ -24,7 +24,7 @@
 
 namespace arcana::noelle {
 
-SCC::SCC(std::set<DGNode<Value> *> internalNodes) {
+SCC::SCC(std::set<DGNode<Value> *> internalNodes) : view{ true } {
 
   /*
    * Collect all internal values
@@ -53,26 +53,168 @@ SCC::SCC(std::set<DGNode<Value> *> internalNodes) {
     }
   }
 
-  copyNodesAndEdges(internalNodes, externalNodes);
+  this->viewNodesAndEdges(internalNodes, externalNodes);
 }
 
 SCC::SCC(std::set<DGNode<Value> *> internalNodes,
-         std::set<DGNode<Value> *> externalNodes) {
-  copyNodesAndEdges(internalNodes, externalNodes);
+         std::set<DGNode<Value> *> externalNodes)
+  : view{ true } {
+  this->viewNodesAndEdges(internalNodes, externalNodes);
 }
 
-void SCC::copyNodesAndEdges(std::set<DGNode<Value> *> internalNodes,
-                            std::set<DGNode<Value> *> externalNodes) {
+void SCC::viewNodesAndEdges(std::set<DGNode<Value> *> &internalNodes,
+                            std::set<DGNode<Value> *> &externalNodes) {
+
+  /*
+   * Refer to the nodes given as input.
+   */
+  for (auto node : internalNodes) {
+    this->internalNodeMap[node->getT()] = node;
+    this->allNodes.insert(node);
+  }
+  for (auto node : externalNodes) {
+    this->externalNodeMap[node->getT()] = node;
+    this->allNodes.insert(node);
+  }
+  this->entryNode = (*this->allNodes.begin());
+
+  /*
+   * Refer to the dependences of the internal nodes with the nodes of the SCC.
+   */
+  for (auto node : internalNodes) {
+    for (auto edge : node->getOutgoingEdges()) {
+      if (this->isInGraph(edge->getDst())) {
+        this->allEdges.insert(edge);
+      }
+    }
+    for (auto edge : node->getIncomingEdges()) {
+      if (this->isInGraph(edge->getSrc())) {
+        this->allEdges.insert(edge);
+      }
+    }
+  }
+
+  return;
+}
+
+bool SCC::isView(void) const {
+  return this->view;
+}
+
+void SCC::materialize(void) {
+  this->materializeAndMapEdges();
+
+  return;
+}
+
+std::unordered_map<DGEdge<Value, Value> *, DGEdge<Value, Value> *> SCC::
+    materializeAndMapEdges(void) {
+  if (!this->view) {
+    return {};
+  }
+
+  /*
+   * Fetch the nodes of the graph the SCC has been computed from.
+   */
+  std::set<DGNode<Value> *> internalNodes;
+  std::set<DGNode<Value> *> externalNodes;
+  for (auto nodePair : this->internalNodePairs()) {
+    internalNodes.insert(nodePair.second);
+  }
+  for (auto nodePair : this->externalNodePairs()) {
+    externalNodes.insert(nodePair.second);
+  }
+
+  /*
+   * Copy them and their dependences.
+   * The nodes and dependences we drop belong to the other graph.
+   */
+  this->clear();
+  this->view = false;
+
+  return this->copyNodesAndEdges(internalNodes, externalNodes);
+}
+
+DGNode<Value> *SCC::addNode(Value *theT, bool inclusion) {
+  this->materialize();
+
+  return DG<Value>::addNode(theT, inclusion);
+}
+
+void SCC::removeNode(DGNode<Value> *node) {
+  assert(!this->view || this->isInGraph(node->getT()));
+  this->materialize();
+
+  /*
+   * @node might belong to the graph the SCC was a view of.
+   */
+  DG<Value>::removeNode(this->fetchNode(node->getT()));
+
+  return;
+}
+
+DGEdge<Value, Value> *SCC::addVariableDataDependenceEdge(Value *from,
+                                                         Value *to,
+                                                         DataDependenceType t) {
+  this->materialize();
+
+  return DG<Value>::addVariableDataDependenceEdge(from, to, t);
+}
+
+DGEdge<Value, Value> *SCC::addMemoryDataDependenceEdge(Value *from,
+                                                       Value *to,
+                                                       DataDependenceType t,
+                                                       bool isMust) {
+  this->materialize();
+
+  return DG<Value>::addMemoryDataDependenceEdge(from, to, t, isMust);
+}
+
+DGEdge<Value, Value> *SCC::addControlDependenceEdge(Value *from, Value *to) {
+  this->materialize();
+
+  return DG<Value>::addControlDependenceEdge(from, to);
+}
+
+DGEdge<Value, Value> *SCC::copyAddEdge(DGEdge<Value, Value> &edgeToCopy) {
+  this->materialize();
+
+  return DG<Value>::copyAddEdge(edgeToCopy);
+}
+
+void SCC::removeEdge(DGEdge<Value, Value> *edge) {
+  if (!this->view) {
+    DG<Value>::removeEdge(edge);
+    return;
+  }
+
+  /*
+   * @edge belongs to the graph the SCC is a view of.
+   * Remove its copy.
+   */
+  auto copies = this->materializeAndMapEdges();
+  auto copy = copies.find(edge);
+  if (copy != copies.end()) {
+    DG<Value>::removeEdge(copy->second);
+  }
+
+  return;
+}
+
+std::unordered_map<DGEdge<Value, Value> *, DGEdge<Value, Value> *> SCC::
+    copyNodesAndEdges(std::set<DGNode<Value> *> internalNodes,
+                      std::set<DGNode<Value> *> externalNodes) {
+  std::unordered_map<DGEdge<Value, Value> *, DGEdge<Value, Value> *> copies;
 
   /*
    * Add all nodes by classification. Arbitrarily choose entry node from all
    * nodes
    */
   for (auto node : internalNodes) {
-    addNode(node->getT(), /*internal=*/true);
+    DG<Value>::addNode(node->getT(), /*internal=*/true);
   }
   for (auto node : externalNodes) {
-    addNode(node->getT(), /*internal=*/false);
+    DG<Value>::addNode(node->getT(), /*internal=*/false);
   }
   entryNode = (*allNodes.begin());
 
@@ -86,7 +228,7 @@ void SCC::copyNodesAndEdges(std::set<DGNode<Value> *> internalNodes,
       auto incomingT = edge->getDst();
       if (isExternal(incomingT))
         continue;
-      copyAddEdge(*edge);
+      copies[edge] = DG<Value>::copyAddEdge(*edge);
     }
   }
 
@@ -98,15 +240,17 @@ void SCC::copyNodesAndEdges(std::set<DGNode<Value> *> internalNodes,
       auto incomingT = edge->getDstNode()->getT();
       if (isInternal(incomingT))
         continue;
-      copyAddEdge(*edge);
+      copies[edge] = DG<Value>::copyAddEdge(*edge);
     }
     for (auto edge : node->getIncomingEdges()) {
       auto outgoingT = edge->getSrcNode()->getT();
       if (isInternal(outgoingT))
         continue;
-      copyAddEdge(*edge);
+      copies[edge] = DG<Value>::copyAddEdge(*edge);
     }
   }
+
+  return copies;
 }
 
 int64_t SCC::numberOfInstructions(void) const {
@@ -180,7 +324,25 @@ raw_ostream &SCC::printMinimal(raw_ostream &stream, std::string prefixToUse) {
   return stream;
 }
 
+bool SCC::isDependenceOfSCC(DGEdge<Value, Value> *edge) const {
+  auto src = edge->getSrc();
+  auto dst = edge->getDst();
+  if (this->isInternal(src)) {
+    return this->isInGraph(dst);
+  }
+  if (this->isInternal(dst)) {
+    return this->isInGraph(src);
+  }
+
+  return false;
+}
+
 bool SCC::hasCycle(bool ignoreControlDep) {
+
+  /*
+   * Only the dependences of the SCC are considered.
+   * Nodes of a view can have other dependences as well.
+   */
   std::set<DGNode<Value> *> nodesChecked;
   for (auto nodePair : this->internalNodePairs()) {
     auto node = nodePair.second;
@@ -199,6 +361,8 @@ bool SCC::hasCycle(bool ignoreControlDep) {
       for (auto edge : node->getOutgoingEdges()) {
         if (ignoreControlDep && isa<ControlDependence<Value, Value>>(edge))
           continue;
+        if (this->allEdges.find(edge) == this->allEdges.end())
+          continue;
 
         auto otherNode = edge->getDstNode();
         if (nodesSeen.find(otherNode) != nodesSeen.end())
@@ -295,6 +459,16 @@ bool SCC::iterateOverAllValues(std::function<bool(Value *)> funcToInvoke) {
 }
 
 SCC::~SCC() {
+
+  /*
+   * The nodes and dependences of a view belong to another graph.
+   */
+  if (this->view) {
+    this->clear();
+    return;
+  }
+  this->destroyNodesAndEdges();
+
   return;
 }
 
@@ -36,15 +36,20 @@ SCCDAG::SCCDAG(PDG *pdg) {
    * components (see Tarjan's DFS algo).
    */
   std::set<DGNode<Value> *> visited;
-  DGNode<Value> *originalEntryNode = pdg->getEntryNode();
+
+  /*
+   * Traverse the read-optimized form of the PDG.
+   * The same wrapper is used for all the traversals.
+   */
+  auto wasFrozen = pdg->isFrozen();
+  pdg->freeze();
+  DGGraphWrapper<PDG, Value> pdgWrapper(pdg);
 
   for (auto nodeToVisit : pdg->getNodes()) {
     if (visited.find(nodeToVisit) != visited.end())
       continue;
 
-    pdg->setEntryNode(nodeToVisit);
-
-    DGGraphWrapper<PDG, Value> pdgWrapper(pdg);
+    pdgWrapper.setEntryNode(nodeToVisit);
 
     for (auto pdgI = scc_begin(&pdgWrapper); pdgI != scc_end(&pdgWrapper);
          ++pdgI) {
@@ -78,7 +83,9 @@ SCCDAG::SCCDAG(PDG *pdg) {
     }
   }
 
-  pdg->setEntryNode(originalEntryNode);
+  if (!wasFrozen) {
+    pdg->thaw();
+  }
 
   /*
    * Create the map from a Value to an SCC included in the SCCDAG.
@@ -93,7 +100,6 @@ SCCDAG::SCCDAG(PDG *pdg) {
   /*
    * Compute transitive dependences between nodes of the SCCDAG.
    */
-  orderedDirty = true;
   this->computeReachabilityAmongSCCs();
 
   return;
@@ -139,14 +145,26 @@ void SCCDAG::markEdgesAndSubEdges(void) {
     auto outgoingSCC = outgoingSCCNode->getT();
 
     /*
-     * Check dependences that go outside the current SCC.
+     * Collect the dependences that go outside the current SCC grouped by the
+     * SCC they reach.
+     * Only the dependences of internal nodes are considered because the nodes
+     * of an SCC might be shared with the graph it has been computed from.
      */
-    for (auto externalNodePair : outgoingSCC->externalNodePairs()) {
-      auto incomingNode = externalNodePair.second;
-      if (incomingNode->inDegree() == 0)
-        continue;
+    std::map<DGNode<SCC> *, std::vector<DGEdge<Value, Value> *>> subEdges;
+    for (auto internalNodePair : outgoingSCC->internalNodePairs()) {
+      for (auto edge : internalNodePair.second->getOutgoingEdges()) {
+        auto incomingValue = edge->getDst();
+        if (!outgoingSCC->isExternal(incomingValue))
+          continue;
+        subEdges[this->valueToSCCNode[incomingValue]].push_back(edge);
+      }
+    }
 
-      auto incomingSCCNode = this->valueToSCCNode[externalNodePair.first];
+    /*
+     * Check dependences that go outside the current SCC.
+     */
+    for (auto &subEdgesPair : subEdges) {
+      auto incomingSCCNode = subEdgesPair.first;
       auto incomingSCC = incomingSCCNode->getT();
 
       /*
@@ -176,7 +194,7 @@ void SCCDAG::markEdgesAndSubEdges(void) {
         sccEdge->removeSubEdges();
         clearedEdges.insert(sccEdge);
       }
-      for (auto edge : incomingNode->getIncomingEdges())
+      for (auto edge : subEdgesPair.second)
         sccEdge->addSubEdge(edge);
     }
   }
@@ -187,20 +205,39 @@ void SCCDAG::mergeSCCs(std::set<DGNode<SCC> *> &sccSet) {
     return;
 
   std::set<DGNode<Value> *> mergeNodes;
+  auto areViews = true;
   for (auto sccNode : sccSet) {
+    areViews &= sccNode->getT()->isView();
     for (auto internalNodePair : sccNode->getT()->internalNodePairs()) {
       mergeNodes.insert(internalNodePair.second);
     }
   }
 
   /*
-   * Note: nodes are from 2 contexts; internal nodes will point to external
+   * If all SCCs are views, their nodes belong to the graph the SCCDAG has been
+   * computed from, and so will the ones of the merged SCC.
+   *
+   * Otherwise, nodes are from 2 contexts; internal nodes will point to external
    * nodes, some of whose values are in nodes in this list, and some of whose
-   * values are NOT in nodes in this list. However, SCC's constructor accounts
-   * for that context mismatch and properly copies edges WITHOUT duplicating any
-   * nodes or edges.
+   * values are NOT in nodes in this list. However, SCC's materialization
+   * accounts for that context mismatch and properly copies edges WITHOUT
+   * duplicating any nodes or edges.
    */
   auto mergeSCC = new SCC(mergeNodes);
+  if (!areViews) {
+    mergeSCC->materialize();
+  }
+
+  /*
+   * Update the ordering: the new SCC takes one of the indexes of the old ones.
+   */
+  std::vector<uint32_t> indexes;
+  for (auto sccNode : sccSet) {
+    auto scc = sccNode->getT();
+    indexes.push_back(this->sccIndexes.at(scc));
+    this->sccIndexes.erase(scc);
+  }
+  this->sccIndexes[mergeSCC] = this->ordered.merge(indexes);
 
   /*
    * Add the new SCC and remove the old ones
@@ -357,17 +394,16 @@ bool SCCDAG::orderedBefore(const SCCSet &earlies, const SCC *lateSCC) const {
 
 /*
  * Returns true if there is a path of dependences from earlySCC to lateSCC.
- * O(1) complexity thanks to the precomputation of the bitMatrix.
+ * O(1) complexity for small SCCDAGs and logarithmic in the number of intervals
+ * of earlySCC for large ones (see DAGReachability).
  */
 bool SCCDAG::orderedBefore(const SCC *earlySCC, const SCC *lateSCC) const {
-  assert(!orderedDirty && "Must run computeReachabilityAmongSCCs() first");
   auto earlySCCid = sccIndexes.find(earlySCC)->second;
   auto lateSCCid = sccIndexes.find(lateSCC)->second;
-  return ordered.test(earlySCCid, lateSCCid);
+  return ordered.isReachable(earlySCCid, lateSCCid);
 }
 
 void SCCDAG::computeReachabilityAmongSCCs(void) {
-  orderedDirty = false;
   const uint32_t Nscc = this->numNodes();
 
   /*
@@ -380,23 +416,19 @@ void SCCDAG::computeReachabilityAmongSCCs(void) {
   }
 
   /*
-   * Resize bitMatrix (NxN), where N is the number of SCC nodes.
-   */
-  ordered.resize(Nscc);
-
-  /*
-   * Populate bitMatrix with all reported dependences among SCC nodes.
+   * Collect all reported dependences among SCC nodes.
    */
+  std::vector<std::vector<uint32_t>> successors(Nscc);
   for (auto *SCCEdge : this->getEdges()) {
     const SCC *srcSCC = SCCEdge->getSrc();
     const SCC *dstSCC = SCCEdge->getDst();
-    ordered.set(sccIndexes[srcSCC], sccIndexes[dstSCC]);
+    successors[sccIndexes[srcSCC]].push_back(sccIndexes[dstSCC]);
   }
 
   /*
-   * Compute transitive closure of the bitMatrix.
+   * Compute the transitive closure.
    */
-  ordered.transitiveClosure();
+  ordered.compute(Nscc, successors);
 }
 
 uint32_t SCCDAG::getSCCIndex(const SCC *scc) const {
@@ -405,19 +437,7 @@ uint32_t SCCDAG::getSCCIndex(const SCC *scc) const {
 }
 
 SCCDAG::~SCCDAG() {
-  for (auto *edge : allEdges) {
-    if (edge) {
-      delete edge;
-    }
-  }
-
-  for (auto *node : allNodes) {
-    if (node) {
-      delete node;
-    }
-  }
-
-  this->clear();
+  this->destroyNodesAndEdges();
 
   return;
 }
@@ -25,7 +25,7 @@
 #include "arcana/noelle/core/SystemHeaders.hpp"
 #include "arcana/noelle/core/Dominators.hpp"
 #include "arcana/noelle/core/LoopContent.hpp"
-#include "arcana/noelle/core/DataFlowResult.hpp"
+#include "arcana/noelle/core/InstructionReachability.hpp"
 #include "arcana/noelle/core/SCCDAGPartition.hpp"
 
 namespace arcana::noelle {
@@ -34,7 +34,7 @@ class SCCPartitionScheduler {
 public:
   SCCPartitionScheduler(SCCDAG *loopSCCDAG,
                         std::unordered_set<SCCSet *> sccPartitions,
-                        DataFlowResult *reachabilityDFR);
+                        const InstructionReachability *reachability);
 
   bool squeezePartitions(void);
 
@@ -43,14 +43,9 @@ private:
   std::unordered_set<SCCSet *> sccPartitions;
 
   /*
-   * The reachability DFR OUT set for an instruction I is
-   * all instructions J that can be reached from I.
-   * The reverse reachability is the OUT set of the inverse DFR.
-   * For an instruction I, the OUT set would be all J that can reach I
+   * The reachability of the instructions of the loop.
    */
-  DataFlowResult *reachabilityDFR;
-  std::unordered_map<Instruction *, std::unordered_set<Instruction *>>
-      reverseReachabilityMap;
+  const InstructionReachability *reachability;
 
   std::unordered_map<SCC *, SCCSet *> sccToPartitionMap;
   std::unordered_map<BasicBlock *, std::unordered_set<SCCSet *>>
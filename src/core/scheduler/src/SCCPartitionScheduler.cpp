@@ -26,10 +26,10 @@ namespace arcana::noelle {
 SCCPartitionScheduler::SCCPartitionScheduler(
     SCCDAG *loopSCCDAG,
     std::unordered_set<SCCSet *> sccPartitions,
-    DataFlowResult *reachabilityDFR)
+    const InstructionReachability *reachability)
   : loopSCCDAG{ loopSCCDAG },
     sccPartitions{ sccPartitions },
-    reachabilityDFR{ reachabilityDFR } {}
+    reachability{ reachability } {}
 
 bool SCCPartitionScheduler::squeezePartitions(void) {
   auto modified = false;
@@ -44,26 +44,18 @@ bool SCCPartitionScheduler::squeezePartitions(void) {
   }
 
   /*
-   * Collect reverse reachability OUT sets
-   * NOTE: This is done on EVERY SCC, not just ones that are partitioned
-   * This is to ensure a full picture of reachability
-   *
    * Collect a mapping between basic blocks and partitions present in that basic
    * block
    */
   for (auto sccNode : loopSCCDAG->getNodes()) {
     auto scc = sccNode->getT();
+    if (sccToPartitionMap.find(scc) == sccToPartitionMap.end()) {
+      continue;
+    }
+    auto partition = sccToPartitionMap[scc];
     scc->iterateOverInstructions([&](Instruction *I) -> bool {
-      if (sccToPartitionMap.find(scc) != sccToPartitionMap.end()) {
-        auto B = I->getParent();
-        auto partition = sccToPartitionMap[scc];
-        basicBlockToPartitionsMap[B].insert(partition);
-      }
-
-      auto instructionsAfterI = reachabilityDFR->OUT(I);
-      for (auto J : instructionsAfterI) {
-        reverseReachabilityMap[cast<Instruction>(J)].insert(I);
-      }
+      auto B = I->getParent();
+      basicBlockToPartitionsMap[B].insert(partition);
 
       return false;
     });
@@ -248,6 +240,12 @@ std::unordered_set<Instruction *> SCCPartitionScheduler::
 
     for (auto edge : node->getIncomingEdges()) {
 
+      /*
+       * Ignore dependences that are not of the SCC of @I
+       */
+      if (!sccOfI->isDependenceOfSCC(edge))
+        continue;
+
       /*
        * Ignore self edges
        */
@@ -415,6 +415,16 @@ bool LoopInvariantCodeMotion::hoistInvariantValues(LoopContent const &LC) {
     preHeaderBuilder.Insert(I);
     modified = true;
   }
+
+  /*
+   * Update the PDG.
+   */
+  if (modified) {
+    std::unordered_set<Instruction *> hoistedInstructions(
+        instructionsToHoistToPreheader.begin(),
+        instructionsToHoistToPreheader.end());
+    this->noelle.codeModified(loopFunction, hoistedInstructions);
+  }
   if (modified) {
     errs() << "LICM:   The loop has been modified\n";
   } else {
@@ -49,8 +49,12 @@ bool LoopStats::runOnModule(Module &M) {
 
   /*
    * Fetch all program loops.
+   * The statistics only need the invariants and the induction variables of
+   * the loops.
    */
-  auto programLoops = noelle.getLoopContents();
+  auto programLoops = noelle.getLoopContents(
+      noelle.getMinimumHotness(),
+      { LOOP_INVARIANTS_ID, LOOP_INDUCTION_VARIABLES_ID });
 
   /*
    * Analyze the loops.
@@ -67,6 +67,9 @@ void MetadataCleaner::cleanPDGMetadata(Module &M) {
   if (auto n = M.getNamedMetadata("noelle.module.pdg")) {
     M.eraseNamedMetadata(n);
   }
+  if (auto n = M.getNamedMetadata("noelle.module.pdg.edges")) {
+    M.eraseNamedMetadata(n);
+  }
 
   return;
 }
@@ -24,11 +24,19 @@
 
 namespace arcana::noelle {
 
-PDGEmbedder::PDGEmbedder() : ModulePass(ID) {
+static cl::opt<std::string> PDGFileName(
+    "pdg-embed-file",
+    cl::init(""),
+    cl::desc("Store the memory dependences of the PDG in this file rather "
+             "than in the IR"));
+
+PDGEmbedder::PDGEmbedder() : ModulePass(ID), fileName{} {
   return;
 }
 
 bool PDGEmbedder::doInitialization(Module &M) {
+  this->fileName = PDGFileName;
+
   return false;
 }
 
@@ -52,8 +60,12 @@ bool PDGEmbedder::runOnModule(Module &M) {
   /*
    * Embed the PDG.
    */
-  auto pdgGen = noelle.getPDGGenerator();
-  pdgGen.cleanAndEmbedPDGAsMetadata(pdg);
+  auto &pdgGen = noelle.getPDGGenerator();
+  if (!pdgGen.cleanAndEmbedPDGAsMetadata(pdg, this->fileName)) {
+    errs() << "PDGEmbedder: Error = the file " << this->fileName
+           << " could not be written\n";
+    abort();
+  }
 
   return true;
 }
@@ -37,6 +37,9 @@ public:
   void getAnalysisUsage(AnalysisUsage &AU) const override;
 
   bool runOnModule(Module &M) override;
+
+private:
+  std::string fileName;
 };
 
 } // namespace arcana::noelle
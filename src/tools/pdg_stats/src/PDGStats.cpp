@@ -79,6 +79,22 @@ bool PDGStats::runOnModule(Module &M) {
     this->analyzeDependence(edge);
   }
 
+  /*
+   * Collect the memory used by the PDG.
+   */
+  auto &arena = PDG->getArena();
+  this->numberOfBytesReserved = arena.getNumberOfBytesReserved();
+  this->numberOfBytesInUse = arena.getNumberOfBytesInUse();
+
+  /*
+   * Collect the number of alias queries done to compute the PDG.
+   */
+  auto &pdgGenerator = noelle.getPDGGenerator();
+  this->numberOfMemoryPairQueries =
+      pdgGenerator.getNumberOfMemoryPairQueries();
+  this->numberOfPrunedMemoryPairs =
+      pdgGenerator.getNumberOfPrunedMemoryPairs();
+
   /*
    * Collect the statistics for all functions.
    */
@@ -98,6 +114,7 @@ bool PDGStats::runOnModule(Module &M) {
   /*
    * Print the statistics.
    */
+  this->queryCache = &noelle.getDependenceQueryCache();
   printStats();
 
   return false;
@@ -303,6 +320,26 @@ void PDGStats::printStats() {
          << "\n";
   errs() << "     Number of potential memory dependences: "
          << this->numberOfPotentialMemoryDependences << "\n";
+  errs() << "Number of bytes reserved by the PDG arena: "
+         << this->numberOfBytesReserved << "\n";
+  errs() << " Number of bytes used by nodes and edges: "
+         << this->numberOfBytesInUse << "\n";
+  errs() << "Number of memory instruction pairs checked: "
+         << this->numberOfMemoryPairQueries << "\n";
+  errs() << " Number of memory instruction pairs skipped: "
+         << this->numberOfPrunedMemoryPairs << "\n";
+  if (this->queryCache != nullptr) {
+    errs() << "Number of memoized answers of the analyses: "
+           << this->queryCache->getNumberOfAnswers() << "\n";
+    this->queryCache->iterateOverStatistics(
+        [](const std::string &analysisName,
+           const DependenceQueryCache::Statistics &statistics) {
+          errs() << " " << analysisName << ": " << statistics.hits
+                 << " hits, " << statistics.misses << " misses, "
+                 << statistics.nanosecondsToAnswerMisses
+                 << " nanoseconds to answer the misses\n";
+        });
+  }
 
   return;
 }
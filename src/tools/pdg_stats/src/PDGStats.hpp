@@ -53,6 +53,11 @@ private:
   int64_t numberOfMemoryMustDependence = 0;
   int64_t numberOfPotentialMemoryDependences = 0;
   int64_t numberOfControlDependence = 0;
+  uint64_t numberOfBytesReserved = 0;
+  uint64_t numberOfBytesInUse = 0;
+  uint64_t numberOfMemoryPairQueries = 0;
+  uint64_t numberOfPrunedMemoryPairs = 0;
+  const DependenceQueryCache *queryCache = nullptr;
 
   void collectStatsForNodes(Function &F);
   void collectStatsForPotentialEdges(
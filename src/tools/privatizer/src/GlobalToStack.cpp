@@ -485,6 +485,11 @@ bool Privatizer::transformG2S(Noelle &noelle,
     errs() << prefix << "Replace global variable @" << globalVarName << "\n";
     errs() << emptyPrefix << "with allocaInst: " << *allocaInst << "\n";
     errs() << emptyPrefix << suffix;
+
+    /*
+     * Update the dependences of the function.
+     */
+    noelle.invalidateFunctionDependenceGraph(currentF);
   }
 
   return modified;
@@ -190,6 +190,7 @@ std::unordered_map<Function *, LiveMemorySummary> Privatizer::collectH2S(
 
 bool Privatizer::transformH2S(Noelle &noelle, LiveMemorySummary liveMemSum) {
   auto modified = false;
+  std::unordered_set<Function *> modifiedFunctions;
 
   auto heapAllocInsts = Utils::sort(liveMemSum.allocable);
   for (auto heapAllocInst : heapAllocInsts) {
@@ -212,6 +213,7 @@ bool Privatizer::transformH2S(Noelle &noelle, LiveMemorySummary liveMemSum) {
     }
 
     modified = true;
+    modifiedFunctions.insert(currentF);
     auto entryBlock = &currentF->getEntryBlock();
     auto firstInst = entryBlock->getFirstNonPHI();
     IRBuilder<> entryBuilder(firstInst);
@@ -259,9 +261,17 @@ bool Privatizer::transformH2S(Noelle &noelle, LiveMemorySummary liveMemSum) {
    * Remove dead instructions.
    */
   for (auto freeInst : liveMemSum.removable) {
+    modifiedFunctions.insert(freeInst->getFunction());
     freeInst->eraseFromParent();
   }
 
+  /*
+   * Update the dependences of the modified functions.
+   */
+  for (auto f : modifiedFunctions) {
+    noelle.invalidateFunctionDependenceGraph(f);
+  }
+
   return modified;
 }
 
@@ -0,0 +1,133 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "llvm/Pass.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/BasicBlock.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/Dominators.h"
+#include "llvm/Analysis/LoopInfo.h"
+
+#include "TestSuite.hpp"
+#include "arcana/noelle/core/LoopStructure.hpp"
+#include "arcana/noelle/core/DenseDataFlowEngine.hpp"
+#include "arcana/noelle/core/DataFlowEngine.hpp"
+#include "arcana/noelle/core/DataFlowWorkList.hpp"
+
+#include <sstream>
+#include <vector>
+#include <string>
+
+using namespace parallelizertests;
+
+namespace llvm {
+
+class DFTestSuite : public ModulePass {
+public:
+  DFTestSuite() : ModulePass{ ID } {}
+
+  /*
+   * Class fields
+   */
+  static char ID;
+  static const char *tests[];
+  static parallelizertests::TestFunction testFns[];
+
+  bool doInitialization(Module &M) override;
+  bool runOnModule(Module &M) override;
+  void getAnalysisUsage(AnalysisUsage &AU) const override;
+
+private:
+  static Values forwardAnalysisOfFunction(ModulePass &pass, TestSuite &suite);
+  static Values backwardAnalysisOfFunction(ModulePass &pass, TestSuite &suite);
+  static Values forwardAnalysisOfLoops(ModulePass &pass, TestSuite &suite);
+  static Values backwardAnalysisOfLoops(ModulePass &pass, TestSuite &suite);
+  static Values loopAnalysisIncludesOnlyItsBlocks(ModulePass &pass,
+                                                  TestSuite &suite);
+  static Values forwardBlockSummariesMatchAllSets(ModulePass &pass,
+                                                  TestSuite &suite);
+  static Values backwardBlockSummariesMatchAllSets(ModulePass &pass,
+                                                   TestSuite &suite);
+  static Values workListPopsInReversePostOrder(ModulePass &pass,
+                                               TestSuite &suite);
+  static Values workListIncludesABlockOnce(ModulePass &pass,
+                                           TestSuite &suite);
+  static Values analysesConvergeWithinTheLoopDepthBound(ModulePass &pass,
+                                                        TestSuite &suite);
+
+  /*
+   * Return the successors of every basic block of the function, identified
+   * by their position in @blocks.
+   */
+  static std::vector<std::vector<uint32_t>> getFlowsTo(
+      const std::vector<BasicBlock *> &blocks);
+
+  /*
+   * GEN and KILL of the problems tested.
+   * Forward: an instruction generates itself and kills its operands.
+   * Backward: an instruction generates its operands and kills itself.
+   */
+  static void computeGENAndKILL(Instruction *i,
+                                bool isForward,
+                                std::vector<Value *> &GEN,
+                                std::vector<Value *> &KILL);
+
+  /*
+   * Compute the sets of the instructions of @blocks one instruction at a
+   * time.
+   */
+  static void computeExpectedSets(
+      const std::vector<BasicBlock *> &blocks,
+      bool isForward,
+      const std::set<Value *> &boundary,
+      std::unordered_map<Instruction *, std::set<Value *>> &IN,
+      std::unordered_map<Instruction *, std::set<Value *>> &OUT);
+
+  static Values compareSets(DFTestSuite &pass,
+                            arcana::noelle::DenseDataFlowResult &result,
+                            const std::vector<BasicBlock *> &blocks,
+                            const std::set<Value *> &boundary);
+
+  static Values analyzeFunction(ModulePass &pass, bool isForward);
+
+  static Values analyzeLoops(ModulePass &pass, bool isForward);
+
+  /*
+   * Compute the sets of the function with DataFlowEngine, keeping the sets of
+   * every instruction or only the ones at the boundaries of basic blocks.
+   */
+  static arcana::noelle::DataFlowResult *applyDataFlowEngine(
+      DFTestSuite &pass,
+      bool isForward,
+      bool storeOnlyBlockSummaries);
+
+  static Values compareBlockSummariesWithAllSets(ModulePass &pass,
+                                                 bool isForward);
+
+  TestSuite *suite;
+  Module *M;
+  Function *mainFunction;
+  LoopInfo *li;
+  std::vector<Value *> domain;
+};
+} // namespace llvm
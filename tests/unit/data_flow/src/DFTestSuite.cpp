@@ -0,0 +1,661 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "DFTestSuite.hpp"
+
+using namespace llvm;
+
+// Register pass to "opt"
+char DFTestSuite::ID = 0;
+static RegisterPass<DFTestSuite> X("UnitTester",
+                                   "Data Flow Unit Tester");
+
+// Register pass to "clang"
+static DFTestSuite *_PassMaker = NULL;
+static RegisterStandardPasses _RegPass1(PassManagerBuilder::EP_OptimizerLast,
+                                        [](const PassManagerBuilder &,
+                                           legacy::PassManagerBase &PM) {
+                                          if (!_PassMaker) {
+                                            PM.add(_PassMaker =
+                                                       new DFTestSuite());
+                                          }
+                                        }); // ** for -Ox
+static RegisterStandardPasses _RegPass2(
+    PassManagerBuilder::EP_EnabledOnOptLevel0,
+    [](const PassManagerBuilder &, legacy::PassManagerBase &PM) {
+      if (!_PassMaker) {
+        PM.add(_PassMaker = new DFTestSuite());
+      }
+    }); // ** for -O0
+
+const char *DFTestSuite::tests[] = {
+  "dense forward analysis of the function",
+  "dense backward analysis of the function",
+  "dense forward analysis of the loops",
+  "dense backward analysis of the loops",
+  "dense analysis of a loop includes only its blocks",
+  "forward block summaries match the sets of every instruction",
+  "backward block summaries match the sets of every instruction",
+  "work list pops blocks in reverse post-order",
+  "work list includes a block once",
+  "analyses converge within the loop depth bound",
+};
+TestFunction DFTestSuite::testFns[] = {
+  DFTestSuite::forwardAnalysisOfFunction,
+  DFTestSuite::backwardAnalysisOfFunction,
+  DFTestSuite::forwardAnalysisOfLoops,
+  DFTestSuite::backwardAnalysisOfLoops,
+  DFTestSuite::loopAnalysisIncludesOnlyItsBlocks,
+  DFTestSuite::forwardBlockSummariesMatchAllSets,
+  DFTestSuite::backwardBlockSummariesMatchAllSets,
+  DFTestSuite::workListPopsInReversePostOrder,
+  DFTestSuite::workListIncludesABlockOnce,
+  DFTestSuite::analysesConvergeWithinTheLoopDepthBound,
+};
+
+bool DFTestSuite::doInitialization(Module &M) {
+  errs() << "DFTestSuite: Initialize\n";
+  const int numTests = sizeof(tests) / sizeof(tests[0]);
+  this->suite =
+      new TestSuite("DFTestSuite", tests, testFns, numTests, "test.txt");
+  this->M = &M;
+  return false;
+}
+
+void DFTestSuite::getAnalysisUsage(AnalysisUsage &AU) const {
+  AU.addRequired<LoopInfoWrapperPass>();
+}
+
+bool DFTestSuite::runOnModule(Module &M) {
+  errs() << "DFTestSuite: Start\n";
+  this->mainFunction = M.getFunction("main");
+  this->li =
+      &getAnalysis<LoopInfoWrapperPass>(*this->mainFunction).getLoopInfo();
+
+  /*
+   * The elements of the data-flow sets are the arguments and the instructions
+   * of the function.
+   */
+  for (auto &arg : this->mainFunction->args()) {
+    this->domain.push_back(&arg);
+  }
+  for (auto &inst : instructions(*this->mainFunction)) {
+    this->domain.push_back(&inst);
+  }
+
+  suite->runTests((ModulePass &)*this);
+
+  return false;
+}
+
+void DFTestSuite::computeGENAndKILL(Instruction *i,
+                                    bool isForward,
+                                    std::vector<Value *> &GEN,
+                                    std::vector<Value *> &KILL) {
+  std::vector<Value *> operands;
+  for (auto &op : i->operands()) {
+    if (isa<Instruction>(op.get()) || isa<Argument>(op.get())) {
+      operands.push_back(op.get());
+    }
+  }
+  if (isForward) {
+    GEN.push_back(i);
+    KILL = operands;
+  } else {
+    GEN = operands;
+    KILL.push_back(i);
+  }
+  return;
+}
+
+void DFTestSuite::computeExpectedSets(
+    const std::vector<BasicBlock *> &blocks,
+    bool isForward,
+    const std::set<Value *> &boundary,
+    std::unordered_map<Instruction *, std::set<Value *>> &IN,
+    std::unordered_map<Instruction *, std::set<Value *>> &OUT) {
+  std::set<BasicBlock *> blockSet(blocks.begin(), blocks.end());
+
+  /*
+   * Compute the fixed point by visiting all the blocks until nothing changes.
+   */
+  auto modified = true;
+  while (modified) {
+    modified = false;
+    for (auto bb : blocks) {
+      std::set<Value *> current;
+      auto isAtTheBoundary = false;
+      if (isForward) {
+        auto hasPredecessors = false;
+        for (auto pred : predecessors(bb)) {
+          hasPredecessors = true;
+          if (blockSet.count(pred) == 0) {
+            isAtTheBoundary = true;
+            continue;
+          }
+          auto &predOUT = OUT[pred->getTerminator()];
+          current.insert(predOUT.begin(), predOUT.end());
+        }
+        isAtTheBoundary |= !hasPredecessors;
+      } else {
+        auto hasSuccessors = false;
+        for (auto succ : successors(bb)) {
+          hasSuccessors = true;
+          if (blockSet.count(succ) == 0) {
+            isAtTheBoundary = true;
+            continue;
+          }
+          auto &succIN = IN[&*succ->begin()];
+          current.insert(succIN.begin(), succIN.end());
+        }
+        isAtTheBoundary |= !hasSuccessors;
+      }
+      if (isAtTheBoundary) {
+        current.insert(boundary.begin(), boundary.end());
+      }
+
+      /*
+       * Apply the transfer function of every instruction.
+       */
+      std::vector<Instruction *> insts;
+      for (auto &inst : *bb) {
+        insts.push_back(&inst);
+      }
+      if (!isForward) {
+        std::reverse(insts.begin(), insts.end());
+      }
+      for (auto inst : insts) {
+        std::vector<Value *> gen, kill;
+        DFTestSuite::computeGENAndKILL(inst, isForward, gen, kill);
+        auto &before = isForward ? IN[inst] : OUT[inst];
+        auto &after = isForward ? OUT[inst] : IN[inst];
+        if (before != current) {
+          before = current;
+          modified = true;
+        }
+        for (auto v : kill) {
+          current.erase(v);
+        }
+        current.insert(gen.begin(), gen.end());
+        if (after != current) {
+          after = current;
+          modified = true;
+        }
+      }
+    }
+  }
+
+  return;
+}
+
+Values DFTestSuite::compareSets(DFTestSuite &pass,
+                                arcana::noelle::DenseDataFlowResult &result,
+                                const std::vector<BasicBlock *> &blocks,
+                                const std::set<Value *> &boundary) {
+  std::unordered_map<Instruction *, std::set<Value *>> IN, OUT;
+  DFTestSuite::computeExpectedSets(blocks,
+                                   result.isForward(),
+                                   boundary,
+                                   IN,
+                                   OUT);
+
+  Values errors;
+  for (auto bb : blocks) {
+    if (!result.isIncluded(bb)) {
+      errors.insert("The sets of " + pass.suite->printAsOperandToString(bb)
+                    + " have not been computed");
+      continue;
+    }
+    if (result.toSet(result.IN(bb)) != IN[&*bb->begin()]) {
+      errors.insert("IN of " + pass.suite->printAsOperandToString(bb)
+                    + " is not correct");
+    }
+    if (result.toSet(result.OUT(bb)) != OUT[bb->getTerminator()]) {
+      errors.insert("OUT of " + pass.suite->printAsOperandToString(bb)
+                    + " is not correct");
+    }
+    for (auto &inst : *bb) {
+      if (result.toSet(result.IN(&inst)) != IN[&inst]) {
+        errors.insert("IN of " + pass.suite->valueToString(&inst)
+                      + " is not correct");
+      }
+      if (result.toSet(result.OUT(&inst)) != OUT[&inst]) {
+        errors.insert("OUT of " + pass.suite->valueToString(&inst)
+                      + " is not correct");
+      }
+    }
+
+    /*
+     * Expanding the block must give the same sets.
+     */
+    result.expand(bb,
+                  [&](Instruction *inst,
+                      const arcana::noelle::DataFlowBitVector &instIN,
+                      const arcana::noelle::DataFlowBitVector &instOUT) {
+                    if ((result.toSet(instIN) != IN[inst])
+                        || (result.toSet(instOUT) != OUT[inst])) {
+                      errors.insert("Expanding "
+                                    + pass.suite->valueToString(inst)
+                                    + " is not correct");
+                    }
+                  });
+  }
+
+  return errors;
+}
+
+Values DFTestSuite::analyzeFunction(ModulePass &pass, bool isForward) {
+  auto &dfPass = static_cast<DFTestSuite &>(pass);
+  auto F = dfPass.mainFunction;
+  auto computeGENAndKILL = [isForward](Instruction *i,
+                                       std::vector<Value *> &GEN,
+                                       std::vector<Value *> &KILL) {
+    DFTestSuite::computeGENAndKILL(i, isForward, GEN, KILL);
+  };
+
+  arcana::noelle::DenseDataFlowEngine engine{};
+  auto result =
+      isForward ? engine.applyForward(F, dfPass.domain, computeGENAndKILL)
+                : engine.applyBackward(F, dfPass.domain, computeGENAndKILL);
+  std::vector<BasicBlock *> blocks;
+  for (auto &bb : *F) {
+    blocks.push_back(&bb);
+  }
+  auto errors = DFTestSuite::compareSets(dfPass, *result, blocks, {});
+  delete result;
+
+  return errors;
+}
+
+Values DFTestSuite::analyzeLoops(ModulePass &pass, bool isForward) {
+  auto &dfPass = static_cast<DFTestSuite &>(pass);
+  auto computeGENAndKILL = [isForward](Instruction *i,
+                                       std::vector<Value *> &GEN,
+                                       std::vector<Value *> &KILL) {
+    DFTestSuite::computeGENAndKILL(i, isForward, GEN, KILL);
+  };
+
+  /*
+   * The arguments of the function flow into the loops.
+   */
+  std::vector<Value *> boundary;
+  for (auto &arg : dfPass.mainFunction->args()) {
+    boundary.push_back(&arg);
+  }
+
+  Values errors;
+  arcana::noelle::DenseDataFlowEngine engine{};
+  for (auto loop : dfPass.li->getLoopsInPreorder()) {
+    arcana::noelle::LoopStructure loopStructure(loop);
+    auto result = isForward ? engine.applyForward(&loopStructure,
+                                                  dfPass.domain,
+                                                  boundary,
+                                                  computeGENAndKILL)
+                            : engine.applyBackward(&loopStructure,
+                                                   dfPass.domain,
+                                                   boundary,
+                                                   computeGENAndKILL);
+    std::vector<BasicBlock *> blocks;
+    for (auto &bb : *dfPass.mainFunction) {
+      if (loop->contains(&bb)) {
+        blocks.push_back(&bb);
+      }
+    }
+    auto loopErrors = DFTestSuite::compareSets(
+        dfPass,
+        *result,
+        blocks,
+        std::set<Value *>(boundary.begin(), boundary.end()));
+    errors.insert(loopErrors.begin(), loopErrors.end());
+    delete result;
+  }
+
+  return errors;
+}
+
+Values DFTestSuite::forwardAnalysisOfFunction(ModulePass &pass,
+                                              TestSuite &suite) {
+  return DFTestSuite::analyzeFunction(pass, true);
+}
+
+Values DFTestSuite::backwardAnalysisOfFunction(ModulePass &pass,
+                                               TestSuite &suite) {
+  return DFTestSuite::analyzeFunction(pass, false);
+}
+
+Values DFTestSuite::forwardAnalysisOfLoops(ModulePass &pass,
+                                           TestSuite &suite) {
+  return DFTestSuite::analyzeLoops(pass, true);
+}
+
+Values DFTestSuite::backwardAnalysisOfLoops(ModulePass &pass,
+                                            TestSuite &suite) {
+  return DFTestSuite::analyzeLoops(pass, false);
+}
+
+Values DFTestSuite::loopAnalysisIncludesOnlyItsBlocks(ModulePass &pass,
+                                                      TestSuite &suite) {
+  auto &dfPass = static_cast<DFTestSuite &>(pass);
+  auto computeGENAndKILL = [](Instruction *i,
+                              std::vector<Value *> &GEN,
+                              std::vector<Value *> &KILL) {
+    DFTestSuite::computeGENAndKILL(i, true, GEN, KILL);
+  };
+
+  Values errors;
+  arcana::noelle::DenseDataFlowEngine engine{};
+  for (auto loop : dfPass.li->getLoopsInPreorder()) {
+    arcana::noelle::LoopStructure loopStructure(loop);
+    auto result = engine.applyForward(&loopStructure,
+                                      dfPass.domain,
+                                      {},
+                                      computeGENAndKILL);
+    for (auto &bb : *dfPass.mainFunction) {
+      if (result->isIncluded(&bb) != loop->contains(&bb)) {
+        errors.insert("The analysis of the loop of "
+                      + dfPass.suite->printAsOperandToString(
+                          loop->getHeader())
+                      + " does not include exactly its blocks");
+      }
+    }
+    if (result->getFunction() != dfPass.mainFunction) {
+      errors.insert("The analysis of a loop is not bound to its function");
+    }
+    delete result;
+  }
+
+  return errors;
+}
+
+arcana::noelle::DataFlowResult *DFTestSuite::applyDataFlowEngine(
+    DFTestSuite &pass,
+    bool isForward,
+    bool storeOnlyBlockSummaries) {
+  auto F = pass.mainFunction;
+  auto computeGEN = [isForward](Instruction *i,
+                                arcana::noelle::DataFlowResult *df) {
+    std::vector<Value *> gen, kill;
+    DFTestSuite::computeGENAndKILL(i, isForward, gen, kill);
+    df->GEN(i).insert(gen.begin(), gen.end());
+  };
+  auto computeKILL = [isForward](Instruction *i,
+                                 arcana::noelle::DataFlowResult *df) {
+    std::vector<Value *> gen, kill;
+    DFTestSuite::computeGENAndKILL(i, isForward, gen, kill);
+    df->KILL(i).insert(kill.begin(), kill.end());
+  };
+
+  /*
+   * The set after an instruction is its GEN plus the set before it minus its
+   * KILL.
+   */
+  auto transfer = [](Instruction *i,
+                     std::set<Value *> &before,
+                     std::set<Value *> &after,
+                     arcana::noelle::DataFlowResult *df) {
+    auto &gen = df->GEN(i);
+    auto &kill = df->KILL(i);
+    after.insert(gen.begin(), gen.end());
+    for (auto v : before) {
+      if (kill.count(v) == 0) {
+        after.insert(v);
+      }
+    }
+  };
+
+  arcana::noelle::DataFlowEngine engine(storeOnlyBlockSummaries);
+  if (isForward) {
+    return engine.applyForward(
+        F,
+        computeGEN,
+        computeKILL,
+        [](Instruction *inst, std::set<Value *> &IN) { return; },
+        [](Instruction *inst, std::set<Value *> &OUT) { return; },
+        [](Instruction *inst,
+           Instruction *predecessor,
+           std::set<Value *> &IN,
+           arcana::noelle::DataFlowResult *df) {
+          auto &predecessorOUT = df->OUT(predecessor);
+          IN.insert(predecessorOUT.begin(), predecessorOUT.end());
+        },
+        [transfer](Instruction *inst,
+                   std::set<Value *> &OUT,
+                   arcana::noelle::DataFlowResult *df) {
+          transfer(inst, df->IN(inst), OUT, df);
+        });
+  }
+
+  return engine.applyBackward(
+      F,
+      computeGEN,
+      computeKILL,
+      [transfer](Instruction *inst,
+                 std::set<Value *> &IN,
+                 arcana::noelle::DataFlowResult *df) {
+        transfer(inst, df->OUT(inst), IN, df);
+      },
+      [](Instruction *inst,
+         Instruction *successor,
+         std::set<Value *> &OUT,
+         arcana::noelle::DataFlowResult *df) {
+        auto &successorIN = df->IN(successor);
+        OUT.insert(successorIN.begin(), successorIN.end());
+      });
+}
+
+Values DFTestSuite::compareBlockSummariesWithAllSets(ModulePass &pass,
+                                                     bool isForward) {
+  auto &dfPass = static_cast<DFTestSuite &>(pass);
+
+  /*
+   * Compute the expected sets.
+   */
+  std::vector<BasicBlock *> blocks;
+  for (auto &bb : *dfPass.mainFunction) {
+    blocks.push_back(&bb);
+  }
+  std::unordered_map<Instruction *, std::set<Value *>> IN, OUT;
+  DFTestSuite::computeExpectedSets(blocks, isForward, {}, IN, OUT);
+
+  /*
+   * Both modes must compute the expected sets with the same iterations.
+   */
+  Values errors;
+  auto allSets = DFTestSuite::applyDataFlowEngine(dfPass, isForward, false);
+  auto summaries = DFTestSuite::applyDataFlowEngine(dfPass, isForward, true);
+  for (auto &inst : instructions(*dfPass.mainFunction)) {
+    auto name = dfPass.suite->valueToString(&inst);
+    if ((allSets->IN(&inst) != IN[&inst])
+        || (allSets->OUT(&inst) != OUT[&inst])) {
+      errors.insert("The sets of " + name + " are not correct");
+    }
+    if ((summaries->OUT(&inst) != OUT[&inst])
+        || (summaries->IN(&inst) != IN[&inst])) {
+      errors.insert("The replayed sets of " + name + " are not correct");
+    }
+  }
+  if (allSets->getNumberOfBlockIterations()
+      != summaries->getNumberOfBlockIterations()) {
+    errors.insert("Keeping only block summaries changes the iterations");
+  }
+  delete summaries;
+  delete allSets;
+
+  return errors;
+}
+
+Values DFTestSuite::forwardBlockSummariesMatchAllSets(ModulePass &pass,
+                                                      TestSuite &suite) {
+  return DFTestSuite::compareBlockSummariesWithAllSets(pass, true);
+}
+
+Values DFTestSuite::backwardBlockSummariesMatchAllSets(ModulePass &pass,
+                                                       TestSuite &suite) {
+  return DFTestSuite::compareBlockSummariesWithAllSets(pass, false);
+}
+
+std::vector<std::vector<uint32_t>> DFTestSuite::getFlowsTo(
+    const std::vector<BasicBlock *> &blocks) {
+  std::unordered_map<BasicBlock *, uint32_t> blockIDs;
+  for (auto b = 0u; b < blocks.size(); b++) {
+    blockIDs[blocks[b]] = b;
+  }
+  std::vector<std::vector<uint32_t>> flowsTo(blocks.size());
+  for (auto b = 0u; b < blocks.size(); b++) {
+    for (auto succ : successors(blocks[b])) {
+      flowsTo[b].push_back(blockIDs.at(succ));
+    }
+  }
+
+  return flowsTo;
+}
+
+Values DFTestSuite::workListPopsInReversePostOrder(ModulePass &pass,
+                                                   TestSuite &suite) {
+  auto &dfPass = static_cast<DFTestSuite &>(pass);
+  std::vector<BasicBlock *> blocks;
+  for (auto &bb : *dfPass.mainFunction) {
+    blocks.push_back(&bb);
+  }
+  auto flowsTo = DFTestSuite::getFlowsTo(blocks);
+
+  /*
+   * Pop every basic block.
+   */
+  arcana::noelle::DataFlowWorkList workList(flowsTo);
+  workList.pushAll();
+  std::vector<uint32_t> order(blocks.size(), 0);
+  std::vector<uint32_t> pops(blocks.size(), 0);
+  auto position = 0u;
+  while (!workList.empty()) {
+    auto b = workList.pop();
+    order[b] = position++;
+    pops[b]++;
+  }
+  Values errors;
+  if (workList.getNumberOfIterations() != blocks.size()) {
+    errors.insert("The iterations are not the blocks popped");
+  }
+  if (std::count(pops.begin(), pops.end(), 1) != (int64_t)blocks.size()) {
+    errors.insert("A block is not popped exactly once");
+  }
+  if (order[0] != 0) {
+    errors.insert("The entry block is not popped first");
+  }
+
+  /*
+   * A basic block must come after its predecessors, except along back edges.
+   */
+  DominatorTree DT(*dfPass.mainFunction);
+  for (auto b = 0u; b < blocks.size(); b++) {
+    for (auto succ : flowsTo[b]) {
+      if (DT.dominates(blocks[succ], blocks[b])) {
+        continue;
+      }
+      if (order[succ] < order[b]) {
+        errors.insert(dfPass.suite->printAsOperandToString(blocks[succ])
+                      + " is popped before its predecessor "
+                      + dfPass.suite->printAsOperandToString(blocks[b]));
+      }
+    }
+  }
+
+  return errors;
+}
+
+Values DFTestSuite::workListIncludesABlockOnce(ModulePass &pass,
+                                               TestSuite &suite) {
+  auto &dfPass = static_cast<DFTestSuite &>(pass);
+  std::vector<BasicBlock *> blocks;
+  for (auto &bb : *dfPass.mainFunction) {
+    blocks.push_back(&bb);
+  }
+  arcana::noelle::DataFlowWorkList workList(DFTestSuite::getFlowsTo(blocks));
+  Values errors;
+
+  /*
+   * Pushing a basic block already in the list must not add it again.
+   */
+  workList.pushAll();
+  workList.pushAll();
+  auto pops = 0u;
+  while (!workList.empty()) {
+    auto b = workList.pop();
+    pops++;
+    if (pops == 1) {
+      workList.push(b);
+      workList.push(b);
+    }
+  }
+  if (pops != (blocks.size() + 1)) {
+    errors.insert("A block is in the list more than once");
+  }
+  if (workList.getNumberOfIterations() != pops) {
+    errors.insert("The iterations are not the blocks popped");
+  }
+
+  return errors;
+}
+
+Values DFTestSuite::analysesConvergeWithinTheLoopDepthBound(
+    ModulePass &pass,
+    TestSuite &suite) {
+  auto &dfPass = static_cast<DFTestSuite &>(pass);
+  auto F = dfPass.mainFunction;
+
+  /*
+   * Following the reverse post-order, an analysis whose sets are unions of
+   * GEN and KILL converges after visiting the blocks as many times as the
+   * loops are nested plus two.
+   */
+  auto depth = 0u;
+  for (auto loop : dfPass.li->getLoopsInPreorder()) {
+    depth = std::max(depth, loop->getLoopDepth());
+  }
+  auto bound = F->size() * (depth + 2);
+
+  Values errors;
+  for (auto isForward : { true, false }) {
+    auto direction = std::string(isForward ? "forward" : "backward");
+    auto computeGENAndKILL = [isForward](Instruction *i,
+                                         std::vector<Value *> &GEN,
+                                         std::vector<Value *> &KILL) {
+      DFTestSuite::computeGENAndKILL(i, isForward, GEN, KILL);
+    };
+    arcana::noelle::DenseDataFlowEngine denseEngine{};
+    auto denseResult =
+        isForward
+            ? denseEngine.applyForward(F, dfPass.domain, computeGENAndKILL)
+            : denseEngine.applyBackward(F, dfPass.domain, computeGENAndKILL);
+    if (denseResult->getNumberOfBlockIterations() > bound) {
+      errors.insert("The dense " + direction + " analysis exceeds the bound");
+    }
+    delete denseResult;
+
+    auto result = DFTestSuite::applyDataFlowEngine(dfPass, isForward, false);
+    if (result->getNumberOfBlockIterations() > bound) {
+      errors.insert("The " + direction + " analysis exceeds the bound");
+    }
+    delete result;
+  }
+
+  return errors;
+}
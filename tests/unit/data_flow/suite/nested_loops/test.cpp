@@ -0,0 +1,19 @@
+#include <stdio.h>
+#include <stdint.h>
+
+int main (int argc, char *argv[]){
+  int s = 0;
+
+  for (int i = 0; i < argc * 10; ++i) {
+    for (int j = 0; j < i; ++j) {
+      if (j % 3) {
+        s += j;
+      } else {
+        s -= i;
+      }
+    }
+  }
+
+  printf("%d\n", s);
+  return 0;
+}
@@ -65,6 +65,25 @@ private:
                                                    TestSuite &suite);
   static Values sccdagExternalNodesOfOutermostLoop(ModulePass &pass,
                                                    TestSuite &suite);
+  static Values frozenPDGHasAllDGEdgesInProgram(ModulePass &pass,
+                                                TestSuite &suite);
+  static Values frozenPDGAdjacencyMatchesNodes(ModulePass &pass,
+                                               TestSuite &suite);
+  static Values frozenPDGIsDroppedByModifications(ModulePass &pass,
+                                                  TestSuite &suite);
+  static Values frozenPDGOutlivesModificationsDuringWalks(ModulePass &pass,
+                                                          TestSuite &suite);
+  static Values arenaRecyclesRemovedDependences(ModulePass &pass,
+                                                TestSuite &suite);
+  static Values fdgCacheKeepsFDGsUntilInvalidated(ModulePass &pass,
+                                                  TestSuite &suite);
+  static Values fdgViewHasTheDependencesOfTheFDG(ModulePass &pass,
+                                                 TestSuite &suite);
+  static Values sccIsAViewUntilItIsMaterialized(ModulePass &pass,
+                                                TestSuite &suite);
+
+  static std::string describeDependence(TestSuite &suite,
+                                        DGEdge<Value, Value> *dependence);
 
   Values getSCCValues(std::set<SCC *> sccs);
 
@@ -54,7 +54,15 @@ const char *DGTestSuite::tests[] = {
   "pdg leaf values",
   "pdg disjoint values",
   "sccdag internal nodes (of outermost loop)",
-  "sccdag external nodes (of outermost loop)"
+  "sccdag external nodes (of outermost loop)",
+  "frozen pdg edges",
+  "frozen pdg adjacency matches the nodes",
+  "frozen pdg is dropped by modifications",
+  "frozen pdg outlives modifications during walks",
+  "dg arena recycles the memory of removed dependences",
+  "fdg cache keeps fdgs until they are invalidated",
+  "fdg view has the dependences of the fdg",
+  "scc is a view of the graph until it is materialized"
 };
 
 TestFunction DGTestSuite::testFns[] = {
@@ -65,7 +73,15 @@ TestFunction DGTestSuite::testFns[] = {
   DGTestSuite::pdgIdentifiesLeafValues,
   DGTestSuite::pdgIdentifiesDisconnectedValueSets,
   DGTestSuite::sccdagInternalNodesOfOutermostLoop,
-  DGTestSuite::sccdagExternalNodesOfOutermostLoop
+  DGTestSuite::sccdagExternalNodesOfOutermostLoop,
+  DGTestSuite::frozenPDGHasAllDGEdgesInProgram,
+  DGTestSuite::frozenPDGAdjacencyMatchesNodes,
+  DGTestSuite::frozenPDGIsDroppedByModifications,
+  DGTestSuite::frozenPDGOutlivesModificationsDuringWalks,
+  DGTestSuite::arenaRecyclesRemovedDependences,
+  DGTestSuite::fdgCacheKeepsFDGsUntilInvalidated,
+  DGTestSuite::fdgViewHasTheDependencesOfTheFDG,
+  DGTestSuite::sccIsAViewUntilItIsMaterialized
 };
 
 bool DGTestSuite::doInitialization(Module &M) {
@@ -224,3 +240,532 @@ Values DGTestSuite::getSCCValues(std::set<SCC *> sccs) {
   }
   return sccStrings;
 }
+
+Values DGTestSuite::frozenPDGHasAllDGEdgesInProgram(ModulePass &pass,
+                                                    TestSuite &suite) {
+  auto &dgPass = static_cast<DGTestSuite &>(pass);
+  using Edge = DGEdge<Value, Value>;
+
+  /*
+   * Walk the edges through the CSR adjacency of the frozen form.
+   */
+  dgPass.fdg->freeze();
+  auto frozen = dgPass.fdg->getFrozenForm();
+  Values valueNames;
+  for (auto nodeID = 0u; nodeID < frozen->getNumberOfNodes(); nodeID++) {
+    for (auto edgeID : frozen->getOutgoingEdgeIDs(nodeID)) {
+      auto outName = suite.valueToString(frozen->getT(nodeID));
+      auto inName = suite.valueToString(frozen->getT(frozen->getDstID(edgeID)));
+      auto kind = frozen->getKind(edgeID);
+      auto type = (kind == Edge::CONTROL_DEPENDENCE)
+                      ? "control"
+                      : (((kind >= Edge::FIRST_MEMORY_DEPENDENCE)
+                          && (kind <= Edge::LAST_MEMORY_DEPENDENCE))
+                             ? "memory"
+                             : "data");
+      auto delim = suite.orderedValueDelimiter;
+      valueNames.insert(outName + delim + inName + delim + type);
+    }
+  }
+  dgPass.fdg->thaw();
+
+  return valueNames;
+}
+
+Values DGTestSuite::frozenPDGAdjacencyMatchesNodes(ModulePass &pass,
+                                                   TestSuite &suite) {
+  auto &dgPass = static_cast<DGTestSuite &>(pass);
+  dgPass.fdg->freeze();
+  auto frozen = dgPass.fdg->getFrozenForm();
+  Values errors;
+
+  if (frozen->getNumberOfNodes() != dgPass.fdg->numNodes()) {
+    errors.insert("The frozen form does not have all the nodes");
+  }
+  if (frozen->getNumberOfEdges() != dgPass.fdg->numEdges()) {
+    errors.insert("The frozen form does not have all the edges");
+  }
+
+  /*
+   * The edges of every node stored in CSR form must be the ones of the node,
+   * and the filtered iterations must visit them.
+   */
+  for (auto node : dgPass.fdg->getNodes()) {
+    auto value = node->getT();
+    auto nodeName = suite.valueToString(value);
+    auto nodeID = frozen->getNodeID(node);
+    if ((frozen->getNode(nodeID) != node) || (frozen->getT(nodeID) != value)
+        || (frozen->getNodeID(value) != nodeID)) {
+      errors.insert("Wrong ID of " + nodeName);
+    }
+
+    std::set<DGEdge<Value, Value> *> outgoing, incoming;
+    for (auto edgeID : frozen->getOutgoingEdgeIDs(nodeID)) {
+      if (frozen->getSrcID(edgeID) != nodeID) {
+        errors.insert("Wrong outgoing edge of " + nodeName);
+      }
+      outgoing.insert(frozen->getEdge(edgeID));
+    }
+    for (auto edgeID : frozen->getIncomingEdgeIDs(nodeID)) {
+      if (frozen->getDstID(edgeID) != nodeID) {
+        errors.insert("Wrong incoming edge of " + nodeName);
+      }
+      incoming.insert(frozen->getEdge(edgeID));
+    }
+    auto nodeOutgoingEdges = node->getOutgoingEdges();
+    auto nodeIncomingEdges = node->getIncomingEdges();
+    std::set<DGEdge<Value, Value> *> nodeOutgoing(nodeOutgoingEdges.begin(),
+                                                  nodeOutgoingEdges.end());
+    std::set<DGEdge<Value, Value> *> nodeIncoming(nodeIncomingEdges.begin(),
+                                                  nodeIncomingEdges.end());
+    if (outgoing != nodeOutgoing) {
+      errors.insert("Outgoing edges differ for " + nodeName);
+    }
+    if (incoming != nodeIncoming) {
+      errors.insert("Incoming edges differ for " + nodeName);
+    }
+
+    std::set<DGEdge<Value, Value> *> visitedOutgoing, visitedIncoming;
+    frozen->iterateOverEdgesFrom(
+        value,
+        true,
+        true,
+        true,
+        [&](Value *dst, DGEdge<Value, Value> *edge) -> bool {
+          if (edge->getDst() != dst) {
+            errors.insert("Wrong destination from " + nodeName);
+          }
+          visitedOutgoing.insert(edge);
+          return false;
+        });
+    frozen->iterateOverEdgesTo(
+        value,
+        true,
+        true,
+        true,
+        [&](Value *src, DGEdge<Value, Value> *edge) -> bool {
+          if (edge->getSrc() != src) {
+            errors.insert("Wrong source to " + nodeName);
+          }
+          visitedIncoming.insert(edge);
+          return false;
+        });
+    if (visitedOutgoing != nodeOutgoing) {
+      errors.insert("Iteration from " + nodeName + " misses edges");
+    }
+    if (visitedIncoming != nodeIncoming) {
+      errors.insert("Iteration to " + nodeName + " misses edges");
+    }
+
+    /*
+     * Excluding every kind of dependence must not visit any edge.
+     */
+    auto visited = frozen->iterateOverEdgesFrom(
+        value,
+        false,
+        false,
+        false,
+        [](Value *dst, DGEdge<Value, Value> *edge) -> bool { return true; });
+    if (visited) {
+      errors.insert("Iteration from " + nodeName + " ignores the filters");
+    }
+  }
+  dgPass.fdg->thaw();
+
+  return errors;
+}
+
+Values DGTestSuite::frozenPDGIsDroppedByModifications(ModulePass &pass,
+                                                      TestSuite &suite) {
+  auto &dgPass = static_cast<DGTestSuite &>(pass);
+  Values errors;
+
+  /*
+   * Modify a copy of the graph of the outermost loop.
+   */
+  auto &LI =
+      dgPass.getAnalysis<LoopInfoWrapperPass>(*dgPass.mainF).getLoopInfo();
+  auto l = LI.getLoopsInPreorder()[0];
+  auto ldg = dgPass.fdg->createLoopsSubgraph(l);
+  ldg->freeze();
+  if (!ldg->isFrozen() || (ldg->getFrozenForm() == nullptr)) {
+    errors.insert("The graph has not been frozen");
+  }
+  auto edge = *ldg->getEdges().begin();
+  ldg->removeEdge(edge);
+  if (ldg->isFrozen() || (ldg->getFrozenForm() != nullptr)) {
+    errors.insert("Removing an edge does not drop the frozen form");
+  }
+
+  /*
+   * The frozen form of the modified graph must not include the removed edge.
+   */
+  ldg->freeze();
+  auto frozen = ldg->getFrozenForm();
+  if (frozen->getNumberOfEdges() != ldg->numEdges()) {
+    errors.insert("The frozen form does not follow the modified graph");
+  }
+  delete ldg;
+
+  return errors;
+}
+
+Values DGTestSuite::frozenPDGOutlivesModificationsDuringWalks(
+    ModulePass &pass,
+    TestSuite &suite) {
+  auto &dgPass = static_cast<DGTestSuite &>(pass);
+  Values errors;
+
+  /*
+   * Fetch the node of the outermost loop with the most outgoing edges.
+   */
+  auto &LI =
+      dgPass.getAnalysis<LoopInfoWrapperPass>(*dgPass.mainF).getLoopInfo();
+  auto l = LI.getLoopsInPreorder()[0];
+  auto ldg = dgPass.fdg->createLoopsSubgraph(l);
+  DGNode<Value> *source = nullptr;
+  for (auto node : ldg->getNodes()) {
+    if ((source == nullptr)
+        || (node->outDegree() > source->outDegree())) {
+      source = node;
+    }
+  }
+  auto numberOfEdges = source->outDegree();
+
+  /*
+   * Remove every edge while the walk visits it.
+   * The first removal thaws the graph, but the walk must go on over the frozen
+   * form it started from.
+   */
+  ldg->freeze();
+  auto visited = 0u;
+  ldg->iterateOverDependencesFrom(
+      source->getT(),
+      true,
+      true,
+      true,
+      [ldg, &visited](Value *dst, DGEdge<Value, Value> *edge) -> bool {
+        visited++;
+        ldg->removeEdge(edge);
+        return false;
+      });
+  if (visited != numberOfEdges) {
+    errors.insert("The walk did not visit all the edges");
+  }
+  if (ldg->isFrozen()) {
+    errors.insert("Removing edges during a walk does not thaw the graph");
+  }
+  if (source->outDegree() != 0) {
+    errors.insert("Not all the edges have been removed");
+  }
+  delete ldg;
+
+  return errors;
+}
+
+Values DGTestSuite::arenaRecyclesRemovedDependences(ModulePass &pass,
+                                                    TestSuite &suite) {
+  auto &dgPass = static_cast<DGTestSuite &>(pass);
+  Values errors;
+
+  /*
+   * Fetch a control dependence of a copy of the graph of the outermost loop.
+   */
+  auto &LI =
+      dgPass.getAnalysis<LoopInfoWrapperPass>(*dgPass.mainF).getLoopInfo();
+  auto l = LI.getLoopsInPreorder()[0];
+  auto ldg = dgPass.fdg->createLoopsSubgraph(l);
+  DGEdge<Value, Value> *dependence = nullptr;
+  for (auto edge : ldg->getEdges()) {
+    if (isa<ControlDependence<Value, Value>>(edge)) {
+      dependence = edge;
+      break;
+    }
+  }
+  if (dependence == nullptr) {
+    errors.insert("The loop has no control dependence");
+    delete ldg;
+    return errors;
+  }
+  auto src = dependence->getSrc();
+  auto dst = dependence->getDst();
+
+  /*
+   * The objects of the graph must be in the slabs of its arena.
+   */
+  auto &arena = ldg->getArena();
+  auto bytesInUse = arena.getNumberOfBytesInUse();
+  auto bytesReserved = arena.getNumberOfBytesReserved();
+  auto recycledObjects = arena.getNumberOfRecycledObjects();
+  if ((bytesInUse == 0) || (bytesInUse > bytesReserved)) {
+    errors.insert("The arena does not account the nodes and edges");
+  }
+
+  /*
+   * The memory of a removed dependence must be kept for the next one.
+   */
+  ldg->removeEdge(dependence);
+  if (arena.getNumberOfBytesInUse() >= bytesInUse) {
+    errors.insert("Removing a dependence does not release its memory");
+  }
+  if (arena.getNumberOfBytesToRecycle() == 0) {
+    errors.insert("The memory of a removed dependence is not recycled");
+  }
+
+  /*
+   * A new dependence of the same kind must reuse that memory.
+   */
+  auto bytesToRecycle = arena.getNumberOfBytesToRecycle();
+  ldg->addControlDependenceEdge(src, dst);
+  if (arena.getNumberOfRecycledObjects() != (recycledObjects + 1)) {
+    errors.insert(
+        "A new dependence does not reuse the memory of a removed one");
+  }
+  if (arena.getNumberOfBytesToRecycle() >= bytesToRecycle) {
+    errors.insert("The recycled memory is still available");
+  }
+  if (arena.getNumberOfBytesInUse() != bytesInUse) {
+    errors.insert("The memory in use does not match the graph");
+  }
+  if (arena.getNumberOfBytesReserved() != bytesReserved) {
+    errors.insert("Recycling memory reserves more slabs");
+  }
+  delete ldg;
+
+  return errors;
+}
+
+std::string DGTestSuite::describeDependence(TestSuite &suite,
+                                            DGEdge<Value, Value> *dependence) {
+  auto outName = suite.valueToString(dependence->getSrc());
+  auto inName = suite.valueToString(dependence->getDst());
+  auto type =
+      isa<ControlDependence<Value, Value>>(dependence)
+          ? "control"
+          : (isa<MemoryDependence<Value, Value>>(dependence) ? "memory"
+                                                             : "data");
+  auto delim = suite.orderedValueDelimiter;
+
+  return outName + delim + inName + delim + type;
+}
+
+Values DGTestSuite::fdgCacheKeepsFDGsUntilInvalidated(ModulePass &pass,
+                                                      TestSuite &suite) {
+  auto &dgPass = static_cast<DGTestSuite &>(pass);
+  auto pdg =
+      dgPass.getAnalysis<NoellePass>().getNoelle().getProgramDependenceGraph();
+  FunctionDependenceGraphCache cache([pdg](void) -> PDG * { return pdg; });
+  Values errors;
+
+  /*
+   * The first request computes the FDG and the next ones return it.
+   */
+  auto fdg = cache.getFunctionDependenceGraph(*dgPass.mainF);
+  if ((cache.getNumberOfMisses() != 1) || (cache.getNumberOfHits() != 0)) {
+    errors.insert("The first request is not a miss");
+  }
+  if (cache.getFunctionDependenceGraph(*dgPass.mainF) != fdg) {
+    errors.insert("The second request does not return the cached FDG");
+  }
+  if ((cache.getNumberOfMisses() != 1) || (cache.getNumberOfHits() != 1)) {
+    errors.insert("The second request is not a hit");
+  }
+
+  /*
+   * The cached FDG must have the dependences of the one created from the PDG.
+   */
+  std::set<std::string> cachedDependences, expectedDependences;
+  for (auto edge : fdg->getEdges()) {
+    cachedDependences.insert(DGTestSuite::describeDependence(suite, edge));
+  }
+  for (auto edge : dgPass.fdg->getEdges()) {
+    expectedDependences.insert(DGTestSuite::describeDependence(suite, edge));
+  }
+  if (cachedDependences != expectedDependences) {
+    errors.insert("The cached FDG does not have the dependences of the PDG");
+  }
+
+  /*
+   * Invalidating the function drops its FDG, so it is computed again.
+   */
+  cache.invalidate(*dgPass.mainF);
+  if (cache.getNumberOfInvalidations() != 1) {
+    errors.insert("The invalidation is not accounted");
+  }
+  cache.getFunctionDependenceGraph(*dgPass.mainF);
+  if (cache.getNumberOfMisses() != 2) {
+    errors.insert("The request after the invalidation is not a miss");
+  }
+
+  return errors;
+}
+
+Values DGTestSuite::fdgViewHasTheDependencesOfTheFDG(ModulePass &pass,
+                                                     TestSuite &suite) {
+  auto &dgPass = static_cast<DGTestSuite &>(pass);
+  auto pdg =
+      dgPass.getAnalysis<NoellePass>().getNoelle().getProgramDependenceGraph();
+  FunctionDependenceGraphView view(pdg, *dgPass.mainF);
+  Values errors;
+
+  /*
+   * The view must include every dependence of the FDG once.
+   */
+  std::multiset<std::string> viewDependences, fdgDependences;
+  view.iterateOverDependences(
+      true,
+      true,
+      true,
+      [&](DGEdge<Value, Value> *dependence) -> bool {
+        viewDependences.insert(
+            DGTestSuite::describeDependence(suite, dependence));
+        return false;
+      });
+  for (auto edge : dgPass.fdg->getEdges()) {
+    fdgDependences.insert(DGTestSuite::describeDependence(suite, edge));
+  }
+  if (viewDependences != fdgDependences) {
+    errors.insert("The view does not have the dependences of the FDG");
+  }
+
+  /*
+   * The dependences from and to every value must be the ones of its node.
+   */
+  for (auto node : dgPass.fdg->getNodes()) {
+    auto value = node->getT();
+    auto nodeName = suite.valueToString(value);
+    if (view.isInternal(value) != dgPass.fdg->isInternal(value)) {
+      errors.insert("The view does not include " + nodeName);
+    }
+
+    std::multiset<std::string> outgoing, incoming, viewOutgoing, viewIncoming;
+    for (auto edge : node->getOutgoingEdges()) {
+      outgoing.insert(DGTestSuite::describeDependence(suite, edge));
+    }
+    for (auto edge : node->getIncomingEdges()) {
+      incoming.insert(DGTestSuite::describeDependence(suite, edge));
+    }
+    view.iterateOverDependencesFrom(
+        value,
+        true,
+        true,
+        true,
+        [&](Value *to, DGEdge<Value, Value> *dependence) -> bool {
+          viewOutgoing.insert(
+              DGTestSuite::describeDependence(suite, dependence));
+          return false;
+        });
+    view.iterateOverDependencesTo(
+        value,
+        true,
+        true,
+        true,
+        [&](Value *from, DGEdge<Value, Value> *dependence) -> bool {
+          viewIncoming.insert(
+              DGTestSuite::describeDependence(suite, dependence));
+          return false;
+        });
+    if (viewOutgoing != outgoing) {
+      errors.insert("Dependences from " + nodeName + " differ");
+    }
+    if (viewIncoming != incoming) {
+      errors.insert("Dependences to " + nodeName + " differ");
+    }
+  }
+
+  return errors;
+}
+
+Values DGTestSuite::sccIsAViewUntilItIsMaterialized(ModulePass &pass,
+                                                    TestSuite &suite) {
+  auto &dgPass = static_cast<DGTestSuite &>(pass);
+  Values errors;
+
+  /*
+   * Compute the SCCs of a copy of the graph of the outermost loop, so the
+   * graph can be freed once the SCCs are materialized.
+   */
+  auto &LI =
+      dgPass.getAnalysis<LoopInfoWrapperPass>(*dgPass.mainF).getLoopInfo();
+  auto l = LI.getLoopsInPreorder()[0];
+  auto ldg = dgPass.fdg->createLoopsSubgraph(l);
+  auto sccdag = new SCCDAG(ldg);
+
+  /*
+   * Describe every SCC.
+   */
+  auto describeSCC = [&suite](SCC *scc) -> std::string {
+    std::set<std::string> internalValues, externalValues, dependences;
+    for (auto nodePair : scc->internalNodePairs()) {
+      internalValues.insert(suite.valueToString(nodePair.first));
+    }
+    for (auto nodePair : scc->externalNodePairs()) {
+      externalValues.insert(suite.valueToString(nodePair.first));
+    }
+    for (auto edge : scc->getEdges()) {
+      dependences.insert(DGTestSuite::describeDependence(suite, edge));
+    }
+    std::string description;
+    for (auto &values : { internalValues, externalValues, dependences }) {
+      for (auto &value : values) {
+        description += value + suite.unorderedValueDelimiter;
+      }
+      description += suite.orderedValueDelimiter;
+    }
+    description += scc->hasCycle(false) ? "cycle" : "acyclic";
+    description += scc->hasCycle(true) ? " cycle" : " acyclic";
+
+    return description;
+  };
+  std::vector<SCC *> sccs;
+  std::vector<std::string> descriptions;
+  for (auto sccNode : sccdag->getNodes()) {
+    auto scc = sccNode->getT();
+    sccs.push_back(scc);
+    descriptions.push_back(describeSCC(scc));
+  }
+
+  /*
+   * The nodes and dependences of a view must be the ones of the graph.
+   */
+  for (auto scc : sccs) {
+    if (!scc->isView()) {
+      errors.insert("A new SCC is not a view of the graph");
+    }
+    for (auto nodePair : scc->internalNodePairs()) {
+      if (ldg->fetchNode(nodePair.first) != nodePair.second) {
+        errors.insert("A node of a view is not the one of the graph");
+      }
+    }
+    for (auto edge : scc->getEdges()) {
+      if (!scc->isDependenceOfSCC(edge)) {
+        errors.insert("An edge of a view is not a dependence of the SCC");
+      }
+    }
+  }
+
+  /*
+   * Materialized SCCs must be the same as their views, and they must not rely
+   * on the graph.
+   */
+  for (auto scc : sccs) {
+    scc->materialize();
+    if (scc->isView()) {
+      errors.insert("A materialized SCC is still a view");
+    }
+    for (auto nodePair : scc->internalNodePairs()) {
+      if (ldg->fetchNode(nodePair.first) == nodePair.second) {
+        errors.insert("A materialized SCC shares a node with the graph");
+      }
+    }
+  }
+  delete ldg;
+  for (auto i = 0u; i < sccs.size(); i++) {
+    if (describeSCC(sccs[i]) != descriptions[i]) {
+      errors.insert("A materialized SCC differs from its view");
+    }
+  }
+  delete sccdag;
+
+  return errors;
+}
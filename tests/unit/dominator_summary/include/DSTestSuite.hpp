@@ -27,10 +27,14 @@
 #include "llvm/IR/Instructions.h"
 #include "llvm/IR/Dominators.h"
 #include "llvm/Analysis/PostDominators.h"
+#include "llvm/Analysis/LoopInfo.h"
 #include "llvm/Support/GenericDomTree.h"
 
 #include "TestSuite.hpp"
 #include "arcana/noelle/core/Dominators.hpp"
+#include "arcana/noelle/core/LoopStructure.hpp"
+#include "arcana/noelle/core/InstructionReachability.hpp"
+#include "arcana/noelle/core/InstructionReachabilityCache.hpp"
 
 #include <sstream>
 #include <vector>
@@ -67,6 +71,43 @@ private:
                                    DTBase &DT,
                                    arcana::noelle::DominatorForest &DTS);
 
+  static Values blockDominanceIsIdentical(ModulePass &pass, TestSuite &suite);
+  static Values instructionDominanceIsCorrect(ModulePass &pass,
+                                              TestSuite &suite);
+  static Values instructionsDoNotPostDominateThemselves(ModulePass &pass,
+                                                        TestSuite &suite);
+  static Values subsetDominanceIsIdentical(ModulePass &pass,
+                                           TestSuite &suite);
+
+  template <class DTBase>
+  static Values blockDominanceIsIdentical(DSTestSuite &pass,
+                                          DTBase &DT,
+                                          arcana::noelle::DominatorForest &DTS);
+
+  static Values instructionDominanceIsCorrect(
+      DSTestSuite &pass,
+      arcana::noelle::DominatorForest &DTS,
+      bool post);
+
+  static Values instructionsDoNotPostDominateThemselves(
+      DSTestSuite &pass,
+      arcana::noelle::DominatorSummary &ds);
+
+  static Values functionReachabilityIsCorrect(ModulePass &pass,
+                                              TestSuite &suite);
+  static Values loopReachabilityIsCorrect(ModulePass &pass, TestSuite &suite);
+  static Values reachabilityIsCached(ModulePass &pass, TestSuite &suite);
+
+  static Values reachabilityIsCorrect(
+      DSTestSuite &pass,
+      const arcana::noelle::InstructionReachability &reachability,
+      Loop *loop);
+
+  static bool isReachableInCFG(BasicBlock *from, BasicBlock *to, Loop *loop);
+
+  Function *mainFunction;
+  LoopInfo *li;
+
   TestSuite *suite;
   Module *M;
   arcana::noelle::DominatorSummary *ds;
@@ -48,9 +48,23 @@ static RegisterStandardPasses _RegPass2(
 
 const char *DSTestSuite::tests[] = {
   "dom trees are identical",
+  "block dominance is identical",
+  "instruction dominance is correct",
+  "instructions do not post-dominate themselves",
+  "dominance of a subset of blocks is identical",
+  "function reachability is correct",
+  "loop reachability is correct",
+  "reachability is cached",
 };
 TestFunction DSTestSuite::testFns[] = {
   DSTestSuite::domTreesAreIdentical,
+  DSTestSuite::blockDominanceIsIdentical,
+  DSTestSuite::instructionDominanceIsCorrect,
+  DSTestSuite::instructionsDoNotPostDominateThemselves,
+  DSTestSuite::subsetDominanceIsIdentical,
+  DSTestSuite::functionReachabilityIsCorrect,
+  DSTestSuite::loopReachabilityIsCorrect,
+  DSTestSuite::reachabilityIsCached,
 };
 
 bool DSTestSuite::doInitialization(Module &M) {
@@ -65,16 +79,19 @@ bool DSTestSuite::doInitialization(Module &M) {
 void DSTestSuite::getAnalysisUsage(AnalysisUsage &AU) const {
   AU.addRequired<DominatorTreeWrapperPass>();
   AU.addRequired<PostDominatorTreeWrapperPass>();
+  AU.addRequired<LoopInfoWrapperPass>();
 }
 
 bool DSTestSuite::runOnModule(Module &M) {
   errs() << "DSTestSuite: Start\n";
   auto mainFunction = M.getFunction("main");
+  this->mainFunction = mainFunction;
 
   this->dt = &getAnalysis<DominatorTreeWrapperPass>(*mainFunction).getDomTree();
   this->pdt = &getAnalysis<PostDominatorTreeWrapperPass>(*mainFunction)
                    .getPostDomTree();
   this->ds = new arcana::noelle::DominatorSummary(*dt, *pdt);
+  this->li = &getAnalysis<LoopInfoWrapperPass>(*mainFunction).getLoopInfo();
 
   suite->runTests((ModulePass &)*this);
 
@@ -152,3 +169,327 @@ Values DSTestSuite::domTreesAreIdentical(ModulePass &pass, TestSuite &suite) {
     return errors;
   return {};
 }
+
+template <class DTBase>
+Values DSTestSuite::blockDominanceIsIdentical(
+    DSTestSuite &pass,
+    DTBase &DT,
+    arcana::noelle::DominatorForest &DTS) {
+  Values errors;
+  for (auto &B1 : *pass.mainFunction) {
+    for (auto &B2 : *pass.mainFunction) {
+      if (DT.dominates(&B1, &B2) != DTS.dominates(&B1, &B2)) {
+        errors.insert("Dominance of " + pass.suite->printAsOperandToString(&B1)
+                      + " over " + pass.suite->printAsOperandToString(&B2)
+                      + " is not correct");
+      }
+      if (DT.properlyDominates(&B1, &B2)
+          != DTS.strictlyDominates(&B1, &B2)) {
+        errors.insert("Strict dominance of "
+                      + pass.suite->printAsOperandToString(&B1) + " over "
+                      + pass.suite->printAsOperandToString(&B2)
+                      + " is not correct");
+      }
+    }
+  }
+  return errors;
+}
+
+Values DSTestSuite::blockDominanceIsIdentical(ModulePass &pass,
+                                              TestSuite &suite) {
+  auto &dsPass = static_cast<DSTestSuite &>(pass);
+  Values errors =
+      DSTestSuite::blockDominanceIsIdentical(dsPass, *dsPass.dt, dsPass.ds->DT);
+  Values postErrors =
+      DSTestSuite::blockDominanceIsIdentical(dsPass,
+                                             *dsPass.pdt,
+                                             dsPass.ds->PDT);
+  for (auto error : postErrors) {
+    errors.insert("Post: " + error);
+  }
+  return errors;
+}
+
+Values DSTestSuite::instructionDominanceIsCorrect(
+    DSTestSuite &pass,
+    arcana::noelle::DominatorForest &DTS,
+    bool post) {
+
+  /*
+   * Number the instructions of every basic block.
+   */
+  std::unordered_map<Instruction *, uint32_t> positions;
+  for (auto &B : *pass.mainFunction) {
+    auto position = 0u;
+    for (auto &I : B) {
+      positions[&I] = position++;
+    }
+  }
+
+  /*
+   * Instructions of different blocks follow the dominance of their blocks.
+   * Within a block, an instruction dominates the ones that follow it and
+   * post-dominates the ones that precede it.
+   */
+  Values errors;
+  for (auto &B1 : *pass.mainFunction) {
+    for (auto &I : B1) {
+      for (auto &B2 : *pass.mainFunction) {
+        for (auto &J : B2) {
+          if (&I == &J) {
+            continue;
+          }
+          bool expected;
+          if (&B1 != &B2) {
+            expected = DTS.dominates(&B1, &B2);
+          } else if (post) {
+            expected = positions[&I] > positions[&J];
+          } else {
+            expected = positions[&I] < positions[&J];
+          }
+          if (DTS.dominates(&I, &J) != expected) {
+            errors.insert(std::string(post ? "Post-dominance" : "Dominance")
+                          + " of " + pass.suite->valueToString(&I) + " over "
+                          + pass.suite->valueToString(&J) + " is not correct");
+          }
+          if (DTS.strictlyDominates(&I, &J) != expected) {
+            errors.insert(std::string(post ? "Post-dominance" : "Dominance")
+                          + " of " + pass.suite->valueToString(&I) + " over "
+                          + pass.suite->valueToString(&J)
+                          + " is not strict");
+          }
+        }
+      }
+    }
+  }
+  return errors;
+}
+
+Values DSTestSuite::instructionDominanceIsCorrect(ModulePass &pass,
+                                                  TestSuite &suite) {
+  auto &dsPass = static_cast<DSTestSuite &>(pass);
+  Values errors =
+      DSTestSuite::instructionDominanceIsCorrect(dsPass, dsPass.ds->DT, false);
+  Values postErrors =
+      DSTestSuite::instructionDominanceIsCorrect(dsPass, dsPass.ds->PDT, true);
+  errors.insert(postErrors.begin(), postErrors.end());
+  return errors;
+}
+
+Values DSTestSuite::instructionsDoNotPostDominateThemselves(
+    DSTestSuite &pass,
+    arcana::noelle::DominatorSummary &ds) {
+
+  /*
+   * An instruction dominates itself, but it does not post-dominate itself.
+   * Neither relation is strict.
+   */
+  Values errors;
+  for (auto &B : *pass.mainFunction) {
+    for (auto &I : B) {
+      auto name = pass.suite->valueToString(&I);
+      if (!ds.DT.dominates(&I, &I)) {
+        errors.insert(name + " does not dominate itself");
+      }
+      if (ds.PDT.dominates(&I, &I)) {
+        errors.insert(name + " post-dominates itself");
+      }
+      if (ds.DT.strictlyDominates(&I, &I)) {
+        errors.insert(name + " strictly dominates itself");
+      }
+      if (ds.PDT.strictlyDominates(&I, &I)) {
+        errors.insert(name + " strictly post-dominates itself");
+      }
+    }
+  }
+  return errors;
+}
+
+Values DSTestSuite::instructionsDoNotPostDominateThemselves(ModulePass &pass,
+                                                            TestSuite &suite) {
+  auto &dsPass = static_cast<DSTestSuite &>(pass);
+  return DSTestSuite::instructionsDoNotPostDominateThemselves(dsPass,
+                                                              *dsPass.ds);
+}
+
+Values DSTestSuite::subsetDominanceIsIdentical(ModulePass &pass,
+                                               TestSuite &suite) {
+  auto &dsPass = static_cast<DSTestSuite &>(pass);
+
+  /*
+   * Build the summary of all the blocks from the summary of the function.
+   * It must keep both the numbering of the nodes and whether its forests
+   * describe post-dominance.
+   */
+  std::set<BasicBlock *> blocks;
+  for (auto &B : *dsPass.mainFunction) {
+    blocks.insert(&B);
+  }
+  arcana::noelle::DominatorSummary subset(*dsPass.ds, blocks);
+  Values errors =
+      DSTestSuite::blockDominanceIsIdentical(dsPass, *dsPass.dt, subset.DT);
+  Values postErrors =
+      DSTestSuite::blockDominanceIsIdentical(dsPass, *dsPass.pdt, subset.PDT);
+  for (auto error : postErrors) {
+    errors.insert("Post: " + error);
+  }
+  auto instructionErrors =
+      DSTestSuite::instructionDominanceIsCorrect(dsPass, subset.DT, false);
+  errors.insert(instructionErrors.begin(), instructionErrors.end());
+  instructionErrors =
+      DSTestSuite::instructionDominanceIsCorrect(dsPass, subset.PDT, true);
+  errors.insert(instructionErrors.begin(), instructionErrors.end());
+  instructionErrors =
+      DSTestSuite::instructionsDoNotPostDominateThemselves(dsPass, subset);
+  errors.insert(instructionErrors.begin(), instructionErrors.end());
+  return errors;
+}
+
+bool DSTestSuite::isReachableInCFG(BasicBlock *from,
+                                   BasicBlock *to,
+                                   Loop *loop) {
+
+  /*
+   * Walk the CFG from the successors of @from.
+   * Within @loop, only the blocks of a single iteration are visited.
+   */
+  if ((loop != nullptr) && (!loop->contains(from) || !loop->contains(to))) {
+    return false;
+  }
+  std::set<BasicBlock *> visited;
+  std::vector<BasicBlock *> toVisit;
+  auto visitSuccessorsOf = [&](BasicBlock *bb) {
+    for (auto succ : successors(bb)) {
+      if (loop != nullptr) {
+        if (!loop->contains(succ) || (succ == loop->getHeader())) {
+          continue;
+        }
+      }
+      if (visited.insert(succ).second) {
+        toVisit.push_back(succ);
+      }
+    }
+  };
+  visitSuccessorsOf(from);
+  while (!toVisit.empty()) {
+    auto bb = toVisit.back();
+    toVisit.pop_back();
+    if (bb == to) {
+      return true;
+    }
+    visitSuccessorsOf(bb);
+  }
+  return false;
+}
+
+Values DSTestSuite::reachabilityIsCorrect(
+    DSTestSuite &pass,
+    const arcana::noelle::InstructionReachability &reachability,
+    Loop *loop) {
+  Values errors;
+  for (auto &B1 : *pass.mainFunction) {
+    for (auto &B2 : *pass.mainFunction) {
+      auto blocksAreReachable = DSTestSuite::isReachableInCFG(&B1, &B2, loop);
+      if (reachability.canReach(&B1, &B2) != blocksAreReachable) {
+        errors.insert("Reachability of "
+                      + pass.suite->printAsOperandToString(&B2) + " from "
+                      + pass.suite->printAsOperandToString(&B1)
+                      + " is not correct");
+      }
+
+      for (auto &I : B1) {
+        for (auto &J : B2) {
+          auto expected = blocksAreReachable;
+          if ((&B1 == &B2) && (I.comesBefore(&J))
+              && ((loop == nullptr) || loop->contains(&B1))) {
+            expected = true;
+          }
+          if (reachability.canReach(&I, &J) != expected) {
+            errors.insert("Reachability of " + pass.suite->valueToString(&J)
+                          + " from " + pass.suite->valueToString(&I)
+                          + " is not correct");
+          }
+        }
+      }
+    }
+
+    for (auto &I : B1) {
+      if (reachability.isIncludedInACycle(&I)
+          != DSTestSuite::isReachableInCFG(&B1, &B1, loop)) {
+        errors.insert("Cycles including " + pass.suite->valueToString(&I)
+                      + " are not correct");
+      }
+    }
+  }
+  return errors;
+}
+
+Values DSTestSuite::functionReachabilityIsCorrect(ModulePass &pass,
+                                                  TestSuite &suite) {
+  auto &dsPass = static_cast<DSTestSuite &>(pass);
+  arcana::noelle::InstructionReachability reachability(*dsPass.mainFunction);
+  return DSTestSuite::reachabilityIsCorrect(dsPass, reachability, nullptr);
+}
+
+Values DSTestSuite::loopReachabilityIsCorrect(ModulePass &pass,
+                                              TestSuite &suite) {
+  auto &dsPass = static_cast<DSTestSuite &>(pass);
+  Values errors;
+  for (auto loop : dsPass.li->getLoopsInPreorder()) {
+    arcana::noelle::LoopStructure loopStructure(loop);
+    arcana::noelle::InstructionReachability reachability(loopStructure);
+    auto loopErrors =
+        DSTestSuite::reachabilityIsCorrect(dsPass, reachability, loop);
+    errors.insert(loopErrors.begin(), loopErrors.end());
+  }
+  return errors;
+}
+
+Values DSTestSuite::reachabilityIsCached(ModulePass &pass, TestSuite &suite) {
+  auto &dsPass = static_cast<DSTestSuite &>(pass);
+  auto &F = *dsPass.mainFunction;
+  Values errors;
+
+  /*
+   * The reachability is computed only the first time it is requested.
+   */
+  arcana::noelle::InstructionReachabilityCache cache(1);
+  auto reachability = cache.getReachability(F);
+  if (cache.getReachability(F) != reachability) {
+    errors.insert("The reachability of the function is computed again");
+  }
+  if ((cache.getNumberOfMisses() != 1) || (cache.getNumberOfHits() != 1)) {
+    errors.insert("Wrong number of hits and misses");
+  }
+
+  /*
+   * Loops share the entry of their function.
+   */
+  for (auto loop : dsPass.li->getLoopsInPreorder()) {
+    arcana::noelle::LoopStructure loopStructure(loop);
+    auto loopReachability = cache.getReachability(loopStructure);
+    if (cache.getReachability(loopStructure) != loopReachability) {
+      errors.insert("The reachability of a loop is computed again");
+    }
+  }
+  if (cache.getNumberOfFunctions() != 1) {
+    errors.insert("The cache exceeds its capacity");
+  }
+
+  /*
+   * Modifications drop the reachability, while the results already returned
+   * stay valid for their users.
+   */
+  cache.invalidate(F);
+  if (cache.getNumberOfFunctions() != 0) {
+    errors.insert("The reachability of a modified function is kept");
+  }
+  if (cache.getReachability(F) == reachability) {
+    errors.insert("The reachability of a modified function is reused");
+  }
+  if (reachability->getFunction() != &F) {
+    errors.insert("The reachability returned has been freed");
+  }
+
+  return errors;
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "llvm/Pass.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/BasicBlock.h"
+#include "llvm/IR/Instructions.h"
+
+#include "arcana/noelle/core/NoellePass.hpp"
+#include "arcana/noelle/core/LoopContent.hpp"
+#include "arcana/noelle/core/LoopForest.hpp"
+#include "arcana/noelle/core/Hot.hpp"
+#include "TestSuite.hpp"
+
+#include <sstream>
+#include <vector>
+#include <string>
+#include <map>
+#include <set>
+
+using namespace parallelizertests;
+
+namespace arcana::noelle {
+
+class LoopContentTestSuite : public ModulePass {
+public:
+  LoopContentTestSuite() : ModulePass{ ID } {}
+
+  /*
+   * Class fields
+   */
+  static char ID;
+  static const char *tests[];
+  static parallelizertests::TestFunction testFns[];
+
+  bool doInitialization(Module &M) override;
+  bool runOnModule(Module &M) override;
+  void getAnalysisUsage(AnalysisUsage &AU) const override;
+
+private:
+  static Values componentsAreComputedOnDemand(ModulePass &pass,
+                                              TestSuite &suite);
+  static Values prefetchedComponentsIncludeTheirDependences(ModulePass &pass,
+                                                            TestSuite &suite);
+  static Values lazyComponentsMatchPrefetchedOnes(ModulePass &pass,
+                                                  TestSuite &suite);
+  static Values forestsShareTheNestCache(ModulePass &pass, TestSuite &suite);
+  static Values nestCacheComputesFactsOnce(ModulePass &pass, TestSuite &suite);
+  static Values inductionVariablesFillTheNestCache(ModulePass &pass,
+                                                   TestSuite &suite);
+  static Values loopHotnessMatchesItsBlocks(ModulePass &pass,
+                                            TestSuite &suite);
+  static Values sccsAreSortedByHotness(ModulePass &pass, TestSuite &suite);
+  static Values loopContentUsesItsChunkSize(ModulePass &pass,
+                                            TestSuite &suite);
+
+  /*
+   * Return the total number of instructions executed by the loops of main,
+   * identified by their header.
+   */
+  static std::map<std::string, uint64_t> getLoopHotness(
+      LoopContentTestSuite &pass,
+      TestSuite &suite);
+
+  static std::string getComponentName(LoopContentComponent component);
+
+  /*
+   * Report the components of @LC whose state differs from @expected, which
+   * are the only ones that should have been computed.
+   */
+  static Values checkComputedComponents(
+      TestSuite &suite,
+      LoopContent *LC,
+      const std::unordered_set<LoopContentComponent> &expected);
+
+  /*
+   * Describe what the components of @LC found about every loop of its nest.
+   */
+  static Values describeComponents(TestSuite &suite, LoopContent *LC);
+
+  TestSuite *suite;
+  Module *M;
+  Function *mainF;
+};
+} // namespace arcana::noelle
@@ -0,0 +1,630 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "LoopContentTestSuite.hpp"
+
+namespace arcana::noelle {
+
+// Register pass to "opt"
+char LoopContentTestSuite::ID = 0;
+static RegisterPass<LoopContentTestSuite> X("UnitTester",
+                                            "Loop Content Unit Tester");
+
+// Register pass to "clang"
+static LoopContentTestSuite *_PassMaker = NULL;
+static RegisterStandardPasses _RegPass1(
+    PassManagerBuilder::EP_OptimizerLast,
+    [](const PassManagerBuilder &, legacy::PassManagerBase &PM) {
+      if (!_PassMaker) {
+        PM.add(_PassMaker = new LoopContentTestSuite());
+      }
+    }); // ** for -Ox
+static RegisterStandardPasses _RegPass2(
+    PassManagerBuilder::EP_EnabledOnOptLevel0,
+    [](const PassManagerBuilder &, legacy::PassManagerBase &PM) {
+      if (!_PassMaker) {
+        PM.add(_PassMaker = new LoopContentTestSuite());
+      }
+    }); // ** for -O0
+
+const char *LoopContentTestSuite::tests[] = {
+  "loop content computes its components on demand",
+  "prefetched components include the ones they depend on",
+  "components computed on demand match the prefetched ones",
+  "loop forests share the loop nest cache",
+  "loop nest cache computes a fact once until it is invalidated",
+  "induction variables fill the loop nest cache of the nest",
+  "hotness of a loop is the one of its blocks",
+  "sccs are sorted by hotness",
+  "loop content uses the chunk size it is given",
+};
+TestFunction LoopContentTestSuite::testFns[] = {
+  LoopContentTestSuite::componentsAreComputedOnDemand,
+  LoopContentTestSuite::prefetchedComponentsIncludeTheirDependences,
+  LoopContentTestSuite::lazyComponentsMatchPrefetchedOnes,
+  LoopContentTestSuite::forestsShareTheNestCache,
+  LoopContentTestSuite::nestCacheComputesFactsOnce,
+  LoopContentTestSuite::inductionVariablesFillTheNestCache,
+  LoopContentTestSuite::loopHotnessMatchesItsBlocks,
+  LoopContentTestSuite::sccsAreSortedByHotness,
+  LoopContentTestSuite::loopContentUsesItsChunkSize,
+};
+
+bool LoopContentTestSuite::doInitialization(Module &M) {
+  errs() << "LoopContentTestSuite: Initialize\n";
+  const int numTests = sizeof(tests) / sizeof(tests[0]);
+  this->suite = new TestSuite("LoopContentTestSuite",
+                              tests,
+                              testFns,
+                              numTests,
+                              "test.txt");
+  this->M = &M;
+  return false;
+}
+
+void LoopContentTestSuite::getAnalysisUsage(AnalysisUsage &AU) const {
+  AU.addRequired<NoellePass>();
+}
+
+bool LoopContentTestSuite::runOnModule(Module &M) {
+  errs() << "LoopContentTestSuite: Start\n";
+  this->mainF = M.getFunction("main");
+
+  suite->runTests((ModulePass &)*this);
+
+  return false;
+}
+
+std::string LoopContentTestSuite::getComponentName(
+    LoopContentComponent component) {
+  switch (component) {
+    case LOOP_ENVIRONMENT_ID:
+      return "environment";
+    case LOOP_INVARIANTS_ID:
+      return "invariants";
+    case LOOP_INDUCTION_VARIABLES_ID:
+      return "induction variables";
+    case LOOP_SCC_MANAGER_ID:
+      return "SCC manager";
+    case LOOP_ITERATION_SPACE_ID:
+      return "iteration space";
+  }
+
+  return "unknown component";
+}
+
+Values LoopContentTestSuite::checkComputedComponents(
+    TestSuite &suite,
+    LoopContent *LC,
+    const std::unordered_set<LoopContentComponent> &expected) {
+  Values errors;
+
+  auto loop = LC->getLoopStructure();
+  auto header = suite.printAsOperandToString(loop->getHeader());
+  for (auto component : LoopContent::getAllComponents()) {
+    auto isExpected = expected.count(component) > 0;
+    if (LC->isComputed(component) == isExpected) {
+      continue;
+    }
+    auto name = getComponentName(component);
+    if (isExpected) {
+      errors.insert("The " + name + " of loop " + header
+                    + " has not been computed");
+    } else {
+      errors.insert("The " + name + " of loop " + header
+                    + " has been computed without being needed");
+    }
+  }
+
+  return errors;
+}
+
+Values LoopContentTestSuite::describeComponents(TestSuite &suite,
+                                                LoopContent *LC) {
+  Values description;
+
+  /*
+   * Environment.
+   */
+  auto environment = LC->getEnvironment();
+  description.insert("live-ins "
+                     + std::to_string(environment->getNumberOfLiveIns()));
+  description.insert("live-outs "
+                     + std::to_string(environment->getNumberOfLiveOuts()));
+
+  /*
+   * Invariants.
+   */
+  std::vector<std::string> invariants;
+  auto invariantManager = LC->getInvariantManager();
+  for (auto inst :
+       invariantManager->getLoopInstructionsThatAreLoopInvariants()) {
+    invariants.push_back(suite.valueToString(inst));
+  }
+  description.insert("invariants "
+                     + suite.combineUnorderedValues(invariants));
+
+  /*
+   * Induction variables of every loop of the nest.
+   */
+  auto ivManager = LC->getInductionVariableManager();
+  for (auto loop : LC->getLoopHierarchyStructures()->getLoops()) {
+    auto header = suite.printAsOperandToString(loop->getHeader());
+    std::vector<std::string> phis;
+    for (auto IV : ivManager->getInductionVariables(*loop)) {
+      phis.push_back(suite.valueToString(IV->getLoopEntryPHI()));
+    }
+    description.insert(header + " has IVs "
+                       + suite.combineUnorderedValues(phis));
+    if (ivManager->getLoopGoverningInductionVariable(*loop) != nullptr) {
+      description.insert(header + " has a loop-governing IV");
+    }
+  }
+
+  /*
+   * SCCs.
+   */
+  auto sccdag = LC->getSCCManager()->getSCCDAG();
+  description.insert("SCCs " + std::to_string(sccdag->getSCCs().size()));
+
+  return description;
+}
+
+Values LoopContentTestSuite::componentsAreComputedOnDemand(ModulePass &pass,
+                                                           TestSuite &suite) {
+  auto &lcPass = static_cast<LoopContentTestSuite &>(pass);
+  auto &noelle = lcPass.getAnalysis<NoellePass>().getNoelle();
+  Values errors;
+
+  std::unordered_set<LoopContentComponent> ivComponents{
+    LOOP_ENVIRONMENT_ID,
+    LOOP_INVARIANTS_ID,
+    LOOP_INDUCTION_VARIABLES_ID
+  };
+  auto sccComponents = ivComponents;
+  sccComponents.insert(LOOP_SCC_MANAGER_ID);
+
+  auto loops = noelle.getLoopStructures(lcPass.mainF, 0);
+  for (auto loop : *loops) {
+
+    /*
+     * Nothing is computed until it is requested.
+     */
+    auto LC = noelle.getLoopContent(
+        loop,
+        std::unordered_set<LoopContentOptimization>{},
+        std::unordered_set<LoopContentComponent>{});
+    for (auto &error : checkComputedComponents(suite, LC, {})) {
+      errors.insert(error);
+    }
+
+    /*
+     * A component is computed together with the ones it depends on, only.
+     */
+    LC->getInvariantManager();
+    for (auto &error :
+         checkComputedComponents(suite, LC, { LOOP_INVARIANTS_ID })) {
+      errors.insert(error);
+    }
+    LC->getInductionVariableManager();
+    for (auto &error : checkComputedComponents(suite, LC, ivComponents)) {
+      errors.insert(error);
+    }
+    LC->getSCCManager();
+    for (auto &error : checkComputedComponents(suite, LC, sccComponents)) {
+      errors.insert(error);
+    }
+    LC->getLoopIterationSpaceAnalysis();
+    auto allComponents = LoopContent::getAllComponents();
+    for (auto &error : checkComputedComponents(suite, LC, allComponents)) {
+      errors.insert(error);
+    }
+
+    delete LC;
+  }
+  delete loops;
+
+  return errors;
+}
+
+Values LoopContentTestSuite::prefetchedComponentsIncludeTheirDependences(
+    ModulePass &pass,
+    TestSuite &suite) {
+  auto &lcPass = static_cast<LoopContentTestSuite &>(pass);
+  auto &noelle = lcPass.getAnalysis<NoellePass>().getNoelle();
+  Values errors;
+
+  /*
+   * The iteration space depends on the induction variables, which depend on
+   * the environment and the invariants.
+   */
+  std::unordered_set<LoopContentComponent> expected{
+    LOOP_ENVIRONMENT_ID,
+    LOOP_INVARIANTS_ID,
+    LOOP_INDUCTION_VARIABLES_ID,
+    LOOP_ITERATION_SPACE_ID
+  };
+
+  auto loops = noelle.getLoopStructures(lcPass.mainF, 0);
+  for (auto loop : *loops) {
+    auto LC = noelle.getLoopContent(
+        loop,
+        std::unordered_set<LoopContentOptimization>{},
+        std::unordered_set<LoopContentComponent>{ LOOP_ITERATION_SPACE_ID });
+    for (auto &error : checkComputedComponents(suite, LC, expected)) {
+      errors.insert(error);
+    }
+    delete LC;
+  }
+  delete loops;
+
+  return errors;
+}
+
+Values LoopContentTestSuite::lazyComponentsMatchPrefetchedOnes(
+    ModulePass &pass,
+    TestSuite &suite) {
+  auto &lcPass = static_cast<LoopContentTestSuite &>(pass);
+  auto &noelle = lcPass.getAnalysis<NoellePass>().getNoelle();
+  Values errors;
+
+  auto loops = noelle.getLoopStructures(lcPass.mainF, 0);
+  for (auto loop : *loops) {
+    auto header = suite.printAsOperandToString(loop->getHeader());
+    auto lazyLC = noelle.getLoopContent(
+        loop,
+        std::unordered_set<LoopContentOptimization>{},
+        std::unordered_set<LoopContentComponent>{});
+    auto eagerLC = noelle.getLoopContent(
+        loop,
+        std::unordered_set<LoopContentOptimization>{},
+        LoopContent::getAllComponents());
+
+    if (describeComponents(suite, lazyLC)
+        != describeComponents(suite, eagerLC)) {
+      errors.insert("The components of loop " + header
+                    + " computed on demand differ from the prefetched ones");
+    }
+
+    delete lazyLC;
+    delete eagerLC;
+  }
+  delete loops;
+
+  return errors;
+}
+
+Values LoopContentTestSuite::forestsShareTheNestCache(ModulePass &pass,
+                                                      TestSuite &suite) {
+  auto &lcPass = static_cast<LoopContentTestSuite &>(pass);
+  auto &noelle = lcPass.getAnalysis<NoellePass>().getNoelle();
+  Values errors;
+
+  auto loops = noelle.getLoopStructures(lcPass.mainF, 0);
+  auto otherLoops = noelle.getLoopStructures(lcPass.mainF, 0);
+  auto forest = noelle.organizeLoopsInTheirNestingForest(*loops);
+  auto otherForest = noelle.organizeLoopsInTheirNestingForest(*otherLoops);
+
+  auto &cache = forest->getNestCache();
+  if (&cache != &otherForest->getNestCache()) {
+    errors.insert("The loop forests have different loop nest caches");
+  }
+  for (auto f : { forest, otherForest }) {
+    for (auto tree : f->getTrees()) {
+      if (&tree->getNestCache() != &cache) {
+        auto header = tree->getLoop()->getHeader();
+        errors.insert("The tree of loop " + suite.printAsOperandToString(header)
+                      + " does not use the loop nest cache of its forest");
+      }
+    }
+  }
+
+  delete forest;
+  delete otherForest;
+  delete loops;
+  delete otherLoops;
+
+  return errors;
+}
+
+Values LoopContentTestSuite::nestCacheComputesFactsOnce(ModulePass &pass,
+                                                        TestSuite &suite) {
+  auto &lcPass = static_cast<LoopContentTestSuite &>(pass);
+  auto &noelle = lcPass.getAnalysis<NoellePass>().getNoelle();
+  Values errors;
+
+  auto loops = noelle.getLoopStructures(lcPass.mainF, 0);
+  auto otherLoops = noelle.getLoopStructures(lcPass.mainF, 0);
+  auto forest = noelle.organizeLoopsInTheirNestingForest(*loops);
+  auto &cache = forest->getNestCache();
+  cache.invalidate(*lcPass.mainF);
+
+  /*
+   * The facts are recorded by loop header, so they are shared by the
+   * structures allocated for the same loop.
+   * The fact recorded is the nesting level of the loop, which is not the
+   * number of iterations but it identifies the loop the fact comes from.
+   */
+  uint32_t computations = 0;
+  auto compute = [&computations](LoopStructure *loop) {
+    computations++;
+    return std::optional<int64_t>(loop->getNestingLevel());
+  };
+  auto checkFacts = [&](std::vector<LoopStructure *> *ls,
+                        uint32_t expectedComputations,
+                        const std::string &when) {
+    computations = 0;
+    for (auto loop : *ls) {
+      auto iterations = cache.getIterationsPerInvocation(loop, compute);
+      if (iterations != std::optional<int64_t>(loop->getNestingLevel())) {
+        errors.insert("The fact of loop "
+                      + suite.printAsOperandToString(loop->getHeader())
+                      + " is wrong " + when);
+      }
+    }
+    if (computations != expectedComputations) {
+      errors.insert(std::to_string(computations) + " facts have been computed "
+                    + when + " instead of "
+                    + std::to_string(expectedComputations));
+    }
+  };
+  checkFacts(loops, loops->size(), "the first time");
+  checkFacts(otherLoops, 0, "for the same loops");
+
+  /*
+   * Invalidating a loop forgets only its facts.
+   */
+  cache.invalidate(loops->front());
+  checkFacts(otherLoops, 1, "after invalidating a loop");
+
+  /*
+   * Invalidating the function forgets the facts of all its loops.
+   */
+  cache.invalidate(*lcPass.mainF);
+  checkFacts(otherLoops, otherLoops->size(), "after invalidating main");
+  cache.invalidateAll();
+  checkFacts(loops, loops->size(), "after invalidating everything");
+
+  /*
+   * Drop the facts recorded by this test, which are not the real ones.
+   */
+  cache.invalidate(*lcPass.mainF);
+
+  delete forest;
+  delete loops;
+  delete otherLoops;
+
+  return errors;
+}
+
+Values LoopContentTestSuite::inductionVariablesFillTheNestCache(
+    ModulePass &pass,
+    TestSuite &suite) {
+  auto &lcPass = static_cast<LoopContentTestSuite &>(pass);
+  auto &noelle = lcPass.getAnalysis<NoellePass>().getNoelle();
+  Values errors;
+
+  auto loops = noelle.getLoopStructures(lcPass.mainF, 0);
+  auto forest = noelle.organizeLoopsInTheirNestingForest(*loops);
+  auto &cache = forest->getNestCache();
+  cache.invalidate(*lcPass.mainF);
+
+  for (auto tree : forest->getTrees()) {
+
+    /*
+     * Computing the induction variables of the outermost loop classifies
+     * the header PHIs of every loop of its nest.
+     */
+    auto LC = noelle.getLoopContent(
+        tree->getLoop(),
+        std::unordered_set<LoopContentOptimization>{},
+        std::unordered_set<LoopContentComponent>{
+            LOOP_INDUCTION_VARIABLES_ID });
+    for (auto loop : tree->getLoops()) {
+      auto computed = false;
+      cache.getHeaderPHIs(loop, [&computed](LoopStructure *l) {
+        computed = true;
+        return LoopNestCache::HeaderPHIs{};
+      });
+      if (computed) {
+        errors.insert("The header PHIs of loop "
+                      + suite.printAsOperandToString(loop->getHeader())
+                      + " have not been cached by the induction variables");
+      }
+    }
+    delete LC;
+  }
+
+  delete forest;
+  delete loops;
+
+  return errors;
+}
+
+std::map<std::string, uint64_t> LoopContentTestSuite::getLoopHotness(
+    LoopContentTestSuite &pass,
+    TestSuite &suite) {
+  auto &noelle = pass.getAnalysis<NoellePass>().getNoelle();
+  auto hot = noelle.getProfiles();
+
+  std::map<std::string, uint64_t> hotness;
+  auto loops = noelle.getLoopStructures(pass.mainF, 0);
+  for (auto loop : *loops) {
+    auto header = suite.printAsOperandToString(loop->getHeader());
+    hotness[header] = hot->getTotalInstructions(loop);
+  }
+  delete loops;
+
+  return hotness;
+}
+
+Values LoopContentTestSuite::loopHotnessMatchesItsBlocks(ModulePass &pass,
+                                                         TestSuite &suite) {
+  auto &lcPass = static_cast<LoopContentTestSuite &>(pass);
+  auto &noelle = lcPass.getAnalysis<NoellePass>().getNoelle();
+  auto hot = noelle.getProfiles();
+  Values errors;
+
+  /*
+   * The instructions executed by a loop are the ones executed by its blocks,
+   * which are the ones executed by their instructions.
+   */
+  auto loops = noelle.getLoopStructures(lcPass.mainF, 0);
+  for (auto loop : *loops) {
+    auto header = suite.printAsOperandToString(loop->getHeader());
+    uint64_t blocksInsts = 0;
+    uint64_t instructionsInsts = 0;
+    for (auto bb : loop->getBasicBlocks()) {
+      blocksInsts += hot->getTotalInstructions(bb);
+      for (auto &inst : *bb) {
+        instructionsInsts += hot->getTotalInstructions(&inst);
+      }
+    }
+    auto loopInsts = hot->getTotalInstructions(loop);
+    if (loopInsts != blocksInsts) {
+      errors.insert("The hotness of loop " + header
+                    + " differs from the one of its blocks");
+    }
+    if (loopInsts != instructionsInsts) {
+      errors.insert("The hotness of loop " + header
+                    + " differs from the one of its instructions");
+    }
+
+    /*
+     * A loop executes at least the instructions of the loops it includes.
+     */
+    for (auto otherLoop : *loops) {
+      if ((otherLoop == loop)
+          || (loop->getBasicBlocks().count(otherLoop->getHeader()) == 0)) {
+        continue;
+      }
+      if (hot->getTotalInstructions(otherLoop) > loopInsts) {
+        errors.insert("The hotness of loop " + header
+                      + " is lower than the one of a loop it includes");
+      }
+    }
+  }
+  delete loops;
+
+  /*
+   * The hotness of a loop does not depend on the LoopStructure used to ask
+   * for it, and it is unchanged once the unmodified function is invalidated.
+   */
+  auto hotness = getLoopHotness(lcPass, suite);
+  if (getLoopHotness(lcPass, suite) != hotness) {
+    errors.insert("The hotness of the loops changes with their structures");
+  }
+  hot->invalidate(lcPass.mainF);
+  if (getLoopHotness(lcPass, suite) != hotness) {
+    errors.insert("The hotness of the loops changes after invalidating main");
+  }
+
+  return errors;
+}
+
+Values LoopContentTestSuite::sccsAreSortedByHotness(ModulePass &pass,
+                                                    TestSuite &suite) {
+  auto &lcPass = static_cast<LoopContentTestSuite &>(pass);
+  auto &noelle = lcPass.getAnalysis<NoellePass>().getNoelle();
+  auto hot = noelle.getProfiles();
+  Values errors;
+
+  auto loops = noelle.getLoopStructures(lcPass.mainF, 0);
+  for (auto loop : *loops) {
+    auto header = suite.printAsOperandToString(loop->getHeader());
+    auto LC = noelle.getLoopContent(
+        loop,
+        std::unordered_set<LoopContentOptimization>{},
+        std::unordered_set<LoopContentComponent>{});
+    auto sccs = LC->getSCCManager()->getSCCDAG()->getSCCs();
+    std::set<SCC *> sccSet(sccs.begin(), sccs.end());
+
+    /*
+     * The SCCs sorted must be the ones given, from the hottest one.
+     */
+    auto sorted = noelle.sortByHotness(sccSet);
+    if (std::set<SCC *>(sorted.begin(), sorted.end()) != sccSet
+        || sorted.size() != sccSet.size()) {
+      errors.insert("The SCCs of loop " + header + " have changed by sorting");
+    }
+    for (auto i = 1u; i < sorted.size(); i++) {
+      if (hot->getTotalInstructions(sorted[i - 1])
+          < hot->getTotalInstructions(sorted[i])) {
+        errors.insert("The SCCs of loop " + header + " are not sorted");
+        break;
+      }
+    }
+
+    delete LC;
+  }
+  delete loops;
+
+  return errors;
+}
+
+Values LoopContentTestSuite::loopContentUsesItsChunkSize(ModulePass &pass,
+                                                         TestSuite &suite) {
+  auto &lcPass = static_cast<LoopContentTestSuite &>(pass);
+  auto &noelle = lcPass.getAnalysis<NoellePass>().getNoelle();
+  Values errors;
+
+  /*
+   * The chunk size of a loop is the one of the transformations manager
+   * given, and it is 8 when none is given.
+   */
+  uint32_t chunkSize = 3;
+  LoopTransformationsManager ltm(2,
+                                 chunkSize,
+                                 std::unordered_set<LoopContentOptimization>{},
+                                 true);
+  ltm.enableAllTransformations();
+  auto fdg =
+      noelle.getProgramDependenceGraph()->createFunctionSubgraph(*lcPass.mainF);
+
+  auto loops = noelle.getLoopStructures(lcPass.mainF, 0);
+  for (auto loop : *loops) {
+    auto header = loop->getHeader();
+    auto headerName = suite.printAsOperandToString(header);
+
+    auto LC = noelle.getLoopContent(header, fdg, &ltm, true);
+    auto loopChunkSize = LC->getLoopTransformationsManager()->getChunkSize();
+    if (loopChunkSize != chunkSize) {
+      errors.insert("The chunk size of loop " + headerName + " is "
+                    + std::to_string(loopChunkSize) + " instead of "
+                    + std::to_string(chunkSize));
+    }
+    delete LC;
+
+    LC = noelle.getLoopContent(loop);
+    loopChunkSize = LC->getLoopTransformationsManager()->getChunkSize();
+    if (loopChunkSize != 8) {
+      errors.insert("The default chunk size of loop " + headerName + " is "
+                    + std::to_string(loopChunkSize) + " instead of 8");
+    }
+    delete LC;
+  }
+  delete loops;
+  delete fdg;
+
+  return errors;
+}
+
+} // namespace arcana::noelle
@@ -0,0 +1,24 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+int main(int argc, char *argv[]) {
+  int m[8][16];
+  long long s = 0;
+
+  for (int i = 0; i < 8; i++) {
+    for (int j = 0; j < 16; j++) {
+      m[i][j] = i * j + argc;
+    }
+  }
+
+  for (int i = 0; i < 8; i++) {
+    for (int j = 0; j < 16; j++) {
+      for (int k = 0; k < 4; k++) {
+        s += m[i][j] * k;
+      }
+    }
+  }
+
+  printf("%lld\n", s);
+  return 0;
+}
@@ -0,0 +1,165 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "llvm/Pass.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/BasicBlock.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/Analysis/PostDominators.h"
+#include "llvm/Analysis/ScalarEvolution.h"
+#include "llvm/Analysis/AliasAnalysis.h"
+#include "llvm/Analysis/CallGraph.h"
+
+#include "arcana/noelle/core/NoellePass.hpp"
+#include "arcana/noelle/core/PDGGenerator.hpp"
+#include "arcana/noelle/core/PDGSerializer.hpp"
+#include "TestSuite.hpp"
+
+#include <sstream>
+#include <vector>
+#include <string>
+
+using namespace parallelizertests;
+using namespace arcana::noelle;
+
+namespace llvm {
+
+/*
+ * Dependence analysis that gives the same answer about the type of every
+ * memory dependence.
+ */
+class FixedStrengthAnalysis : public DependenceAnalysis {
+public:
+  FixedStrengthAnalysis(const std::string &name,
+                        MemoryDataDependenceStrength strength);
+
+  MemoryDataDependenceStrength isThereThisMemoryDataDependenceType(
+      DataDependenceType t,
+      Instruction *fromInst,
+      Instruction *toInst,
+      Function &function) override;
+
+private:
+  MemoryDataDependenceStrength strength;
+};
+
+/*
+ * Dependence analysis that asserts the lack of every memory dependence, but
+ * only when asked about pairs in batches, and that cannot remove the
+ * dependences of @skippedFunction.
+ */
+class BatchedAnalysis : public DependenceAnalysis {
+public:
+  BatchedAnalysis(Function *skippedFunction);
+
+  bool canThereBeAMemoryDataDependence(Instruction *fromInst,
+                                       Instruction *toInst,
+                                       Function &function) override;
+
+  std::vector<bool> canThereBeMemoryDataDependences(
+      const std::vector<std::pair<Instruction *, Instruction *>> &pairs,
+      Function &function) override;
+
+  bool canRemoveDependencesOf(Function &function) override;
+
+  uint64_t singleQueries;
+  uint64_t batchedQueries;
+  bool askedAboutSkippedFunction;
+
+private:
+  Function *skippedFunction;
+};
+
+class PDGGeneratorTestSuite : public ModulePass {
+public:
+  PDGGeneratorTestSuite() : ModulePass{ ID } {}
+
+  /*
+   * Class fields
+   */
+  static char ID;
+  static const char *tests[];
+  static parallelizertests::TestFunction testFns[];
+
+  bool doInitialization(Module &M) override;
+  bool runOnModule(Module &M) override;
+  void getAnalysisUsage(AnalysisUsage &AU) const override;
+
+private:
+  static Values parallelPDGMatchesSerialPDG(ModulePass &pass,
+                                            TestSuite &suite);
+  static Values sparsePDGMatchesDensePDG(ModulePass &pass, TestSuite &suite);
+  static Values queryCacheAnswersOnce(ModulePass &pass, TestSuite &suite);
+  static Values queryCacheDropsLeastRecentlyUsedAnswers(ModulePass &pass,
+                                                        TestSuite &suite);
+  static Values queryCacheDropsStaleAnswers(ModulePass &pass,
+                                            TestSuite &suite);
+  static Values reachabilitySummaryMatchesCallChains(ModulePass &pass,
+                                                     TestSuite &suite);
+  static Values cannotExistWinsInAnyOrder(ModulePass &pass, TestSuite &suite);
+  static Values batchedAnalysisRemovesDependences(ModulePass &pass,
+                                                  TestSuite &suite);
+  static Values serializedPDGHasTheSameDependences(ModulePass &pass,
+                                                   TestSuite &suite);
+  static Values invalidSerializedPDGIsRejected(ModulePass &pass,
+                                               TestSuite &suite);
+  static Values updatedPDGMatchesThePDGFromScratch(ModulePass &pass,
+                                                   TestSuite &suite);
+  static Values updatedPDGRefreshesTheCallers(ModulePass &pass,
+                                              TestSuite &suite);
+  static Values indirectCallsReachExternalFunctions(ModulePass &pass,
+                                                    TestSuite &suite);
+
+  /*
+   * Return the function of @M named @name in the source code.
+   * The names of the C++ functions are mangled (e.g., _ZL4fillPiii).
+   */
+  static Function *getFunctionNamed(Module &M, const std::string &name);
+
+  /*
+   * Create a PDG generator that does not share any state (e.g., caches) with
+   * the one of NOELLE.
+   */
+  PDGGenerator *createPDGGenerator(bool sparseMemoryCandidates,
+                                   uint32_t numberOfThreads);
+
+  /*
+   * Describe every dependence of @pdg, so the dependences of different graphs
+   * can be compared.
+   */
+  static std::multiset<std::string> describeDependences(TestSuite &suite,
+                                                        PDG *pdg);
+
+  /*
+   * Return the dependences missing in @pdg or not expected in it.
+   */
+  static Values compareDependences(TestSuite &suite,
+                                   PDG *expectedPDG,
+                                   PDG *pdg);
+
+  TestSuite *suite;
+  Module *M;
+  Function *mainF;
+};
+} // namespace llvm
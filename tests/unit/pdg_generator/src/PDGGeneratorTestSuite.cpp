@@ -0,0 +1,1094 @@
+/*
+ * Copyright 2016 - 2024  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "PDGGeneratorTestSuite.hpp"
+
+using namespace llvm;
+
+// Register pass to "opt"
+char PDGGeneratorTestSuite::ID = 0;
+static RegisterPass<PDGGeneratorTestSuite> X("UnitTester",
+                                             "PDG Generator Unit Tester");
+
+// Register pass to "clang"
+static PDGGeneratorTestSuite *_PassMaker = NULL;
+static RegisterStandardPasses _RegPass1(
+    PassManagerBuilder::EP_OptimizerLast,
+    [](const PassManagerBuilder &, legacy::PassManagerBase &PM) {
+      if (!_PassMaker) {
+        PM.add(_PassMaker = new PDGGeneratorTestSuite());
+      }
+    }); // ** for -Ox
+static RegisterStandardPasses _RegPass2(
+    PassManagerBuilder::EP_EnabledOnOptLevel0,
+    [](const PassManagerBuilder &, legacy::PassManagerBase &PM) {
+      if (!_PassMaker) {
+        PM.add(_PassMaker = new PDGGeneratorTestSuite());
+      }
+    }); // ** for -O0
+
+const char *PDGGeneratorTestSuite::tests[] = {
+  "parallel pdg matches the serial one",
+  "sparse pdg matches the dense one",
+  "query cache answers every query once",
+  "query cache drops the least recently used answers",
+  "query cache drops the answers about modified code",
+  "reachability summary matches the chains of calls",
+  "cannot exist wins over must exist in any order",
+  "batched analysis removes dependences",
+  "serialized pdg has the same dependences",
+  "invalid serialized pdg is rejected",
+  "updated pdg matches the pdg from scratch",
+  "updated pdg refreshes the callers of the modified function",
+  "indirect calls reach external functions",
+};
+TestFunction PDGGeneratorTestSuite::testFns[] = {
+  PDGGeneratorTestSuite::parallelPDGMatchesSerialPDG,
+  PDGGeneratorTestSuite::sparsePDGMatchesDensePDG,
+  PDGGeneratorTestSuite::queryCacheAnswersOnce,
+  PDGGeneratorTestSuite::queryCacheDropsLeastRecentlyUsedAnswers,
+  PDGGeneratorTestSuite::queryCacheDropsStaleAnswers,
+  PDGGeneratorTestSuite::reachabilitySummaryMatchesCallChains,
+  PDGGeneratorTestSuite::cannotExistWinsInAnyOrder,
+  PDGGeneratorTestSuite::batchedAnalysisRemovesDependences,
+  PDGGeneratorTestSuite::serializedPDGHasTheSameDependences,
+  PDGGeneratorTestSuite::invalidSerializedPDGIsRejected,
+  PDGGeneratorTestSuite::updatedPDGMatchesThePDGFromScratch,
+  PDGGeneratorTestSuite::updatedPDGRefreshesTheCallers,
+  PDGGeneratorTestSuite::indirectCallsReachExternalFunctions,
+};
+
+bool PDGGeneratorTestSuite::doInitialization(Module &M) {
+  errs() << "PDGGeneratorTestSuite: Initialize\n";
+  const int numTests = sizeof(tests) / sizeof(tests[0]);
+  this->suite = new TestSuite("PDGGeneratorTestSuite",
+                              tests,
+                              testFns,
+                              numTests,
+                              "test.txt");
+  this->M = &M;
+  return false;
+}
+
+void PDGGeneratorTestSuite::getAnalysisUsage(AnalysisUsage &AU) const {
+  AU.addRequired<NoellePass>();
+  AU.addRequired<ScalarEvolutionWrapperPass>();
+  AU.addRequired<LoopInfoWrapperPass>();
+  AU.addRequired<PostDominatorTreeWrapperPass>();
+  AU.addRequired<CallGraphWrapperPass>();
+  AU.addRequired<AAResultsWrapperPass>();
+}
+
+bool PDGGeneratorTestSuite::runOnModule(Module &M) {
+  errs() << "PDGGeneratorTestSuite: Start\n";
+  this->mainF = M.getFunction("main");
+
+  suite->runTests((ModulePass &)*this);
+
+  return false;
+}
+
+PDGGenerator *PDGGeneratorTestSuite::createPDGGenerator(
+    bool sparseMemoryCandidates,
+    uint32_t numberOfThreads) {
+  auto getSCEV = [this](Function &F) -> ScalarEvolution & {
+    return getAnalysis<ScalarEvolutionWrapperPass>(F).getSE();
+  };
+  auto getLoopInfo = [this](Function &F) -> LoopInfo & {
+    return getAnalysis<LoopInfoWrapperPass>(F).getLoopInfo();
+  };
+  auto getPDT = [this](Function &F) -> PostDominatorTree & {
+    return getAnalysis<PostDominatorTreeWrapperPass>(F).getPostDomTree();
+  };
+  auto getCallGraph = [this](void) -> CallGraph & {
+    return getAnalysis<CallGraphWrapperPass>().getCallGraph();
+  };
+  auto getAA = [this](Function &F) -> AAResults & {
+    return getAnalysis<AAResultsWrapperPass>(F).getAAResults();
+  };
+
+  /*
+   * SVF keeps global state, so it is not used by the generators of the tests.
+   */
+  return new PDGGenerator(*this->M,
+                          getSCEV,
+                          getLoopInfo,
+                          getPDT,
+                          getCallGraph,
+                          getAA,
+                          /*dumpPDG=*/false,
+                          /*performThePDGComparison=*/false,
+                          /*disableSVF=*/true,
+                          /*disableSVFCallGraph=*/true,
+                          /*disableAllocAA=*/false,
+                          /*disableRA=*/false,
+                          sparseMemoryCandidates,
+                          PDGVerbosity::Disabled,
+                          numberOfThreads,
+                          /*cacheFileName=*/"",
+                          /*aliasAnalyses=*/"");
+}
+
+Function *PDGGeneratorTestSuite::getFunctionNamed(Module &M,
+                                                  const std::string &name) {
+  auto mangledName = std::to_string(name.size()) + name;
+  for (auto &F : M) {
+    auto fName = F.getName();
+    if ((fName == name) || fName.startswith("_Z" + mangledName)
+        || fName.startswith("_ZL" + mangledName)) {
+      return &F;
+    }
+  }
+
+  return nullptr;
+}
+
+std::multiset<std::string> PDGGeneratorTestSuite::describeDependences(
+    TestSuite &suite,
+    PDG *pdg) {
+
+  /*
+   * Values of different functions can be printed the same way, so values are
+   * prefixed by their function.
+   */
+  auto describeValue = [&suite](Value *v) -> std::string {
+    std::string prefix;
+    if (auto inst = dyn_cast<Instruction>(v)) {
+      prefix = inst->getFunction()->getName().str() + ": ";
+    } else if (auto arg = dyn_cast<Argument>(v)) {
+      prefix = arg->getParent()->getName().str() + ": ";
+    }
+    return prefix + suite.valueToString(v);
+  };
+
+  std::multiset<std::string> dependences;
+  for (auto dep : pdg->getEdges()) {
+    std::string type = "control";
+    if (auto dataDep = dyn_cast<DataDependence<Value, Value>>(dep)) {
+      if (isa<MustMemoryDependence<Value, Value>>(dep)) {
+        type = "must memory ";
+      } else if (isa<MemoryDependence<Value, Value>>(dep)) {
+        type = "may memory ";
+      } else {
+        type = "data ";
+      }
+      type += dataDep->dataDepToString();
+    }
+    if (dep->isLoopCarriedDependence()) {
+      type += " loop-carried";
+    }
+    auto delim = suite.orderedValueDelimiter;
+    dependences.insert(describeValue(dep->getSrc()) + delim
+                       + describeValue(dep->getDst()) + delim + type);
+  }
+
+  return dependences;
+}
+
+Values PDGGeneratorTestSuite::compareDependences(TestSuite &suite,
+                                                 PDG *expectedPDG,
+                                                 PDG *pdg) {
+  auto expected =
+      PDGGeneratorTestSuite::describeDependences(suite, expectedPDG);
+  auto actual = PDGGeneratorTestSuite::describeDependences(suite, pdg);
+
+  Values errors;
+  std::vector<std::string> missing, unexpected;
+  std::set_difference(expected.begin(),
+                      expected.end(),
+                      actual.begin(),
+                      actual.end(),
+                      std::back_inserter(missing));
+  std::set_difference(actual.begin(),
+                      actual.end(),
+                      expected.begin(),
+                      expected.end(),
+                      std::back_inserter(unexpected));
+  for (auto &dep : missing) {
+    errors.insert("Missing " + dep);
+  }
+  for (auto &dep : unexpected) {
+    errors.insert("Unexpected " + dep);
+  }
+
+  return errors;
+}
+
+Values PDGGeneratorTestSuite::parallelPDGMatchesSerialPDG(ModulePass &pass,
+                                                          TestSuite &suite) {
+  auto &genPass = static_cast<PDGGeneratorTestSuite &>(pass);
+
+  /*
+   * Compute the PDG serially and with a pool of workers.
+   * More workers than cores are requested, so the look-ahead window of the
+   * pool is exercised even on small machines.
+   */
+  auto serialGenerator = genPass.createPDGGenerator(false, 1);
+  auto parallelGenerator = genPass.createPDGGenerator(false, 4);
+  auto errors = PDGGeneratorTestSuite::compareDependences(
+      suite,
+      serialGenerator->getPDG(),
+      parallelGenerator->getPDG());
+  delete parallelGenerator;
+  delete serialGenerator;
+
+  return errors;
+}
+
+Values PDGGeneratorTestSuite::sparsePDGMatchesDensePDG(ModulePass &pass,
+                                                       TestSuite &suite) {
+  auto &genPass = static_cast<PDGGeneratorTestSuite &>(pass);
+
+  /*
+   * Skipping the pairs that cannot depend on each other must not change the
+   * dependences.
+   */
+  auto denseGenerator = genPass.createPDGGenerator(false, 1);
+  auto sparseGenerator = genPass.createPDGGenerator(true, 1);
+  auto errors =
+      PDGGeneratorTestSuite::compareDependences(suite,
+                                                denseGenerator->getPDG(),
+                                                sparseGenerator->getPDG());
+
+  /*
+   * Every pair checked by the dense generator is either checked or skipped by
+   * the sparse one.
+   * The test accesses distinct arrays, so some pairs must be skipped.
+   */
+  auto densePairs = denseGenerator->getNumberOfMemoryPairQueries();
+  auto sparsePairs = sparseGenerator->getNumberOfMemoryPairQueries();
+  auto skippedPairs = sparseGenerator->getNumberOfPrunedMemoryPairs();
+  if (denseGenerator->getNumberOfPrunedMemoryPairs() != 0) {
+    errors.insert("The dense generator skips pairs");
+  }
+  if ((sparsePairs + skippedPairs) != densePairs) {
+    errors.insert("The sparse generator does not consider every pair");
+  }
+  if (skippedPairs == 0) {
+    errors.insert("The sparse generator does not skip any pair");
+  }
+  delete sparseGenerator;
+  delete denseGenerator;
+
+  return errors;
+}
+
+Values PDGGeneratorTestSuite::queryCacheAnswersOnce(ModulePass &pass,
+                                                    TestSuite &suite) {
+  auto &genPass = static_cast<PDGGeneratorTestSuite &>(pass);
+  DependenceQueryCache cache(DependenceQueryCache::defaultCapacity);
+  int analysis;
+  auto analysisID = cache.getAnalysisID(&analysis, "test analysis");
+  Values errors;
+
+  /*
+   * Create a query for every pair of instructions of the entry block of main.
+   */
+  std::vector<DependenceQueryCache::Query> queries;
+  for (auto &I : genPass.mainF->getEntryBlock()) {
+    for (auto &J : genPass.mainF->getEntryBlock()) {
+      queries.push_back({ DependenceQueryCache::ALIAS,
+                          analysisID,
+                          &I,
+                          &J,
+                          genPass.mainF,
+                          0 });
+    }
+  }
+  auto half = queries.size() / 2;
+
+  /*
+   * Answer the first half of the queries one at a time.
+   */
+  uint64_t answers = 0;
+  for (auto i = 0u; i < half; i++) {
+    auto answer = cache.query(queries[i], [&answers, i](void) -> uint8_t {
+      answers++;
+      return i % 3;
+    });
+    if (answer != (i % 3)) {
+      errors.insert("A single query has a wrong answer");
+    }
+  }
+
+  /*
+   * Ask every query again, as a batch: only the second half must be answered.
+   */
+  std::set<uint64_t> answeredIndexes;
+  auto batchAnswers = cache.query(
+      queries,
+      [&answeredIndexes](uint64_t queryIndex) -> uint8_t {
+        answeredIndexes.insert(queryIndex);
+        return queryIndex % 3;
+      });
+  for (auto i = 0u; i < queries.size(); i++) {
+    if (batchAnswers[i] != (i % 3)) {
+      errors.insert("A batched query has a wrong answer");
+    }
+    if ((answeredIndexes.count(i) > 0) != (i >= half)) {
+      errors.insert("A batched query is answered while cached or vice versa");
+    }
+  }
+
+  /*
+   * Every answer is now cached, so they must not be computed again.
+   */
+  auto invocations = 0u;
+  auto allAnswers = cache.queryAll(
+      queries,
+      [&invocations](const std::vector<uint64_t> &queryIndexes)
+          -> std::vector<uint8_t> {
+        invocations++;
+        return std::vector<uint8_t>(queryIndexes.size(), 0);
+      });
+  if ((invocations != 0) || (allAnswers != batchAnswers)) {
+    errors.insert("Cached answers are computed again");
+  }
+
+  /*
+   * Missing answers are computed by a single invocation.
+   */
+  cache.clear();
+  cache.queryAll(queries,
+                 [&](const std::vector<uint64_t> &queryIndexes)
+                     -> std::vector<uint8_t> {
+                   invocations++;
+                   if (queryIndexes.size() != queries.size()) {
+                     errors.insert("Not every missing answer is computed");
+                   }
+                   return std::vector<uint8_t>(queryIndexes.size(), 1);
+                 });
+  if ((invocations != 1) || (cache.getNumberOfAnswers() != queries.size())) {
+    errors.insert("Missing answers are not computed at once");
+  }
+
+  /*
+   * Check the statistics of the analysis.
+   */
+  cache.iterateOverStatistics(
+      [&](const std::string &name,
+          const DependenceQueryCache::Statistics &statistics) {
+        if (name != "test analysis") {
+          errors.insert("Unexpected analysis " + name);
+          return;
+        }
+        if ((statistics.hits != (half + queries.size()))
+            || (statistics.misses != (2 * queries.size()))) {
+          errors.insert("The hits and misses are not accounted");
+        }
+      });
+  if (answers != half) {
+    errors.insert("Single queries are answered more than once");
+  }
+
+  return errors;
+}
+
+Values PDGGeneratorTestSuite::queryCacheDropsLeastRecentlyUsedAnswers(
+    ModulePass &pass,
+    TestSuite &suite) {
+  auto &genPass = static_cast<PDGGeneratorTestSuite &>(pass);
+  DependenceQueryCache cache(3);
+  int analysis;
+  auto analysisID = cache.getAnalysisID(&analysis, "test analysis");
+  Values errors;
+
+  /*
+   * Create four queries.
+   */
+  std::vector<DependenceQueryCache::Query> queries;
+  for (auto &I : genPass.mainF->getEntryBlock()) {
+    if (queries.size() == 4) {
+      break;
+    }
+    queries.push_back({ DependenceQueryCache::CAN_THERE_BE_A_DEPENDENCE,
+                        analysisID,
+                        &I,
+                        &I,
+                        genPass.mainF,
+                        0 });
+  }
+  if (queries.size() != 4) {
+    errors.insert("The entry block of main is too small");
+    return errors;
+  }
+  auto answers = 0u;
+  auto ask = [&](uint64_t queryIndex) -> void {
+    cache.query(queries[queryIndex], [&answers](void) -> uint8_t {
+      answers++;
+      return 1;
+    });
+  };
+
+  /*
+   * Fill the cache, use the first answer, and then add the fourth one.
+   * The second answer is the least recently used, so it must be dropped.
+   */
+  ask(0);
+  ask(1);
+  ask(2);
+  ask(0);
+  ask(3);
+  if ((answers != 4) || (cache.getNumberOfAnswers() != 3)) {
+    errors.insert("The cache exceeds its capacity");
+  }
+  ask(0);
+  ask(2);
+  ask(3);
+  if (answers != 4) {
+    errors.insert("A recently used answer is dropped");
+  }
+  ask(1);
+  if (answers != 5) {
+    errors.insert("The least recently used answer is kept");
+  }
+
+  return errors;
+}
+
+Values PDGGeneratorTestSuite::queryCacheDropsStaleAnswers(ModulePass &pass,
+                                                          TestSuite &suite) {
+  auto &genPass = static_cast<PDGGeneratorTestSuite &>(pass);
+  DependenceQueryCache cache(DependenceQueryCache::defaultCapacity);
+  int firstAnalysis, secondAnalysis;
+  auto firstID = cache.getAnalysisID(&firstAnalysis, "first analysis");
+  auto secondID = cache.getAnalysisID(&secondAnalysis, "second analysis");
+  Values errors;
+
+  /*
+   * Fetch an instruction of main and one of another function.
+   */
+  auto fillF = getFunctionNamed(*genPass.M, "fill");
+  if (fillF == nullptr) {
+    errors.insert("The function fill is missing");
+    return errors;
+  }
+  auto mainInst = &*genPass.mainF->getEntryBlock().begin();
+  auto fillInst = &*fillF->getEntryBlock().begin();
+
+  /*
+   * Cache answers of both analyses, about main only and about both functions.
+   */
+  DependenceQueryCache::Query mainQuery{ DependenceQueryCache::ALIAS,
+                                         firstID,
+                                         mainInst,
+                                         mainInst,
+                                         nullptr,
+                                         0 };
+  DependenceQueryCache::Query bothQuery{ DependenceQueryCache::ALIAS,
+                                         firstID,
+                                         mainInst,
+                                         fillInst,
+                                         nullptr,
+                                         0 };
+  auto secondMainQuery = mainQuery;
+  secondMainQuery.analysisID = secondID;
+  auto answers = 0u;
+  auto ask = [&](const DependenceQueryCache::Query &query) -> void {
+    cache.query(query, [&answers](void) -> uint8_t {
+      answers++;
+      return 1;
+    });
+  };
+  ask(mainQuery);
+  ask(bothQuery);
+  ask(secondMainQuery);
+
+  /*
+   * Modifying fill makes stale only the answer that includes one of its
+   * values.
+   */
+  cache.invalidate(*fillF);
+  if (cache.getNumberOfAnswers() != 2) {
+    errors.insert("The answers about a modified function are kept");
+  }
+  ask(mainQuery);
+  ask(secondMainQuery);
+  if (answers != 3) {
+    errors.insert("The answers about other functions are dropped");
+  }
+
+  /*
+   * Dropping an analysis drops only its answers, and the analysis gets a new
+   * identifier.
+   */
+  cache.invalidate(&firstAnalysis);
+  if (cache.getNumberOfAnswers() != 1) {
+    errors.insert("The answers of a dropped analysis are kept");
+  }
+  ask(secondMainQuery);
+  if (answers != 3) {
+    errors.insert("The answers of other analyses are dropped");
+  }
+  if (cache.getAnalysisID(&firstAnalysis, "first analysis") == firstID) {
+    errors.insert("A dropped analysis keeps its identifier");
+  }
+
+  return errors;
+}
+
+Values PDGGeneratorTestSuite::reachabilitySummaryMatchesCallChains(
+    ModulePass &pass,
+    TestSuite &suite) {
+  auto &genPass = static_cast<PDGGeneratorTestSuite &>(pass);
+  auto &noelle = genPass.getAnalysis<NoellePass>().getNoelle();
+  auto cg = noelle.getFunctionsManager()->getProgramCallGraph();
+  Values errors;
+
+  /*
+   * Every function of the program is a target.
+   */
+  std::vector<const Function *> targets;
+  for (auto node : cg->getFunctionNodes()) {
+    targets.push_back(node->getFunction());
+  }
+  FunctionReachabilitySummary summary(cg, targets);
+
+  /*
+   * The targets reachable from a function must be the ones found by visiting
+   * the chains of calls that start from it.
+   */
+  for (auto node : cg->getFunctionNodes()) {
+    std::set<const Function *> reachable;
+    std::vector<CallGraphFunctionNode *> toVisit{ node };
+    std::set<CallGraphFunctionNode *> visited;
+    while (!toVisit.empty()) {
+      auto current = toVisit.back();
+      toVisit.pop_back();
+      for (auto edge : cg->getOutgoingEdges(current)) {
+        auto callee = edge->getCallee();
+        reachable.insert(callee->getFunction());
+        if (visited.insert(callee).second) {
+          toVisit.push_back(callee);
+        }
+      }
+    }
+
+    auto f = node->getFunction();
+    auto name = f->getName().str();
+    if (summary.getReachableTargets(f) != reachable) {
+      errors.insert("The targets reachable from " + name + " differ");
+    }
+    if (summary.canReachATarget(f) != !reachable.empty()) {
+      errors.insert(name + " is wrongly considered to reach a target");
+    }
+    for (auto target : targets) {
+      if (summary.canReach(f, target) != (reachable.count(target) > 0)) {
+        errors.insert(name + " is wrongly considered to reach "
+                      + target->getName().str());
+      }
+    }
+  }
+
+  return errors;
+}
+
+Values PDGGeneratorTestSuite::updatedPDGRefreshesTheCallers(
+    ModulePass &pass,
+    TestSuite &suite) {
+  auto &genPass = static_cast<PDGGeneratorTestSuite &>(pass);
+  Values errors;
+
+  auto fillF = getFunctionNamed(*genPass.M, "fill");
+  if (fillF == nullptr) {
+    errors.insert("The function fill is missing");
+    return errors;
+  }
+
+  /*
+   * Use a generator that does not share its PDG with NOELLE, and cache the
+   * dependence graphs of fill and of its caller, main.
+   */
+  auto generator = genPass.createPDGGenerator(false, 1);
+  generator->getPDG();
+  FunctionDependenceGraphCache fdgCache(
+      [generator](void) -> PDG * { return generator->getPDG(); });
+  generator->setFunctionDependenceGraphCache(&fdgCache);
+  std::vector<Function *> functions{ fillF, genPass.mainF };
+  for (auto F : functions) {
+    fdgCache.getFunctionDependenceGraph(*F);
+  }
+
+  /*
+   * The dependence graphs of fill and main must be the ones computed from
+   * scratch after modifying fill.
+   */
+  auto compareWithPDGFromScratch = [&](const std::string &modification) {
+    auto misses = fdgCache.getNumberOfMisses();
+    auto pdgFromScratch = generator->constructPDGFromScratch();
+    for (auto F : functions) {
+      auto expectedFDG = pdgFromScratch->createFunctionSubgraph(*F);
+      auto fdg = fdgCache.getFunctionDependenceGraph(*F);
+      for (auto &error :
+           PDGGeneratorTestSuite::compareDependences(suite, expectedFDG, fdg)) {
+        errors.insert(error + " in the FDG of " + F->getName().str()
+                      + " after " + modification);
+      }
+      delete expectedFDG;
+    }
+    for (auto &error :
+         PDGGeneratorTestSuite::compareDependences(suite,
+                                                   pdgFromScratch,
+                                                   generator->getPDG())) {
+      errors.insert(error + " after " + modification);
+    }
+    delete pdgFromScratch;
+
+    /*
+     * The FDGs cached before the modification must have been dropped.
+     */
+    if (fdgCache.getNumberOfMisses() != (misses + functions.size())) {
+      errors.insert("Stale FDGs have been used after " + modification);
+    }
+  };
+
+  /*
+   * Duplicate a store of fill.
+   */
+  StoreInst *store = nullptr;
+  for (auto &inst : instructions(*fillF)) {
+    if (auto s = dyn_cast<StoreInst>(&inst)) {
+      store = s;
+      break;
+    }
+  }
+  if (store == nullptr) {
+    errors.insert("fill has no stores");
+  } else {
+    auto clone = store->clone();
+    clone->insertAfter(store);
+    generator->codeModified(*fillF, { clone });
+    compareWithPDGFromScratch("cloning a store of fill");
+
+    /*
+     * Erase the duplicate, which restores the code for the other tests.
+     */
+    clone->eraseFromParent();
+    generator->codeModified(*fillF, {});
+    compareWithPDGFromScratch("erasing a store of fill");
+  }
+
+  generator->setFunctionDependenceGraphCache(nullptr);
+  delete generator;
+
+  return errors;
+}
+
+Values PDGGeneratorTestSuite::indirectCallsReachExternalFunctions(
+    ModulePass &pass,
+    TestSuite &suite) {
+  auto &genPass = static_cast<PDGGeneratorTestSuite &>(pass);
+  auto &noelle = genPass.getAnalysis<NoellePass>().getNoelle();
+  Values errors;
+
+  auto applyF = getFunctionNamed(*genPass.M, "apply");
+  auto printfF = genPass.M->getFunction("printf");
+  auto counter = genPass.M->getGlobalVariable("counter");
+  if ((applyF == nullptr) || (printfF == nullptr) || (counter == nullptr)) {
+    errors.insert("The program does not include apply, printf, and counter");
+    return errors;
+  }
+
+  /*
+   * apply invokes printf only through its indirect call.
+   */
+  auto cg = noelle.getFunctionsManager()->getProgramCallGraph();
+  FunctionReachabilitySummary summary(cg, { printfF });
+  if (!summary.canReach(applyF, printfF)) {
+    errors.insert("apply is considered not to reach printf");
+  }
+
+  /*
+   * Hence, the accesses to counter must depend on the call to apply.
+   */
+  CallBase *callToApply = nullptr;
+  std::vector<Instruction *> accesses;
+  for (auto &inst : instructions(*genPass.mainF)) {
+    if (auto call = dyn_cast<CallBase>(&inst)) {
+      if (call->getCalledFunction() == applyF) {
+        callToApply = call;
+      }
+    }
+    if (auto load = dyn_cast<LoadInst>(&inst)) {
+      if (load->getPointerOperand() == counter) {
+        accesses.push_back(load);
+      }
+    }
+    if (auto store = dyn_cast<StoreInst>(&inst)) {
+      if (store->getPointerOperand() == counter) {
+        accesses.push_back(store);
+      }
+    }
+  }
+  if ((callToApply == nullptr) || accesses.empty()) {
+    errors.insert("main does not invoke apply and access counter");
+    return errors;
+  }
+  auto pdg = noelle.getProgramDependenceGraph();
+  auto callNode = pdg->fetchNode(callToApply);
+  for (auto access : accesses) {
+    auto accessNode = pdg->fetchNode(access);
+    auto edges = pdg->fetchEdges(callNode, accessNode);
+    for (auto edge : pdg->fetchEdges(accessNode, callNode)) {
+      edges.insert(edge);
+    }
+    auto isDependent = false;
+    for (auto edge : edges) {
+      if (isa<MemoryDependence<Value, Value>>(edge)) {
+        isDependent = true;
+        break;
+      }
+    }
+    if (!isDependent) {
+      errors.insert("The call to apply and " + suite.valueToString(access)
+                    + " are independent");
+    }
+  }
+
+  return errors;
+}
+
+FixedStrengthAnalysis::FixedStrengthAnalysis(
+    const std::string &name,
+    MemoryDataDependenceStrength strength)
+  : DependenceAnalysis(name),
+    strength{ strength } {
+  return;
+}
+
+MemoryDataDependenceStrength FixedStrengthAnalysis::
+    isThereThisMemoryDataDependenceType(DataDependenceType t,
+                                        Instruction *fromInst,
+                                        Instruction *toInst,
+                                        Function &function) {
+  return this->strength;
+}
+
+BatchedAnalysis::BatchedAnalysis(Function *skippedFunction)
+  : DependenceAnalysis("Batched analysis"),
+    singleQueries{ 0 },
+    batchedQueries{ 0 },
+    askedAboutSkippedFunction{ false },
+    skippedFunction{ skippedFunction } {
+  return;
+}
+
+bool BatchedAnalysis::canThereBeAMemoryDataDependence(Instruction *fromInst,
+                                                      Instruction *toInst,
+                                                      Function &function) {
+  this->singleQueries++;
+
+  return true;
+}
+
+std::vector<bool> BatchedAnalysis::canThereBeMemoryDataDependences(
+    const std::vector<std::pair<Instruction *, Instruction *>> &pairs,
+    Function &function) {
+  this->batchedQueries++;
+  if (&function == this->skippedFunction) {
+    this->askedAboutSkippedFunction = true;
+  }
+
+  return std::vector<bool>(pairs.size(), false);
+}
+
+bool BatchedAnalysis::canRemoveDependencesOf(Function &function) {
+  return &function != this->skippedFunction;
+}
+
+Values PDGGeneratorTestSuite::cannotExistWinsInAnyOrder(ModulePass &pass,
+                                                        TestSuite &suite) {
+  auto &genPass = static_cast<PDGGeneratorTestSuite &>(pass);
+  FixedStrengthAnalysis mustExist("Must exist", MUST_EXIST);
+  FixedStrengthAnalysis cannotExist("Cannot exist", CANNOT_EXIST);
+
+  /*
+   * The dependences must be the ones removed by the analysis that asserts
+   * their lack, no matter where the other analysis is.
+   */
+  auto cannotGenerator = genPass.createPDGGenerator(false, 1);
+  cannotGenerator->addAnalysis(&cannotExist);
+  auto mustFirstGenerator = genPass.createPDGGenerator(false, 1);
+  mustFirstGenerator->addAnalysis(&mustExist);
+  mustFirstGenerator->addAnalysis(&cannotExist);
+  auto cannotFirstGenerator = genPass.createPDGGenerator(false, 1);
+  cannotFirstGenerator->addAnalysis(&cannotExist);
+  cannotFirstGenerator->addAnalysis(&mustExist);
+  auto errors =
+      PDGGeneratorTestSuite::compareDependences(suite,
+                                                cannotGenerator->getPDG(),
+                                                mustFirstGenerator->getPDG());
+  for (auto &error : PDGGeneratorTestSuite::compareDependences(
+           suite,
+           cannotGenerator->getPDG(),
+           cannotFirstGenerator->getPDG())) {
+    errors.insert(error);
+  }
+  delete cannotFirstGenerator;
+  delete mustFirstGenerator;
+  delete cannotGenerator;
+
+  return errors;
+}
+
+Values PDGGeneratorTestSuite::batchedAnalysisRemovesDependences(
+    ModulePass &pass,
+    TestSuite &suite) {
+  auto &genPass = static_cast<PDGGeneratorTestSuite &>(pass);
+  Values errors;
+
+  /*
+   * Compute the PDG with and without an analysis that asserts the lack of
+   * every memory dependence, except the ones of main.
+   */
+  BatchedAnalysis analysis(genPass.mainF);
+  auto generator = genPass.createPDGGenerator(false, 1);
+  auto batchedGenerator = genPass.createPDGGenerator(false, 1);
+  batchedGenerator->addAnalysis(&analysis);
+  auto dependences =
+      PDGGeneratorTestSuite::describeDependences(suite, generator->getPDG());
+  auto batchedDependences =
+      PDGGeneratorTestSuite::describeDependences(suite,
+                                                 batchedGenerator->getPDG());
+  delete batchedGenerator;
+  delete generator;
+
+  /*
+   * Only the memory dependences of main must be left.
+   */
+  std::multiset<std::string> mainMemoryDependences;
+  for (auto &dependence : dependences) {
+    if (dependence.find(" memory ") == std::string::npos) {
+      continue;
+    }
+    if (dependence.compare(0, 6, "main: ") == 0) {
+      mainMemoryDependences.insert(dependence);
+    }
+  }
+  std::multiset<std::string> batchedMemoryDependences;
+  for (auto &dependence : batchedDependences) {
+    if (dependence.find(" memory ") != std::string::npos) {
+      batchedMemoryDependences.insert(dependence);
+    }
+  }
+  if (mainMemoryDependences.empty()) {
+    errors.insert("main has no memory dependences");
+  }
+  if (batchedMemoryDependences != mainMemoryDependences) {
+    errors.insert("The memory dependences left are not the ones of main");
+  }
+
+  /*
+   * The analysis must be asked only in batches, and never about main.
+   */
+  if (analysis.batchedQueries == 0) {
+    errors.insert("The analysis is not asked in batches");
+  }
+  if (analysis.singleQueries != 0) {
+    errors.insert("The analysis is asked about single pairs");
+  }
+  if (analysis.askedAboutSkippedFunction) {
+    errors.insert("The analysis is asked about main");
+  }
+
+  return errors;
+}
+
+Values PDGGeneratorTestSuite::serializedPDGHasTheSameDependences(
+    ModulePass &pass,
+    TestSuite &suite) {
+  auto &genPass = static_cast<PDGGeneratorTestSuite &>(pass);
+  auto generator = genPass.createPDGGenerator(false, 1);
+  auto pdg = generator->getPDG();
+
+  /*
+   * Assign an ID to every value of the PDG.
+   */
+  std::vector<Value *> values;
+  std::unordered_map<Value *, uint64_t> valueIDs;
+  for (auto node : pdg->getNodes()) {
+    valueIDs[node->getT()] = values.size();
+    values.push_back(node->getT());
+  }
+
+  /*
+   * Encode the dependences and decode them into a PDG with the same values.
+   */
+  std::vector<DGEdge<Value, Value> *> dependences(pdg->getEdges().begin(),
+                                                  pdg->getEdges().end());
+  auto data = PDGSerializer::serialize(dependences, valueIDs);
+  auto decodedPDG = new PDG(values);
+  Values errors;
+  if (!PDGSerializer::deserialize(data, decodedPDG, values)) {
+    errors.insert("The encoding of the PDG is not valid");
+  }
+  for (auto &error :
+       PDGGeneratorTestSuite::compareDependences(suite, pdg, decodedPDG)) {
+    errors.insert(error);
+  }
+  delete decodedPDG;
+  delete generator;
+
+  return errors;
+}
+
+Values PDGGeneratorTestSuite::invalidSerializedPDGIsRejected(
+    ModulePass &pass,
+    TestSuite &suite) {
+  auto &genPass = static_cast<PDGGeneratorTestSuite &>(pass);
+  Values errors;
+
+  /*
+   * Encode the dependences between the instructions of main and their only
+   * user.
+   */
+  std::vector<Value *> values;
+  std::unordered_map<Value *, uint64_t> valueIDs;
+  for (auto &inst : instructions(*genPass.mainF)) {
+    valueIDs[&inst] = values.size();
+    values.push_back(&inst);
+  }
+  auto fdg = new PDG(values);
+  std::vector<DGEdge<Value, Value> *> dependences;
+  for (auto &inst : instructions(*genPass.mainF)) {
+    if (!inst.hasOneUse()) {
+      continue;
+    }
+    if (auto user = dyn_cast<Instruction>(inst.user_back())) {
+      dependences.push_back(
+          fdg->addVariableDataDependenceEdge(&inst, user, DG_DATA_RAW));
+    }
+  }
+  if (dependences.empty()) {
+    errors.insert("main has no dependences to encode");
+    delete fdg;
+    return errors;
+  }
+  auto data = PDGSerializer::serialize(dependences, valueIDs);
+
+  /*
+   * Check that the decoding fails.
+   */
+  auto check = [&](StringRef invalidData,
+                   const std::vector<Value *> &invalidValues,
+                   const std::string &error) {
+    auto pdg = new PDG(values);
+    if (PDGSerializer::deserialize(invalidData, pdg, invalidValues)) {
+      errors.insert(error);
+    }
+    delete pdg;
+  };
+
+  /*
+   * The buffer is truncated.
+   */
+  check(StringRef(data).drop_back(1), values, "A truncated buffer is decoded");
+  check(StringRef(data).take_front(8), values, "A header is decoded");
+
+  /*
+   * The buffer has extra bytes.
+   */
+  check(data + "x", values, "A buffer with extra bytes is decoded");
+
+  /*
+   * A value is missing.
+   */
+  auto missingValues = values;
+  missingValues[valueIDs.at(dependences[0]->getSrc())] = nullptr;
+  check(data, missingValues, "A missing value is decoded");
+  check(data,
+        std::vector<Value *>(values.begin(), values.begin() + 1),
+        "A value out of range is decoded");
+
+  /*
+   * The magic or the version differ.
+   */
+  auto wrongMagic = data;
+  wrongMagic[0] = 'X';
+  check(wrongMagic, values, "A wrong magic is decoded");
+  auto wrongVersion = data;
+  wrongVersion[8] = (char)(PDGSerializer::version + 1);
+  check(wrongVersion, values, "A wrong version is decoded");
+  delete fdg;
+
+  return errors;
+}
+
+Values PDGGeneratorTestSuite::updatedPDGMatchesThePDGFromScratch(
+    ModulePass &pass,
+    TestSuite &suite) {
+  auto &genPass = static_cast<PDGGeneratorTestSuite &>(pass);
+  auto &noelle = genPass.getAnalysis<NoellePass>().getNoelle();
+  auto &generator = noelle.getPDGGenerator();
+  Values errors;
+
+  /*
+   * Compute the PDG before modifying the code.
+   */
+  noelle.getProgramDependenceGraph();
+
+  /*
+   * Compare the PDG updated by NOELLE with the one computed from scratch.
+   */
+  auto compareWithPDGFromScratch = [&](const std::string &modification) {
+    auto pdgFromScratch = generator.constructPDGFromScratch();
+    for (auto &error :
+         PDGGeneratorTestSuite::compareDependences(suite,
+                                                   pdgFromScratch,
+                                                   generator.getPDG())) {
+      errors.insert(error + " after " + modification);
+    }
+    delete pdgFromScratch;
+  };
+
+  /*
+   * Fetch a store of main.
+   */
+  StoreInst *store = nullptr;
+  for (auto &inst : instructions(*genPass.mainF)) {
+    if (auto s = dyn_cast<StoreInst>(&inst)) {
+      store = s;
+      break;
+    }
+  }
+  if (store == nullptr) {
+    errors.insert("main has no stores");
+    return errors;
+  }
+
+  /*
+   * Duplicate the store.
+   */
+  auto clone = store->clone();
+  clone->insertAfter(store);
+  noelle.codeModified(genPass.mainF, { clone });
+  compareWithPDGFromScratch("cloning a store");
+
+  /*
+   * Erase the duplicate, which restores the code for the other tests.
+   * Erased instructions do not need to be reported.
+   */
+  clone->eraseFromParent();
+  noelle.codeModified(genPass.mainF, {});
+  compareWithPDGFromScratch("erasing a store");
+
+  return errors;
+}
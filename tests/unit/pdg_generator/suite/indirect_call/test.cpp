@@ -0,0 +1,28 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+int counter;
+
+static void logValue(int v) {
+  printf("%d\n", v);
+}
+
+static void bump(int v) {
+  counter += v;
+}
+
+typedef void (*Action)(int);
+
+static void apply(Action action, int v) {
+  action(v);
+}
+
+int main(int argc, char *argv[]) {
+  Action actions[2] = { bump, logValue };
+
+  counter = argc;
+  apply(actions[argc % 2], argc);
+  counter *= 2;
+
+  return counter;
+}
@@ -0,0 +1,63 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+static int table[32];
+int histogram[16];
+
+static void fill(int *v, int n, int seed) {
+  for (int i = 0; i < n; i++) {
+    v[i] = (seed * i) % 17;
+  }
+}
+
+static int sumOf(int *v, int n) {
+  int s = 0;
+  for (int i = 0; i < n; i++) {
+    s += v[i];
+  }
+  return s;
+}
+
+static int isOdd(int n);
+
+static int isEven(int n) {
+  if (n == 0) {
+    return 1;
+  }
+  histogram[n % 16]++;
+  return isOdd(n - 1);
+}
+
+static int isOdd(int n) {
+  if (n == 0) {
+    return 0;
+  }
+  if (n > 1000) {
+    printf("Large input\n");
+  }
+  return isEven(n - 1);
+}
+
+int main(int argc, char *argv[]) {
+  int a[32];
+  int b[32];
+  int n = argc * 8;
+  if (n > 32) {
+    n = 32;
+  }
+
+  fill(a, n, argc);
+  fill(b, n, argc + 1);
+  for (int i = 0; i < n; i++) {
+    a[i] += b[i];
+    table[i] = a[i];
+    histogram[a[i] % 16]++;
+  }
+
+  int *heap = (int *)malloc(sizeof(int) * n);
+  fill(heap, n, 3);
+  printf("%d %d %d\n", sumOf(a, n), sumOf(table, n), isEven(n) + heap[0]);
+  free(heap);
+
+  return 0;
+}
@@ -38,6 +38,7 @@
 #include "arcana/noelle/core/SCCDAGAttrs.hpp"
 #include "arcana/noelle/core/Invariants.hpp"
 #include "arcana/noelle/core/InductionVariables.hpp"
+#include "arcana/noelle/core/DAGReachability.hpp"
 
 #include "TestSuite.hpp"
 
@@ -83,6 +84,22 @@ private:
                           TestSuite &suite,
                           std::set<SCC *> sccs);
 
+  static Values denseReachability(ModulePass &pass, TestSuite &suite);
+  static Values intervalsReachability(ModulePass &pass, TestSuite &suite);
+  static Values denseReachabilityAfterAMerge(ModulePass &pass,
+                                             TestSuite &suite);
+  static Values intervalsReachabilityAfterAMerge(ModulePass &pass,
+                                                 TestSuite &suite);
+  static Values denseReachabilityAfterTwoMerges(ModulePass &pass,
+                                                TestSuite &suite);
+  static Values intervalsReachabilityAfterTwoMerges(ModulePass &pass,
+                                                    TestSuite &suite);
+
+  static Values printReachability(
+      TestSuite &suite,
+      DAGReachability::Representation representation,
+      uint32_t numberOfMerges);
+
   TestSuite *suite;
   Module *M;
   ScalarEvolution *SE;
@@ -56,7 +56,13 @@ const char *SCCDAGAttrTestSuite::tests[] = {
   "reducible SCC",
   "clonable SCC",
   "clonable SCC into local memory",
-  "loop carried dependencies (top loop)"
+  "loop carried dependencies (top loop)",
+  "dag reachability (dense)",
+  "dag reachability (intervals)",
+  "dag reachability after a merge (dense)",
+  "dag reachability after a merge (intervals)",
+  "dag reachability after two merges (dense)",
+  "dag reachability after two merges (intervals)"
 };
 TestFunction SCCDAGAttrTestSuite::testFns[] = {
   SCCDAGAttrTestSuite::sccdagHasCorrectSCCs,
@@ -64,7 +70,13 @@ TestFunction SCCDAGAttrTestSuite::testFns[] = {
   SCCDAGAttrTestSuite::reducibleSCCsAreFound,
   SCCDAGAttrTestSuite::clonableSCCsAreFound,
   SCCDAGAttrTestSuite::clonableSCCsIntoLocalMemoryAreFound,
-  SCCDAGAttrTestSuite::loopCarriedDependencies
+  SCCDAGAttrTestSuite::loopCarriedDependencies,
+  SCCDAGAttrTestSuite::denseReachability,
+  SCCDAGAttrTestSuite::intervalsReachability,
+  SCCDAGAttrTestSuite::denseReachabilityAfterAMerge,
+  SCCDAGAttrTestSuite::intervalsReachabilityAfterAMerge,
+  SCCDAGAttrTestSuite::denseReachabilityAfterTwoMerges,
+  SCCDAGAttrTestSuite::intervalsReachabilityAfterTwoMerges
 };
 
 bool SCCDAGAttrTestSuite::doInitialization(Module &M) {
@@ -355,4 +367,103 @@ Values SCCDAGAttrTestSuite::loopCarriedDependencies(ModulePass &pass,
   return valueNames;
 }
 
+Values SCCDAGAttrTestSuite::printReachability(
+    TestSuite &suite,
+    DAGReachability::Representation representation,
+    uint32_t numberOfMerges) {
+
+  /*
+   * The DAG is
+   *   0 -> 1 -> 2 -> 5
+   *   0 -> 3 -> 4 -> 5
+   * Merging 1 and 5 creates the cycle 1 -> 2 -> 1.
+   * Merging 2 and 3 afterwards extends it to 1 -> 2 -> 4 -> 1.
+   */
+  std::vector<std::vector<uint32_t>> successors{ { 1, 3 }, { 2 }, { 5 },
+                                                 { 4 },    { 5 }, {} };
+  DAGReachability reachability{};
+  reachability.compute(successors.size(), successors, representation);
+  std::set<uint32_t> nodes{ 0, 1, 2, 3, 4, 5 };
+  Values valueNames{};
+  if (reachability.getRepresentation() != representation) {
+    valueNames.insert("Wrong representation");
+  }
+
+  /*
+   * Merge the nodes.
+   */
+  std::vector<std::vector<uint32_t>> merges{ { 5, 1 }, { 3, 2 } };
+  for (auto i = 0u; i < numberOfMerges; i++) {
+    auto merged = reachability.merge(merges[i]);
+    if (merged != *std::min_element(merges[i].begin(), merges[i].end())) {
+      valueNames.insert("Wrong merged node");
+    }
+    for (auto node : merges[i]) {
+      if (node != merged) {
+        nodes.erase(node);
+      }
+    }
+  }
+
+  /*
+   * Print the pairs of nodes that are reachable.
+   */
+  for (auto from : nodes) {
+    for (auto to : nodes) {
+      if (!reachability.isReachable(from, to)) {
+        continue;
+      }
+      valueNames.insert(std::to_string(from) + suite.orderedValueDelimiter
+                        + std::to_string(to));
+    }
+  }
+
+  return valueNames;
+}
+
+Values SCCDAGAttrTestSuite::denseReachability(ModulePass &pass,
+                                              TestSuite &suite) {
+  return SCCDAGAttrTestSuite::printReachability(suite,
+                                                DAGReachability::DENSE,
+                                                0);
+}
+
+Values SCCDAGAttrTestSuite::intervalsReachability(ModulePass &pass,
+                                                  TestSuite &suite) {
+  return SCCDAGAttrTestSuite::printReachability(suite,
+                                                DAGReachability::INTERVALS,
+                                                0);
+}
+
+Values SCCDAGAttrTestSuite::denseReachabilityAfterAMerge(ModulePass &pass,
+                                                         TestSuite &suite) {
+  return SCCDAGAttrTestSuite::printReachability(suite,
+                                                DAGReachability::DENSE,
+                                                1);
+}
+
+Values SCCDAGAttrTestSuite::intervalsReachabilityAfterAMerge(
+    ModulePass &pass,
+    TestSuite &suite) {
+  return SCCDAGAttrTestSuite::printReachability(suite,
+                                                DAGReachability::INTERVALS,
+                                                1);
+}
+
+Values SCCDAGAttrTestSuite::denseReachabilityAfterTwoMerges(
+    ModulePass &pass,
+    TestSuite &suite) {
+  return SCCDAGAttrTestSuite::printReachability(suite,
+                                                DAGReachability::DENSE,
+                                                2);
+}
+
+Values SCCDAGAttrTestSuite::intervalsReachabilityAfterTwoMerges(
+    ModulePass &pass,
+    TestSuite &suite) {
+  return SCCDAGAttrTestSuite::printReachability(suite,
+                                                DAGReachability::INTERVALS,
+                                                2);
+}
+
 } // namespace arcana::noelle